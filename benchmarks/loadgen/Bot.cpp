@@ -0,0 +1,475 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Bot.h"
+#include "SharedHttpTransport.h"
+#include "Shard.h"
+
+#include <nakama-cpp/ClientFactory.h>
+#include <nakama-cpp/realtime/NWebsocketsFactory.h>
+
+#include <cstring>
+
+namespace Nakama {
+namespace LoadGen {
+
+namespace {
+
+constexpr int64_t kMatchDataOpCode = 1;
+constexpr const char* kStorageCollection = "loadgen";
+
+std::string jsonPayload(size_t bytes) { return "{\"data\":\"" + std::string(bytes, 'x') + "\"}"; }
+
+// Next run of a periodic activity, without catching up on more than one missed run.
+void reschedule(Clock::time_point& next, Clock::duration interval, Clock::time_point now) {
+  next += interval;
+  if (next < now) {
+    next = now;
+  }
+}
+
+} // namespace
+
+Bot::Bot(Shard& shard, size_t index, Clock::time_point startAt)
+    : _shard(shard), _index(index), _startAt(startAt), _random(static_cast<uint32_t>(index)) {
+  auto transport = std::make_shared<SharedHttpTransport>(shard.httpTransport());
+  _client = createRestClient(shard.scenario().server, transport);
+}
+
+Bot::~Bot() {
+  _state = State::Stopped;
+  _rtClient.reset();
+  _retiredRtClient.reset();
+  _client.reset();
+}
+
+void Bot::tick(Clock::time_point now) {
+  // released here, a client can't be destroyed from its own callbacks
+  _retiredRtClient.reset();
+
+  if (_state == State::Stopped) {
+    _rtClient.reset();
+    return;
+  }
+
+  if (_state == State::NotStarted) {
+    if (now < _startAt) {
+      return;
+    }
+    _shard.botStarted();
+    beginStep(now);
+  }
+
+  _client->tick();
+  if (_rtClient) {
+    _rtClient->tick();
+  }
+
+  if (_state == State::Busy && _waitingForMatch) {
+    joinGroupMatch();
+  } else if (_state == State::Timed) {
+    if (now >= _stepEnd) {
+      nextStep();
+    } else if (step().kind == StepKind::Play) {
+      play(now);
+    }
+  }
+}
+
+void Bot::stop() {
+  if (_state == State::Stopped) {
+    return;
+  }
+
+  _state = State::Stopped;
+  if (_rtClient) {
+    _disconnecting = true;
+    _rtClient->disconnect();
+  }
+  _client->disconnect();
+}
+
+const Step& Bot::step() const { return _shard.scenario().steps[_step]; }
+
+void Bot::beginStep(Clock::time_point now) {
+  _state = State::Busy;
+  _stepStart = now;
+
+  switch (step().kind) {
+  case StepKind::Authenticate:
+    authenticate();
+    break;
+  case StepKind::Connect:
+    connect();
+    break;
+  case StepKind::JoinMatch:
+    joinMatch();
+    break;
+  case StepKind::LeaveMatch:
+    _rtClient->leaveMatch(
+        _matchId,
+        [this]() {
+          if (!stopped()) {
+            _matchId.clear();
+            _shard.record(Op::LeaveMatch, _stepStart);
+            nextStep();
+          }
+        },
+        [this](const NRtError& error) {
+          if (!stopped()) {
+            fail(Op::LeaveMatch, error.message);
+          }
+        });
+    break;
+  case StepKind::JoinChat:
+    _rtClient->joinChat(
+        step().room, NChannelType::ROOM, false, false,
+        [this](NChannelPtr channel) {
+          if (!stopped()) {
+            _channelId = channel->id;
+            _shard.record(Op::JoinChat, _stepStart);
+            nextStep();
+          }
+        },
+        [this](const NRtError& error) {
+          if (!stopped()) {
+            fail(Op::JoinChat, error.message);
+          }
+        });
+    break;
+  case StepKind::LeaveChat:
+    _rtClient->leaveChat(
+        _channelId,
+        [this]() {
+          if (!stopped()) {
+            _channelId.clear();
+            _shard.record(Op::LeaveChat, _stepStart);
+            nextStep();
+          }
+        },
+        [this](const NRtError& error) {
+          if (!stopped()) {
+            fail(Op::LeaveChat, error.message);
+          }
+        });
+    break;
+  case StepKind::Play:
+    beginPlay(now);
+    break;
+  case StepKind::Sleep:
+    _state = State::Timed;
+    _stepEnd = now + step().duration;
+    break;
+  case StepKind::Disconnect:
+    _disconnecting = true;
+    _rtClient->disconnect();
+    _matchId.clear();
+    _channelId.clear();
+    nextStep();
+    break;
+  }
+}
+
+void Bot::nextStep() {
+  if (++_step < _shard.scenario().steps.size()) {
+    beginStep(Clock::now());
+    return;
+  }
+
+  if (isGroupLeader()) {
+    _shard.group(_index).leaderStopped = true;
+  }
+  stop();
+  _shard.botStopped(false);
+}
+
+void Bot::fail(Op op, const std::string& message) {
+  _shard.error(op, message);
+
+  if (isGroupLeader()) {
+    _shard.group(_index).leaderStopped = true;
+  }
+  stop();
+  _shard.botStopped(true);
+}
+
+bool Bot::isGroupLeader() const { return _index % _shard.scenario().matchSize == 0; }
+
+void Bot::authenticate() {
+  const Scenario& scenario = _shard.scenario();
+  _client->authenticateCustom(
+      scenario.idPrefix + "-" + std::to_string(_index), "", true, {},
+      [this](NSessionPtr session) {
+        if (!stopped()) {
+          _session = session;
+          _shard.record(Op::Authenticate, _stepStart);
+          nextStep();
+        }
+      },
+      [this](const NError& error) {
+        if (!stopped()) {
+          fail(Op::Authenticate, error.message);
+        }
+      });
+}
+
+void Bot::connect() {
+  const Scenario& scenario = _shard.scenario();
+
+  // one socket per bot, with an I/O thread of its own unless the scenario has a reactor
+  _retiredRtClient = std::move(_rtClient);
+  _rtClient = _client->createRtClient(createDefaultWebsocket(scenario.server.platformParams, _shard.reactor()));
+  _rtClient->setListener(this);
+  _disconnecting = false;
+  _rtClient->connect(_session, true, scenario.protocol);
+}
+
+void Bot::onConnect() {
+  if (_state == State::Busy && step().kind == StepKind::Connect) {
+    _shard.record(Op::Connect, _stepStart);
+    nextStep();
+  }
+}
+
+void Bot::onDisconnect(const NRtClientDisconnectInfo& info) {
+  if (stopped() || _disconnecting) {
+    return;
+  }
+
+  Op op = step().kind == StepKind::Connect && _state == State::Busy ? Op::Connect : Op::Disconnect;
+  fail(op, "closed with code " + std::to_string(info.code) + (info.reason.empty() ? "" : ", " + info.reason));
+}
+
+void Bot::onError(const NRtError& error) {
+  // errors of requests go to their callbacks, a lost socket to onDisconnect
+  if (!stopped() && _state == State::Busy && step().kind == StepKind::Connect) {
+    fail(Op::Connect, error.message);
+  }
+}
+
+void Bot::onMatchData(const NMatchData& matchData) {
+  if (stopped() || matchData.opCode != kMatchDataOpCode || matchData.data.size() < sizeof(int64_t)) {
+    return;
+  }
+
+  int64_t sent = 0;
+  std::memcpy(&sent, matchData.data.data(), sizeof(sent));
+  auto sentAt = Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(sent)));
+  _shard.matchDataReceived(matchData.data.size(), sentAt);
+}
+
+void Bot::joinMatch() {
+  if (isGroupLeader()) {
+    // a relayed match, joined by its creator
+    _rtClient->createMatch(
+        [this](const NMatch& match) {
+          if (!stopped()) {
+            _matchId = match.matchId;
+            _shard.group(_index).matchIds[_step] = match.matchId;
+            _shard.record(Op::CreateMatch, _stepStart);
+            nextStep();
+          }
+        },
+        [this](const NRtError& error) {
+          if (!stopped()) {
+            fail(Op::CreateMatch, error.message);
+          }
+        });
+    return;
+  }
+
+  _waitingForMatch = true;
+  joinGroupMatch();
+}
+
+void Bot::joinGroupMatch() {
+  MatchGroup& group = _shard.group(_index);
+  auto it = group.matchIds.find(_step);
+  if (it == group.matchIds.end()) {
+    if (group.leaderStopped) {
+      _waitingForMatch = false;
+      fail(Op::JoinMatch, "the match was not created");
+    }
+    return;
+  }
+
+  // the time spent waiting for the leader isn't the server's
+  _waitingForMatch = false;
+  _stepStart = Clock::now();
+  _rtClient->joinMatch(
+      it->second, {},
+      [this](const NMatch& match) {
+        if (!stopped()) {
+          _matchId = match.matchId;
+          _shard.record(Op::JoinMatch, _stepStart);
+          nextStep();
+        }
+      },
+      [this](const NRtError& error) {
+        if (!stopped()) {
+          fail(Op::JoinMatch, error.message);
+        }
+      });
+}
+
+void Bot::beginPlay(Clock::time_point now) {
+  const PlayConfig& play = step().play;
+  _state = State::Timed;
+  _stepEnd = now + play.duration;
+
+  if (play.matchDataHz > 0) {
+    auto period = std::chrono::duration<double>(1.0 / play.matchDataHz);
+    _matchDataPeriod = std::chrono::duration_cast<Clock::duration>(period);
+    _nextMatchData = firstRun(now, _matchDataPeriod);
+  }
+  _nextChat = firstRun(now, play.chatInterval);
+  _nextStorage = firstRun(now, play.storageInterval);
+  _nextRpc = firstRun(now, play.rpcInterval);
+}
+
+Clock::time_point Bot::firstRun(Clock::time_point now, Clock::duration interval) {
+  if (interval.count() <= 0) {
+    return now;
+  }
+  std::uniform_int_distribution<Clock::rep> offset(0, interval.count() - 1);
+  return now + Clock::duration(offset(_random));
+}
+
+void Bot::play(Clock::time_point now) {
+  const PlayConfig& play = step().play;
+
+  if (play.matchDataHz > 0 && now >= _nextMatchData) {
+    reschedule(_nextMatchData, _matchDataPeriod, now);
+    sendMatchData(play);
+  }
+  if (play.chatInterval.count() > 0 && !_chatBusy && now >= _nextChat) {
+    reschedule(_nextChat, play.chatInterval, now);
+    sendChatMessage(play);
+  }
+  if (play.storageInterval.count() > 0 && !_storageBusy && now >= _nextStorage) {
+    reschedule(_nextStorage, play.storageInterval, now);
+    churnStorage(play);
+  }
+  if (play.rpcInterval.count() > 0 && !_rpcBusy && now >= _nextRpc) {
+    reschedule(_nextRpc, play.rpcInterval, now);
+    callRpc(play);
+  }
+}
+
+void Bot::sendMatchData(const PlayConfig& play) {
+  // the receiving bot measures the delivery time, all bots share the clock of this process
+  NBytes data(play.matchDataBytes, 'x');
+  int64_t sent = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+  std::memcpy(&data[0], &sent, sizeof(sent));
+
+  _rtClient->sendMatchData(_matchId, kMatchDataOpCode, data);
+  _shard.matchDataSent(data.size());
+}
+
+void Bot::sendChatMessage(const PlayConfig& play) {
+  Clock::time_point start = Clock::now();
+  _chatBusy = true;
+  _rtClient->writeChatMessage(
+      _channelId, jsonPayload(play.chatBytes),
+      [this, start](const NChannelMessageAck&) {
+        if (!stopped()) {
+          _chatBusy = false;
+          _shard.record(Op::ChatMessage, start);
+        }
+      },
+      [this](const NRtError& error) {
+        if (!stopped()) {
+          _chatBusy = false;
+          _shard.error(Op::ChatMessage, error.message);
+        }
+      });
+}
+
+void Bot::churnStorage(const PlayConfig& play) {
+  std::vector<NStorageObjectWrite> writes(play.storageObjects);
+  std::vector<NReadStorageObjectId> reads(play.storageObjects);
+  for (size_t i = 0; i < writes.size(); i++) {
+    writes[i].collection = reads[i].collection = kStorageCollection;
+    writes[i].key = reads[i].key = "object-" + std::to_string(i);
+    writes[i].value = jsonPayload(play.storageBytes);
+    reads[i].userId = _session->getUserId();
+  }
+
+  // writes the objects and reads them back
+  Clock::time_point start = Clock::now();
+  _storageBusy = true;
+  _client->writeStorageObjects(
+      _session, writes,
+      [this, start, reads](const NStorageObjectAcks&) {
+        if (stopped()) {
+          return;
+        }
+        _shard.record(Op::StorageWrite, start);
+
+        Clock::time_point readStart = Clock::now();
+        _client->readStorageObjects(
+            _session, reads,
+            [this, readStart](const NStorageObjects&) {
+              if (!stopped()) {
+                _storageBusy = false;
+                _shard.record(Op::StorageRead, readStart);
+              }
+            },
+            [this](const NError& error) {
+              if (!stopped()) {
+                _storageBusy = false;
+                _shard.error(Op::StorageRead, error.message);
+              }
+            });
+      },
+      [this](const NError& error) {
+        if (!stopped()) {
+          _storageBusy = false;
+          _shard.error(Op::StorageWrite, error.message);
+        }
+      });
+}
+
+void Bot::callRpc(const PlayConfig& play) {
+  Clock::time_point start = Clock::now();
+  std::string payload = jsonPayload(play.rpcBytes);
+  auto success = [this, start](const NRpc&) {
+    if (!stopped()) {
+      _rpcBusy = false;
+      _shard.record(Op::Rpc, start);
+    }
+  };
+
+  _rpcBusy = true;
+  if (play.rpcRealtime) {
+    _rtClient->rpc(play.rpcId, payload, success, [this](const NRtError& error) {
+      if (!stopped()) {
+        _rpcBusy = false;
+        _shard.error(Op::Rpc, error.message);
+      }
+    });
+  } else {
+    _client->rpc(_session, play.rpcId, payload, success, [this](const NError& error) {
+      if (!stopped()) {
+        _rpcBusy = false;
+        _shard.error(Op::Rpc, error.message);
+      }
+    });
+  }
+}
+
+} // namespace LoadGen
+} // namespace Nakama
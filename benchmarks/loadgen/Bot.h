@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "LoadStats.h"
+#include "Scenario.h"
+
+#include <nakama-cpp/NClientInterface.h>
+#include <nakama-cpp/realtime/NRtClientListenerInterface.h>
+
+#include <random>
+#include <string>
+
+namespace Nakama {
+namespace LoadGen {
+
+class Shard;
+
+/**
+ * One simulated player, walking through the steps of the scenario with a client and a realtime client of
+ * its own. A step which fails stops the bot, errors of the periodic traffic of a play step are only counted.
+ */
+class Bot : public NRtClientListenerInterface {
+public:
+  Bot(Shard& shard, size_t index, Clock::time_point startAt);
+  ~Bot() override;
+
+  Bot(const Bot&) = delete;
+  Bot& operator=(const Bot&) = delete;
+
+  // Ticks the clients and moves on through the scenario, once per frame.
+  void tick(Clock::time_point now);
+
+  // Ends the run of the bot, disconnecting it. Callbacks which are still to come are ignored.
+  void stop();
+
+  bool stopped() const { return _state == State::Stopped; }
+
+  void onConnect() override;
+  void onDisconnect(const NRtClientDisconnectInfo& info) override;
+  void onError(const NRtError& error) override;
+  void onMatchData(const NMatchData& matchData) override;
+
+private:
+  enum class State {
+    NotStarted,
+    Busy,  ///< waiting for the request of a step
+    Timed, ///< in a play or sleep step, until _stepEnd
+    Stopped,
+  };
+
+  const Step& step() const;
+  void beginStep(Clock::time_point now);
+  void nextStep();
+  void fail(Op op, const std::string& message);
+  bool isGroupLeader() const;
+
+  void authenticate();
+  void connect();
+  void joinMatch();
+  void joinGroupMatch();
+
+  void beginPlay(Clock::time_point now);
+  void play(Clock::time_point now);
+  void sendMatchData(const PlayConfig& play);
+  void sendChatMessage(const PlayConfig& play);
+  void churnStorage(const PlayConfig& play);
+  void callRpc(const PlayConfig& play);
+
+  // First run of an activity, at a random point of its interval so that bots don't send in lockstep.
+  Clock::time_point firstRun(Clock::time_point now, Clock::duration interval);
+
+  Shard& _shard;
+  const size_t _index;
+  const Clock::time_point _startAt;
+  std::mt19937 _random;
+
+  NClientPtr _client;
+  NRtClientPtr _rtClient;
+  NRtClientPtr _retiredRtClient; ///< replaced by a reconnect, released on the next tick
+  NSessionPtr _session;
+
+  State _state = State::NotStarted;
+  size_t _step = 0;
+  Clock::time_point _stepStart;
+  Clock::time_point _stepEnd;
+  bool _waitingForMatch = false; ///< a joinMatch step, until the leader has created it
+  bool _disconnecting = false;   ///< the socket is closed on purpose
+
+  std::string _matchId;
+  std::string _channelId;
+
+  // play step
+  Clock::duration _matchDataPeriod{};
+  Clock::time_point _nextMatchData;
+  Clock::time_point _nextChat;
+  Clock::time_point _nextStorage;
+  Clock::time_point _nextRpc;
+  bool _chatBusy = false;
+  bool _storageBusy = false;
+  bool _rpcBusy = false;
+};
+
+} // namespace LoadGen
+} // namespace Nakama
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LoadStats.h"
+
+#include <algorithm>
+
+namespace Nakama {
+namespace LoadGen {
+
+const char* opName(Op op) {
+  switch (op) {
+  case Op::Authenticate:
+    return "authenticate";
+  case Op::Connect:
+    return "connect";
+  case Op::CreateMatch:
+    return "createMatch";
+  case Op::JoinMatch:
+    return "joinMatch";
+  case Op::LeaveMatch:
+    return "leaveMatch";
+  case Op::MatchData:
+    return "matchData";
+  case Op::JoinChat:
+    return "joinChat";
+  case Op::LeaveChat:
+    return "leaveChat";
+  case Op::ChatMessage:
+    return "chatMessage";
+  case Op::StorageWrite:
+    return "storageWrite";
+  case Op::StorageRead:
+    return "storageRead";
+  case Op::Rpc:
+    return "rpc";
+  case Op::Disconnect:
+    return "disconnect";
+  case Op::Count:
+    break;
+  }
+  return "unknown";
+}
+
+void OpStats::record(std::chrono::microseconds value) {
+  uint64_t us = value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0;
+
+  if (latency.buckets.empty()) {
+    latency.buckets.resize(NLatencyHistogram::kBucketCount);
+    latency.minUs = us;
+  }
+  latency.buckets[NLatencyHistogram::bucketIndex(us)]++;
+  latency.count++;
+  latency.sumUs += us;
+  latency.minUs = std::min(latency.minUs, us);
+  latency.maxUs = std::max(latency.maxUs, us);
+}
+
+void OpStats::merge(const OpStats& other) {
+  errors += other.errors;
+  if (other.latency.count == 0) {
+    return;
+  }
+  if (latency.count == 0) {
+    latency = other.latency;
+    return;
+  }
+
+  for (size_t i = 0; i < latency.buckets.size(); i++) {
+    latency.buckets[i] += other.latency.buckets[i];
+  }
+  latency.count += other.latency.count;
+  latency.sumUs += other.latency.sumUs;
+  latency.minUs = std::min(latency.minUs, other.latency.minUs);
+  latency.maxUs = std::max(latency.maxUs, other.latency.maxUs);
+}
+
+void LoadStats::error(Op op, const std::string& message) {
+  (*this)[op].errors++;
+
+  std::string key = std::string(opName(op)) + ": " + message;
+  auto it = errorMessages.find(key);
+  if (it != errorMessages.end()) {
+    it->second++;
+  } else if (errorMessages.size() < kMaxErrorMessages) {
+    errorMessages.emplace(std::move(key), 1);
+  }
+}
+
+void LoadStats::merge(const LoadStats& other) {
+  for (size_t i = 0; i < kOpCount; i++) {
+    ops[i].merge(other.ops[i]);
+  }
+
+  matchDataSent += other.matchDataSent;
+  bytesSent += other.bytesSent;
+  bytesReceived += other.bytesReceived;
+  botsFinished += other.botsFinished;
+  botsFailed += other.botsFailed;
+
+  for (const auto& [message, count] : other.errorMessages) {
+    auto it = errorMessages.find(message);
+    if (it != errorMessages.end()) {
+      it->second += count;
+    } else if (errorMessages.size() < kMaxErrorMessages) {
+      errorMessages.emplace(message, count);
+    }
+  }
+}
+
+} // namespace LoadGen
+} // namespace Nakama
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <nakama-cpp/NLatencyHistogram.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Nakama {
+namespace LoadGen {
+
+using Clock = std::chrono::steady_clock;
+
+enum class Op {
+  Authenticate,
+  Connect,
+  CreateMatch,
+  JoinMatch,
+  LeaveMatch,
+  MatchData, ///< one way, from sending to another bot receiving it
+  JoinChat,
+  LeaveChat,
+  ChatMessage, ///< until the send is acknowledged
+  StorageWrite,
+  StorageRead,
+  Rpc,
+  Disconnect, ///< unexpected ones, errors only
+  Count
+};
+
+constexpr size_t kOpCount = static_cast<size_t>(Op::Count);
+
+const char* opName(Op op);
+
+struct OpStats {
+  NLatencyHistogram latency;
+  uint64_t errors = 0;
+
+  void record(std::chrono::microseconds value);
+  void merge(const OpStats& other);
+};
+
+/**
+ * Results of one shard, only touched by its thread. Merged once the shards have stopped.
+ */
+struct LoadStats {
+  std::array<OpStats, kOpCount> ops;
+
+  uint64_t matchDataSent = 0;
+  uint64_t bytesSent = 0;     ///< match data payloads
+  uint64_t bytesReceived = 0; ///< match data payloads
+
+  uint64_t botsFinished = 0; ///< ran all steps
+  uint64_t botsFailed = 0;   ///< stopped by an error
+
+  std::map<std::string, uint64_t> errorMessages; ///< a sample, capped at kMaxErrorMessages
+
+  static constexpr size_t kMaxErrorMessages = 32;
+
+  OpStats& operator[](Op op) { return ops[static_cast<size_t>(op)]; }
+  const OpStats& operator[](Op op) const { return ops[static_cast<size_t>(op)]; }
+
+  void error(Op op, const std::string& message);
+  void merge(const LoadStats& other);
+};
+
+/**
+ * Running totals for the progress line, written by the shards and read by the main thread.
+ */
+struct LiveCounters {
+  std::atomic<uint64_t> completed{0}; ///< operations, without match data
+  std::atomic<uint64_t> errors{0};
+  std::atomic<uint64_t> matchDataSent{0};
+  std::atomic<uint64_t> matchDataReceived{0};
+  std::atomic<uint32_t> botsStarted{0};
+  std::atomic<uint32_t> botsStopped{0}; ///< finished or failed
+
+  static void add(std::atomic<uint64_t>& counter, uint64_t value = 1) {
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+};
+
+} // namespace LoadGen
+} // namespace Nakama
@@ -0,0 +1,377 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Scenario.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/error/en.h>
+
+#include <cmath>
+
+namespace Nakama {
+namespace LoadGen {
+
+namespace {
+
+// Optional members: absent leaves `out` alone, a wrong type is an error.
+
+bool readNumber(const rapidjson::Value& object, const char* name, double& out, std::string& error) {
+  auto it = object.FindMember(name);
+  if (it == object.MemberEnd()) {
+    return true;
+  }
+  if (!it->value.IsNumber() || it->value.GetDouble() < 0) {
+    error = std::string("\"") + name + "\" must be a non-negative number";
+    return false;
+  }
+  out = it->value.GetDouble();
+  return true;
+}
+
+bool readCount(const rapidjson::Value& object, const char* name, size_t& out, std::string& error) {
+  double value = static_cast<double>(out);
+  if (!readNumber(object, name, value, error)) {
+    return false;
+  }
+  if (value != std::floor(value)) {
+    error = std::string("\"") + name + "\" must be an integer";
+    return false;
+  }
+  out = static_cast<size_t>(value);
+  return true;
+}
+
+template <class Duration>
+bool readDuration(const rapidjson::Value& object, const char* name, double scale, Duration& out, std::string& error) {
+  double value = static_cast<double>(out.count()) / scale;
+  if (!readNumber(object, name, value, error)) {
+    return false;
+  }
+  out = Duration(static_cast<typename Duration::rep>(value * scale));
+  return true;
+}
+
+bool readMs(const rapidjson::Value& object, const char* name, std::chrono::milliseconds& out, std::string& error) {
+  return readDuration(object, name, 1.0, out, error);
+}
+
+// Seconds, fractions allowed.
+bool readSeconds(const rapidjson::Value& object, const char* name, std::chrono::milliseconds& out, std::string& error) {
+  return readDuration(object, name, 1000.0, out, error);
+}
+
+bool readString(const rapidjson::Value& object, const char* name, std::string& out, std::string& error) {
+  auto it = object.FindMember(name);
+  if (it == object.MemberEnd()) {
+    return true;
+  }
+  if (!it->value.IsString()) {
+    error = std::string("\"") + name + "\" must be a string";
+    return false;
+  }
+  out.assign(it->value.GetString(), it->value.GetStringLength());
+  return true;
+}
+
+bool readBool(const rapidjson::Value& object, const char* name, bool& out, std::string& error) {
+  auto it = object.FindMember(name);
+  if (it == object.MemberEnd()) {
+    return true;
+  }
+  if (!it->value.IsBool()) {
+    error = std::string("\"") + name + "\" must be true or false";
+    return false;
+  }
+  out = it->value.GetBool();
+  return true;
+}
+
+// nullptr if absent or not an object, which is an error.
+const rapidjson::Value* findObject(const rapidjson::Value& object, const char* name, std::string& error) {
+  auto it = object.FindMember(name);
+  if (it == object.MemberEnd()) {
+    return nullptr;
+  }
+  if (!it->value.IsObject()) {
+    error = std::string("\"") + name + "\" must be an object";
+    return nullptr;
+  }
+  return &it->value;
+}
+
+bool readPlay(const rapidjson::Value& step, PlayConfig& play, std::string& error) {
+  if (!readSeconds(step, "seconds", play.duration, error)) {
+    return false;
+  }
+
+  if (const rapidjson::Value* matchData = findObject(step, "matchData", error)) {
+    if (!readNumber(*matchData, "hz", play.matchDataHz, error) ||
+        !readCount(*matchData, "bytes", play.matchDataBytes, error)) {
+      return false;
+    }
+    if (play.matchDataBytes < 8) {
+      error = "match data needs at least 8 bytes for the send time";
+      return false;
+    }
+  }
+
+  if (const rapidjson::Value* chat = findObject(step, "chat", error)) {
+    if (!readMs(*chat, "intervalMs", play.chatInterval, error) || !readCount(*chat, "bytes", play.chatBytes, error)) {
+      return false;
+    }
+  }
+
+  if (const rapidjson::Value* storage = findObject(step, "storage", error)) {
+    if (!readMs(*storage, "intervalMs", play.storageInterval, error) ||
+        !readCount(*storage, "objects", play.storageObjects, error) ||
+        !readCount(*storage, "bytes", play.storageBytes, error)) {
+      return false;
+    }
+    if (play.storageObjects == 0) {
+      error = "storage needs at least one object";
+      return false;
+    }
+  }
+
+  if (const rapidjson::Value* rpc = findObject(step, "rpc", error)) {
+    if (!readString(*rpc, "id", play.rpcId, error) || !readMs(*rpc, "intervalMs", play.rpcInterval, error) ||
+        !readCount(*rpc, "bytes", play.rpcBytes, error) || !readBool(*rpc, "realtime", play.rpcRealtime, error)) {
+      return false;
+    }
+  }
+
+  return error.empty();
+}
+
+bool kindFromName(const std::string& name, StepKind& kind) {
+  static const std::pair<const char*, StepKind> kinds[] = {
+      {"authenticate", StepKind::Authenticate},
+      {"connect", StepKind::Connect},
+      {"joinMatch", StepKind::JoinMatch},
+      {"leaveMatch", StepKind::LeaveMatch},
+      {"joinChat", StepKind::JoinChat},
+      {"leaveChat", StepKind::LeaveChat},
+      {"play", StepKind::Play},
+      {"sleep", StepKind::Sleep},
+      {"disconnect", StepKind::Disconnect},
+  };
+
+  for (const auto& entry : kinds) {
+    if (name == entry.first) {
+      kind = entry.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+// What a bot has at a point of the scenario.
+struct BotState {
+  bool authenticated = false;
+  bool connected = false;
+  bool inMatch = false;
+  bool inChat = false;
+};
+
+const char* checkOrder(const Step& step, BotState& state) {
+  switch (step.kind) {
+  case StepKind::Authenticate:
+    if (state.authenticated) {
+      return "already authenticated";
+    }
+    state.authenticated = true;
+    break;
+  case StepKind::Connect:
+    if (!state.authenticated || state.connected) {
+      return "connect needs to be authenticated and not connected";
+    }
+    state.connected = true;
+    break;
+  case StepKind::JoinMatch:
+    if (!state.connected || state.inMatch) {
+      return "joinMatch needs to be connected and not in a match";
+    }
+    state.inMatch = true;
+    break;
+  case StepKind::LeaveMatch:
+    if (!state.inMatch) {
+      return "leaveMatch needs to be in a match";
+    }
+    state.inMatch = false;
+    break;
+  case StepKind::JoinChat:
+    if (!state.connected || state.inChat) {
+      return "joinChat needs to be connected and not in a chat room";
+    }
+    state.inChat = true;
+    break;
+  case StepKind::LeaveChat:
+    if (!state.inChat) {
+      return "leaveChat needs to be in a chat room";
+    }
+    state.inChat = false;
+    break;
+  case StepKind::Play: {
+    const PlayConfig& play = step.play;
+    if (play.duration.count() <= 0) {
+      return "play needs a duration";
+    }
+    if (play.matchDataHz > 0 && !state.inMatch) {
+      return "match data needs to be in a match";
+    }
+    if (play.chatInterval.count() > 0 && !state.inChat) {
+      return "chat needs to be in a chat room";
+    }
+    if ((play.storageInterval.count() > 0 || play.rpcInterval.count() > 0) && !state.authenticated) {
+      return "storage and RPC need to be authenticated";
+    }
+    if (play.rpcInterval.count() > 0 && play.rpcRealtime && !state.connected) {
+      return "realtime RPC needs to be connected";
+    }
+    break;
+  }
+  case StepKind::Sleep:
+    break;
+  case StepKind::Disconnect:
+    if (!state.connected) {
+      return "disconnect needs to be connected";
+    }
+    state.connected = state.inMatch = state.inChat = false;
+    break;
+  }
+  return nullptr;
+}
+
+bool readStep(const rapidjson::Value& value, Step& step, size_t& matchSize, std::string& error) {
+  if (!value.IsObject()) {
+    error = "must be an object";
+    return false;
+  }
+
+  std::string type;
+  if (!readString(value, "type", type, error)) {
+    return false;
+  }
+  if (!kindFromName(type, step.kind)) {
+    error = "unknown type \"" + type + "\"";
+    return false;
+  }
+
+  switch (step.kind) {
+  case StepKind::JoinMatch: {
+    size_t size = 2;
+    if (!readCount(value, "size", size, error)) {
+      return false;
+    }
+    // bots are grouped once, by the match size
+    if (size == 0 || (matchSize != 0 && size != matchSize)) {
+      error = "all matches need the same size, at least 1";
+      return false;
+    }
+    matchSize = size;
+    return true;
+  }
+  case StepKind::JoinChat:
+    step.room = "loadgen";
+    return readString(value, "room", step.room, error);
+  case StepKind::Play:
+    return readPlay(value, step.play, error);
+  case StepKind::Sleep:
+    return readMs(value, "ms", step.duration, error);
+  default:
+    return true;
+  }
+}
+
+} // namespace
+
+bool parseScenario(const std::string& json, Scenario& scenario, std::string& error) {
+  rapidjson::Document document;
+  if (document.Parse(json.c_str(), json.size()).HasParseError()) {
+    error = std::string(rapidjson::GetParseError_En(document.GetParseError())) + " at offset " +
+            std::to_string(document.GetErrorOffset());
+    return false;
+  }
+  if (!document.IsObject()) {
+    error = "a scenario must be an object";
+    return false;
+  }
+
+  std::string protocol = "protobuf";
+  if (!readString(document, "name", scenario.name, error) || !readCount(document, "bots", scenario.bots, error) ||
+      !readSeconds(document, "rampUpSeconds", scenario.rampUp, error) ||
+      !readCount(document, "ioThreads", scenario.ioThreads, error) ||
+      !readCount(document, "reactorThreads", scenario.reactorThreads, error) ||
+      !readMs(document, "tickMs", scenario.tickInterval, error) ||
+      !readDuration(document, "reportSeconds", 1.0, scenario.reportInterval, error) ||
+      !readString(document, "protocol", protocol, error) ||
+      !readString(document, "idPrefix", scenario.idPrefix, error)) {
+    return false;
+  }
+  if (scenario.bots == 0 || scenario.ioThreads == 0 || scenario.tickInterval.count() <= 0) {
+    error = "bots, ioThreads and tickMs must be positive";
+    return false;
+  }
+
+  if (protocol == "protobuf") {
+    scenario.protocol = NRtClientProtocol::Protobuf;
+  } else if (protocol == "json") {
+    scenario.protocol = NRtClientProtocol::Json;
+  } else {
+    error = "protocol must be \"protobuf\" or \"json\"";
+    return false;
+  }
+
+  if (const rapidjson::Value* server = findObject(document, "server", error)) {
+    size_t port = static_cast<size_t>(scenario.server.port);
+    if (!readString(*server, "host", scenario.server.host, error) || !readCount(*server, "port", port, error) ||
+        !readString(*server, "serverKey", scenario.server.serverKey, error) ||
+        !readBool(*server, "ssl", scenario.server.ssl, error) ||
+        !readMs(*server, "timeoutMs", scenario.server.timeout, error)) {
+      return false;
+    }
+    scenario.server.port = static_cast<int32_t>(port);
+  } else if (!error.empty()) {
+    return false;
+  }
+
+  auto steps = document.FindMember("steps");
+  if (steps == document.MemberEnd() || !steps->value.IsArray() || steps->value.Empty()) {
+    error = "\"steps\" must be a non-empty array";
+    return false;
+  }
+
+  BotState state;
+  size_t matchSize = 0;
+  for (const rapidjson::Value& value : steps->value.GetArray()) {
+    Step step;
+    const char* orderError = nullptr;
+    if (!readStep(value, step, matchSize, error) || (orderError = checkOrder(step, state))) {
+      if (orderError) {
+        error = orderError;
+      }
+      error = "step " + std::to_string(scenario.steps.size() + 1) + ": " + error;
+      return false;
+    }
+    scenario.steps.push_back(std::move(step));
+  }
+  scenario.matchSize = matchSize ? matchSize : 1;
+
+  return true;
+}
+
+} // namespace LoadGen
+} // namespace Nakama
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <nakama-cpp/ClientFactory.h>
+#include <nakama-cpp/realtime/NRtClientInterface.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Nakama {
+namespace LoadGen {
+
+enum class StepKind {
+  Authenticate, ///< custom id authentication, creating the account
+  Connect,      ///< realtime socket
+  JoinMatch,    ///< relayed match, created by the first bot of each group
+  LeaveMatch,
+  JoinChat, ///< chat room
+  LeaveChat,
+  Play, ///< periodic traffic for a while, see PlayConfig
+  Sleep,
+  Disconnect,
+};
+
+// What a bot does during a play step, each activity runs on its own schedule. 0 disables an activity.
+// Chat, storage and RPC sizes are of the filler in a {"data":"xx..."} JSON payload.
+struct PlayConfig {
+  std::chrono::milliseconds duration{0};
+
+  double matchDataHz = 0;      ///< match data messages per second, needs a joined match
+  size_t matchDataBytes = 64;  ///< at least 8, the send time goes first
+
+  std::chrono::milliseconds chatInterval{0}; ///< needs a joined chat room
+  size_t chatBytes = 32;
+
+  std::chrono::milliseconds storageInterval{0}; ///< writes the objects, then reads them back
+  size_t storageObjects = 1;
+  size_t storageBytes = 256;
+
+  std::chrono::milliseconds rpcInterval{0};
+  std::string rpcId = "echo";
+  size_t rpcBytes = 32;
+  bool rpcRealtime = false; ///< over the socket instead of HTTP
+};
+
+struct Step {
+  StepKind kind = StepKind::Sleep;
+  std::chrono::milliseconds duration{0}; ///< of a sleep
+  std::string room;                      ///< of a chat room
+  PlayConfig play;
+};
+
+struct Scenario {
+  std::string name = "scenario";
+  size_t bots = 1;
+  std::chrono::milliseconds rampUp{0}; ///< bots are started evenly over this time
+  size_t ioThreads = 1;
+  size_t reactorThreads = 0; ///< threads of a shared websocket event loop, 0 gives every socket its own thread
+  std::chrono::milliseconds tickInterval{5}; ///< of every bot, like the frame time of a game
+  std::chrono::seconds reportInterval{5};
+
+  NClientParameters server;
+  NRtClientProtocol protocol = NRtClientProtocol::Protobuf;
+
+  std::string idPrefix = "loadgen"; ///< custom ids are prefix-index, reruns reuse the accounts
+  size_t matchSize = 1;             ///< players per match, bots are grouped by it
+  std::vector<Step> steps;
+};
+
+/**
+ * Parse a scenario file.
+ *
+ * Steps are checked for order, e.g. a match can only be joined when connected.
+ *
+ * @return false with a description in `error` if the file is not a valid scenario.
+ */
+bool parseScenario(const std::string& json, Scenario& scenario, std::string& error);
+
+} // namespace LoadGen
+} // namespace Nakama
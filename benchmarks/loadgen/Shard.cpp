@@ -0,0 +1,118 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Shard.h"
+#include "Bot.h"
+
+#include <nakama-cpp/ClientFactory.h>
+
+namespace Nakama {
+namespace LoadGen {
+
+Shard::Shard(
+    const Scenario& scenario, size_t index, Clock::time_point start, LiveCounters& live, NRtReactorPtr reactor)
+    : _scenario(scenario), _index(index), _start(start), _live(live), _reactor(std::move(reactor)) {}
+
+Shard::~Shard() { stop(); }
+
+void Shard::start() { _thread = std::thread([this]() { run(); }); }
+
+void Shard::stop() {
+  _stopRequested = true;
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+void Shard::run() {
+  // clients are created on the shard thread, which is the only one to touch them
+  _httpTransport = createDefaultHttpTransport(_scenario.server.platformParams);
+
+  // whole match groups, round robin, started evenly over the ramp up
+  const size_t groupSize = _scenario.matchSize;
+  for (size_t i = 0; i < _scenario.bots; i++) {
+    if ((i / groupSize) % _scenario.ioThreads == _index) {
+      auto startAt = _start + _scenario.rampUp * i / _scenario.bots;
+      _bots.push_back(std::make_unique<Bot>(*this, i, startAt));
+    }
+  }
+
+  Clock::time_point frame = Clock::now();
+  while (!_stopRequested) {
+    Clock::time_point now = Clock::now();
+    _httpTransport->tick();
+
+    bool running = false;
+    for (auto& bot : _bots) {
+      bot->tick(now);
+      running = running || !bot->stopped();
+    }
+
+    if (!running) {
+      _finished.store(true, std::memory_order_release);
+    }
+
+    // a fixed frame rate, a late frame is not made up for
+    frame += _scenario.tickInterval;
+    if (frame < now) {
+      frame = now;
+    } else {
+      std::this_thread::sleep_until(frame);
+    }
+  }
+
+  for (auto& bot : _bots) {
+    bot->stop();
+  }
+  _bots.clear();
+  _httpTransport.reset();
+}
+
+void Shard::record(Op op, Clock::time_point start) {
+  _stats[op].record(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start));
+  LiveCounters::add(_live.completed);
+}
+
+void Shard::error(Op op, const std::string& message) {
+  _stats.error(op, message);
+  LiveCounters::add(_live.errors);
+}
+
+void Shard::matchDataSent(size_t bytes) {
+  _stats.matchDataSent++;
+  _stats.bytesSent += bytes;
+  LiveCounters::add(_live.matchDataSent);
+}
+
+void Shard::matchDataReceived(size_t bytes, Clock::time_point sent) {
+  _stats[Op::MatchData].record(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sent));
+  _stats.bytesReceived += bytes;
+  LiveCounters::add(_live.matchDataReceived);
+}
+
+void Shard::botStarted() { _live.botsStarted.fetch_add(1, std::memory_order_relaxed); }
+
+void Shard::botStopped(bool failed) {
+  if (failed) {
+    _stats.botsFailed++;
+  } else {
+    _stats.botsFinished++;
+  }
+  _live.botsStopped.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace LoadGen
+} // namespace Nakama
@@ -0,0 +1,102 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "LoadStats.h"
+#include "Scenario.h"
+
+#include <nakama-cpp/NHttpTransportInterface.h>
+#include <nakama-cpp/realtime/NRtReactor.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Nakama {
+namespace LoadGen {
+
+class Bot;
+
+// Bots playing together, the first one creates the matches. Always on one shard.
+struct MatchGroup {
+  std::map<size_t, std::string> matchIds; ///< by index of the joinMatch step
+  bool leaderStopped = false;             ///< nobody is going to create a match
+};
+
+/**
+ * Bots of one I/O thread. They share an HTTP transport and are ticked in turn, so nothing in a shard
+ * needs locking. Bots are assigned to shards by match group, bots of a match are on the same shard.
+ */
+class Shard {
+public:
+  Shard(
+      const Scenario& scenario, size_t index, Clock::time_point start, LiveCounters& live, NRtReactorPtr reactor);
+  ~Shard();
+
+  Shard(const Shard&) = delete;
+  Shard& operator=(const Shard&) = delete;
+
+  void start();
+
+  // Stops the bots which are still running and joins the thread.
+  void stop();
+
+  // All bots have stopped on their own.
+  bool finished() const { return _finished.load(std::memory_order_acquire); }
+
+  // Valid once stopped.
+  const LoadStats& stats() const { return _stats; }
+
+  // for bots, on the shard thread
+
+  const Scenario& scenario() const { return _scenario; }
+  NHttpTransportPtr httpTransport() const { return _httpTransport; }
+  const NRtReactorPtr& reactor() const { return _reactor; } ///< shared by all shards, null without one
+  MatchGroup& group(size_t botIndex) { return _groups[botIndex / _scenario.matchSize]; }
+
+  void record(Op op, Clock::time_point start);
+  void error(Op op, const std::string& message);
+  void matchDataSent(size_t bytes);
+  void matchDataReceived(size_t bytes, Clock::time_point sent);
+  void botStarted();
+  void botStopped(bool failed);
+
+private:
+  void run();
+
+  const Scenario& _scenario;
+  const size_t _index;
+  const Clock::time_point _start;
+  LiveCounters& _live;
+  const NRtReactorPtr _reactor;
+
+  NHttpTransportPtr _httpTransport;
+  std::vector<std::unique_ptr<Bot>> _bots;
+  std::unordered_map<size_t, MatchGroup> _groups;
+  LoadStats _stats;
+
+  std::thread _thread;
+  std::atomic<bool> _stopRequested{false};
+  std::atomic<bool> _finished{false};
+};
+
+} // namespace LoadGen
+} // namespace Nakama
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <nakama-cpp/NHttpTransportInterface.h>
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace Nakama {
+namespace LoadGen {
+
+/**
+ * One bot's view of the HTTP transport of its shard, so that all bots of a shard share one curl multi
+ * handle with its connection pool instead of opening sockets of their own.
+ *
+ * The shard ticks the shared transport, tick() of a view does nothing. cancelAllRequests() only cancels
+ * the requests of this view: their callbacks are called with CANCELLED_BY_USER right away, and dropped
+ * when the shared transport completes them later. Not thread safe, like the rest of a shard.
+ */
+class SharedHttpTransport : public NHttpTransportInterface {
+public:
+  explicit SharedHttpTransport(NHttpTransportPtr shared) : _shared(std::move(shared)) {}
+
+  void setBaseUri(const std::string& uri) override { _shared->setBaseUri(uri); }
+  void setTimeout(std::chrono::milliseconds time) override { _shared->setTimeout(time); }
+  void tick() override {}
+
+  void request(const NHttpRequest& req, const NHttpResponseCallback& callback) override {
+    uint64_t id = _nextId++;
+    _pending->emplace(id, callback);
+
+    // the shared transport may outlive this view, hence the weak reference
+    std::weak_ptr<Pending> pending = _pending;
+    _shared->request(req, [pending, id](NHttpResponsePtr response) {
+      auto requests = pending.lock();
+      if (!requests) {
+        return;
+      }
+
+      auto it = requests->find(id);
+      if (it == requests->end()) {
+        return; // cancelled
+      }
+
+      NHttpResponseCallback callback = std::move(it->second);
+      requests->erase(it);
+      if (callback) {
+        callback(response);
+      }
+    });
+  }
+
+  void cancelAllRequests() override {
+    Pending cancelled;
+    cancelled.swap(*_pending);
+
+    for (auto& [id, callback] : cancelled) {
+      if (callback) {
+        auto response = std::make_shared<NHttpResponse>();
+        response->statusCode = InternalStatusCodes::CANCELLED_BY_USER;
+        response->errorMessage = "cancelled by user";
+        callback(response);
+      }
+    }
+  }
+
+private:
+  using Pending = std::unordered_map<uint64_t, NHttpResponseCallback>;
+
+  NHttpTransportPtr _shared;
+  std::shared_ptr<Pending> _pending = std::make_shared<Pending>();
+  uint64_t _nextId = 0;
+};
+
+} // namespace LoadGen
+} // namespace Nakama
@@ -0,0 +1,419 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Runs many simulated players against a Nakama server, or the in-process mock server, following a scenario
+// file, see scenarios/. Prints a progress line to stderr every reportSeconds and a JSON report with latency
+// percentiles and throughput of every operation at the end, or on SIGINT. Exits with 2 if bots failed.
+//
+// usage: nakama-loadgen SCENARIO.json [--bots N] [--io-threads N] [--reactor-threads N] [--host HOST] [--port N]
+//                       [--duration SECONDS] [--report FILE] [--mock]
+
+#include "LoadStats.h"
+#include "Scenario.h"
+#include "Shard.h"
+
+#include <nakama-cpp/realtime/NWebsocketsFactory.h>
+
+#ifdef WITH_MOCK_SERVER
+#include "MockServer.h"
+#endif
+
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace Nakama::LoadGen;
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+void onSignal(int) { g_stop = true; }
+
+struct Options {
+  std::string scenarioPath;
+  std::string reportPath;
+  std::chrono::seconds duration{0}; ///< 0 for until all bots have stopped
+  bool mock = false;
+};
+
+bool readFile(const std::string& path, std::string& content) {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+  std::ostringstream stream;
+  stream << file.rdbuf();
+  content = stream.str();
+  return true;
+}
+
+int usage() {
+  std::fprintf(
+      stderr, "usage: nakama-loadgen SCENARIO.json [--bots N] [--io-threads N] [--reactor-threads N] [--host HOST]\n"
+              "                      [--port N] [--duration SECONDS] [--report FILE] [--mock]\n");
+  return 1;
+}
+
+// Threads of this process, 0 where unknown.
+int threadCount() {
+#ifdef __linux__
+  std::ifstream status("/proc/self/status");
+  std::string line;
+  while (std::getline(status, line)) {
+    if (line.compare(0, 8, "Threads:") == 0) {
+      return std::atoi(line.c_str() + 8);
+    }
+  }
+#endif
+  return 0;
+}
+
+struct ProcessStats {
+  int peakThreads = 0;
+  int64_t maxRssKb = 0;
+  double userCpuSeconds = 0;
+  double systemCpuSeconds = 0;
+};
+
+void readResourceUsage(ProcessStats& stats) {
+#ifndef _WIN32
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    stats.maxRssKb = usage.ru_maxrss / 1024;
+#else
+    stats.maxRssKb = usage.ru_maxrss;
+#endif
+    stats.userCpuSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+    stats.systemCpuSeconds = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+  }
+#else
+  (void)stats;
+#endif
+}
+
+void printProgress(double elapsed, const LiveCounters& live, const Scenario& scenario, double rate[3], int threads) {
+  uint32_t started = live.botsStarted.load(std::memory_order_relaxed);
+  uint32_t stopped = live.botsStopped.load(std::memory_order_relaxed);
+  std::fprintf(
+      stderr,
+      "[%7.1fs] bots %u/%zu started, %u stopped | ops %.0f/s, errors %llu | match data out %.0f/s, in %.0f/s"
+      " | threads %d\n",
+      elapsed, started, scenario.bots, stopped, rate[0],
+      static_cast<unsigned long long>(live.errors.load(std::memory_order_relaxed)), rate[1], rate[2], threads);
+}
+
+using Writer = rapidjson::PrettyWriter<rapidjson::StringBuffer>;
+
+void writeOp(Writer& writer, const OpStats& op, double elapsed) {
+  const auto& latency = op.latency;
+  writer.StartObject();
+  writer.Key("count");
+  writer.Uint64(latency.count);
+  writer.Key("errors");
+  writer.Uint64(op.errors);
+  writer.Key("perSecond");
+  writer.Double(latency.count / elapsed);
+  if (latency.count > 0) {
+    writer.Key("meanUs");
+    writer.Double(latency.meanUs());
+    writer.Key("minUs");
+    writer.Uint64(latency.minUs);
+    writer.Key("p50Us");
+    writer.Uint64(latency.percentileUs(50));
+    writer.Key("p90Us");
+    writer.Uint64(latency.percentileUs(90));
+    writer.Key("p99Us");
+    writer.Uint64(latency.percentileUs(99));
+    writer.Key("p999Us");
+    writer.Uint64(latency.percentileUs(99.9));
+    writer.Key("maxUs");
+    writer.Uint64(latency.maxUs);
+  }
+  writer.EndObject();
+}
+
+std::string report(
+    const Scenario& scenario, const LoadStats& stats, uint32_t botsStarted, double elapsed, const ProcessStats& process,
+    const std::string& server) {
+  rapidjson::StringBuffer buffer;
+  Writer writer(buffer);
+
+  writer.StartObject();
+  writer.Key("scenario");
+  writer.String(scenario.name.c_str());
+  writer.Key("server");
+  writer.String(server.c_str());
+  writer.Key("ioThreads");
+  writer.Uint64(scenario.ioThreads);
+  writer.Key("reactorThreads");
+  writer.Uint64(scenario.reactorThreads);
+  writer.Key("tickMs");
+  writer.Int64(scenario.tickInterval.count());
+  writer.Key("protocol");
+  writer.String(scenario.protocol == Nakama::NRtClientProtocol::Json ? "json" : "protobuf");
+  writer.Key("elapsedSeconds");
+  writer.Double(elapsed);
+
+  writer.Key("bots");
+  writer.StartObject();
+  writer.Key("total");
+  writer.Uint64(scenario.bots);
+  writer.Key("started");
+  writer.Uint(botsStarted);
+  writer.Key("finished");
+  writer.Uint64(stats.botsFinished);
+  writer.Key("failed");
+  writer.Uint64(stats.botsFailed);
+  writer.Key("interrupted");
+  writer.Uint64(scenario.bots - stats.botsFinished - stats.botsFailed);
+  writer.EndObject();
+
+  writer.Key("operations");
+  writer.StartObject();
+  for (size_t i = 0; i < kOpCount; i++) {
+    const OpStats& op = stats.ops[i];
+    if (op.latency.count > 0 || op.errors > 0) {
+      writer.Key(opName(static_cast<Op>(i)));
+      writeOp(writer, op, elapsed);
+    }
+  }
+  writer.EndObject();
+
+  const uint64_t received = stats[Op::MatchData].latency.count;
+  writer.Key("matchData");
+  writer.StartObject();
+  writer.Key("sent");
+  writer.Uint64(stats.matchDataSent);
+  writer.Key("received");
+  writer.Uint64(received);
+  writer.Key("sentPerSecond");
+  writer.Double(stats.matchDataSent / elapsed);
+  writer.Key("receivedPerSecond");
+  writer.Double(received / elapsed);
+  writer.Key("bytesSent");
+  writer.Uint64(stats.bytesSent);
+  writer.Key("bytesReceived");
+  writer.Uint64(stats.bytesReceived);
+  writer.EndObject();
+
+  writer.Key("errors");
+  writer.StartObject();
+  for (const auto& [message, count] : stats.errorMessages) {
+    writer.Key(message.c_str());
+    writer.Uint64(count);
+  }
+  writer.EndObject();
+
+  writer.Key("process");
+  writer.StartObject();
+  writer.Key("peakThreads");
+  writer.Int(process.peakThreads);
+  writer.Key("maxRssKb");
+  writer.Int64(process.maxRssKb);
+  writer.Key("userCpuSeconds");
+  writer.Double(process.userCpuSeconds);
+  writer.Key("systemCpuSeconds");
+  writer.Double(process.systemCpuSeconds);
+  writer.EndObject();
+
+  writer.EndObject();
+  return std::string(buffer.GetString(), buffer.GetSize()) + "\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  if (argc < 2 || argv[1][0] == '-') {
+    return usage();
+  }
+
+  Options options;
+  options.scenarioPath = argv[1];
+
+  std::string json, error;
+  Scenario scenario;
+  if (!readFile(options.scenarioPath, json)) {
+    std::fprintf(stderr, "unable to read %s\n", options.scenarioPath.c_str());
+    return 1;
+  }
+  if (!parseScenario(json, scenario, error)) {
+    std::fprintf(stderr, "%s: %s\n", options.scenarioPath.c_str(), error.c_str());
+    return 1;
+  }
+
+  for (int i = 2; i < argc; i++) {
+    const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (!std::strcmp(argv[i], "--mock")) {
+      options.mock = true;
+      continue;
+    }
+    if (!value) {
+      return usage();
+    }
+    if (!std::strcmp(argv[i], "--bots")) {
+      scenario.bots = static_cast<size_t>(std::atoll(value));
+    } else if (!std::strcmp(argv[i], "--io-threads")) {
+      scenario.ioThreads = static_cast<size_t>(std::atoll(value));
+    } else if (!std::strcmp(argv[i], "--reactor-threads")) {
+      scenario.reactorThreads = static_cast<size_t>(std::atoll(value));
+    } else if (!std::strcmp(argv[i], "--host")) {
+      scenario.server.host = value;
+    } else if (!std::strcmp(argv[i], "--port")) {
+      scenario.server.port = std::atoi(value);
+    } else if (!std::strcmp(argv[i], "--duration")) {
+      options.duration = std::chrono::seconds(std::atoll(value));
+    } else if (!std::strcmp(argv[i], "--report")) {
+      options.reportPath = value;
+    } else {
+      std::fprintf(stderr, "unknown option %s\n", argv[i]);
+      return usage();
+    }
+    i++;
+  }
+  if (scenario.bots == 0 || scenario.ioThreads == 0) {
+    std::fprintf(stderr, "bots and I/O threads must be positive\n");
+    return 1;
+  }
+
+#ifdef WITH_MOCK_SERVER
+  std::unique_ptr<Nakama::Test::MockServer> mockServer;
+  if (options.mock) {
+    mockServer = std::make_unique<Nakama::Test::MockServer>();
+    if (!mockServer->start()) {
+      std::fprintf(stderr, "unable to start the mock server\n");
+      return 1;
+    }
+    scenario.server.host = "127.0.0.1";
+    scenario.server.port = mockServer->port();
+    scenario.server.ssl = false;
+  }
+#else
+  if (options.mock) {
+    std::fprintf(stderr, "built without the mock server\n");
+    return 1;
+  }
+#endif
+
+  const std::string server = options.mock ? "mock" : scenario.server.host + ":" + std::to_string(scenario.server.port);
+  std::fprintf(
+      stderr, "%s: %zu bots on %zu I/O threads against %s\n", scenario.name.c_str(), scenario.bots,
+      scenario.ioThreads, server.c_str());
+
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+
+  Nakama::NRtReactorPtr reactor;
+  if (scenario.reactorThreads > 0) {
+    Nakama::NRtReactorConfig config;
+    config.threads = scenario.reactorThreads;
+    reactor = Nakama::createRtReactor(config);
+    if (!reactor) {
+      std::fprintf(stderr, "the websocket transport has no reactor, sockets run their own threads\n");
+    }
+  }
+
+  LiveCounters live;
+  const Clock::time_point start = Clock::now();
+  std::vector<std::unique_ptr<Shard>> shards;
+  for (size_t i = 0; i < scenario.ioThreads; i++) {
+    shards.push_back(std::make_unique<Shard>(scenario, i, start, live, reactor));
+    shards.back()->start();
+  }
+
+  ProcessStats process;
+  Clock::time_point nextReport = start + scenario.reportInterval;
+  uint64_t lastCompleted = 0, lastSent = 0, lastReceived = 0;
+  Clock::time_point lastReport = start;
+
+  while (!g_stop) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    Clock::time_point now = Clock::now();
+    process.peakThreads = std::max(process.peakThreads, threadCount());
+
+    bool finished = true;
+    for (const auto& shard : shards) {
+      finished = finished && shard->finished();
+    }
+    if (finished || (options.duration.count() > 0 && now - start >= options.duration)) {
+      break;
+    }
+
+    if (now >= nextReport) {
+      const double seconds = std::chrono::duration<double>(now - lastReport).count();
+      const uint64_t completed = live.completed.load(std::memory_order_relaxed);
+      const uint64_t sent = live.matchDataSent.load(std::memory_order_relaxed);
+      const uint64_t received = live.matchDataReceived.load(std::memory_order_relaxed);
+      double rate[3] = {
+          (completed - lastCompleted) / seconds, (sent - lastSent) / seconds, (received - lastReceived) / seconds};
+
+      printProgress(std::chrono::duration<double>(now - start).count(), live, scenario, rate, threadCount());
+      lastCompleted = completed;
+      lastSent = sent;
+      lastReceived = received;
+      lastReport = now;
+      nextReport += scenario.reportInterval;
+    }
+  }
+
+  const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+  for (auto& shard : shards) {
+    shard->stop();
+  }
+
+  LoadStats stats;
+  for (const auto& shard : shards) {
+    stats.merge(shard->stats());
+  }
+  readResourceUsage(process);
+
+  std::string output =
+      report(scenario, stats, live.botsStarted.load(std::memory_order_relaxed), elapsed, process, server);
+  if (options.reportPath.empty()) {
+    std::fputs(output.c_str(), stdout);
+  } else {
+    std::ofstream file(options.reportPath, std::ios::binary);
+    file << output;
+    if (!file) {
+      std::fprintf(stderr, "unable to write %s\n", options.reportPath.c_str());
+      return 1;
+    }
+  }
+
+#ifdef WITH_MOCK_SERVER
+  if (mockServer) {
+    mockServer->stop();
+  }
+#endif
+
+  return stats.botsFailed > 0 ? 2 : 0;
+}
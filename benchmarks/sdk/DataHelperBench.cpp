@@ -0,0 +1,124 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SdkBench.h"
+
+#include "DataHelper.h"
+
+#include <benchmark/benchmark.h>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+using ::nakama::realtime::Envelope;
+
+// Converts an already parsed message into a fresh SDK type per iteration, like the callbacks do.
+template <class Output, class Input, class Convert>
+void registerAssign(const std::string& name, const Input& input, Convert convert) {
+  benchmark::RegisterBenchmark(("DataHelper/" + name).c_str(), [input, convert](benchmark::State& state) {
+    for (auto _ : state) {
+      Output output;
+      convert(output, input);
+      benchmark::DoNotOptimize(output);
+    }
+  });
+}
+
+template <class Output, class Input> void registerRest(const std::string& name) {
+  Input input;
+  parseFixture("rest/" + name + ".json", input);
+  registerAssign<Output>(name, input, [](Output& output, const Input& data) { assign(output, data); });
+}
+
+} // namespace
+
+void registerDataHelperBenchmarks() {
+  auto rt = [](const std::string& name) {
+    Envelope envelope;
+    parseFixture("rt/" + name + ".json", envelope);
+    return envelope;
+  };
+
+  Envelope matchData = rt("match_data");
+  registerAssign<NMatchData>(
+      "match_data", matchData, [](NMatchData& out, const Envelope& in) { assign(out, in.match_data()); });
+  registerAssign<NMatchData>(
+      "match_data/interned", matchData, [](NMatchData& out, const Envelope& in) {
+        assignInterned(out, in.match_data());
+      });
+
+  Envelope matchPresence = rt("match_presence_event");
+  registerAssign<NMatchPresenceEvent>(
+      "match_presence_event", matchPresence,
+      [](NMatchPresenceEvent& out, const Envelope& in) { assign(out, in.match_presence_event()); });
+  registerAssign<NMatchPresenceEvent>(
+      "match_presence_event/interned", matchPresence,
+      [](NMatchPresenceEvent& out, const Envelope& in) { assignInterned(out, in.match_presence_event()); });
+
+  registerAssign<NMatch>("match", rt("match"), [](NMatch& out, const Envelope& in) { assign(out, in.match()); });
+
+  Envelope channelMessage = rt("channel_message");
+  registerAssign<NChannelMessage>(
+      "channel_message", channelMessage,
+      [](NChannelMessage& out, const Envelope& in) { assign(out, in.channel_message()); });
+  registerAssign<NChannelMessage>(
+      "channel_message/interned", channelMessage,
+      [](NChannelMessage& out, const Envelope& in) { assignInterned(out, in.channel_message()); });
+
+  Envelope channelPresence = rt("channel_presence_event");
+  registerAssign<NChannelPresenceEvent>(
+      "channel_presence_event", channelPresence,
+      [](NChannelPresenceEvent& out, const Envelope& in) { assign(out, in.channel_presence_event()); });
+  registerAssign<NChannelPresenceEvent>(
+      "channel_presence_event/interned", channelPresence,
+      [](NChannelPresenceEvent& out, const Envelope& in) { assignInterned(out, in.channel_presence_event()); });
+
+  registerAssign<NNotificationList>(
+      "notifications", rt("notifications"),
+      [](NNotificationList& out, const Envelope& in) { assign(out, in.notifications()); });
+
+  Envelope statusPresence = rt("status_presence_event");
+  registerAssign<NStatusPresenceEvent>(
+      "status_presence_event", statusPresence,
+      [](NStatusPresenceEvent& out, const Envelope& in) { assign(out, in.status_presence_event()); });
+  registerAssign<NStatusPresenceEvent>(
+      "status_presence_event/interned", statusPresence,
+      [](NStatusPresenceEvent& out, const Envelope& in) { assignInterned(out, in.status_presence_event()); });
+
+  registerAssign<NMatchmakerMatched>(
+      "matchmaker_matched", rt("matchmaker_matched"),
+      [](NMatchmakerMatched& out, const Envelope& in) { assign(out, in.matchmaker_matched()); });
+
+  Envelope partyData = rt("party_data");
+  registerAssign<NPartyData>(
+      "party_data", partyData, [](NPartyData& out, const Envelope& in) { assign(out, in.party_data()); });
+  registerAssign<NPartyData>(
+      "party_data/interned", partyData,
+      [](NPartyData& out, const Envelope& in) { assignInterned(out, in.party_data()); });
+
+  registerAssign<NRpc>("rpc", rt("rpc"), [](NRpc& out, const Envelope& in) { assign(out, in.rpc()); });
+
+  registerRest<NAccount, nakama::api::Account>("account");
+  registerRest<NStorageObjectList, nakama::api::StorageObjectList>("storage_objects");
+  registerRest<NLeaderboardRecordList, nakama::api::LeaderboardRecordList>("leaderboard_records");
+  registerRest<NChannelMessageList, nakama::api::ChannelMessageList>("channel_messages");
+  registerRest<NFriendList, nakama::api::FriendList>("friends");
+}
+
+} // namespace Bench
+} // namespace Nakama
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// The gRPC client threading modes on loopback: the completion queue polled from tick() against completion
+// threads and a channel pool. A generic in-process server answers every call with a canned api.Rpc
+// message, the client issues `rpc` calls with a fixed number in flight and ticks like a game loop. CPU
+// time is that of the game thread, latency is call to callback, so the tick interval is included.
+
+#include "SdkBench.h"
+
+#include <nakama-cpp/ClientFactory.h>
+#include <nakama-cpp/NClientInterface.h>
+
+#include <grpcpp/generic/async_generic_service.h>
+#include <grpcpp/grpcpp.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+using namespace std::chrono;
+
+constexpr int kCallsPerIteration = 1000;
+constexpr int kInflight = 64;
+constexpr microseconds kFrame(1000);
+constexpr size_t kPayloadSize = 256;
+
+void appendVarint(std::string& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(char(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(char(value));
+}
+
+void appendStringField(std::string& out, int field, const std::string& value) {
+  out.push_back(char(field << 3 | 2));
+  appendVarint(out, value.size());
+  out += value;
+}
+
+// api.Rpc {id = 1, payload = 2}
+std::string makeRpcResponse(size_t payloadSize) {
+  std::string message;
+  appendStringField(message, 1, "bench");
+  appendStringField(message, 2, std::string(payloadSize, 'x'));
+  return message;
+}
+
+// Answers any method with the same serialized message
+class CannedReactor : public grpc::ServerGenericBidiReactor {
+public:
+  explicit CannedReactor(const std::string& response) {
+    grpc::Slice slice(response);
+    _response = grpc::ByteBuffer(&slice, 1);
+    StartRead(&_request);
+  }
+
+  void OnReadDone(bool ok) override {
+    if (ok) {
+      StartWriteAndFinish(&_response, grpc::WriteOptions(), grpc::Status::OK);
+    } else {
+      Finish(grpc::Status::OK);
+    }
+  }
+
+  void OnDone() override { delete this; }
+
+private:
+  grpc::ByteBuffer _request;
+  grpc::ByteBuffer _response;
+};
+
+class CannedService : public grpc::CallbackGenericService {
+public:
+  explicit CannedService(std::string response) : _response(std::move(response)) {}
+
+  grpc::ServerGenericBidiReactor* CreateReactor(grpc::GenericCallbackServerContext*) override {
+    return new CannedReactor(_response);
+  }
+
+private:
+  std::string _response;
+};
+
+// range(0): completion queue threads, 0 polls from tick(), range(1): channels
+void BM_grpcRpc(benchmark::State& state) {
+  CannedService service(makeRpcResponse(kPayloadSize));
+  int port = 0;
+  grpc::ServerBuilder builder;
+  builder.AddListeningPort("127.0.0.1:0", grpc::InsecureServerCredentials(), &port);
+  builder.RegisterCallbackGenericService(&service);
+  std::unique_ptr<grpc::Server> server = builder.BuildAndStart();
+  if (!server || port == 0) {
+    state.SkipWithError("failed to start the stub server");
+    return;
+  }
+
+  // outlive the client, which may fail calls still in flight when it is destroyed
+  std::vector<double> latencies;
+  int sent = 0;
+  int completed = 0;
+  int failed = 0;
+
+  NClientParameters parameters;
+  parameters.host = "127.0.0.1";
+  parameters.port = port;
+  NGrpcClientParameters grpcParameters;
+  grpcParameters.completionThreads = static_cast<uint32_t>(state.range(0));
+  grpcParameters.channels = static_cast<uint32_t>(state.range(1));
+  NClientPtr client = createGrpcClient(parameters, grpcParameters);
+
+  auto send = [&]() {
+    auto start = steady_clock::now();
+    ++sent;
+    client->rpc(
+        "bench",
+        "bench",
+        std::nullopt,
+        [&, start](const NRpc&) {
+          latencies.push_back(double(duration_cast<nanoseconds>(steady_clock::now() - start).count()) / 1000.0);
+          ++completed;
+        },
+        [&](const NError&) {
+          ++failed;
+          ++completed;
+        });
+  };
+
+  for (auto _ : state) {
+    const int target = completed + kCallsPerIteration;
+    while (completed < target) {
+      while (sent < target && sent - completed < kInflight) {
+        send();
+      }
+      client->tick();
+      std::this_thread::sleep_for(kFrame);
+    }
+  }
+
+  client.reset();
+  server->Shutdown();
+
+  std::sort(latencies.begin(), latencies.end());
+  auto percentile = [&](double p) {
+    return latencies.empty() ? 0.0 : latencies[std::min(latencies.size() - 1, size_t(p * latencies.size()))];
+  };
+  state.SetItemsProcessed(completed);
+  state.counters["failed"] = failed;
+  state.counters["p50_us"] = percentile(0.5);
+  state.counters["p99_us"] = percentile(0.99);
+  state.counters["max_us"] = latencies.empty() ? 0.0 : latencies.back();
+}
+BENCHMARK(BM_grpcRpc)
+    ->Name("GrpcClient/rpc")
+    ->ArgNames({"cq_threads", "channels"})
+    ->Args({0, 1})
+    ->Args({1, 1})
+    ->Args({2, 1})
+    ->Args({2, 4})
+    ->UseRealTime();
+
+} // namespace
+
+} // namespace Bench
+} // namespace Nakama
@@ -0,0 +1,210 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Compression ratio and CPU cost of the match data codec per message size. Payloads are synthetic state
+// snapshots (entity ids, positions, velocities) which change a little from message to message, like the
+// data of a realtime match. Every size is compressed without a dictionary and with one trained from
+// separate samples of the same size.
+
+#include "PayloadCodec.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+constexpr int kMessages = 1000;
+constexpr int kDictionarySamples = 1000;
+
+class SnapshotGenerator {
+public:
+  explicit SnapshotGenerator(unsigned seed) : _rng(seed) {}
+
+  NBytes next(size_t size) {
+    std::uniform_int_distribution<int> entity(1, 64);
+    std::uniform_int_distribution<int> coordinate(-2000, 2000);
+    std::uniform_int_distribution<int> velocity(-50, 50);
+    std::uniform_int_distribution<int> health(0, 100);
+    char buf[128];
+
+    NBytes out = "{\"tick\":" + std::to_string(++_tick) + ",\"entities\":[";
+    while (out.size() < size) {
+      int len = std::snprintf(
+          buf,
+          sizeof(buf),
+          "{\"id\":%d,\"pos\":[%d.%d,%d.%d],\"vel\":[%d,%d],\"hp\":%d},",
+          entity(_rng),
+          coordinate(_rng),
+          velocity(_rng) & 7,
+          coordinate(_rng),
+          velocity(_rng) & 7,
+          velocity(_rng),
+          velocity(_rng),
+          health(_rng));
+      out.append(buf, size_t(len));
+    }
+
+    out.resize(size);
+    return out;
+  }
+
+private:
+  std::mt19937 _rng;
+  int _tick = 0;
+};
+
+// A configured codec with the messages of one size and their encoding. Dictionary training takes a while
+// for the larger sizes, so it is done once per size and only for the benchmarks which run.
+struct CodecCase {
+  PayloadCodec codec;
+  std::vector<NBytes> messages;
+  std::vector<NBytes> encoded; // empty for messages sent as they are
+  std::string error;
+  double ratio = 0;
+  double compressed = 0;
+};
+
+CodecCase& codecCase(size_t size, bool withDictionary) {
+  static std::map<std::pair<size_t, bool>, std::unique_ptr<CodecCase>> cases;
+
+  std::unique_ptr<CodecCase>& entry = cases[{size, withDictionary}];
+  if (entry) {
+    return *entry;
+  }
+  entry = std::make_unique<CodecCase>();
+  CodecCase& c = *entry;
+
+  NPayloadCodecConfig config;
+  config.enabled = true;
+  config.minSize = 0;
+  config.level = 1;
+  c.codec.configure(config);
+
+  if (withDictionary) {
+    SnapshotGenerator training(1);
+    std::vector<NBytes> samples;
+    for (int i = 0; i < kDictionarySamples; i++) {
+      samples.push_back(training.next(size));
+    }
+    if (!c.codec.setDictionary("match", trainPayloadDictionary(samples))) {
+      c.error = "dictionary training failed";
+      return c;
+    }
+  }
+
+  SnapshotGenerator generator(2);
+  size_t sent = 0;
+  int compressedCount = 0;
+  NBytes decoded;
+  for (int i = 0; i < kMessages; i++) {
+    c.messages.push_back(generator.next(size));
+    c.encoded.emplace_back();
+    if (c.codec.encode("match", c.messages.back(), c.encoded.back())) {
+      if (!c.codec.decode(c.encoded.back(), decoded) || decoded != c.messages.back()) {
+        c.error = "round trip failed";
+        return c;
+      }
+      sent += c.encoded.back().size();
+      compressedCount++;
+    } else {
+      c.encoded.back().clear();
+      sent += size;
+    }
+  }
+
+  c.ratio = static_cast<double>(size * c.messages.size()) / static_cast<double>(std::max<size_t>(sent, 1));
+  c.compressed = static_cast<double>(compressedCount) / static_cast<double>(c.messages.size());
+  return c;
+}
+
+void setCodecCounters(benchmark::State& state, const CodecCase& c) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * c.messages.front().size()));
+  state.counters["ratio"] = c.ratio;
+  state.counters["compressed"] = c.compressed;
+}
+
+// range(0): message size, range(1): with a trained dictionary
+void BM_payloadEncode(benchmark::State& state) {
+  CodecCase& c = codecCase(static_cast<size_t>(state.range(0)), state.range(1) != 0);
+  if (!c.error.empty()) {
+    state.SkipWithError(c.error.c_str());
+    return;
+  }
+
+  NBytes out;
+  size_t i = 0;
+  for (auto _ : state) {
+    bool ok = c.codec.encode("match", c.messages[i++ % c.messages.size()], out);
+    benchmark::DoNotOptimize(ok);
+  }
+  setCodecCounters(state, c);
+}
+
+// Decodes the messages which were compressed, small ones without a dictionary may not be.
+void BM_payloadDecode(benchmark::State& state) {
+  CodecCase& c = codecCase(static_cast<size_t>(state.range(0)), state.range(1) != 0);
+  if (!c.error.empty()) {
+    state.SkipWithError(c.error.c_str());
+    return;
+  }
+
+  std::vector<const NBytes*> encoded;
+  for (const NBytes& e : c.encoded) {
+    if (!e.empty()) {
+      encoded.push_back(&e);
+    }
+  }
+  if (encoded.empty()) {
+    state.SkipWithError("nothing compressed");
+    return;
+  }
+
+  NBytes out;
+  size_t i = 0;
+  for (auto _ : state) {
+    bool ok = c.codec.decode(*encoded[i++ % encoded.size()], out);
+    benchmark::DoNotOptimize(ok);
+  }
+  setCodecCounters(state, c);
+}
+
+void codecArgs(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"size", "dict"});
+  for (int64_t size : {64, 128, 256, 512, 1024, 4096, 16384}) {
+    b->Args({size, 0});
+    b->Args({size, 1});
+  }
+}
+
+BENCHMARK(BM_payloadEncode)->Name("PayloadCodec/encode")->Apply(codecArgs);
+BENCHMARK(BM_payloadDecode)->Name("PayloadCodec/decode")->Apply(codecArgs);
+
+} // namespace
+
+} // namespace Bench
+} // namespace Nakama
@@ -0,0 +1,156 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SdkBench.h"
+
+#include "DefaultSession.h"
+#include "RestClient.h"
+#include "api/api.pb.h"
+
+#include <benchmark/benchmark.h>
+
+#include <functional>
+#include <memory>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+// Answers every request at once with a canned response, so a call costs what the client does on the game
+// thread: building the request body, the send path, decoding the response and converting it.
+class FixtureTransport : public NHttpTransportInterface {
+public:
+  void setResponse(const std::string& body) {
+    _response = std::make_shared<NHttpResponse>();
+    _response->statusCode = 200;
+    _response->body = body;
+  }
+
+  uint64_t requestBytes() const { return _requestBytes; }
+
+  void setBaseUri(const std::string&) override {}
+  void setTimeout(std::chrono::milliseconds) override {}
+  void tick() override {}
+
+  void request(const NHttpRequest& req, const NHttpResponseCallback& callback) override {
+    _requestBytes += req.body.size();
+    if (callback) {
+      callback(_response);
+    }
+  }
+
+  void cancelAllRequests() override {}
+
+private:
+  NHttpResponsePtr _response;
+  uint64_t _requestBytes = 0;
+};
+
+using Call = std::function<void(RestClient& client, NSessionPtr session, bool& done)>;
+
+void registerCall(const std::string& name, const std::string& response, Call call) {
+  benchmark::RegisterBenchmark(("RestClient/" + name).c_str(), [response, call](benchmark::State& state) {
+    auto transport = std::make_shared<FixtureTransport>();
+    transport->setResponse(fixture("rest/" + response + ".json"));
+    RestClient client(NClientParameters(), transport);
+
+    nakama::api::Session sessionData;
+    parseFixture("rest/session.json", sessionData);
+    NSessionPtr session =
+        std::make_shared<DefaultSession>(sessionData.token(), sessionData.refresh_token(), sessionData.created());
+
+    for (auto _ : state) {
+      bool done = false;
+      call(client, session, done);
+      if (!done) {
+        state.SkipWithError("request didn't complete");
+        break;
+      }
+    }
+
+    if (state.iterations() > 0) {
+      state.counters["request_bytes"] = static_cast<double>(transport->requestBytes() / state.iterations());
+    }
+  });
+}
+
+} // namespace
+
+void registerRestClientBenchmarks() {
+  registerCall("authenticateDevice", "session", [](RestClient& client, NSessionPtr, bool& done) {
+    client.authenticateDevice(
+        "5c6c2ddb-6e36-4a1d-93b8-4b3f7cbd1c9f", std::nullopt, true, {{"platform", "ios"}, {"build", "1.8.2"}},
+        [&done](NSessionPtr session) { done = !session->getUserId().empty(); }, nullptr);
+  });
+
+  registerCall("getAccount", "account", [](RestClient& client, NSessionPtr session, bool& done) {
+    client.getAccount(session, [&done](const NAccount& account) { done = !account.user.id.empty(); }, nullptr);
+  });
+
+  registerCall("writeStorageObjects", "storage_acks", [](RestClient& client, NSessionPtr session, bool& done) {
+    static const std::vector<NStorageObjectWrite> objects = [] {
+      std::vector<NStorageObjectWrite> writes;
+      for (int i = 0; i < 4; i++) {
+        NStorageObjectWrite write;
+        write.collection = "saves";
+        write.key = "slot-" + std::to_string(i);
+        write.value = "{\"level\":" + std::to_string(10 + i) + ",\"checkpoint\":\"zone_3_9\"," +
+                      "\"inventory\":[\"potion\",\"key_3\",\"map\"],\"playtime_sec\":10925}";
+        write.permissionRead = NStoragePermissionRead::OWNER_READ;
+        write.permissionWrite = NStoragePermissionWrite::OWNER_WRITE;
+        writes.push_back(std::move(write));
+      }
+      return writes;
+    }();
+
+    client.writeStorageObjects(
+        session, objects, [&done](const NStorageObjectAcks& acks) { done = acks.size() == objects.size(); }, nullptr);
+  });
+
+  registerCall("listStorageObjects", "storage_objects", [](RestClient& client, NSessionPtr session, bool& done) {
+    client.listStorageObjects(
+        session, "saves", 10, std::nullopt, [&done](NStorageObjectListPtr list) { done = !list->objects.empty(); },
+        nullptr);
+  });
+
+  registerCall(
+      "listLeaderboardRecords", "leaderboard_records", [](RestClient& client, NSessionPtr session, bool& done) {
+        client.listLeaderboardRecords(
+            session, "weekly-score", {session->getUserId()}, 20, std::nullopt,
+            [&done](NLeaderboardRecordListPtr list) { done = !list->records.empty(); }, nullptr);
+      });
+
+  registerCall("listChannelMessages", "channel_messages", [](RestClient& client, NSessionPtr session, bool& done) {
+    client.listChannelMessages(
+        session, "2...lobby-eu", 20, std::nullopt, true,
+        [&done](NChannelMessageListPtr list) { done = !list->messages.empty(); }, nullptr);
+  });
+
+  registerCall("listFriends", "friends", [](RestClient& client, NSessionPtr session, bool& done) {
+    client.listFriends(
+        session, 20, std::nullopt, "", [&done](NFriendListPtr list) { done = !list->friends.empty(); }, nullptr);
+  });
+
+  registerCall("rpc", "rpc", [](RestClient& client, NSessionPtr session, bool& done) {
+    client.rpc(
+        session, "get_inventory", std::string("{\"filter\":\"equipped\",\"page\":1}"),
+        [&done](const NRpc& rpc) { done = !rpc.payload.empty(); }, nullptr);
+  });
+}
+
+} // namespace Bench
+} // namespace Nakama
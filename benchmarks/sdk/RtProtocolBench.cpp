@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SdkBench.h"
+
+#include "NRtClientProtocol_Json.h"
+#include "NRtClientProtocol_Protobuf.h"
+#include "rtapi/realtime.pb.h"
+
+#include <benchmark/benchmark.h>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+using ::nakama::realtime::Envelope;
+
+// Parse into a fresh Envelope like NRtClient does for every message.
+template <class Protocol>
+void registerProtocol(
+    const std::string& format, const std::string& name, const NBytes& input, const Envelope& envelope) {
+  benchmark::RegisterBenchmark(("RtProtocol/" + format + "/parse/" + name).c_str(), [input](benchmark::State& state) {
+    Protocol protocol;
+    for (auto _ : state) {
+      Envelope message;
+      bool ok = protocol.parse(input, message);
+      benchmark::DoNotOptimize(ok);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+  });
+
+  benchmark::RegisterBenchmark(
+      ("RtProtocol/" + format + "/serialize/" + name).c_str(), [envelope](benchmark::State& state) {
+        Protocol protocol;
+        NBytes output;
+        for (auto _ : state) {
+          output.clear();
+          bool ok = protocol.serialize(envelope, output);
+          benchmark::DoNotOptimize(ok);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * output.size()));
+      });
+
+  benchmark::RegisterBenchmark(("RtProtocol/" + format + "/peek/" + name).c_str(), [input](benchmark::State& state) {
+    Protocol protocol;
+    for (auto _ : state) {
+      RtEnvelopePeek peek;
+      bool ok = protocol.peekEnvelope(input, peek);
+      benchmark::DoNotOptimize(ok);
+      benchmark::DoNotOptimize(peek);
+    }
+  });
+}
+
+} // namespace
+
+void registerRtProtocolBenchmarks() {
+  for (const std::string& name : rtFixtureNames()) {
+    const std::string path = "rt/" + name + ".json";
+    Envelope envelope;
+    parseFixture(path, envelope);
+
+    // the protobuf input is the same message, as the server would send it in binary
+    NBytes binary;
+    envelope.SerializeToString(&binary);
+
+    registerProtocol<NRtClientProtocol_Json>("Json", name, fixture(path), envelope);
+    registerProtocol<NRtClientProtocol_Protobuf>("Protobuf", name, binary, envelope);
+  }
+}
+
+} // namespace Bench
+} // namespace Nakama
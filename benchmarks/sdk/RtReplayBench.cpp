@@ -0,0 +1,211 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SdkBench.h"
+
+#include "DefaultSession.h"
+#include "NRtClient.h"
+#include "RtTrafficLog.h"
+#include "api/api.pb.h"
+
+#include <nakama-cpp/realtime/NRtDefaultClientListener.h>
+#include <nakama-cpp/realtime/NRtTrafficLog.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+// Connects at once and delivers what it is given, to record a synthetic log.
+class FeedTransport : public NRtTransportInterface {
+public:
+  void setActivityTimeout(uint32_t) override {}
+  uint32_t getActivityTimeout() const override { return 0; }
+  void tick() override {}
+  void connect(const std::string&, NRtTransportType) override { fireOnConnected(); }
+  bool isConnecting() const override { return false; }
+  void disconnect() override { _connected = false; }
+  bool send(const NBytes&) override { return true; }
+
+  void feed(const NBytes& message) { fireOnMessage(message); }
+};
+
+// The realtime fixtures, 100 of each, as received over a JSON socket.
+std::string recordSyntheticLog() {
+  const std::string path = (std::filesystem::temp_directory_path() / "nakama-sdk-bench-rt.log").string();
+  std::remove(path.c_str());
+
+  auto source = std::make_shared<FeedTransport>();
+  NRtTransportPtr recorder = createRecordingTransport(source, path);
+  if (!recorder) {
+    std::fprintf(stderr, "unable to record %s\n", path.c_str());
+    std::exit(1);
+  }
+
+  recorder->connect("ws://127.0.0.1:7350/ws", NRtTransportType::Text);
+  for (int i = 0; i < 100; i++) {
+    for (const std::string& name : rtFixtureNames()) {
+      source->feed(fixture("rt/" + name + ".json"));
+    }
+  }
+  recorder->disconnect();
+  return path;
+}
+
+// The protocol a log was recorded with, from its first connection.
+NRtClientProtocol logProtocol(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  std::vector<uint8_t> bytes(std::istreambuf_iterator<char>(file), {});
+  size_t offset = RtTrafficLog::readFileHeader(bytes.data(), bytes.size());
+  if (offset == 0) {
+    std::fprintf(stderr, "%s is not a traffic log\n", path.c_str());
+    std::exit(1);
+  }
+
+  RtTrafficLog::RecordHeader header;
+  while (RtTrafficLog::readRecordHeader(bytes.data() + offset, bytes.size() - offset, header)) {
+    if (header.kind == RtTrafficLog::RecordKind::Connect || header.kind == RtTrafficLog::RecordKind::Received) {
+      break;
+    }
+    offset += RtTrafficLog::kRecordHeaderSize + header.size;
+  }
+  return header.transportType == static_cast<uint8_t>(NRtTransportType::Binary) ? NRtClientProtocol::Protobuf
+                                                                                : NRtClientProtocol::Json;
+}
+
+// Replays the first connection of a log at maximum speed per iteration: decoding and listener dispatch of
+// everything a game subscribed to everything would handle.
+void registerReplay(const std::string& name, const std::string& path) {
+  const NRtClientProtocol protocol = logProtocol(path);
+
+  benchmark::RegisterBenchmark(("RtReplay/" + name).c_str(), [path, protocol](benchmark::State& state) {
+    nakama::api::Session sessionData;
+    parseFixture("rest/session.json", sessionData);
+    NSessionPtr session =
+        std::make_shared<DefaultSession>(sessionData.token(), sessionData.refresh_token(), sessionData.created());
+
+    NRtDefaultClientListener listener;
+    uint64_t events = 0;
+    listener.setMatchDataCallback([&events](const NMatchData&) { events++; });
+    listener.setMatchPresenceCallback([&events](const NMatchPresenceEvent&) { events++; });
+    listener.setChannelMessageCallback([&events](const NChannelMessage&) { events++; });
+    listener.setChannelPresenceCallback([&events](const NChannelPresenceEvent&) { events++; });
+    listener.setNotificationsCallback([&events](const NNotificationList&) { events++; });
+    listener.setStatusPresenceCallback([&events](const NStatusPresenceEvent&) { events++; });
+    listener.setStreamPresenceCallback([&events](const NStreamPresenceEvent&) { events++; });
+    listener.setMatchmakerMatchedCallback([&events](NMatchmakerMatchedPtr) { events++; });
+    listener.setPartyDataCallback([&events](const NPartyData&) { events++; });
+
+    uint64_t messages = 0;
+    for (auto _ : state) {
+      state.PauseTiming();
+      NRtReplayTransportPtr transport = createReplayTransport(path, NRtReplaySpeed::Maximum);
+      NRtClient client(transport, "127.0.0.1", 7350, false);
+      client.setListener(&listener);
+      client.connect(session, false, protocol);
+      state.ResumeTiming();
+
+      client.tick();
+
+      state.PauseTiming();
+      messages += transport->getReplayedMessages();
+      client.disconnect();
+      state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(messages));
+    const int64_t iterations = std::max<int64_t>(static_cast<int64_t>(state.iterations()), 1);
+    state.counters["events"] = static_cast<double>(events) / static_cast<double>(iterations);
+  });
+}
+
+// Mixed traffic as seen by a match client, half match data and the rest chat and presence, dispatched
+// to a listener subscribed to everything or to match data only, whose other events are skipped undecoded.
+void registerDispatch(bool matchDataOnly) {
+  const std::string name = matchDataOnly ? "match_data_only" : "subscribed_all";
+
+  benchmark::RegisterBenchmark(("RtDispatch/Json/" + name).c_str(), [matchDataOnly](benchmark::State& state) {
+    const std::pair<const char*, int> mix[] = {
+        {"channel_message", 5}, {"status_presence_event", 3}, {"match_presence_event", 2}, {"match_data", 10}};
+    std::vector<NBytes> trace;
+    for (const auto& [type, count] : mix) {
+      trace.insert(trace.end(), count, fixture("rt/" + std::string(type) + ".json"));
+    }
+
+    nakama::api::Session sessionData;
+    parseFixture("rest/session.json", sessionData);
+    NSessionPtr session =
+        std::make_shared<DefaultSession>(sessionData.token(), sessionData.refresh_token(), sessionData.created());
+
+    NRtDefaultClientListener listener;
+    uint64_t matchData = 0;
+    listener.setMatchDataCallback([&matchData](const NMatchData&) { matchData++; });
+    if (matchDataOnly) {
+      listener.setSubscribed(NRtEventType::ChannelMessage, false);
+      listener.setSubscribed(NRtEventType::StatusPresence, false);
+      listener.setSubscribed(NRtEventType::MatchPresence, false);
+    } else {
+      listener.setChannelMessageCallback([](const NChannelMessage&) {});
+      listener.setStatusPresenceCallback([](const NStatusPresenceEvent&) {});
+      listener.setMatchPresenceCallback([](const NMatchPresenceEvent&) {});
+    }
+
+    auto transport = std::make_shared<FeedTransport>();
+    NRtClient client(transport, "127.0.0.1", 7350, false);
+    client.setListener(&listener);
+    client.connect(session, false, NRtClientProtocol::Json);
+
+    size_t i = 0;
+    for (auto _ : state) {
+      transport->feed(trace[i++ % trace.size()]);
+    }
+    client.disconnect();
+
+    // match data is the second half of the trace
+    const uint64_t rounds = i / trace.size();
+    const uint64_t rest = i % trace.size();
+    if (matchData != rounds * trace.size() / 2 + (rest > trace.size() / 2 ? rest - trace.size() / 2 : 0)) {
+      state.SkipWithError("match data went missing");
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+  });
+}
+
+} // namespace
+
+void registerRtReplayBenchmarks(const std::vector<std::string>& logs) {
+  registerDispatch(false);
+  registerDispatch(true);
+  if (logs.empty()) {
+    registerReplay("synthetic", recordSyntheticLog());
+  }
+  for (const std::string& path : logs) {
+    registerReplay(std::filesystem::path(path).filename().string(), path);
+  }
+}
+
+} // namespace Bench
+} // namespace Nakama
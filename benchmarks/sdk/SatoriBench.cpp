@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SdkBench.h"
+
+#include "InternalLowLevelSatoriAPI.h"
+
+#include <benchmark/benchmark.h>
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+template <class Decoded> void registerDecoder(const std::string& name) {
+  const std::string& input = fixture("satori/" + name + ".json");
+
+  Decoded check;
+  if (!check.fromJson(input)) {
+    std::fprintf(stderr, "fixture satori/%s.json doesn't decode\n", name.c_str());
+    std::exit(1);
+  }
+
+  benchmark::RegisterBenchmark(("Satori/fromJson/" + name).c_str(), [input](benchmark::State& state) {
+    for (auto _ : state) {
+      Decoded decoded;
+      bool ok = decoded.fromJson(input);
+      benchmark::DoNotOptimize(ok);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+  });
+}
+
+std::string makeFlagListJson(int64_t count) {
+  std::string json = "{\"flags\":[";
+  for (int64_t i = 0; i < count; i++) {
+    if (i > 0) {
+      json += ',';
+    }
+    std::string n = std::to_string(i);
+    json += "{\"name\":\"Feature-Flag-" + n + "\",\"value\":\"{\\\"enabled\\\":true,\\\"weight\\\":" + n +
+            "}\",\"condition_changed\":" + (i % 3 == 0 ? "true" : "false") +
+            ",\"change_reason\":{\"name\":\"Experiment-" + n + "\",\"variant_name\":\"B\",\"type\":3}" +
+            ",\"labels\":[\"economy\",\"season-" + std::to_string(i % 8) + "\"]}";
+  }
+  json += "]}";
+  return json;
+}
+
+// What decoding cost before the streaming parser: a DOM of the whole body, then copies of every field
+bool decodeWithDom(const std::string& json, Satori::SFlagList& list) {
+  rapidjson::Document d;
+  if (d.Parse(json.data(), json.size()).HasParseError() || !d.HasMember("flags")) {
+    return false;
+  }
+  for (auto& jsonFlag : d["flags"].GetArray()) {
+    Satori::SFlag flag;
+    flag.name = jsonFlag["name"].GetString();
+    flag.value = jsonFlag["value"].GetString();
+    flag.condition_changed = jsonFlag["condition_changed"].GetBool();
+    flag.change_reason.name = jsonFlag["change_reason"]["name"].GetString();
+    flag.change_reason.variant_name = jsonFlag["change_reason"]["variant_name"].GetString();
+    for (auto& label : jsonFlag["labels"].GetArray()) {
+      flag.labels.emplace_back(label.GetString());
+    }
+    list.flags.emplace_back(std::move(flag));
+  }
+  return true;
+}
+
+// Large generated flag lists, decoded with the DOM and the streaming parser. range(0): number of flags
+template <bool Dom> void BM_flagList(benchmark::State& state) {
+  const std::string json = makeFlagListJson(state.range(0));
+  uint64_t flags = 0;
+  const uint64_t allocationsBefore = allocations();
+  for (auto _ : state) {
+    Satori::SInternalFlagList list;
+    bool ok = Dom ? decodeWithDom(json, list) : list.fromJson(json);
+    if (!ok) {
+      state.SkipWithError("decode failed");
+      return;
+    }
+    flags += list.flags.size();
+  }
+  const uint64_t allocated = allocations() - allocationsBefore;
+
+  state.SetItemsProcessed(static_cast<int64_t>(flags));
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+  state.counters["allocs_per_flag"] =
+      static_cast<double>(allocated) / static_cast<double>(std::max<uint64_t>(flags, 1));
+}
+BENCHMARK_TEMPLATE(BM_flagList, true)->Name("Satori/flagList/dom")->ArgName("flags")->Arg(100)->Arg(10000);
+BENCHMARK_TEMPLATE(BM_flagList, false)->Name("Satori/flagList/sax")->ArgName("flags")->Arg(100)->Arg(10000);
+
+} // namespace
+
+void registerSatoriBenchmarks() {
+  registerDecoder<Satori::SInternalFlagList>("flags");
+  registerDecoder<Satori::SInternalExperimentList>("experiments");
+  registerDecoder<Satori::SInternalLiveEventList>("live_events");
+  registerDecoder<Satori::SInternalProperties>("properties");
+  registerDecoder<Satori::SInternalGetMessageListResponse>("messages");
+}
+
+} // namespace Bench
+} // namespace Nakama
@@ -0,0 +1,166 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// CPU cost of the SDK's pure, hot paths: realtime codecs, DataHelper conversions, REST request round trips
+// through a transport that answers at once, string utilities, session token decoding and the Satori
+// decoders. Inputs are the payloads in fixtures/, shaped like the server's responses. Realtime traffic logs,
+// e.g. recorded in production with createRecordingTransport, are replayed through NRtClient with --rt-log.
+//
+// The optional parts of the SDK are benchmarked when they are built: the zstd payload codec (WITH_ZSTD),
+// permessage-deflate (WITH_WS_WSLAY, captured traffic with --ws-traffic), the wslay I/O backends against
+// an echo server (CFG_WSLAY_SOCKET_IO, an in-process one unless --echo is given) and the gRPC client
+// threading modes (WITH_GRPC_CLIENT).
+//
+// Results are printed as JSON so they can be compared across releases, e.g. with Google Benchmark's
+// tools/compare.py. Google Benchmark options are passed through, --benchmark_format=console for a table.
+//
+// usage: nakama-sdk-bench [--fixtures DIR] [--rt-log FILE]... [--ws-traffic FILE]... [--echo HOST:PORT [--echo-tls]]
+//                         [--benchmark_filter REGEX] [--benchmark_out FILE] ...
+
+#include "SdkBench.h"
+
+#include <benchmark/benchmark.h>
+#include <google/protobuf/util/json_util.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+}
+
+// Counts allocations for the benchmarks which report them, the cost is the same for all of them.
+void* operator new(std::size_t size) {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  if (void* p = std::malloc(size ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+std::string fixturesDir = NAKAMA_BENCH_FIXTURES_DIR;
+
+} // namespace
+
+uint64_t allocations() { return allocationCount.load(std::memory_order_relaxed); }
+
+const std::string& fixture(const std::string& path) {
+  static std::unordered_map<std::string, std::string> cache;
+
+  auto it = cache.find(path);
+  if (it != cache.end()) {
+    return it->second;
+  }
+
+  std::ifstream file(fixturesDir + "/" + path, std::ios::binary);
+  if (!file) {
+    std::fprintf(stderr, "unable to read fixture %s/%s\n", fixturesDir.c_str(), path.c_str());
+    std::exit(1);
+  }
+
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  return cache.emplace(path, contents.str()).first->second;
+}
+
+void parseFixture(const std::string& path, google::protobuf::Message& message) {
+  google::protobuf::util::JsonParseOptions options;
+  options.ignore_unknown_fields = true;
+  if (!google::protobuf::util::JsonStringToMessage(fixture(path), &message, options).ok()) {
+    std::fprintf(stderr, "fixture %s is not a %s\n", path.c_str(), message.GetTypeName().c_str());
+    std::exit(1);
+  }
+}
+
+const std::vector<std::string>& rtFixtureNames() {
+  static const std::vector<std::string> names = {
+      "match_data",
+      "match_presence_event",
+      "match",
+      "channel_message",
+      "channel_presence_event",
+      "notifications",
+      "status_presence_event",
+      "matchmaker_matched",
+      "party_data",
+      "rpc",
+  };
+  return names;
+}
+
+} // namespace Bench
+} // namespace Nakama
+
+int main(int argc, char** argv) {
+  // JSON by default, options given later win
+  std::vector<char*> args = {argv[0], const_cast<char*>("--benchmark_format=json")};
+  std::vector<std::string> rtLogs;
+  std::vector<std::string> wsTraffic;
+  std::string echo;
+  bool echoTls = false;
+  for (int i = 1; i < argc; i++) {
+    if (!std::strcmp(argv[i], "--fixtures") && i + 1 < argc) {
+      Nakama::Bench::fixturesDir = argv[++i];
+    } else if (!std::strcmp(argv[i], "--rt-log") && i + 1 < argc) {
+      rtLogs.push_back(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--ws-traffic") && i + 1 < argc) {
+      wsTraffic.push_back(argv[++i]);
+    } else if (!std::strcmp(argv[i], "--echo") && i + 1 < argc) {
+      echo = argv[++i];
+    } else if (!std::strcmp(argv[i], "--echo-tls")) {
+      echoTls = true;
+    } else {
+      args.push_back(argv[i]);
+    }
+  }
+
+  int benchmarkArgc = static_cast<int>(args.size());
+  benchmark::Initialize(&benchmarkArgc, args.data());
+  if (benchmark::ReportUnrecognizedArguments(benchmarkArgc, args.data())) {
+    return 1;
+  }
+
+  Nakama::Bench::registerRtProtocolBenchmarks();
+  Nakama::Bench::registerDataHelperBenchmarks();
+  Nakama::Bench::registerRestClientBenchmarks();
+  Nakama::Bench::registerSessionBenchmarks();
+  Nakama::Bench::registerSatoriBenchmarks();
+  Nakama::Bench::registerRtReplayBenchmarks(rtLogs);
+#ifdef WITH_WS_WSLAY
+  Nakama::Bench::registerWsDeflateBenchmarks(wsTraffic);
+#endif
+#ifdef CFG_WSLAY_SOCKET_IO
+  Nakama::Bench::registerWslayIoBenchmarks(echo, echoTls);
+#endif
+
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/message.h>
+
+namespace Nakama {
+namespace Bench {
+
+// Contents of a file in the fixtures directory, e.g. "rt/match_data.json". Exits if it can't be read,
+// numbers for missing data would be meaningless.
+const std::string& fixture(const std::string& path);
+
+// Parses a JSON fixture the way the SDK parses server responses. Exits if it doesn't parse.
+void parseFixture(const std::string& path, google::protobuf::Message& message);
+
+// Allocations made by the process so far.
+uint64_t allocations();
+
+// Realtime fixtures, named after the Envelope field they set.
+const std::vector<std::string>& rtFixtureNames();
+
+// Benchmarks that depend on fixtures are registered once the fixtures directory is known.
+void registerRtProtocolBenchmarks();
+void registerDataHelperBenchmarks();
+void registerRestClientBenchmarks();
+void registerSessionBenchmarks();
+void registerSatoriBenchmarks();
+
+// Replays of traffic logs recorded with createRecordingTransport, or of a synthetic one when none are given.
+void registerRtReplayBenchmarks(const std::vector<std::string>& logs);
+
+// permessage-deflate of generated chat and match traffic and of captured traffic, one message per line.
+void registerWsDeflateBenchmarks(const std::vector<std::string>& trafficFiles);
+
+// wslay I/O backends against an echo server at HOST:PORT, or an in-process one if it is empty.
+void registerWslayIoBenchmarks(const std::string& echo, bool tls);
+
+} // namespace Bench
+} // namespace Nakama
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SdkBench.h"
+
+#include "DefaultSession.h"
+#include "StrUtil.h"
+#include "api/api.pb.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+std::string randomBytes(size_t size) {
+  std::mt19937 rng(46);
+  std::string bytes(size, '\0');
+  for (char& c : bytes) {
+    c = static_cast<char>(rng());
+  }
+  return bytes;
+}
+
+// Query arguments: a pagination cursor, which is base64 with characters to escape, and a display name.
+void BM_encodeURIComponent(benchmark::State& state) {
+  const std::string input = state.range(0) == 0 ? "CgVzYXZlcxIHc2xvdC0xMBokMGQ2YjA5ZGQtZjRmNC00YjJj+LWE3MzEt/ZTQy=="
+                                                 : "Zo\xC3\xAB the Brave & Friends (EU #2)";
+  for (auto _ : state) {
+    std::string encoded = encodeURIComponent(input);
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_encodeURIComponent)->Name("StrUtil/encodeURIComponent")->ArgName("utf8")->Arg(0)->Arg(1);
+
+void BM_base64Encode(benchmark::State& state) {
+  const std::string input = randomBytes(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::string encoded = base64Encode(input);
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_base64Encode)->Name("StrUtil/base64Encode")->Arg(64)->Arg(1024)->Arg(16384);
+
+void BM_base64EncodeUrl(benchmark::State& state) {
+  const std::string input = randomBytes(static_cast<size_t>(state.range(0)));
+  for (auto _ : state) {
+    std::string encoded = base64EncodeUrl(input);
+    benchmark::DoNotOptimize(encoded);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_base64EncodeUrl)->Name("StrUtil/base64EncodeUrl")->Arg(64)->Arg(1024)->Arg(16384);
+
+void BM_base64DecodeUrl(benchmark::State& state) {
+  const std::string input = base64EncodeUrl(randomBytes(static_cast<size_t>(state.range(0))));
+  for (auto _ : state) {
+    Base64Buffer decoded = base64DecodeUrl(input);
+    benchmark::DoNotOptimize(decoded);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * input.size()));
+}
+BENCHMARK(BM_base64DecodeUrl)->Name("StrUtil/base64DecodeUrl")->Arg(64)->Arg(1024)->Arg(16384);
+
+} // namespace
+
+void registerSessionBenchmarks() {
+  nakama::api::Session data;
+  parseFixture("rest/session.json", data);
+
+  // decodes the JWT claims: user id, username, expiry and session variables
+  benchmark::RegisterBenchmark("DefaultSession/decode", [data](benchmark::State& state) {
+    for (auto _ : state) {
+      DefaultSession session(data.token(), data.refresh_token(), data.created());
+      benchmark::DoNotOptimize(session.getUserId().data());
+    }
+  });
+}
+
+} // namespace Bench
+} // namespace Nakama
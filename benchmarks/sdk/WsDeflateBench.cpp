@@ -0,0 +1,251 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Bytes on the wire and CPU per message of permessage-deflate in the wslay transport. Messages are sent
+// through a client side WslayDeflate and inflated by a second one, like the server would, for several
+// parameter sets. Wire bytes include the websocket frame header of a masked client frame.
+//
+// The generated traffic is JSON protocol envelopes of a chat channel and a match with a few players.
+// Captured traffic is benchmarked too when given with --ws-traffic: one message per line, e.g. written
+// by a logging transport.
+
+#include "SdkBench.h"
+
+#include "WslayDeflate.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+constexpr size_t kMessages = 20000;
+
+struct Mode {
+  const char* name;
+  bool deflate;
+  uint8_t windowBits;
+  bool noContextTakeover;
+  int level;
+};
+
+class TrafficGenerator {
+public:
+  TrafficGenerator() : _rng(7) {
+    for (int i = 0; i < 8; ++i) {
+      _users.push_back(uuid());
+      _sessions.push_back(uuid());
+    }
+    _matchId = uuid() + ".nakama1";
+  }
+
+  std::string chatMessage() {
+    static const char* const kWords[] = {
+        "gg", "nice", "push", "mid", "wait", "ready", "anyone", "queue", "again", "lol"};
+    std::uniform_int_distribution<size_t> user(0, _users.size() - 1);
+    std::uniform_int_distribution<int> words(1, 12);
+    std::uniform_int_distribution<size_t> word(0, std::size(kWords) - 1);
+
+    std::string text;
+    for (int i = words(_rng); i > 0; --i) {
+      text += kWords[word(_rng)];
+      text += i > 1 ? " " : "";
+    }
+
+    size_t sender = user(_rng);
+    std::string time = timestamp();
+    return "{\"channel_message\":{\"channel_id\":\"2...lobby\",\"message_id\":\"" + uuid() +
+           "\",\"code\":0,\"sender_id\":\"" + _users[sender] + "\",\"username\":\"player" +
+           std::to_string(sender) + "\",\"content\":\"{\\\"text\\\":\\\"" + text + "\\\"}\",\"create_time\":\"" +
+           time + "\",\"update_time\":\"" + time + "\",\"persistent\":true,\"room_name\":\"lobby\"}}";
+  }
+
+  std::string matchData() {
+    std::uniform_int_distribution<size_t> user(0, _users.size() - 1);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> length(12, 48);
+
+    // a small binary state update, base64 encoded like the JSON protocol does
+    std::string state;
+    for (int i = length(_rng); i > 0; --i) {
+      // positions change in their low bytes, the rest repeats
+      state.push_back(char(i % 4 == 0 ? byte(_rng) : i));
+    }
+
+    size_t sender = user(_rng);
+    return "{\"match_data\":{\"match_id\":\"" + _matchId + "\",\"presence\":{\"user_id\":\"" + _users[sender] +
+           "\",\"session_id\":\"" + _sessions[sender] + "\",\"username\":\"player" + std::to_string(sender) +
+           "\"},\"op_code\":\"" + std::to_string(1 + sender % 3) + "\",\"data\":\"" + base64(state) +
+           "\",\"reliable\":true}}";
+  }
+
+private:
+  std::string uuid() {
+    static const char kHex[] = "0123456789abcdef";
+    std::uniform_int_distribution<int> digit(0, 15);
+    std::string out;
+    for (int i = 0; i < 32; ++i) {
+      if (i == 8 || i == 12 || i == 16 || i == 20) {
+        out.push_back('-');
+      }
+      out.push_back(kHex[digit(_rng)]);
+    }
+    return out;
+  }
+
+  std::string timestamp() {
+    _seconds += 1 + _rng() % 5;
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "2025-06-01T12:%02d:%02dZ", int(_seconds / 60 % 60), int(_seconds % 60));
+    return buf;
+  }
+
+  static std::string base64(const std::string& in) {
+    static const char kChars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < in.size(); i += 3) {
+      uint32_t n = uint32_t(uint8_t(in[i])) << 16;
+      n |= i + 1 < in.size() ? uint32_t(uint8_t(in[i + 1])) << 8 : 0;
+      n |= i + 2 < in.size() ? uint32_t(uint8_t(in[i + 2])) : 0;
+      out.push_back(kChars[(n >> 18) & 63]);
+      out.push_back(kChars[(n >> 12) & 63]);
+      out.push_back(i + 1 < in.size() ? kChars[(n >> 6) & 63] : '=');
+      out.push_back(i + 2 < in.size() ? kChars[n & 63] : '=');
+    }
+    return out;
+  }
+
+  std::mt19937 _rng;
+  std::vector<std::string> _users;
+  std::vector<std::string> _sessions;
+  std::string _matchId;
+  unsigned _seconds = 0;
+};
+
+// header of a masked client frame carrying `len` bytes
+size_t frameSize(size_t len) { return len + 2 + 4 + (len < 126 ? 0 : len <= 0xffff ? 2 : 8); }
+
+// Every iteration deflates the next message and inflates it on the other side, the streams carry their
+// context from message to message like those of a connection.
+void registerTraffic(const std::string& name, std::shared_ptr<const std::vector<std::string>> messages) {
+  static const Mode kModes[] = {
+      {"uncompressed", false, 15, false, 1},
+      {"level1_window15", true, 15, false, 1},
+      {"level1_window10", true, 10, false, 1},
+      {"level1_no_context_takeover", true, 15, true, 1},
+      {"level6_window15", true, 15, false, 6},
+  };
+
+  for (const Mode& mode : kModes) {
+    benchmark::RegisterBenchmark(
+        ("WsDeflate/" + name + "/" + mode.name).c_str(), [messages, mode](benchmark::State& state) {
+          NWebsocketDeflateConfig config;
+          config.enabled = true;
+          config.clientMaxWindowBits = mode.windowBits;
+          config.clientNoContextTakeover = mode.noContextTakeover;
+          config.level = mode.level;
+
+          WslayDeflate client(config);
+          WslayDeflate server(config);
+          if (mode.deflate) {
+            client.accept("permessage-deflate");
+            server.accept("permessage-deflate");
+          }
+
+          std::string sent;
+          std::string received;
+          size_t payloadBytes = 0;
+          size_t wireBytes = 0;
+          size_t compressed = 0;
+          size_t i = 0;
+          for (auto _ : state) {
+            const std::string& message = (*messages)[i++ % messages->size()];
+            const auto* data = reinterpret_cast<const uint8_t*>(message.data());
+            if (client.deflate(data, message.size(), sent)) {
+              if (!server.inflate(reinterpret_cast<const uint8_t*>(sent.data()), sent.size(), received) ||
+                  received != message) {
+                state.SkipWithError("round trip failed");
+                return;
+              }
+              wireBytes += frameSize(sent.size());
+              compressed++;
+            } else {
+              wireBytes += frameSize(message.size());
+            }
+            payloadBytes += message.size();
+          }
+
+          const double iterations = static_cast<double>(std::max<int64_t>(state.iterations(), 1));
+          state.SetBytesProcessed(static_cast<int64_t>(payloadBytes));
+          state.counters["wire"] =
+              static_cast<double>(wireBytes) / static_cast<double>(std::max<size_t>(payloadBytes, 1));
+          state.counters["compressed"] = static_cast<double>(compressed) / iterations;
+        });
+  }
+}
+
+std::shared_ptr<const std::vector<std::string>> readTraffic(const std::string& path) {
+  std::ifstream file(path);
+  if (!file) {
+    std::fprintf(stderr, "unable to read %s\n", path.c_str());
+    std::exit(1);
+  }
+
+  auto messages = std::make_shared<std::vector<std::string>>();
+  for (std::string line; std::getline(file, line) && messages->size() < kMessages;) {
+    messages->push_back(line);
+  }
+  if (messages->empty()) {
+    std::fprintf(stderr, "%s has no messages\n", path.c_str());
+    std::exit(1);
+  }
+  return messages;
+}
+
+} // namespace
+
+void registerWsDeflateBenchmarks(const std::vector<std::string>& trafficFiles) {
+  auto chat = std::make_shared<std::vector<std::string>>();
+  auto match = std::make_shared<std::vector<std::string>>();
+  TrafficGenerator chatGenerator;
+  TrafficGenerator matchGenerator;
+  for (size_t i = 0; i < kMessages; i++) {
+    chat->push_back(chatGenerator.chatMessage());
+    match->push_back(matchGenerator.matchData());
+  }
+
+  registerTraffic("chat", chat);
+  registerTraffic("match", match);
+  for (const std::string& path : trafficFiles) {
+    registerTraffic(std::filesystem::path(path).filename().string(), readTraffic(path));
+  }
+}
+
+} // namespace Bench
+} // namespace Nakama
@@ -0,0 +1,272 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+// Connect time, round trip latency and throughput of the wslay network I/O backends. The backends are
+// driven directly, below the websocket framing, against a TCP echo server: an in-process one on loopback
+// by default, or any echo server given with --echo HOST:PORT, e.g. behind a TLS terminating proxy with
+// --echo-tls. CPU time is the process CPU time, the echo server included when it runs in-process.
+
+#include "SdkBench.h"
+
+#include "WslayIOSocket.h"
+#ifdef BENCH_CURL_IO
+#include "WslayIOCurl.h"
+#endif
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Nakama {
+namespace Bench {
+
+namespace {
+
+using namespace std::chrono;
+
+struct Endpoint {
+  std::string host;
+  uint16_t port = 0;
+  bool tls = false;
+};
+
+// Echoes every connection back on its own thread until the peer closes.
+class EchoServer {
+public:
+  EchoServer() {
+    _listener = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(_listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrLen = sizeof(addr);
+    if (bind(_listener, reinterpret_cast<sockaddr*>(&addr), addrLen) != 0 || listen(_listener, 16) != 0 ||
+        getsockname(_listener, reinterpret_cast<sockaddr*>(&addr), &addrLen) != 0) {
+      std::perror("echo server");
+      std::exit(1);
+    }
+    _port = ntohs(addr.sin_port);
+
+    _acceptor = std::thread([this] {
+      while (true) {
+        int fd = accept(_listener, nullptr, nullptr);
+        if (fd < 0) {
+          return;
+        }
+        std::thread([fd] {
+          int one = 1;
+          setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+          std::vector<char> buf(64 * 1024);
+          ssize_t n;
+          while ((n = ::recv(fd, buf.data(), buf.size(), 0)) > 0) {
+            for (ssize_t sent = 0; sent < n;) {
+              ssize_t m = ::send(fd, buf.data() + sent, size_t(n - sent), MSG_NOSIGNAL);
+              if (m <= 0) {
+                break;
+              }
+              sent += m;
+            }
+          }
+          ::close(fd);
+        }).detach();
+      }
+    });
+  }
+
+  ~EchoServer() {
+    shutdown(_listener, SHUT_RDWR);
+    ::close(_listener);
+    _acceptor.join();
+  }
+
+  uint16_t port() const { return _port; }
+
+private:
+  int _listener = -1;
+  uint16_t _port = 0;
+  std::thread _acceptor;
+};
+
+Endpoint endpoint;
+
+// The in-process echo server is started by the first benchmark which runs.
+const Endpoint& echoEndpoint() {
+  static std::unique_ptr<EchoServer> server;
+  if (endpoint.host.empty()) {
+    server = std::make_unique<EchoServer>();
+    endpoint.host = "127.0.0.1";
+    endpoint.port = server->port();
+    endpoint.tls = false;
+  }
+  return endpoint;
+}
+
+bool connect(WslayIOInterface& io) {
+  const Endpoint& echo = echoEndpoint();
+  URLParts url;
+  url.scheme = echo.tls ? "wss" : "ws";
+  url.host = echo.host;
+  url.port = echo.port;
+  url.url = url.scheme + "://" + echo.host + ":" + std::to_string(echo.port) + "/";
+
+  NetIOAsyncResult result = io.connect_init(url);
+  if (result == NetIOAsyncResult::DONE) {
+    while ((result = io.connect_tick()) == NetIOAsyncResult::AGAIN) {
+    }
+  }
+  return result == NetIOAsyncResult::DONE;
+}
+
+// Sends `len` bytes and reads as many back, spinning on would-block like the transport's loop does
+// without its sleep. Returns false if the connection failed.
+bool exchange(WslayIOInterface& io, const char* data, size_t len, std::vector<char>& buf, size_t& calls) {
+  size_t sent = 0;
+  size_t received = 0;
+  int wouldBlock = 0;
+  while (received < len) {
+    if (sent < len) {
+      int n = io.send(data + sent, len - sent, &wouldBlock);
+      ++calls;
+      if (n < 0) {
+        return false;
+      }
+      sent += size_t(n);
+    }
+    int n = io.recv(buf.data(), std::min(buf.size(), len - received), &wouldBlock);
+    ++calls;
+    if (n < 0 || (n == 0 && !wouldBlock)) {
+      return false;
+    }
+    received += size_t(n);
+  }
+  return true;
+}
+
+double percentile(std::vector<double>& samples, double p) {
+  if (samples.empty()) {
+    return 0;
+  }
+  size_t n = std::min(samples.size() - 1, size_t(p * double(samples.size())));
+  std::nth_element(samples.begin(), samples.begin() + long(n), samples.end());
+  return samples[n];
+}
+
+using IoFactory = std::function<std::unique_ptr<WslayIOInterface>()>;
+
+void registerBackend(const std::string& name, const IoFactory& create) {
+  benchmark::RegisterBenchmark(("WslayIO/" + name + "/connect").c_str(), [create](benchmark::State& state) {
+    for (auto _ : state) {
+      std::unique_ptr<WslayIOInterface> io = create();
+      if (!connect(*io)) {
+        state.SkipWithError("unable to connect");
+        return;
+      }
+      state.PauseTiming();
+      io->close();
+      state.ResumeTiming();
+    }
+  })->UseRealTime()->MeasureProcessCPUTime();
+
+  // round trips of a small message, latency percentiles in microseconds
+  benchmark::RegisterBenchmark(("WslayIO/" + name + "/rtt").c_str(), [create](benchmark::State& state) {
+    std::unique_ptr<WslayIOInterface> io = create();
+    if (!connect(*io)) {
+      state.SkipWithError("unable to connect");
+      return;
+    }
+
+    std::vector<char> buf(64 * 1024);
+    const std::string message(static_cast<size_t>(state.range(0)), 'x');
+    std::vector<double> rtts;
+    size_t calls = 0;
+    for (auto _ : state) {
+      auto start = steady_clock::now();
+      if (!exchange(*io, message.data(), message.size(), buf, calls)) {
+        state.SkipWithError("connection failed");
+        break;
+      }
+      rtts.push_back(double(duration_cast<nanoseconds>(steady_clock::now() - start).count()) / 1000.0);
+    }
+    io->close();
+
+    const double iterations = static_cast<double>(std::max<int64_t>(state.iterations(), 1));
+    state.counters["calls"] = static_cast<double>(calls) / iterations;
+    state.counters["p50_us"] = percentile(rtts, 0.5);
+    state.counters["p99_us"] = percentile(rtts, 0.99);
+    state.counters["p999_us"] = percentile(rtts, 0.999);
+  })->ArgName("size")->Arg(64)->UseRealTime()->MeasureProcessCPUTime();
+
+  // bulk transfer in chunks the size of a large match state
+  benchmark::RegisterBenchmark(("WslayIO/" + name + "/bulk").c_str(), [create](benchmark::State& state) {
+    std::unique_ptr<WslayIOInterface> io = create();
+    if (!connect(*io)) {
+      state.SkipWithError("unable to connect");
+      return;
+    }
+
+    std::vector<char> buf(64 * 1024);
+    const std::string chunk(64 * 1024, 'y');
+    size_t calls = 0;
+    for (auto _ : state) {
+      if (!exchange(*io, chunk.data(), chunk.size(), buf, calls)) {
+        state.SkipWithError("connection failed");
+        break;
+      }
+    }
+    io->close();
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * chunk.size()));
+  })->UseRealTime()->MeasureProcessCPUTime();
+}
+
+} // namespace
+
+void registerWslayIoBenchmarks(const std::string& echo, bool tls) {
+  if (!echo.empty()) {
+    size_t colon = echo.rfind(':');
+    if (colon == std::string::npos || colon == 0) {
+      std::fprintf(stderr, "--echo takes HOST:PORT, not %s\n", echo.c_str());
+      std::exit(1);
+    }
+    endpoint.host = echo.substr(0, colon);
+    endpoint.port = static_cast<uint16_t>(std::atoi(echo.c_str() + colon + 1));
+    endpoint.tls = tls;
+  }
+
+  registerBackend("socket", [] { return std::make_unique<WslayIOSocket>(); });
+#ifdef BENCH_CURL_IO
+  registerBackend("curl", [] { return std::make_unique<WslayIOCurl>(); });
+#endif
+}
+
+} // namespace Bench
+} // namespace Nakama
@@ -23,14 +23,180 @@
 
 #include <future>
 #include <optional>
+#include <set>
+#include <string>
 #include <vector>
 
 namespace Nakama {
 
+namespace {
+
+// owner of storage objects which no user owns
+const char* const kSystemUserId = "00000000-0000-0000-0000-000000000000";
+
+} // namespace
+
 #ifdef HAVE_DEFAULT_RT_TRANSPORT_FACTORY
 NRtClientPtr BaseClient::createRtClient() { return createRtClient(createDefaultWebsocket(_platformParams)); }
 #endif
 
+void BaseClient::tick() { tick(std::chrono::microseconds::max()); }
+
+void BaseClient::tick(std::chrono::microseconds budget) {
+  _ioWorker.tick([this]() { pump(); }, budget);
+}
+
+void BaseClient::startIoThread(NExecutorPtr callbackExecutor, std::chrono::milliseconds interval) {
+  _ioWorker.start([this]() { pump(); }, std::move(callbackExecutor), interval);
+}
+
+void BaseClient::stopIoThread() { _ioWorker.stop(); }
+
+void BaseClient::pump() {
+  pumpTransport();
+  sendStorageWrites();
+  sendPointReads();
+}
+
+void BaseClient::bufferStorageWrite(NSessionPtr session, const NStorageObjectWrite& object) {
+  std::string userId = session->getUserId();
+  {
+    std::lock_guard<std::mutex> lock(_storageWriteSessionLock);
+    _storageWriteSessions[userId] = std::move(session);
+  }
+  _storageWrites->push(userId, object);
+}
+
+void BaseClient::configureStorageWriteBuffer(const NStorageWriteBufferConfig& config) {
+  _storageWrites->configure(config);
+}
+
+std::future<void> BaseClient::flushStorageWrites() {
+  std::future<void> future = _storageWrites->flush();
+  if (_ioWorker.isRunning()) {
+    _ioWorker.wakeUp();
+  }
+  return future;
+}
+
+void BaseClient::sendStorageWrites() {
+  std::set<std::string> owners;
+  {
+    std::lock_guard<std::mutex> lock(_storageWriteSessionLock);
+    for (const auto& p : _storageWriteSessions) {
+      owners.insert(p.first);
+    }
+  }
+
+  std::string owner;
+  std::vector<NStorageObjectWrite> batch;
+  if (owners.empty() || !_storageWrites->takeBatch(owners, owner, batch)) {
+    return;
+  }
+
+  // a batch holds writes of one user, sent with the latest session of that user
+  NSessionPtr session;
+  {
+    std::lock_guard<std::mutex> lock(_storageWriteSessionLock);
+    session = _storageWriteSessions[owner];
+  }
+
+  std::weak_ptr<StorageWriteBuffer> weakBuffer = _storageWrites;
+  auto sent = std::make_shared<std::vector<NStorageObjectWrite>>(batch);
+
+  writeStorageObjects(
+      session,
+      batch,
+      [weakBuffer](const NStorageObjectAcks& acks) {
+        if (auto buffer = weakBuffer.lock()) {
+          buffer->onBatchWritten(acks);
+        }
+      },
+      [weakBuffer, sent](const NError& error) {
+        if (auto buffer = weakBuffer.lock()) {
+          buffer->onBatchFailed(std::move(*sent), error);
+        }
+      });
+}
+
+void BaseClient::loadUser(
+    NSessionPtr session,
+    const std::string& id,
+    std::function<void(const std::optional<NUser>&)> successCallback,
+    ErrorCallback errorCallback) {
+  _userReads.add(std::move(session), id, {std::move(successCallback), std::move(errorCallback)});
+}
+
+void BaseClient::loadStorageObject(
+    NSessionPtr session,
+    const NReadStorageObjectId& objectId,
+    std::function<void(const std::optional<NStorageObject>&)> successCallback,
+    ErrorCallback errorCallback) {
+  StorageObjectKey key(objectId.collection, objectId.key, objectId.userId);
+  _storageObjectReads.add(std::move(session), key, {std::move(successCallback), std::move(errorCallback)});
+}
+
+void BaseClient::configureReadBatching(const NReadBatchConfig& config) {
+  _storageObjectReads.configure(config.window, config.maxStorageObjectsPerRequest);
+  _userReads.configure(config.window, config.maxUsersPerRequest);
+}
+
+void BaseClient::sendPointReads() {
+  // readers without an error callback fall back to the client's one, like any other request
+  ErrorCallback defaultErrorCallback = _defaultErrorCallback;
+
+  auto storageBatch = std::make_shared<PointReadBatcher<StorageObjectKey, NStorageObject>::Batch>();
+  while (_storageObjectReads.takeBatch(*storageBatch)) {
+    std::vector<NReadStorageObjectId> ids;
+    for (const StorageObjectKey& key : storageBatch->keys()) {
+      ids.push_back({std::get<0>(key), std::get<1>(key), std::get<2>(key)});
+    }
+
+    readStorageObjects(
+        storageBatch->session,
+        ids,
+        [storageBatch](const NStorageObjects& objects) {
+          std::map<StorageObjectKey, const NStorageObject*> values;
+          for (const NStorageObject& object : objects) {
+            // objects owned by the system come back with the nil user id or none, they were asked for with none
+            std::string owner = object.userId == kSystemUserId ? std::string() : object.userId;
+            values.emplace(StorageObjectKey(object.collection, object.key, owner), &object);
+          }
+          storageBatch->complete(values);
+        },
+        [storageBatch, defaultErrorCallback](const NError& error) {
+          if (!storageBatch->fail(error) && defaultErrorCallback) {
+            defaultErrorCallback(error);
+          }
+        });
+
+    storageBatch = std::make_shared<PointReadBatcher<StorageObjectKey, NStorageObject>::Batch>();
+  }
+
+  auto userBatch = std::make_shared<PointReadBatcher<std::string, NUser>::Batch>();
+  while (_userReads.takeBatch(*userBatch)) {
+    getUsers(
+        userBatch->session,
+        userBatch->keys(),
+        {},
+        {},
+        [userBatch](const NUsers& users) {
+          std::map<std::string, const NUser*> values;
+          for (const NUser& user : users.users) {
+            values.emplace(user.id, &user);
+          }
+          userBatch->complete(values);
+        },
+        [userBatch, defaultErrorCallback](const NError& error) {
+          if (!userBatch->fail(error) && defaultErrorCallback) {
+            defaultErrorCallback(error);
+          }
+        });
+
+    userBatch = std::make_shared<PointReadBatcher<std::string, NUser>::Batch>();
+  }
+}
+
 NRtClientPtr BaseClient::createRtClient(NRtTransportPtr transport) {
   RtClientParameters parameters;
   parameters.host = _host;
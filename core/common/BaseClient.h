@@ -16,10 +16,19 @@
 
 #pragma once
 
+#include "IoWorker.h"
+#include "Metrics.h"
+#include "PointReadBatcher.h"
+#include "StorageWriteBuffer.h"
+#include "Tracing.h"
 #include "nakama-cpp/ClientFactory.h"
 #include "nakama-cpp/NClientInterface.h"
+#include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 namespace Nakama {
@@ -34,6 +43,34 @@ public:
   void setUserData(void* userData) override { _userData = userData; }
   void* getUserData() const override { return _userData; }
 
+  void tick() override;
+  void tick(std::chrono::microseconds budget) override;
+  NTickStats getTickStats() const override { return _ioWorker.getTickStats(); }
+
+  void startIoThread(NExecutorPtr callbackExecutor, std::chrono::milliseconds interval) override;
+  void stopIoThread() override;
+
+  NClientMetrics getMetrics() const override { return _metrics.snapshot(); }
+  void resetMetrics() override { _metrics.reset(); }
+  void setTraceSink(NTraceSinkPtr sink) override { _tracer.setSink(std::move(sink)); }
+
+  void bufferStorageWrite(NSessionPtr session, const NStorageObjectWrite& object) override;
+  void configureStorageWriteBuffer(const NStorageWriteBufferConfig& config) override;
+  std::future<void> flushStorageWrites() override;
+  NStorageWriteBufferStats getStorageWriteBufferStats() const override { return _storageWrites->getStats(); }
+
+  void loadUser(
+      NSessionPtr session,
+      const std::string& id,
+      std::function<void(const std::optional<NUser>&)> successCallback,
+      ErrorCallback errorCallback) override;
+  void loadStorageObject(
+      NSessionPtr session,
+      const NReadStorageObjectId& objectId,
+      std::function<void(const std::optional<NStorageObject>&)> successCallback,
+      ErrorCallback errorCallback) override;
+  void configureReadBatching(const NReadBatchConfig& config) override;
+
 #ifdef HAVE_DEFAULT_RT_TRANSPORT_FACTORY
   NRtClientPtr createRtClient() override;
 #endif
@@ -352,6 +389,21 @@ public:
   std::future<NRpc>
   rpcAsync(const std::string& http_key, const std::string& id, const std::optional<std::string>& payload) override;
 
+protected:
+  // Pumps the transport. Called from tick() or from the I/O thread when it is running.
+  virtual void pumpTransport() = 0;
+
+  // Runs user callback inline, or posts it to the callback executor when I/O thread is running.
+  void dispatch(std::function<void()> callback) { _ioWorker.dispatch(std::move(callback)); }
+
+private:
+  // Transport pump followed by the periodic work of the client
+  void pump();
+  // Sends the next batch of buffered storage writes if it is due
+  void sendStorageWrites();
+  // Sends batched loadUser and loadStorageObject reads which are due
+  void sendPointReads();
+
 protected:
   int _port = -1;
   bool _ssl = false;
@@ -360,5 +412,19 @@ protected:
   void* _userData = nullptr;
   ErrorCallback _defaultErrorCallback;
   NPlatformParameters _platformParams;
+  RestMetrics _metrics;
+  Tracer _tracer;
+  IoWorker _ioWorker;
+
+private:
+  // write callbacks hold it weakly, they may run after the client is gone
+  std::shared_ptr<StorageWriteBuffer> _storageWrites = std::make_shared<StorageWriteBuffer>();
+  // the latest session passed to bufferStorageWrite by user id
+  std::map<std::string, NSessionPtr> _storageWriteSessions;
+  std::mutex _storageWriteSessionLock;
+  // collection, key, user id
+  using StorageObjectKey = std::tuple<std::string, std::string, std::string>;
+  PointReadBatcher<StorageObjectKey, NStorageObject> _storageObjectReads;
+  PointReadBatcher<std::string, NUser> _userReads;
 };
 } // namespace Nakama
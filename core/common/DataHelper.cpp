@@ -433,4 +433,81 @@ void assign(NPartyPresenceEvent& partyPresenceEvent, const ::nakama::realtime::P
   assign(partyPresenceEvent.partyId, data.party_id());
 }
 
+void assignInterned(NUserPresence& presence, const ::nakama::realtime::UserPresence& data) {
+  assign(presence.persistence, data.persistence());
+  presence.sessionIdHandle = NInternedString(data.session_id());
+  assign(presence.status, data.status());
+  presence.usernameHandle = NInternedString(data.username());
+  presence.userIdHandle = NInternedString(data.user_id());
+}
+
+void assignInterned(NChannelMessage& msg, const nakama::api::ChannelMessage& data) {
+  msg.channelIdHandle = NInternedString(data.channel_id());
+  assign(msg.code, data.code());
+  assign(msg.content, data.content());
+  assign(msg.createTime, data.create_time());
+  assign(msg.messageId, data.message_id());
+  assign(msg.persistent, data.persistent());
+  msg.senderIdHandle = NInternedString(data.sender_id());
+  assign(msg.updateTime, data.update_time());
+  msg.usernameHandle = NInternedString(data.username());
+  assign(msg.roomName, data.room_name());
+  assign(msg.groupId, data.group_id());
+  assign(msg.userIdOne, data.user_id_one());
+  assign(msg.userIdTwo, data.user_id_two());
+}
+
+void assignInterned(NChannelPresenceEvent& event, const ::nakama::realtime::ChannelPresenceEvent& data) {
+  assign(event.channelId, data.channel_id());
+  assignInterned(event.joins, data.joins());
+  assignInterned(event.leaves, data.leaves());
+  assign(event.roomName, data.room_name());
+  assign(event.groupId, data.group_id());
+  assign(event.userIdOne, data.user_id_one());
+  assign(event.userIdTwo, data.user_id_two());
+}
+
+void assignInterned(NMatchData& matchData, const ::nakama::realtime::MatchData& data) {
+  matchData.matchIdHandle = NInternedString(data.match_id());
+  assign(matchData.opCode, data.op_code());
+  assignInterned(matchData.presence, data.presence());
+  assign(matchData.data, data.data());
+}
+
+void assignInterned(NMatchPresenceEvent& event, const ::nakama::realtime::MatchPresenceEvent& data) {
+  assign(event.matchId, data.match_id());
+  assignInterned(event.joins, data.joins());
+  assignInterned(event.leaves, data.leaves());
+}
+
+void assignInterned(NStatusPresenceEvent& event, const ::nakama::realtime::StatusPresenceEvent& data) {
+  assignInterned(event.joins, data.joins());
+  assignInterned(event.leaves, data.leaves());
+}
+
+void assignInterned(NStreamData& streamData, const ::nakama::realtime::StreamData& data) {
+  assignInterned(streamData.sender, data.sender());
+  assign(streamData.data, data.data());
+  assign(streamData.stream, data.stream());
+}
+
+void assignInterned(NStreamPresenceEvent& event, const ::nakama::realtime::StreamPresenceEvent& data) {
+  assign(event.stream, data.stream());
+  assignInterned(event.joins, data.joins());
+  assignInterned(event.leaves, data.leaves());
+}
+
+void assignInterned(NPartyData& partyData, const ::nakama::realtime::PartyData& data) {
+  assign(partyData.data, data.data());
+  partyData.opCode = data.op_code();
+  assign(partyData.partyId, data.party_id());
+  assignInterned(partyData.presence, data.presence());
+}
+
+void assignInterned(NPartyPresenceEvent& partyPresenceEvent, const ::nakama::realtime::PartyPresenceEvent& data) {
+  assignInterned(partyPresenceEvent.joins, data.joins());
+  assignInterned(partyPresenceEvent.leaves, data.leaves());
+  assign(partyPresenceEvent.partyId, data.party_id());
+}
+
 } // namespace Nakama
@@ -120,6 +120,18 @@ void assign(NPartyData& partyData, const ::nakama::realtime::PartyData& data);
 void assign(NPartyLeader& partyLeader, const ::nakama::realtime::PartyLeader& data);
 void assign(NPartyPresenceEvent& partyPresenceEvent, const ::nakama::realtime::PartyPresenceEvent& data);
 
+// Variants for realtime messages which set the interned handles instead of the id and name strings.
+void assignInterned(NUserPresence& presence, const ::nakama::realtime::UserPresence& data);
+void assignInterned(NChannelMessage& msg, const nakama::api::ChannelMessage& data);
+void assignInterned(NChannelPresenceEvent& event, const ::nakama::realtime::ChannelPresenceEvent& data);
+void assignInterned(NMatchData& matchData, const ::nakama::realtime::MatchData& data);
+void assignInterned(NMatchPresenceEvent& event, const ::nakama::realtime::MatchPresenceEvent& data);
+void assignInterned(NStatusPresenceEvent& event, const ::nakama::realtime::StatusPresenceEvent& data);
+void assignInterned(NStreamData& streamData, const ::nakama::realtime::StreamData& data);
+void assignInterned(NStreamPresenceEvent& event, const ::nakama::realtime::StreamPresenceEvent& data);
+void assignInterned(NPartyData& partyData, const ::nakama::realtime::PartyData& data);
+void assignInterned(NPartyPresenceEvent& partyPresenceEvent, const ::nakama::realtime::PartyPresenceEvent& data);
+
 template <class T> void assign(T& b, const T& data) { b = data; }
 
 template <class T, class B> void assign(T& b, const ::google::protobuf::RepeatedPtrField<B>& data) {
@@ -131,6 +143,16 @@ template <class T, class B> void assign(T& b, const ::google::protobuf::Repeated
   }
 }
 
+template <class T, class B>
+void assignInterned(std::vector<T>& b, const ::google::protobuf::RepeatedPtrField<B>& data) {
+  b.resize(data.size());
+
+  size_t i = 0;
+  for (auto& item : data) {
+    assignInterned(b[i++], item);
+  }
+}
+
 template <class A, class B> void assign(std::map<A, B>& b, const ::google::protobuf::Map<A, B>& data) {
   b.clear();
 
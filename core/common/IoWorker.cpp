@@ -0,0 +1,114 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "IoWorker.h"
+#include "nakama-cpp/log/NLogger.h"
+
+#undef NMODULE_NAME
+#define NMODULE_NAME "Nakama::IoWorker"
+
+namespace Nakama {
+
+IoWorker::~IoWorker() { stop(); }
+
+void IoWorker::start(std::function<void()> pump, NExecutorPtr callbackExecutor, std::chrono::milliseconds interval) {
+  if (_state->running) {
+    NLOG_WARN("I/O thread is already running");
+    return;
+  }
+
+  _executor = std::move(callbackExecutor);
+  // a thread detached by an earlier stop() may still hold the previous state
+  _state = std::make_shared<ThreadState>();
+  _state->running = true;
+  _thread = std::thread(&IoWorker::threadFunc, _state, std::move(pump), interval);
+}
+
+void IoWorker::stop() {
+  if (!_state->running) {
+    return;
+  }
+
+  _state->running = false;
+  wakeUp();
+
+  if (isIoThread()) {
+    // stop() called from a callback executed inline on the I/O thread, can't join ourselves. The thread only
+    // touches its state once the pump returns, this worker may be gone by then.
+    _thread.detach();
+  } else if (_thread.joinable()) {
+    _thread.join();
+  }
+
+  _executor.reset();
+}
+
+void IoWorker::wakeUp() {
+  {
+    std::lock_guard<std::mutex> lock(_state->wakeMutex);
+    _state->wakeRequested = true;
+  }
+  _state->wakeCv.notify_one();
+}
+
+void IoWorker::dispatch(std::function<void()> callback, TickPriority priority) {
+  if (!callback) {
+    return;
+  }
+
+  if (!_state->running) {
+    callback();
+  } else if (_executor) {
+    _executor->post(std::move(callback));
+  } else {
+    _queue.push(priority, std::move(callback));
+  }
+}
+
+void IoWorker::runOrDefer(TickPriority priority, std::function<void()> task) {
+  if (_pumping) {
+    _queue.push(priority, std::move(task));
+  } else {
+    task();
+  }
+}
+
+void IoWorker::tick(const std::function<void()>& pump, std::chrono::microseconds budget) {
+  if (!_state->running) {
+    _pumping = true;
+    pump();
+    _pumping = false;
+  }
+
+  _queue.drain(budget);
+}
+
+void IoWorker::threadFunc(
+    std::shared_ptr<ThreadState> state, std::function<void()> pump, std::chrono::milliseconds interval) {
+  NLOG_DEBUG("I/O thread started");
+
+  while (state->running) {
+    pump();
+
+    std::unique_lock<std::mutex> lock(state->wakeMutex);
+    state->wakeCv.wait_for(lock, interval, [&state]() { return state->wakeRequested || !state->running; });
+    state->wakeRequested = false;
+  }
+
+  NLOG_DEBUG("I/O thread stopped");
+}
+
+} // namespace Nakama
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "TickQueue.h"
+#include "nakama-cpp/NExecutor.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace Nakama {
+
+/**
+ * Pumps a client's transport on a dedicated thread and routes user callbacks to an executor.
+ *
+ * While the worker is stopped the client is pumped from `tick`: transport callbacks fired during
+ * the pump are deferred to the tick queue, so that they can be drained within a time budget, and
+ * `dispatch` runs user callbacks inline. `start` and `stop` must be called from the thread owning the client.
+ */
+class IoWorker {
+public:
+  ~IoWorker();
+
+  /**
+   * @param pump Called repeatedly from the I/O thread.
+   * @param callbackExecutor Where callbacks go. If nullptr, they are queued until `tick` is called.
+   * @param interval Sleep between pumps.
+   */
+  void start(std::function<void()> pump, NExecutorPtr callbackExecutor, std::chrono::milliseconds interval);
+  void stop();
+
+  bool isRunning() const { return _state->running; }
+  bool isIoThread() const { return std::this_thread::get_id() == _thread.get_id(); }
+
+  // Wakes the I/O thread up before interval expires, e.g. when new request has been queued.
+  void wakeUp();
+
+  void dispatch(std::function<void()> callback, TickPriority priority = TickPriority::Normal);
+
+  // Runs `task` right away, unless we are inside tick()'s transport pump, in which case
+  // it is queued and executed by the same tick() within its budget, or by the following ones.
+  void runOrDefer(TickPriority priority, std::function<void()> task);
+
+  // Pumps transport if I/O thread isn't running, then drains tick queue within budget.
+  void tick(const std::function<void()>& pump, std::chrono::microseconds budget);
+
+  NTickStats getTickStats() const { return _queue.getStats(); }
+
+private:
+  // What the I/O thread uses besides the pump. It's shared with the thread, which outlives the worker if it is
+  // stopped from the I/O thread, e.g. by a callback destroying the client.
+  struct ThreadState {
+    std::atomic<bool> running{false};
+    std::mutex wakeMutex;
+    std::condition_variable wakeCv;
+    bool wakeRequested = false;
+  };
+
+  static void threadFunc(
+      std::shared_ptr<ThreadState> state, std::function<void()> pump, std::chrono::milliseconds interval);
+
+  std::thread _thread;
+  std::shared_ptr<ThreadState> _state = std::make_shared<ThreadState>();
+  std::atomic<bool> _pumping{false};
+  NExecutorPtr _executor;
+  TickQueue _queue;
+};
+
+} // namespace Nakama
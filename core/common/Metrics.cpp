@@ -0,0 +1,259 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Metrics.h"
+
+namespace Nakama {
+
+void AtomicHistogram::record(uint64_t valueUs) {
+  _buckets[NLatencyHistogram::bucketIndex(valueUs)].fetch_add(1, std::memory_order_relaxed);
+  _count.fetch_add(1, std::memory_order_relaxed);
+  _sum.fetch_add(valueUs, std::memory_order_relaxed);
+
+  uint64_t current = _min.load(std::memory_order_relaxed);
+  while (valueUs < current && !_min.compare_exchange_weak(current, valueUs, std::memory_order_relaxed)) {
+  }
+
+  current = _max.load(std::memory_order_relaxed);
+  while (valueUs > current && !_max.compare_exchange_weak(current, valueUs, std::memory_order_relaxed)) {
+  }
+}
+
+NLatencyHistogram AtomicHistogram::snapshot() const {
+  NLatencyHistogram result;
+  result.count = _count.load(std::memory_order_relaxed);
+
+  if (result.count == 0) {
+    return result;
+  }
+
+  result.buckets.resize(_buckets.size());
+  for (size_t i = 0; i < _buckets.size(); ++i) {
+    result.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+  }
+
+  // drop empty tail to keep snapshots small
+  while (!result.buckets.empty() && result.buckets.back() == 0) {
+    result.buckets.pop_back();
+  }
+
+  result.sumUs = _sum.load(std::memory_order_relaxed);
+  result.minUs = _min.load(std::memory_order_relaxed);
+  result.maxUs = _max.load(std::memory_order_relaxed);
+  return result;
+}
+
+void AtomicHistogram::reset() {
+  for (auto& bucket : _buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  _count.store(0, std::memory_order_relaxed);
+  _sum.store(0, std::memory_order_relaxed);
+  _min.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  _max.store(0, std::memory_order_relaxed);
+}
+
+NEndpointMetrics EndpointRecorder::snapshot() const {
+  NEndpointMetrics result;
+  result.requests = requests.load(std::memory_order_relaxed);
+  result.errors = errors.load(std::memory_order_relaxed);
+  result.errorsByCode = errorsByCode.snapshot();
+  result.bytesSent = bytesSent.load(std::memory_order_relaxed);
+  result.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+  result.network = network.snapshot();
+  result.queueWait = queueWait.snapshot();
+  result.decode = decode.snapshot();
+  result.callback = callback.snapshot();
+  return result;
+}
+
+void EndpointRecorder::reset() {
+  requests.store(0, std::memory_order_relaxed);
+  errors.store(0, std::memory_order_relaxed);
+  errorsByCode.reset();
+  bytesSent.store(0, std::memory_order_relaxed);
+  bytesReceived.store(0, std::memory_order_relaxed);
+  network.reset();
+  queueWait.reset();
+  decode.reset();
+  callback.reset();
+}
+
+namespace {
+const char* methodName(NHttpReqMethod method) {
+  switch (method) {
+    case NHttpReqMethod::GET:
+      return "GET";
+    case NHttpReqMethod::POST:
+      return "POST";
+    case NHttpReqMethod::PUT:
+      return "PUT";
+    case NHttpReqMethod::DEL:
+      return "DELETE";
+  }
+  return "UNKNOWN";
+}
+
+// path segments which are followed by an id
+bool isIdPrefix(const std::string& segment) {
+  static const char* const prefixes[] = {"group", "leaderboard", "tournament", "channel", "user", "owner", "storage"};
+  for (const char* prefix : prefixes) {
+    if (segment == prefix) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+std::string RestMetrics::endpointName(NHttpReqMethod method, const std::string& path) {
+  std::string name = methodName(method);
+  name.reserve(name.size() + 1 + path.size());
+  name.push_back(' ');
+
+  std::string previous;
+  size_t pos = 0;
+
+  while (pos < path.size()) {
+    size_t end = path.find('/', pos);
+    if (end == std::string::npos) {
+      end = path.size();
+    }
+
+    std::string segment = path.substr(pos, end - pos);
+    bool isId = !segment.empty() && isIdPrefix(previous) && !(previous == "storage" && segment == "delete");
+    name.append(isId ? "{id}" : segment);
+
+    if (end < path.size()) {
+      name.push_back('/');
+    }
+
+    previous = std::move(segment);
+    pos = end + 1;
+  }
+
+  return name;
+}
+
+std::shared_ptr<EndpointRecorder> RestMetrics::endpoint(NHttpReqMethod method, const std::string& path) {
+  std::string name = endpointName(method, path);
+  std::lock_guard<std::mutex> lock(_mutex);
+  auto& recorder = _endpoints[name];
+  if (!recorder) {
+    recorder = std::make_shared<EndpointRecorder>();
+    recorder->name = name;
+  }
+  return recorder;
+}
+
+NClientMetrics RestMetrics::snapshot() const {
+  NClientMetrics result;
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  for (const auto& entry : _endpoints) {
+    NEndpointMetrics endpoint = entry.second->snapshot();
+    if (endpoint.requests == 0 && endpoint.errors == 0) {
+      continue;
+    }
+
+    result.requests += endpoint.requests;
+    result.errors += endpoint.errors;
+    result.bytesSent += endpoint.bytesSent;
+    result.bytesReceived += endpoint.bytesReceived;
+    result.endpoints.emplace(entry.first, std::move(endpoint));
+  }
+
+  return result;
+}
+
+void RestMetrics::reset() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (auto& entry : _endpoints) {
+    entry.second->reset();
+  }
+}
+
+size_t RtMetrics::typeIndex(int messageType) {
+  return messageType > 0 && static_cast<size_t>(messageType) < kMaxMessageTypes ? static_cast<size_t>(messageType) : 0;
+}
+
+void RtMetrics::recordSent(int messageType, size_t bytes) {
+  addRelaxed(_sent[typeIndex(messageType)], 1);
+  addRelaxed(_bytesSent, bytes);
+}
+
+void RtMetrics::recordReceived(int messageType) { addRelaxed(_received[typeIndex(messageType)], 1); }
+
+void RtMetrics::recordConnect() {
+  if (_connects.fetch_add(1, std::memory_order_relaxed) > 0) {
+    addRelaxed(_reconnects, 1);
+  }
+}
+
+std::map<std::string, uint64_t>
+RtMetrics::snapshot(const TypeCounters& counters, const std::function<std::string(int)>& typeName) {
+  std::map<std::string, uint64_t> result;
+  for (size_t i = 0; i < counters.size(); ++i) {
+    uint64_t count = counters[i].load(std::memory_order_relaxed);
+    if (count > 0) {
+      std::string name = i > 0 ? typeName(static_cast<int>(i)) : std::string();
+      result[name.empty() ? "unknown" : name] += count;
+    }
+  }
+  return result;
+}
+
+NRtClientMetrics RtMetrics::snapshot(const std::function<std::string(int)>& typeName) const {
+  NRtClientMetrics result;
+  result.messagesSent = snapshot(_sent, typeName);
+  result.messagesReceived = snapshot(_received, typeName);
+  result.messagesSkipped = snapshot(_skipped, typeName);
+  result.errorsByCode = _errorsByCode.snapshot();
+  result.bytesSent = _bytesSent.load(std::memory_order_relaxed);
+  result.bytesReceived = _bytesReceived.load(std::memory_order_relaxed);
+  result.connects = _connects.load(std::memory_order_relaxed);
+  result.disconnects = _disconnects.load(std::memory_order_relaxed);
+  result.reconnects = _reconnects.load(std::memory_order_relaxed);
+  result.requestRtt = requestRtt.snapshot();
+  result.queueWait = queueWait.snapshot();
+  result.decode = decode.snapshot();
+  result.callback = callback.snapshot();
+  return result;
+}
+
+void RtMetrics::reset() {
+  for (auto& counter : _sent) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  for (auto& counter : _received) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  for (auto& counter : _skipped) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+  _errorsByCode.reset();
+  _bytesSent.store(0, std::memory_order_relaxed);
+  _bytesReceived.store(0, std::memory_order_relaxed);
+  _connects.store(0, std::memory_order_relaxed);
+  _disconnects.store(0, std::memory_order_relaxed);
+  _reconnects.store(0, std::memory_order_relaxed);
+  requestRtt.reset();
+  queueWait.reset();
+  decode.reset();
+  callback.reset();
+}
+
+} // namespace Nakama
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "nakama-cpp/NClientMetrics.h"
+#include "nakama-cpp/NHttpTransportInterface.h"
+#include "nakama-cpp/NLatencyHistogram.h"
+#include "nakama-cpp/realtime/NRtClientMetrics.h"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace Nakama {
+
+using MetricsClock = std::chrono::steady_clock;
+
+inline uint64_t elapsedUs(MetricsClock::time_point from, MetricsClock::time_point to) {
+  return to > from ? std::chrono::duration_cast<std::chrono::microseconds>(to - from).count() : 0;
+}
+
+/**
+ * Latency histogram which can be recorded into from any thread without locking.
+ * All operations are relaxed: a snapshot taken concurrently with recording may be off by the in-flight samples.
+ */
+class AtomicHistogram {
+public:
+  void record(uint64_t valueUs);
+  void record(MetricsClock::time_point from, MetricsClock::time_point to) { record(elapsedUs(from, to)); }
+
+  NLatencyHistogram snapshot() const;
+  void reset();
+
+private:
+  std::array<std::atomic<uint64_t>, NLatencyHistogram::kBucketCount> _buckets{};
+  std::atomic<uint64_t> _count{0};
+  std::atomic<uint64_t> _sum{0};
+  std::atomic<uint64_t> _min{std::numeric_limits<uint64_t>::max()};
+  std::atomic<uint64_t> _max{0};
+};
+
+/**
+ * Lock-free counters for a contiguous range of error codes [MinCode, MaxCode].
+ * Codes outside of the range are counted as `Fallback`.
+ */
+template <typename Code, int MinCode, int MaxCode, Code Fallback>
+class CodeCounters {
+public:
+  void increment(Code code) {
+    int value = static_cast<int>(code);
+    size_t index = value >= MinCode && value <= MaxCode ? static_cast<size_t>(value - MinCode) : kFallbackIndex;
+    _counters[index].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  std::map<Code, uint64_t> snapshot() const {
+    std::map<Code, uint64_t> result;
+    for (size_t i = 0; i < _counters.size(); ++i) {
+      uint64_t count = _counters[i].load(std::memory_order_relaxed);
+      if (count > 0) {
+        Code code = i == kFallbackIndex ? Fallback : static_cast<Code>(static_cast<int>(i) + MinCode);
+        result[code] += count;
+      }
+    }
+    return result;
+  }
+
+  void reset() {
+    for (auto& counter : _counters) {
+      counter.store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  static constexpr size_t kFallbackIndex = MaxCode - MinCode + 1;
+  std::array<std::atomic<uint64_t>, kFallbackIndex + 1> _counters{};
+};
+
+inline void addRelaxed(std::atomic<uint64_t>& counter, uint64_t value) {
+  counter.fetch_add(value, std::memory_order_relaxed);
+}
+
+/// Recorder for a single REST endpoint.
+struct EndpointRecorder {
+  std::string name;
+  std::atomic<uint64_t> requests{0};
+  std::atomic<uint64_t> errors{0};
+  CodeCounters<ErrorCode, -3, 5, ErrorCode::Unknown> errorsByCode;
+  std::atomic<uint64_t> bytesSent{0};
+  std::atomic<uint64_t> bytesReceived{0};
+  AtomicHistogram network;
+  AtomicHistogram queueWait;
+  AtomicHistogram decode;
+  AtomicHistogram callback;
+
+  void recordError(ErrorCode code) {
+    addRelaxed(errors, 1);
+    errorsByCode.increment(code);
+  }
+
+  NEndpointMetrics snapshot() const;
+  void reset();
+};
+
+/**
+ * Per-endpoint metrics of a REST client.
+ *
+ * Endpoint lookup takes a lock once per request, everything recorded afterwards goes through
+ * the returned recorder's atomics.
+ */
+class RestMetrics {
+public:
+  // Ids in path are replaced with "{id}" so that the number of endpoints stays bounded.
+  static std::string endpointName(NHttpReqMethod method, const std::string& path);
+
+  // Shared, so that callbacks outliving the client can still record into it.
+  std::shared_ptr<EndpointRecorder> endpoint(NHttpReqMethod method, const std::string& path);
+
+  NClientMetrics snapshot() const;
+
+  // Zeroes all counters. Recorders aren't freed, requests in flight may still hold them.
+  void reset();
+
+private:
+  mutable std::mutex _mutex;
+  std::map<std::string, std::shared_ptr<EndpointRecorder>> _endpoints;
+};
+
+/**
+ * Metrics of a realtime client. Message types are counted by their envelope field number.
+ */
+class RtMetrics {
+public:
+  // Field numbers above this are counted as 0, i.e. unknown.
+  static constexpr size_t kMaxMessageTypes = 128;
+
+  void recordSent(int messageType, size_t bytes);
+  void recordReceived(int messageType);
+  void recordSkipped(int messageType) { addRelaxed(_skipped[typeIndex(messageType)], 1); }
+  void recordReceivedBytes(size_t bytes) { addRelaxed(_bytesReceived, bytes); }
+  void recordError(RtErrorCode code) { _errorsByCode.increment(code); }
+  void recordConnect();
+  void recordDisconnect() { addRelaxed(_disconnects, 1); }
+
+  // @param typeName Maps envelope field number to its name.
+  NRtClientMetrics snapshot(const std::function<std::string(int)>& typeName) const;
+  void reset();
+
+  AtomicHistogram requestRtt;
+  AtomicHistogram queueWait;
+  AtomicHistogram decode;
+  AtomicHistogram callback;
+
+private:
+  using TypeCounters = std::array<std::atomic<uint64_t>, kMaxMessageTypes>;
+
+  static size_t typeIndex(int messageType);
+  static std::map<std::string, uint64_t>
+  snapshot(const TypeCounters& counters, const std::function<std::string(int)>& typeName);
+
+  TypeCounters _sent{};
+  TypeCounters _received{};
+  TypeCounters _skipped{};
+  CodeCounters<RtErrorCode, -4, 7, RtErrorCode::UNKNOWN> _errorsByCode;
+  std::atomic<uint64_t> _bytesSent{0};
+  std::atomic<uint64_t> _bytesReceived{0};
+  std::atomic<uint64_t> _connects{0};
+  std::atomic<uint64_t> _disconnects{0};
+  std::atomic<uint64_t> _reconnects{0};
+};
+
+} // namespace Nakama
@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+namespace Nakama {
+
+/**
+ * Lock-free multi-producer, single-consumer queue.
+ *
+ * Producers push onto an intrusive stack with a CAS. The consumer takes the whole stack with one exchange
+ * and reverses it, so items come out in push order. There is no pop of a single item, hence no ABA problem.
+ */
+template <typename T> class MpscQueue {
+public:
+  MpscQueue() = default;
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  ~MpscQueue() {
+    drain([](T&&) {});
+  }
+
+  void push(T value) {
+    Node* node = new Node{std::move(value), _head.load(std::memory_order_relaxed)};
+    while (!_head.compare_exchange_weak(node->next, node, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+  }
+
+  // Calls `consume` for every item pushed so far, oldest first. Must be called from a single thread.
+  template <typename F> size_t drain(F&& consume) {
+    Node* node = _head.exchange(nullptr, std::memory_order_acquire);
+    Node* reversed = nullptr;
+
+    while (node) {
+      Node* next = node->next;
+      node->next = reversed;
+      reversed = node;
+      node = next;
+    }
+
+    size_t count = 0;
+    while (reversed) {
+      Node* next = reversed->next;
+      consume(std::move(reversed->value));
+      delete reversed;
+      reversed = next;
+      ++count;
+    }
+
+    return count;
+  }
+
+  bool empty() const { return _head.load(std::memory_order_relaxed) == nullptr; }
+
+private:
+  struct Node {
+    T value;
+    Node* next;
+  };
+
+  std::atomic<Node*> _head{nullptr};
+};
+
+} // namespace Nakama
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nakama-cpp/NInternedString.h"
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace Nakama {
+
+struct NInternedStringEntry {
+  std::atomic<uint32_t> refs{1};
+  size_t shard;
+  std::string str;
+};
+
+namespace {
+
+// Decoding threads of several clients intern concurrently, shards keep them off each other's lock.
+constexpr size_t kShardCount = 16;
+
+struct Shard {
+  std::mutex mutex;
+  // keys point into the entries
+  std::unordered_map<std::string_view, NInternedStringEntry*> entries;
+};
+
+struct Table {
+  Shard shards[kShardCount];
+  std::atomic<size_t> count{0};
+};
+
+// Never destroyed, handles in static objects may outlive any static table.
+Table& table() {
+  static Table* table = new Table();
+  return *table;
+}
+
+const std::string kEmpty;
+
+} // namespace
+
+NInternedString::NInternedString(std::string_view str) {
+  if (str.empty()) {
+    return;
+  }
+
+  Table& t = table();
+  size_t shardIndex = std::hash<std::string_view>()(str) % kShardCount;
+  Shard& shard = t.shards[shardIndex];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  auto it = shard.entries.find(str);
+  if (it != shard.entries.end()) {
+    // may revive an entry whose last handle is waiting for the lock to delete it, release checks again
+    it->second->refs.fetch_add(1, std::memory_order_relaxed);
+    _entry = it->second;
+    return;
+  }
+
+  _entry = new NInternedStringEntry();
+  _entry->shard = shardIndex;
+  _entry->str.assign(str.data(), str.size());
+  shard.entries.emplace(_entry->str, _entry);
+  t.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+NInternedString::NInternedString(const NInternedString& other) noexcept : _entry(other._entry) {
+  if (_entry) {
+    _entry->refs.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+NInternedString::~NInternedString() {
+  if (!_entry) {
+    return;
+  }
+
+  // Dropping a reference which isn't the last one needs no lock. The last one is dropped under the
+  // shard lock, where the constructor could be handing out a new reference at the same time.
+  uint32_t refs = _entry->refs.load(std::memory_order_relaxed);
+  while (refs > 1) {
+    if (_entry->refs.compare_exchange_weak(refs, refs - 1, std::memory_order_release, std::memory_order_relaxed)) {
+      return;
+    }
+  }
+
+  Table& t = table();
+  Shard& shard = t.shards[_entry->shard];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  if (_entry->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    shard.entries.erase(_entry->str);
+    t.count.fetch_sub(1, std::memory_order_relaxed);
+    delete _entry;
+  }
+}
+
+const std::string& NInternedString::str() const noexcept { return _entry ? _entry->str : kEmpty; }
+
+size_t NInternedString::getInternedCount() noexcept { return table().count.load(std::memory_order_relaxed); }
+
+} // namespace Nakama
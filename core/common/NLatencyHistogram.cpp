@@ -0,0 +1,84 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nakama-cpp/NLatencyHistogram.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Nakama {
+
+namespace {
+constexpr size_t kSubBuckets = size_t(1) << NLatencyHistogram::kSubBucketBits;
+// largest value which still fits into the last bucket, ~38 hours
+constexpr uint64_t kMaxTrackableUs = (uint64_t(1) << (NLatencyHistogram::kBucketCount / kSubBuckets + 2)) - 1;
+
+unsigned mostSignificantBit(uint64_t value) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return static_cast<unsigned>(index);
+#else
+  return 63u - static_cast<unsigned>(__builtin_clzll(value));
+#endif
+}
+} // namespace
+
+size_t NLatencyHistogram::bucketIndex(uint64_t valueUs) {
+  if (valueUs < kSubBuckets) {
+    return static_cast<size_t>(valueUs);
+  }
+
+  valueUs = std::min(valueUs, kMaxTrackableUs);
+  unsigned msb = mostSignificantBit(valueUs);
+  unsigned shift = msb - kSubBucketBits;
+  return (msb - kSubBucketBits + 1) * kSubBuckets + static_cast<size_t>((valueUs >> shift) - kSubBuckets);
+}
+
+uint64_t NLatencyHistogram::bucketUpperBoundUs(size_t index) {
+  if (index < kSubBuckets) {
+    return index;
+  }
+
+  size_t shift = index / kSubBuckets - 1;
+  uint64_t subBucket = index % kSubBuckets + kSubBuckets;
+  return ((subBucket + 1) << shift) - 1;
+}
+
+uint64_t NLatencyHistogram::percentileUs(double percentile) const {
+  if (count == 0 || buckets.empty()) {
+    return 0;
+  }
+
+  percentile = std::clamp(percentile, 0.0, 100.0);
+  auto target = static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(count)));
+  target = std::max<uint64_t>(target, 1);
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); ++i) {
+    seen += buckets[i];
+    if (seen >= target) {
+      return std::min(bucketUpperBoundUs(i), maxUs);
+    }
+  }
+
+  return maxUs;
+}
+
+} // namespace Nakama
@@ -26,6 +26,8 @@ const char* toString(RtErrorCode code) {
       return "TRANSPORT_ERROR";
     case Nakama::RtErrorCode::DISCONNECTED:
       return "DISCONNECTED";
+    case Nakama::RtErrorCode::SEND_QUEUE_FULL:
+      return "SEND_QUEUE_FULL";
     case Nakama::RtErrorCode::RUNTIME_EXCEPTION:
       return "RUNTIME_EXCEPTION";
     case Nakama::RtErrorCode::UNRECOGNIZED_PAYLOAD:
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nakama-cpp/NTrace.h"
+#include "nakama-cpp/log/NLogger.h"
+#include <cstdio>
+
+#undef NMODULE_NAME
+#define NMODULE_NAME "Nakama::NChromeTraceExporter"
+
+namespace Nakama {
+
+NTraceSinkInterface::~NTraceSinkInterface() = default;
+
+namespace {
+void appendJsonString(std::string& out, const std::string& value) {
+  out.push_back('"');
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      case '\r':
+        out.append("\\r");
+        break;
+      case '\t':
+        out.append("\\t");
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          char buf[8];
+          std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+          out.append(buf);
+        } else {
+          out.push_back(c);
+        }
+    }
+  }
+  out.push_back('"');
+}
+} // namespace
+
+NChromeTraceExporter::NChromeTraceExporter(const std::string& path)
+    : _file(path, std::ios::out | std::ios::trunc), _epoch(std::chrono::steady_clock::now()) {
+  if (!_file.is_open()) {
+    NLOG_ERROR("Failed to open trace file: " + path);
+    return;
+  }
+
+  // JSON array format. Viewers accept it without the closing bracket, which is written on destruction.
+  _file << "[\n";
+}
+
+NChromeTraceExporter::~NChromeTraceExporter() {
+  if (_file.is_open()) {
+    _file << "\n]\n";
+  }
+}
+
+void NChromeTraceExporter::onSpan(const NTraceSpan& span) {
+  if (!_file.is_open()) {
+    return;
+  }
+
+  auto ts = std::chrono::duration_cast<std::chrono::microseconds>(span.start - _epoch).count();
+
+  std::string event;
+  event.reserve(192);
+  event.append("{\"name\":");
+  appendJsonString(event, span.name);
+  event.append(",\"cat\":");
+  appendJsonString(event, span.category);
+  event.append(",\"ph\":\"X\",\"pid\":1,\"tid\":").append(std::to_string(span.threadId % 1000000));
+  event.append(",\"ts\":").append(std::to_string(ts));
+  event.append(",\"dur\":").append(std::to_string(span.duration.count()));
+  event.append(",\"args\":{\"traceId\":").append(std::to_string(span.traceId));
+
+  for (const auto& arg : span.args) {
+    event.push_back(',');
+    appendJsonString(event, arg.first);
+    event.push_back(':');
+    appendJsonString(event, arg.second);
+  }
+
+  event.append("}}");
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (!_first) {
+    _file << ",\n";
+  }
+  _first = false;
+  _file << event;
+}
+
+void NChromeTraceExporter::flush() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _file.flush();
+}
+
+} // namespace Nakama
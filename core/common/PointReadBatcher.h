@@ -0,0 +1,152 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "nakama-cpp/NError.h"
+#include "nakama-cpp/NSessionInterface.h"
+
+namespace Nakama {
+
+/**
+ * Collects point reads of the same kind, dataloader style, so that they can be sent as multi-key requests.
+ * Thread safe.
+ *
+ * Reads are grouped per session. A group is due once its oldest read has waited for the window, or it holds
+ * as many keys as fit into one request. Reads of the same key share one slot in the request.
+ */
+template <typename Key, typename Value> class PointReadBatcher {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  struct Reader {
+    std::function<void(const std::optional<Value>&)> onValue;
+    std::function<void(const NError&)> onError;
+  };
+
+  struct Batch {
+    NSessionPtr session;
+    std::map<Key, std::vector<Reader>> readers;
+
+    std::vector<Key> keys() const {
+      std::vector<Key> keys;
+      keys.reserve(readers.size());
+      for (const auto& p : readers) {
+        keys.push_back(p.first);
+      }
+      return keys;
+    }
+
+    // Fans the response out, readers of keys missing from `values` get nullopt.
+    void complete(const std::map<Key, const Value*>& values) const {
+      for (const auto& p : readers) {
+        auto it = values.find(p.first);
+        std::optional<Value> value;
+        if (it != values.end()) {
+          value = *it->second;
+        }
+        for (const Reader& reader : p.second) {
+          if (reader.onValue) {
+            reader.onValue(value);
+          }
+        }
+      }
+    }
+
+    // Returns false if some reader had no error callback.
+    bool fail(const NError& error) const {
+      bool handled = true;
+      for (const auto& p : readers) {
+        for (const Reader& reader : p.second) {
+          if (reader.onError) {
+            reader.onError(error);
+          } else {
+            handled = false;
+          }
+        }
+      }
+      return handled;
+    }
+  };
+
+  void configure(std::chrono::milliseconds window, size_t maxKeys) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _window = window;
+    _maxKeys = std::max<size_t>(maxKeys, 1);
+  }
+
+  void add(NSessionPtr session, const Key& key, Reader reader) {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto group = std::find_if(_groups.begin(), _groups.end(), [&](const Group& g) { return g.session == session; });
+    if (group == _groups.end()) {
+      _groups.push_back(Group{std::move(session), Clock::now(), {}});
+      group = _groups.end() - 1;
+    }
+
+    group->readers[key].push_back(std::move(reader));
+  }
+
+  // Moves up to one request worth of due reads into `batch`.
+  bool takeBatch(Batch& batch) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Clock::time_point now = Clock::now();
+
+    for (auto group = _groups.begin(); group != _groups.end(); ++group) {
+      if (group->readers.size() < _maxKeys && now - group->firstReadAt < _window) {
+        continue;
+      }
+
+      batch.session = group->session;
+      batch.readers.clear();
+
+      while (!group->readers.empty() && batch.readers.size() < _maxKeys) {
+        auto it = group->readers.begin();
+        batch.readers.emplace(it->first, std::move(it->second));
+        group->readers.erase(it);
+      }
+
+      if (group->readers.empty()) {
+        _groups.erase(group);
+      }
+      return true;
+    }
+
+    return false;
+  }
+
+private:
+  struct Group {
+    NSessionPtr session;
+    Clock::time_point firstReadAt;
+    std::map<Key, std::vector<Reader>> readers;
+  };
+
+  std::mutex _mutex;
+  std::chrono::milliseconds _window{0};
+  size_t _maxKeys = 100;
+  std::vector<Group> _groups;
+};
+
+} // namespace Nakama
@@ -0,0 +1,106 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RestResponse.h"
+
+#include <exception>
+#include <string>
+
+#include <rapidjson/document.h>
+
+#include "grpc_status_code_enum.h"
+#include "nakama-cpp/log/NLogger.h"
+
+#undef NMODULE_NAME
+#define NMODULE_NAME "Nakama::RestResponse"
+
+namespace Nakama {
+
+ErrorCode grpcStatusToErrorCode(int status, bool& known) {
+  known = true;
+  switch (status) {
+    case grpc::StatusCode::UNAVAILABLE:
+      return ErrorCode::ConnectionError;
+    case grpc::StatusCode::INTERNAL:
+      return ErrorCode::InternalError;
+    case grpc::StatusCode::NOT_FOUND:
+      return ErrorCode::NotFound;
+    case grpc::StatusCode::ALREADY_EXISTS:
+      return ErrorCode::AlreadyExists;
+    case grpc::StatusCode::INVALID_ARGUMENT:
+      return ErrorCode::InvalidArgument;
+    case grpc::StatusCode::UNAUTHENTICATED:
+      return ErrorCode::Unauthenticated;
+    case grpc::StatusCode::PERMISSION_DENIED:
+      return ErrorCode::PermissionDenied;
+    default:
+      known = false;
+      return ErrorCode::Unknown;
+  }
+}
+
+NError responseToError(const NHttpResponse& response) {
+  std::string errMessage;
+  ErrorCode code = ErrorCode::Unknown;
+
+  if (response.statusCode == InternalStatusCodes::CONNECTION_ERROR) {
+    code = ErrorCode::ConnectionError;
+    errMessage.append("message: ").append(response.errorMessage);
+  } else if (response.statusCode == InternalStatusCodes::CANCELLED_BY_USER) {
+    code = ErrorCode::CancelledByUser;
+    errMessage.append("message: ").append(response.errorMessage);
+  } else if (response.statusCode == InternalStatusCodes::INTERNAL_TRANSPORT_ERROR) {
+    code = ErrorCode::InternalError;
+    errMessage.append("message: ").append(response.errorMessage);
+  } else if (!response.body.empty() && response.body[0] == '{') { // have to be JSON
+    try {
+      rapidjson::Document document;
+
+      if (document.Parse(response.body.data(), response.body.size()).HasParseError() || !document.IsObject()) {
+        errMessage = "Parse JSON failed: " + response.body;
+        code = ErrorCode::InternalError;
+      } else {
+        auto jsonMessage = document.FindMember("message");
+        auto jsonCode = document.FindMember("code");
+
+        if (jsonMessage != document.MemberEnd() && jsonMessage->value.IsString()) {
+          errMessage.append("message: ").append(jsonMessage->value.GetString());
+        }
+
+        if (jsonCode != document.MemberEnd() && jsonCode->value.IsInt()) {
+          int serverErrCode = jsonCode->value.GetInt();
+          bool known = false;
+          code = grpcStatusToErrorCode(serverErrCode, known);
+          if (!known) {
+            errMessage.append("\ncode: ").append(std::to_string(serverErrCode));
+          }
+        }
+      }
+    } catch (std::exception& e) {
+      NLOG_ERROR("exception: " + std::string(e.what()));
+    }
+  }
+
+  if (errMessage.empty()) {
+    errMessage.append("message: ").append(response.errorMessage);
+    errMessage.append("\nHTTP status: ").append(std::to_string(response.statusCode));
+    errMessage.append("\nbody: ").append(response.body);
+  }
+
+  return NError(std::move(errMessage), code);
+}
+
+} // namespace Nakama
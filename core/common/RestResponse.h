@@ -0,0 +1,36 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "nakama-cpp/NError.h"
+#include "nakama-cpp/NHttpTransportInterface.h"
+
+namespace Nakama {
+
+// Response handling shared by the Nakama and Satori clients.
+
+// Maps a grpc status code, as returned by the gRPC API or the gateway, to ErrorCode.
+// `known` is set to false for codes without a dedicated ErrorCode, these map to ErrorCode::Unknown.
+ErrorCode grpcStatusToErrorCode(int status, bool& known);
+
+inline bool isResponseOk(const NHttpResponse& response) { return response.statusCode == 200; }
+
+// Error of a failed response: transport failures are mapped from internal status codes, server errors from
+// the gateway's `{"code": <grpc status>, "message": ...}` body.
+NError responseToError(const NHttpResponse& response);
+
+} // namespace Nakama
@@ -0,0 +1,268 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SendQueue.h"
+
+#include <algorithm>
+
+namespace Nakama {
+
+namespace {
+
+// weight of the newest sample in the moving average of the queueing delay
+constexpr int64_t kDelayAverageWeight = 16;
+
+// of the whole queue and of a lane
+template <class Stats> void recordDelay(Stats& stats, std::chrono::microseconds delay) {
+  stats.lastQueueDelay = delay;
+  stats.maxQueueDelay = std::max(stats.maxQueueDelay, delay);
+  stats.averageQueueDelay += (delay - stats.averageQueueDelay) / kDelayAverageWeight;
+}
+
+} // namespace
+
+void SendQueue::configure(const NSendQueueConfig& config) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _config = config;
+  _config.lowWatermarkBytes = std::min(_config.lowWatermarkBytes, _config.highWatermarkBytes);
+  _config.lowWatermarkMessages = std::min(_config.lowWatermarkMessages, _config.highWatermarkMessages);
+  updateWritable();
+  _drained.notify_all();
+}
+
+bool SendQueue::fits(size_t bytes, const Entry* replaced) const {
+  size_t queuedMessages = _queuedMessages + _inFlightMessages;
+  size_t queuedBytes = _queuedBytes + _inFlightBytes;
+  if (replaced) {
+    --queuedMessages;
+    queuedBytes -= replaced->data.size();
+  }
+  if (queuedMessages == 0) {
+    return true;
+  }
+
+  bool bytesFit = _config.highWatermarkBytes == 0 || queuedBytes + bytes <= _config.highWatermarkBytes;
+  bool messagesFit = _config.highWatermarkMessages == 0 || queuedMessages + 1 <= _config.highWatermarkMessages;
+  return bytesFit && messagesFit;
+}
+
+bool SendQueue::atCapacity() const {
+  return (_config.highWatermarkBytes != 0 && _queuedBytes + _inFlightBytes >= _config.highWatermarkBytes) ||
+         (_config.highWatermarkMessages != 0 && _queuedMessages + _inFlightMessages >= _config.highWatermarkMessages);
+}
+
+SendQueue::Entry* SendQueue::superseded(const std::optional<NSendDropKey>& dropKey, NSendPriority priority) {
+  if (priority != NSendPriority::Latest || !dropKey) {
+    return nullptr;
+  }
+  for (Entry& entry : _lanes[size_t(NSendPriority::Latest)]) {
+    if (entry.dropKey == dropKey) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+bool SendQueue::dropFor(const NSendDropKey& dropKey, size_t bytes) {
+  // nothing is dropped unless dropping makes enough room
+  size_t droppableBytes = 0;
+  size_t droppableMessages = 0;
+  for (const std::deque<Entry>& lane : _lanes) {
+    for (const Entry& entry : lane) {
+      if (entry.dropKey == dropKey) {
+        droppableBytes += entry.data.size();
+        ++droppableMessages;
+      }
+    }
+  }
+
+  size_t remainingMessages = _queuedMessages + _inFlightMessages - droppableMessages;
+  size_t remainingBytes = _queuedBytes + _inFlightBytes - droppableBytes;
+  if (remainingMessages != 0 &&
+      ((_config.highWatermarkBytes != 0 && remainingBytes + bytes > _config.highWatermarkBytes) ||
+       (_config.highWatermarkMessages != 0 && remainingMessages + 1 > _config.highWatermarkMessages))) {
+    return false;
+  }
+
+  for (size_t i = 0; i < kLanes; ++i) {
+    std::deque<Entry>& lane = _lanes[i];
+    for (auto it = lane.begin(); it != lane.end() && !fits(bytes);) {
+      if (it->dropKey == dropKey) {
+        _queuedBytes -= it->data.size();
+        _stats.lane(NSendPriority(i)).queuedBytes -= it->data.size();
+        --_queuedMessages;
+        ++_stats.droppedMessages;
+        it = lane.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  return true;
+}
+
+NSendResult SendQueue::push(NBytes data, const std::optional<NSendDropKey>& dropKey, NSendPriority priority) {
+  std::unique_lock<std::mutex> lock(_mutex);
+  size_t bytes = data.size();
+
+  // newer state takes the place of queued state, which needs room for the difference in size only
+  Entry* replaced = superseded(dropKey, priority);
+  if (!fits(bytes, replaced)) {
+    _full = true;
+    _stats.writable = false;
+
+    bool made = false;
+    if (_config.overflowPolicy == NSendOverflowPolicy::DropOldest && dropKey) {
+      made = dropFor(*dropKey, bytes);
+    } else if (_config.overflowPolicy == NSendOverflowPolicy::Block) {
+      ++_stats.blockedSends;
+      uint64_t generation = _generation;
+      // the replaced message may be written while this waits
+      made = _drained.wait_for(lock, std::chrono::milliseconds(_config.blockTimeoutMs), [&] {
+        return generation != _generation || fits(bytes, superseded(dropKey, priority));
+      });
+      if (generation != _generation) {
+        return NSendResult::Failed;
+      }
+    }
+
+    if (!made) {
+      ++_stats.rejectedMessages;
+      return NSendResult::Rejected;
+    }
+    replaced = superseded(dropKey, priority);
+  }
+
+  if (replaced) {
+    _queuedBytes = _queuedBytes - replaced->data.size() + bytes;
+    _stats.latest.queuedBytes = _stats.latest.queuedBytes - replaced->data.size() + bytes;
+    ++_stats.latest.supersededMessages;
+    replaced->data = std::move(data);
+    replaced->queuedAt = Clock::now();
+  } else {
+    _lanes[size_t(priority)].push_back({std::move(data), dropKey, Clock::now()});
+    ++_queuedMessages;
+    _queuedBytes += bytes;
+    _stats.lane(priority).queuedBytes += bytes;
+  }
+  _stats.peakQueuedBytes = std::max(_stats.peakQueuedBytes, _queuedBytes + _inFlightBytes);
+
+  // a queue which filled up to capacity waits for the low watermarks as well
+  if (atCapacity()) {
+    _full = true;
+    _stats.writable = false;
+  }
+  return NSendResult::Queued;
+}
+
+bool SendQueue::pop(NBytes& data, NSendPriority lowest) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  size_t i = 0;
+  while (i <= size_t(lowest) && _lanes[i].empty()) {
+    ++i;
+  }
+  if (i > size_t(lowest)) {
+    return false;
+  }
+
+  std::deque<Entry>& lane = _lanes[i];
+  NSendLaneStats& laneStats = _stats.lane(NSendPriority(i));
+  Entry& entry = lane.front();
+  auto delay = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - entry.queuedAt);
+  recordDelay(_stats, delay);
+  recordDelay(laneStats, delay);
+  ++laneStats.sentMessages;
+
+  _queuedBytes -= entry.data.size();
+  laneStats.queuedBytes -= entry.data.size();
+  --_queuedMessages;
+  data = std::move(entry.data);
+  lane.pop_front();
+
+  updateWritable();
+  _drained.notify_all();
+  return true;
+}
+
+bool SendQueue::empty() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _queuedMessages == 0;
+}
+
+void SendQueue::setInFlight(size_t bytes, size_t messages) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (bytes == _inFlightBytes && messages == _inFlightMessages) {
+    return;
+  }
+  _inFlightBytes = bytes;
+  _inFlightMessages = messages;
+  _stats.peakQueuedBytes = std::max(_stats.peakQueuedBytes, _queuedBytes + _inFlightBytes);
+
+  updateWritable();
+  _drained.notify_all();
+}
+
+void SendQueue::updateWritable() {
+  if (!_full) {
+    return;
+  }
+
+  bool bytesLow = _config.highWatermarkBytes == 0 || _queuedBytes + _inFlightBytes <= _config.lowWatermarkBytes;
+  bool messagesLow = _config.highWatermarkMessages == 0 ||
+                     _queuedMessages + _inFlightMessages <= _config.lowWatermarkMessages;
+  if (bytesLow && messagesLow) {
+    _full = false;
+    _writablePending = true;
+    _stats.writable = true;
+  }
+}
+
+bool SendQueue::takeWritable() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  bool writable = _writablePending;
+  _writablePending = false;
+  return writable;
+}
+
+void SendQueue::clear() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  for (size_t i = 0; i < kLanes; ++i) {
+    _lanes[i].clear();
+    _stats.lane(NSendPriority(i)).queuedBytes = 0;
+  }
+  _queuedMessages = 0;
+  _queuedBytes = 0;
+  _inFlightBytes = 0;
+  _inFlightMessages = 0;
+  _full = false;
+  _writablePending = false;
+  _stats.writable = true;
+  ++_generation;
+  _drained.notify_all();
+}
+
+NSendQueueStats SendQueue::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  NSendQueueStats stats = _stats;
+  for (size_t i = 0; i < kLanes; ++i) {
+    stats.lane(NSendPriority(i)).queuedMessages = _lanes[i].size();
+  }
+  stats.queuedMessages = _queuedMessages + _inFlightMessages;
+  stats.queuedBytes = _queuedBytes + _inFlightBytes;
+  return stats;
+}
+
+} // namespace Nakama
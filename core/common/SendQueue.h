@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include <nakama-cpp/NTypes.h>
+#include <nakama-cpp/realtime/NRtTransportInterface.h>
+
+namespace Nakama {
+
+/**
+ * Outgoing messages of a transport, bounded by the watermarks of NSendQueueConfig.
+ *
+ * Each NSendPriority has its own FIFO lane and pop() takes from the most urgent lane which isn't empty. A Latest
+ * message with a drop key takes the place of a queued one with the same key instead of being appended, if the
+ * queue has room for the difference in size; otherwise it overflows like any other message.
+ *
+ * push() is called by the sending thread, pop() and setInFlight() by the thread writing to the socket.
+ * Messages the socket layer holds are reported with setInFlight() and count against the watermarks,
+ * but can't be dropped anymore. All methods are thread safe.
+ */
+class SendQueue {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  void configure(const NSendQueueConfig& config);
+
+  NSendResult push(
+      NBytes data, const std::optional<NSendDropKey>& dropKey, NSendPriority priority = NSendPriority::Control);
+
+  // Takes the oldest message of the most urgent lane, of lanes up to `lowest` only. Returns false if they're empty.
+  bool pop(NBytes& data, NSendPriority lowest = NSendPriority::Bulk);
+
+  bool empty() const;
+
+  // Bytes and messages handed to the socket layer which it hasn't written yet.
+  void setInFlight(size_t bytes, size_t messages);
+
+  // Whether a full queue drained to the low watermarks since the last call, i.e. the writable callback is due.
+  bool takeWritable();
+
+  // Drops everything and wakes blocked senders, e.g. on disconnect.
+  void clear();
+
+  NSendQueueStats getStats() const;
+
+private:
+  struct Entry {
+    NBytes data;
+    std::optional<NSendDropKey> dropKey;
+    Clock::time_point queuedAt;
+  };
+
+  static constexpr size_t kLanes = 3;
+
+  // Whether a message of `bytes` fits, in place of `replaced` if that isn't null.
+  bool fits(size_t bytes, const Entry* replaced = nullptr) const;
+  bool atCapacity() const;
+  // The queued Latest message a new one with `dropKey` takes the place of, or nullptr.
+  Entry* superseded(const std::optional<NSendDropKey>& dropKey, NSendPriority priority);
+  // Drops the oldest queued messages with `dropKey` until a message of `bytes` fits.
+  bool dropFor(const NSendDropKey& dropKey, size_t bytes);
+  void updateWritable();
+
+  mutable std::mutex _mutex;
+  std::condition_variable _drained;
+  NSendQueueConfig _config;
+  std::array<std::deque<Entry>, kLanes> _lanes; // by NSendPriority
+  size_t _queuedMessages = 0;
+  size_t _queuedBytes = 0;
+  size_t _inFlightBytes = 0;
+  size_t _inFlightMessages = 0;
+  bool _full = false;
+  bool _writablePending = false;
+  uint64_t _generation = 0; // bumped by clear(), so blocked senders give up
+  NSendQueueStats _stats;
+};
+
+} // namespace Nakama
@@ -0,0 +1,400 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StorageWriteBuffer.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "nakama-cpp/NException.h"
+#include "nakama-cpp/log/NLogger.h"
+
+#undef NMODULE_NAME
+#define NMODULE_NAME "Nakama::StorageWriteBuffer"
+
+namespace Nakama {
+
+namespace {
+
+template <typename Writer> void writeString(Writer& writer, const char* key, const std::string& str) {
+  writer.Key(key);
+  writer.String(str.data(), static_cast<rapidjson::SizeType>(str.size()));
+}
+
+void writeJournalLine(rapidjson::StringBuffer& buffer, const std::string& owner, const NStorageObjectWrite& object) {
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writeString(writer, "user", owner);
+  writeString(writer, "collection", object.collection);
+  writeString(writer, "key", object.key);
+  writeString(writer, "value", object.value);
+  writeString(writer, "version", object.version);
+  if (object.permissionRead) {
+    writer.Key("read");
+    writer.Int(static_cast<int>(*object.permissionRead));
+  }
+  if (object.permissionWrite) {
+    writer.Key("write");
+    writer.Int(static_cast<int>(*object.permissionWrite));
+  }
+  writer.EndObject();
+  buffer.Put('\n');
+}
+
+std::string getString(const rapidjson::Value& object, const char* name) {
+  auto it = object.FindMember(name);
+  return it != object.MemberEnd() && it->value.IsString() ? it->value.GetString() : std::string();
+}
+
+bool parseJournalLine(const std::string& line, std::string& owner, NStorageObjectWrite& object) {
+  rapidjson::Document document;
+  if (document.Parse(line.data(), line.size()).HasParseError() || !document.IsObject()) {
+    return false;
+  }
+
+  owner = getString(document, "user");
+
+  object.collection = getString(document, "collection");
+  object.key = getString(document, "key");
+  object.value = getString(document, "value");
+  object.version = getString(document, "version");
+
+  auto it = document.FindMember("read");
+  if (it != document.MemberEnd() && it->value.IsInt()) {
+    object.permissionRead = static_cast<NStoragePermissionRead>(it->value.GetInt());
+  }
+  it = document.FindMember("write");
+  if (it != document.MemberEnd() && it->value.IsInt()) {
+    object.permissionWrite = static_cast<NStoragePermissionWrite>(it->value.GetInt());
+  }
+
+  // lines without an owner can't be sent with the right session
+  return !owner.empty() && !object.collection.empty() && !object.key.empty();
+}
+
+} // namespace
+
+void StorageWriteBuffer::configure(const NStorageWriteBufferConfig& config) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _config = config;
+  _config.maxBatchObjects = std::max<size_t>(_config.maxBatchObjects, 1);
+
+  if (!_config.journalFilePath.empty()) {
+    loadJournal();
+    rewriteJournal();
+  }
+}
+
+void StorageWriteBuffer::push(const std::string& userId, const NStorageObjectWrite& object) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  ++_stats.buffered;
+
+  if (_replayUnclaimed) {
+    _replayUnclaimed = false;
+    dropReplayedOfOthers(userId);
+  }
+
+  Key key(userId, object.collection, object.key);
+  auto it = _pending.find(key);
+  if (it != _pending.end()) {
+    // keeps the time of the first write, so that frequent updates don't postpone sending
+    it->second.object = object;
+    it->second.replayed = false;
+    ++_stats.coalesced;
+  } else {
+    _pending.emplace(std::move(key), PendingWrite{object, Clock::now()});
+  }
+
+  if (!_config.journalFilePath.empty()) {
+    appendToJournal(userId, object);
+  }
+}
+
+bool StorageWriteBuffer::takeBatch(
+    const std::set<std::string>& owners, std::string& owner, std::vector<NStorageObjectWrite>& batch) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_pending.empty() || !_inFlight.empty()) {
+    return false;
+  }
+
+  Clock::time_point now = Clock::now();
+  if (now < _retryAt) {
+    return false;
+  }
+
+  // the user with the oldest write which has a session
+  auto first = _pending.end();
+  for (auto it = _pending.begin(); it != _pending.end(); ++it) {
+    if (owners.count(std::get<0>(it->first)) != 0 &&
+        (first == _pending.end() || it->second.bufferedAt < first->second.bufferedAt)) {
+      first = it;
+    }
+  }
+  if (first == _pending.end()) {
+    return false;
+  }
+
+  // writes of a user are adjacent in the map
+  std::vector<std::map<Key, PendingWrite>::iterator> oldest;
+  const std::string& firstOwner = std::get<0>(first->first);
+  for (auto it = _pending.lower_bound(Key(firstOwner, std::string(), std::string()));
+       it != _pending.end() && std::get<0>(it->first) == firstOwner;
+       ++it) {
+    oldest.push_back(it);
+  }
+
+  size_t count = std::min(oldest.size(), _config.maxBatchObjects);
+  std::partial_sort(oldest.begin(), oldest.begin() + count, oldest.end(), [](const auto& a, const auto& b) {
+    return a->second.bufferedAt < b->second.bufferedAt;
+  });
+
+  bool due = _flushRequested || oldest.size() >= _config.maxBatchObjects ||
+             now - first->second.bufferedAt >= _config.flushInterval;
+  if (!due) {
+    return false;
+  }
+
+  owner = firstOwner;
+
+  batch.clear();
+  batch.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    NStorageObjectWrite& object = oldest[i]->second.object;
+    if (_config.trackVersions && object.version.empty()) {
+      auto version = _versions.find(oldest[i]->first);
+      if (version != _versions.end()) {
+        object.version = version->second;
+      }
+    }
+    batch.push_back(std::move(object));
+    _pending.erase(oldest[i]);
+  }
+
+  _inFlight = batch;
+  _inFlightOwner = owner;
+  ++_stats.requests;
+  if (_attempt > 0) {
+    ++_stats.retries;
+  }
+  return true;
+}
+
+void StorageWriteBuffer::onBatchWritten(const NStorageObjectAcks& acks) {
+  std::vector<std::shared_ptr<std::promise<void>>> waiters;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const NStorageObjectAck& ack : acks) {
+      _versions[Key(_inFlightOwner, ack.collection, ack.key)] = ack.version;
+    }
+
+    _stats.written += _inFlight.size();
+    _inFlight.clear();
+    _attempt = 0;
+    _retryAt = {};
+
+    if (!_config.journalFilePath.empty()) {
+      rewriteJournal();
+    }
+    takeFlushWaitersIfEmpty(waiters);
+  }
+
+  for (auto& waiter : waiters) {
+    waiter->set_value();
+  }
+}
+
+void StorageWriteBuffer::onBatchFailed(std::vector<NStorageObjectWrite> batch, const NError& error) {
+  std::vector<std::shared_ptr<std::promise<void>>> waiters;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _inFlight.clear();
+
+    switch (error.code) {
+      case ErrorCode::ConnectionError:
+      case ErrorCode::CancelledByUser:
+      case ErrorCode::Unauthenticated:
+        // didn't reach the server, or waits for a new session
+        for (NStorageObjectWrite& object : batch) {
+          requeue(_inFlightOwner, std::move(object), Clock::time_point());
+        }
+        scheduleRetry(Clock::now());
+        return;
+
+      default:
+        NLOG(NLogLevel::Warn, "Dropping %u storage write(s) rejected by server.", batch.size());
+        _stats.failed += batch.size();
+        for (const NStorageObjectWrite& object : batch) {
+          // likely a version conflict, the next write of the object shouldn't repeat it
+          _versions.erase(Key(_inFlightOwner, object.collection, object.key));
+        }
+        _attempt = 0;
+        _retryAt = {};
+
+        if (!_config.journalFilePath.empty()) {
+          rewriteJournal();
+        }
+        waiters.swap(_flushWaiters);
+        _flushRequested = false;
+        break;
+    }
+  }
+
+  for (auto& waiter : waiters) {
+    waiter->set_exception(std::make_exception_ptr<NException>(error));
+  }
+}
+
+std::future<void> StorageWriteBuffer::flush() {
+  auto promise = std::make_shared<std::promise<void>>();
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (_pending.empty() && _inFlight.empty()) {
+    promise->set_value();
+  } else {
+    _flushWaiters.push_back(promise);
+    _flushRequested = true;
+  }
+
+  return promise->get_future();
+}
+
+NStorageWriteBufferStats StorageWriteBuffer::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  NStorageWriteBufferStats stats = _stats;
+  stats.pending = _pending.size();
+  stats.inFlight = _inFlight.size();
+  return stats;
+}
+
+void StorageWriteBuffer::requeue(const std::string& owner, NStorageObjectWrite&& object, Clock::time_point bufferedAt) {
+  Key key(owner, object.collection, object.key);
+  if (_pending.find(key) == _pending.end()) {
+    _pending.emplace(std::move(key), PendingWrite{std::move(object), bufferedAt});
+  }
+}
+
+void StorageWriteBuffer::dropReplayedOfOthers(const std::string& userId) {
+  size_t dropped = 0;
+  for (auto it = _pending.begin(); it != _pending.end();) {
+    if (it->second.replayed && std::get<0>(it->first) != userId) {
+      it = _pending.erase(it);
+      ++dropped;
+    } else {
+      ++it;
+    }
+  }
+
+  if (dropped > 0) {
+    NLOG(NLogLevel::Warn, "Dropping %u storage write(s) of another user from journal.", dropped);
+    _stats.failed += dropped;
+    if (!_config.journalFilePath.empty()) {
+      rewriteJournal();
+    }
+  }
+}
+
+void StorageWriteBuffer::scheduleRetry(Clock::time_point now) {
+  std::chrono::milliseconds backoff = _config.retryBackoff * (1LL << std::min(_attempt, 16));
+  _retryAt = now + std::min(backoff, _config.maxRetryBackoff);
+  ++_attempt;
+}
+
+void StorageWriteBuffer::takeFlushWaitersIfEmpty(std::vector<std::shared_ptr<std::promise<void>>>& waiters) {
+  if (_pending.empty() && _inFlight.empty()) {
+    waiters.swap(_flushWaiters);
+    _flushRequested = false;
+  }
+}
+
+bool StorageWriteBuffer::appendToJournal(const std::string& owner, const NStorageObjectWrite& object) {
+  std::ofstream file(_config.journalFilePath, std::ios::binary | std::ios::app);
+  if (!file) {
+    NLOG(NLogLevel::Error, "Can't open storage write journal %s", _config.journalFilePath.c_str());
+    return false;
+  }
+
+  rapidjson::StringBuffer buffer;
+  writeJournalLine(buffer, owner, object);
+  // one write per line, a crash can only tear the last line which is skipped on replay
+  file.write(buffer.GetString(), static_cast<std::streamsize>(buffer.GetSize()));
+  file.flush();
+  return static_cast<bool>(file);
+}
+
+void StorageWriteBuffer::rewriteJournal() {
+  rapidjson::StringBuffer buffer;
+  for (const NStorageObjectWrite& object : _inFlight) {
+    writeJournalLine(buffer, _inFlightOwner, object);
+  }
+  for (const auto& p : _pending) {
+    writeJournalLine(buffer, std::get<0>(p.first), p.second.object);
+  }
+
+  std::string tmpPath = _config.journalFilePath + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    file.write(buffer.GetString(), static_cast<std::streamsize>(buffer.GetSize()));
+    if (!file) {
+      NLOG(NLogLevel::Warn, "Can't write storage write journal %s", tmpPath.c_str());
+      return;
+    }
+  }
+  std::remove(_config.journalFilePath.c_str());
+  if (std::rename(tmpPath.c_str(), _config.journalFilePath.c_str()) != 0) {
+    NLOG(NLogLevel::Warn, "Can't replace storage write journal %s", _config.journalFilePath.c_str());
+  }
+}
+
+void StorageWriteBuffer::loadJournal() {
+  std::ifstream file(_config.journalFilePath, std::ios::binary);
+  if (!file) {
+    return;
+  }
+
+  size_t replayed = 0;
+  std::string line;
+  while (std::getline(file, line)) {
+    std::string owner;
+    NStorageObjectWrite object;
+    if (line.empty() || !parseJournalLine(line, owner, object)) {
+      continue;
+    }
+
+    // later lines are newer values of the same object
+    Key key(std::move(owner), object.collection, object.key);
+    auto it = _pending.find(key);
+    if (it != _pending.end()) {
+      it->second.object = std::move(object);
+    } else {
+      // overdue already, send with the first session of the owner
+      _pending.emplace(std::move(key), PendingWrite{std::move(object), Clock::time_point(), true});
+      ++replayed;
+    }
+  }
+
+  if (replayed > 0) {
+    NLOG(NLogLevel::Info, "Replaying %u storage write(s) from journal.", replayed);
+    _stats.replayed += replayed;
+    _replayUnclaimed = true;
+  }
+}
+
+} // namespace Nakama
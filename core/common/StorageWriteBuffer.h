@@ -0,0 +1,104 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "nakama-cpp/NError.h"
+#include "nakama-cpp/NStorageWriteBuffer.h"
+#include "nakama-cpp/data/NStorageObjectAck.h"
+#include "nakama-cpp/data/NStorageObjectWrite.h"
+
+namespace Nakama {
+
+/**
+ * Storage writes waiting to be sent in batches, the latest value per owner, collection and key. Thread safe.
+ *
+ * A batch holds the writes of one user, to be sent with that user's session. At most one batch is in flight. A value buffered while an older one for the same object is in flight
+ * waits for the next batch, so writes of an object reach the server in order. Writes which failed to reach
+ * the server are retried with backoff unless a newer value has been buffered since. Writes rejected by the
+ * server are dropped and fail pending flush futures.
+ *
+ * With a journal file every buffered write is appended to it as a JSON line with its owner. The journal is
+ * compacted to the writes not acknowledged yet after each batch and replayed by `configure`. Replayed writes
+ * of another user than the first one to buffer a write afterwards are dropped.
+ */
+class StorageWriteBuffer {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  void configure(const NStorageWriteBufferConfig& config);
+  void push(const std::string& userId, const NStorageObjectWrite& object);
+
+  // Moves the next batch of one of `owners` into `batch` if the flush policy or a pending flush says so.
+  bool takeBatch(
+      const std::set<std::string>& owners, std::string& owner, std::vector<NStorageObjectWrite>& batch);
+
+  void onBatchWritten(const NStorageObjectAcks& acks);
+  void onBatchFailed(std::vector<NStorageObjectWrite> batch, const NError& error);
+
+  // Completes once everything buffered so far is written. Sending starts with the next takeBatch.
+  std::future<void> flush();
+
+  NStorageWriteBufferStats getStats() const;
+
+private:
+  // user id, collection, key
+  using Key = std::tuple<std::string, std::string, std::string>;
+
+  struct PendingWrite {
+    NStorageObjectWrite object;
+    Clock::time_point bufferedAt;
+    bool replayed = false;
+  };
+
+  // Puts a write back unless a newer value has been buffered meanwhile, mutex must be held.
+  void requeue(const std::string& owner, NStorageObjectWrite&& object, Clock::time_point bufferedAt);
+  // Drops replayed writes of other users than `userId`, mutex must be held.
+  void dropReplayedOfOthers(const std::string& userId);
+  void scheduleRetry(Clock::time_point now);
+  // Collects flush promises to complete once the buffer is empty, mutex must be held.
+  void takeFlushWaitersIfEmpty(std::vector<std::shared_ptr<std::promise<void>>>& waiters);
+
+  bool appendToJournal(const std::string& owner, const NStorageObjectWrite& object);
+  void rewriteJournal();
+  void loadJournal();
+
+  mutable std::mutex _mutex;
+  NStorageWriteBufferConfig _config;
+  std::map<Key, PendingWrite> _pending;
+  std::vector<NStorageObjectWrite> _inFlight;
+  std::string _inFlightOwner;
+  // versions acknowledged by the server, for optimistic concurrency of writes without version
+  std::map<Key, std::string> _versions;
+  std::vector<std::shared_ptr<std::promise<void>>> _flushWaiters;
+  bool _flushRequested = false;
+  bool _replayUnclaimed = false; // replayed writes wait for the first user to buffer a write
+  int _attempt = 0;
+  Clock::time_point _retryAt;
+  NStorageWriteBufferStats _stats;
+};
+
+} // namespace Nakama
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TickQueue.h"
+
+namespace Nakama {
+
+void TickQueue::push(TickPriority priority, std::function<void()> task) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _tasks[static_cast<size_t>(priority)].emplace_back(std::move(task));
+  ++_size;
+}
+
+bool TickQueue::pop(std::function<void()>& task) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  for (auto& tasks : _tasks) {
+    if (!tasks.empty()) {
+      task = std::move(tasks.front());
+      tasks.pop_front();
+      --_size;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+size_t TickQueue::drain(std::chrono::microseconds budget) {
+  using Clock = std::chrono::steady_clock;
+
+  auto start = Clock::now();
+  std::chrono::microseconds elapsed(0);
+  size_t processed = 0;
+  std::function<void()> task;
+
+  while (pop(task)) {
+    task();
+    ++processed;
+
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+    if (elapsed >= budget) {
+      break;
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  _stats.lastProcessed = processed;
+  _stats.lastTickDuration = elapsed;
+  _stats.totalProcessed += processed;
+  if (elapsed > _stats.maxTickDuration) {
+    _stats.maxTickDuration = elapsed;
+  }
+  if (_size > 0 && elapsed >= budget) {
+    ++_stats.budgetExhaustedTicks;
+  }
+
+  return processed;
+}
+
+size_t TickQueue::size() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _size;
+}
+
+NTickStats TickQueue::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  NTickStats stats = _stats;
+  stats.backlog = _size;
+  return stats;
+}
+
+} // namespace Nakama
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "nakama-cpp/NTickStats.h"
+#include <array>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace Nakama {
+
+enum class TickPriority {
+  High = 0,   // failures, things user is likely blocked on
+  Normal = 1, // responses and realtime messages
+  Low = 2,    // bulk events which can wait a frame
+};
+
+/**
+ * Work waiting to be executed in the user's thread by tick().
+ *
+ * Items are executed highest priority first, FIFO within the same priority.
+ * push() is thread safe, drain() must be called from a single thread.
+ */
+class TickQueue {
+public:
+  void push(TickPriority priority, std::function<void()> task);
+
+  // Execute items until the queue is empty or budget is spent. At least one item is executed
+  // per call, so that progress is made even with tiny budgets.
+  size_t drain(std::chrono::microseconds budget);
+
+  size_t size() const;
+
+  NTickStats getStats() const;
+
+private:
+  bool pop(std::function<void()>& task);
+
+  static constexpr size_t kPriorities = 3;
+
+  mutable std::mutex _mutex;
+  std::array<std::deque<std::function<void()>>, kPriorities> _tasks;
+  size_t _size = 0;
+  NTickStats _stats;
+};
+
+} // namespace Nakama
@@ -0,0 +1,88 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Tracing.h"
+#include <functional>
+#include <thread>
+
+namespace Nakama {
+
+void Tracer::setSink(NTraceSinkPtr sink) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _enabled = sink != nullptr;
+  _sink = std::move(sink);
+}
+
+NTraceSinkPtr Tracer::sink() const {
+  if (!_enabled.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _sink;
+}
+
+void emitSpan(
+    const NTraceSinkPtr& sink,
+    const char* category,
+    std::string name,
+    uint64_t traceId,
+    MetricsClock::time_point start,
+    MetricsClock::time_point end,
+    NStringMap args) {
+  if (!sink) {
+    return;
+  }
+
+  NTraceSpan span;
+  span.name = std::move(name);
+  span.category = category;
+  span.start = start;
+  span.duration = std::chrono::microseconds(elapsedUs(start, end));
+  span.traceId = traceId;
+  span.threadId = std::hash<std::thread::id>()(std::this_thread::get_id());
+  span.args = std::move(args);
+  sink->onSpan(span);
+}
+
+void emitTransportSpans(
+    const NTraceSinkPtr& sink, uint64_t traceId, const NHttpTimings& timings, MetricsClock::time_point receivedAt) {
+  if (!sink || timings.totalUs < 0) {
+    return;
+  }
+
+  auto transferStart = receivedAt - std::chrono::microseconds(timings.totalUs);
+  int64_t phaseStart = 0;
+
+  // phases are cumulative, zero length ones (e.g. reused connection) are skipped
+  auto phase = [&](const char* name, int64_t phaseEnd) {
+    if (phaseEnd > phaseStart) {
+      emitSpan(
+          sink, "transport", name, traceId, transferStart + std::chrono::microseconds(phaseStart),
+          transferStart + std::chrono::microseconds(phaseEnd));
+      phaseStart = phaseEnd;
+    }
+  };
+
+  phase("dns", timings.nameLookupUs);
+  phase("connect", timings.connectUs);
+  phase("tls", timings.tlsHandshakeUs);
+  phase("setup", timings.preTransferUs);
+  phase("server", timings.startTransferUs);
+  phase("download", timings.totalUs);
+}
+
+} // namespace Nakama
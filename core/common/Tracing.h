@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "Metrics.h"
+#include "nakama-cpp/NHttpTransportInterface.h"
+#include "nakama-cpp/NTrace.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+
+namespace Nakama {
+
+/**
+ * Holds the user's trace sink. When no sink is set, checking for it costs a single atomic load.
+ */
+class Tracer {
+public:
+  void setSink(NTraceSinkPtr sink);
+
+  // nullptr when tracing is off. Callbacks capture the returned pointer, so it may outlive the client.
+  NTraceSinkPtr sink() const;
+
+  uint64_t nextTraceId() { return _nextTraceId.fetch_add(1, std::memory_order_relaxed); }
+
+private:
+  std::atomic<bool> _enabled{false};
+  mutable std::mutex _mutex;
+  NTraceSinkPtr _sink;
+  std::atomic<uint64_t> _nextTraceId{1};
+};
+
+void emitSpan(
+    const NTraceSinkPtr& sink,
+    const char* category,
+    std::string name,
+    uint64_t traceId,
+    MetricsClock::time_point start,
+    MetricsClock::time_point end,
+    NStringMap args = {});
+
+// Emits dns/connect/tls/server/download spans from transport timings, anchored at the time response arrived.
+void emitTransportSpans(
+    const NTraceSinkPtr& sink, uint64_t traceId, const NHttpTimings& timings, MetricsClock::time_point receivedAt);
+
+} // namespace Nakama
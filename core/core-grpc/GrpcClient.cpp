@@ -17,10 +17,12 @@
 #include "GrpcClient.h"
 #include "DataHelper.h"
 #include "DefaultSession.h"
+#include "RestResponse.h"
 #include "StrUtil.h"
 #include "grpcpp/create_channel.h"
 #include "nakama-cpp/NakamaVersion.h"
 #include "nakama-cpp/log/NLogger.h"
+#include <algorithm>
 
 #ifdef NAKAMA_SSL_ENABLED
 #include "roots_pem.h"
@@ -33,7 +35,7 @@ using namespace std;
 
 namespace Nakama {
 
-GrpcClient::GrpcClient(const NClientParameters& parameters) {
+GrpcClient::GrpcClient(const NClientParameters& parameters, const NGrpcClientParameters& grpcParameters) {
   NLOG(NLogLevel::Info, "Created. NakamaSdkVersion: %s", getNakamaSdkVersion());
 
   _host = parameters.host;
@@ -42,12 +44,12 @@ GrpcClient::GrpcClient(const NClientParameters& parameters) {
 
   _port = parameters.port;
 
-  if (port == DEFAULT_PORT) {
-    port = parameters.ssl ? 443 : 7349;
-    NLOG(NLogLevel::Info, "using default port %d", port);
+  if (_port == DEFAULT_PORT) {
+    _port = parameters.ssl ? 443 : 7349;
+    NLOG(NLogLevel::Info, "using default port %d", _port);
   }
 
-  std::string target = parameters.host + ":" + std::to_string(port);
+  std::string target = parameters.host + ":" + std::to_string(_port);
 
   std::shared_ptr<grpc::ChannelCredentials> creds;
 
@@ -68,15 +70,51 @@ GrpcClient::GrpcClient(const NClientParameters& parameters) {
     creds = grpc::InsecureChannelCredentials();
   }
 
-  auto channel = grpc::CreateChannel(target, creds);
+  uint32_t channels = std::max<uint32_t>(grpcParameters.channels, 1);
 
-  _stub = nakama::api::Nakama::NewStub(channel);
+  for (uint32_t i = 0; i < channels; ++i) {
+    grpc::ChannelArguments args;
+
+    if (channels > 1) {
+      // channels with identical arguments share subchannels, i.e. the connection
+      args.SetInt(GRPC_ARG_USE_LOCAL_SUBCHANNEL_POOL, 1);
+    }
+
+    _stubs.emplace_back(nakama::api::Nakama::NewStub(grpc::CreateCustomChannel(target, creds, args)));
+  }
 
   _basicAuthMetadata = "Basic " + base64Encode(parameters.serverKey + ":");
+
+  for (uint32_t i = 0; i < grpcParameters.completionThreads; ++i) {
+    _completionThreads.emplace_back(&GrpcClient::completionThreadFunc, this);
+  }
+
+  NLOG(NLogLevel::Info, "channels: %u, completion threads: %u", channels, grpcParameters.completionThreads);
 }
 
 GrpcClient::~GrpcClient() {
-  disconnect();
+  stopIoThread();
+
+  if (!_completionThreads.empty()) {
+    {
+      // Next() returns false only once every pending call has completed, don't let join() wait for timeouts
+      std::lock_guard<std::mutex> lock(_reqContextsLock);
+      for (ReqContext* reqContext : _reqContexts) {
+        reqContext->context.TryCancel();
+      }
+    }
+
+    disconnect();
+
+    for (std::thread& thread : _completionThreads) {
+      thread.join();
+    }
+
+    // callbacks of cancelled calls are not delivered to a client being destroyed
+    _completions.drain([](std::function<void()>&&) {});
+  } else {
+    disconnect();
+  }
 
   if (_reqContexts.size() > 0) {
     NLOG(NLogLevel::Warn, "Not handled %u request(s) detected.", _reqContexts.size());
@@ -91,7 +129,31 @@ GrpcClient::~GrpcClient() {
 
 void GrpcClient::disconnect() { _cq.Shutdown(); }
 
-void GrpcClient::tick() {
+nakama::api::Nakama::Stub* GrpcClient::stub() {
+  if (_stubs.size() == 1) {
+    return _stubs.front().get();
+  }
+
+  return _stubs[_nextStub.fetch_add(1, std::memory_order_relaxed) % _stubs.size()].get();
+}
+
+void GrpcClient::completionThreadFunc() {
+  bool ok;
+  void* tag;
+
+  while (_cq.Next(&tag, &ok)) {
+    onResponse(tag, ok);
+  }
+
+  NLOG_DEBUG("completion queue is stopped");
+}
+
+void GrpcClient::pumpTransport() {
+  if (!_completionThreads.empty()) {
+    _completions.drain([this](std::function<void()>&& callback) { dispatch(std::move(callback)); });
+    return;
+  }
+
   bool ok;
   void* tag;
   bool continueLoop = true;
@@ -122,6 +184,7 @@ void GrpcClient::tick() {
 
 ReqContext* GrpcClient::createReqContext() {
   ReqContext* ctx = new ReqContext();
+  std::lock_guard<std::mutex> lock(_reqContextsLock);
   _reqContexts.emplace(ctx);
   return ctx;
 }
@@ -135,78 +198,74 @@ void GrpcClient::setSessionAuth(ReqContext* ctx, NSessionPtr session) {
 void GrpcClient::onResponse(void* tag, bool ok) {
   ReqContext* reqContext = static_cast<ReqContext*>(tag);
 
-  auto it = _reqContexts.find(reqContext);
-
-  if (it != _reqContexts.end()) {
-    if (ok) {
-      if (reqContext->status.ok()) {
-        if (reqContext->successCallback) {
-          reqContext->successCallback();
-        }
-      } else {
-        std::string errMessage;
-
-        errMessage.append("message: ").append(reqContext->status.error_message());
-
-        if (!reqContext->status.error_details().empty()) {
-          errMessage.append("\ndetails: ").append(reqContext->status.error_details());
-        }
-
-        ErrorCode code = ErrorCode::Unknown;
-
-        switch (reqContext->status.error_code()) {
-          case grpc::StatusCode::UNAVAILABLE:
-            code = ErrorCode::ConnectionError;
-            break;
-          case grpc::StatusCode::INTERNAL:
-            code = ErrorCode::InternalError;
-            break;
-          case grpc::StatusCode::NOT_FOUND:
-            code = ErrorCode::NotFound;
-            break;
-          case grpc::StatusCode::ALREADY_EXISTS:
-            code = ErrorCode::AlreadyExists;
-            break;
-          case grpc::StatusCode::INVALID_ARGUMENT:
-            code = ErrorCode::InvalidArgument;
-            break;
-          case grpc::StatusCode::UNAUTHENTICATED:
-            code = ErrorCode::Unauthenticated;
-            break;
-          case grpc::StatusCode::PERMISSION_DENIED:
-            code = ErrorCode::PermissionDenied;
-            break;
-
-          default:
-            errMessage.append("\ngrpc code: ").append(std::to_string(reqContext->status.error_code()));
-            break;
-        }
-
-        reqError(reqContext, NError(std::move(errMessage), code));
-      }
-    } else {
-      reqError(reqContext, NError("Communication failed. Please check connection.", ErrorCode::ConnectionError));
+  {
+    std::lock_guard<std::mutex> lock(_reqContextsLock);
+    if (_reqContexts.erase(reqContext) == 0) {
+      reqContext = nullptr;
     }
+  }
 
-    delete reqContext;
-    _reqContexts.erase(it);
-  } else {
+  if (!reqContext) {
     reqError(nullptr, NError("Not found request context.", ErrorCode::InternalError));
+    return;
   }
+
+  if (ok) {
+    if (reqContext->status.ok()) {
+      deliver(std::move(reqContext->successCallback));
+    } else {
+      std::string errMessage;
+
+      errMessage.append("message: ").append(reqContext->status.error_message());
+
+      if (!reqContext->status.error_details().empty()) {
+        errMessage.append("\ndetails: ").append(reqContext->status.error_details());
+      }
+
+      bool known = false;
+      ErrorCode code = grpcStatusToErrorCode(reqContext->status.error_code(), known);
+
+      if (!known) {
+        errMessage.append("\ngrpc code: ").append(std::to_string(reqContext->status.error_code()));
+      }
+
+      reqError(reqContext, NError(std::move(errMessage), code));
+    }
+  } else {
+    reqError(reqContext, NError("Communication failed. Please check connection.", ErrorCode::ConnectionError));
+  }
+
+  delete reqContext;
 }
 
 void GrpcClient::reqError(ReqContext* reqContext, const NError& error) {
   NLOG_ERROR(error);
 
-  if (reqContext && reqContext->errorCallback) {
-    reqContext->errorCallback(error);
-  } else if (_defaultErrorCallback) {
-    _defaultErrorCallback(error);
+  ErrorCallback errorCallback =
+      reqContext && reqContext->errorCallback ? reqContext->errorCallback : _defaultErrorCallback;
+
+  if (errorCallback) {
+    deliver([errorCallback, error]() { errorCallback(error); });
   } else {
     NLOG_WARN("^ error not handled");
   }
 }
 
+void GrpcClient::deliver(std::function<void()> callback) {
+  if (!callback) {
+    return;
+  }
+
+  if (_completionThreads.empty()) {
+    dispatch(std::move(callback));
+  } else {
+    _completions.push(std::move(callback));
+    if (_ioWorker.isRunning()) {
+      _ioWorker.wakeUp();
+    }
+  }
+}
+
 void GrpcClient::authenticateDevice(
     const std::string& id,
     const opt::optional<std::string>& username,
@@ -242,7 +301,7 @@ void GrpcClient::authenticateDevice(
     (*account->mutable_vars())[p.first] = p.second;
   }
 
-  auto responseReader = _stub->AsyncAuthenticateDevice(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAuthenticateDevice(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
@@ -283,7 +342,7 @@ void GrpcClient::authenticateEmail(
     (*account->mutable_vars())[p.first] = p.second;
   }
 
-  auto responseReader = _stub->AsyncAuthenticateEmail(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAuthenticateEmail(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
@@ -324,7 +383,7 @@ void GrpcClient::authenticateFacebook(
     (*account->mutable_vars())[p.first] = p.second;
   }
 
-  auto responseReader = _stub->AsyncAuthenticateFacebook(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAuthenticateFacebook(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
@@ -363,7 +422,7 @@ void GrpcClient::authenticateGoogle(
     (*account->mutable_vars())[p.first] = p.second;
   }
 
-  auto responseReader = _stub->AsyncAuthenticateGoogle(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAuthenticateGoogle(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
@@ -417,7 +476,7 @@ void GrpcClient::authenticateGameCenter(
 
   req.mutable_create()->set_value(create);
 
-  auto responseReader = _stub->AsyncAuthenticateGameCenter(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAuthenticateGameCenter(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
@@ -456,7 +515,7 @@ void GrpcClient::authenticateApple(
     (*account->mutable_vars())[p.first] = p.second;
   }
 
-  auto responseReader = _stub->AsyncAuthenticateApple(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAuthenticateApple(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
@@ -495,7 +554,7 @@ void GrpcClient::authenticateCustom(
     (*account->mutable_vars())[p.first] = p.second;
   }
 
-  auto responseReader = _stub->AsyncAuthenticateCustom(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAuthenticateCustom(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
@@ -534,7 +593,7 @@ void GrpcClient::authenticateSteam(
     (*account->mutable_vars())[p.first] = p.second;
   }
 
-  auto responseReader = _stub->AsyncAuthenticateSteam(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAuthenticateSteam(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
@@ -562,7 +621,7 @@ void GrpcClient::authenticateRefresh(
 
   req.set_token(session->getRefreshToken());
 
-  auto responseReader = _stub->AsyncSessionRefresh(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncSessionRefresh(&ctx->context, req, &_cq);
   responseReader->Finish(&(*sessionData), &ctx->status, (void*)ctx);
 }
 
@@ -586,7 +645,7 @@ void GrpcClient::linkFacebook(
   if (importFriends)
     req.mutable_sync()->set_value(*importFriends);
 
-  auto responseReader = _stub->AsyncLinkFacebook(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLinkFacebook(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -610,7 +669,7 @@ void GrpcClient::linkEmail(
   req.set_email(email);
   req.set_password(password);
 
-  auto responseReader = _stub->AsyncLinkEmail(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLinkEmail(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -632,7 +691,7 @@ void GrpcClient::linkDevice(
 
   req.set_id(id);
 
-  auto responseReader = _stub->AsyncLinkDevice(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLinkDevice(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -654,7 +713,7 @@ void GrpcClient::linkGoogle(
 
   req.set_token(accessToken);
 
-  auto responseReader = _stub->AsyncLinkGoogle(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLinkGoogle(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -686,7 +745,7 @@ void GrpcClient::linkGameCenter(
   req.set_signature(signature);
   req.set_public_key_url(publicKeyUrl);
 
-  auto responseReader = _stub->AsyncLinkGameCenter(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLinkGameCenter(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -708,7 +767,7 @@ void GrpcClient::linkApple(
 
   req.set_token(token);
 
-  auto responseReader = _stub->AsyncLinkApple(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLinkApple(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -730,7 +789,7 @@ void GrpcClient::linkSteam(
   req.mutable_account()->set_token(token);
   req.mutable_sync()->set_value(true); // REST syncs when field is missing. Do the same in gRPC
 
-  auto responseReader = _stub->AsyncLinkSteam(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLinkSteam(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -752,7 +811,7 @@ void GrpcClient::linkCustom(
 
   req.set_id(id);
 
-  auto responseReader = _stub->AsyncLinkCustom(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLinkCustom(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -774,7 +833,7 @@ void GrpcClient::unlinkFacebook(
 
   req.set_token(accessToken);
 
-  auto responseReader = _stub->AsyncUnlinkFacebook(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUnlinkFacebook(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -798,7 +857,7 @@ void GrpcClient::unlinkEmail(
   req.set_email(email);
   req.set_password(password);
 
-  auto responseReader = _stub->AsyncUnlinkEmail(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUnlinkEmail(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -820,7 +879,7 @@ void GrpcClient::unlinkGoogle(
 
   req.set_token(accessToken);
 
-  auto responseReader = _stub->AsyncUnlinkGoogle(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUnlinkGoogle(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -852,7 +911,7 @@ void GrpcClient::unlinkGameCenter(
   req.set_signature(signature);
   req.set_public_key_url(publicKeyUrl);
 
-  auto responseReader = _stub->AsyncUnlinkGameCenter(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUnlinkGameCenter(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -874,7 +933,7 @@ void GrpcClient::unlinkApple(
 
   req.set_token(token);
 
-  auto responseReader = _stub->AsyncUnlinkApple(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUnlinkApple(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -896,7 +955,7 @@ void GrpcClient::unlinkSteam(
 
   req.set_token(token);
 
-  auto responseReader = _stub->AsyncUnlinkSteam(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUnlinkSteam(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -918,7 +977,7 @@ void GrpcClient::unlinkDevice(
 
   req.set_id(id);
 
-  auto responseReader = _stub->AsyncUnlinkDevice(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUnlinkDevice(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -940,7 +999,7 @@ void GrpcClient::unlinkCustom(
 
   req.set_id(id);
 
-  auto responseReader = _stub->AsyncUnlinkCustom(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUnlinkCustom(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -965,7 +1024,7 @@ void GrpcClient::importFacebookFriends(
   if (reset)
     req.mutable_reset()->set_value(*reset);
 
-  auto responseReader = _stub->AsyncImportFacebookFriends(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncImportFacebookFriends(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -989,7 +1048,7 @@ void GrpcClient::getAccount(
   }
   ctx->errorCallback = errorCallback;
 
-  auto responseReader = _stub->AsyncGetAccount(&ctx->context, {}, &_cq);
+  auto responseReader = stub()->AsyncGetAccount(&ctx->context, {}, &_cq);
 
   responseReader->Finish(&(*accoutData), &ctx->status, (void*)ctx);
 }
@@ -1027,7 +1086,7 @@ void GrpcClient::updateAccount(
   if (timezone)
     req.mutable_timezone()->set_value(*timezone);
 
-  auto responseReader = _stub->AsyncUpdateAccount(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUpdateAccount(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1068,7 +1127,7 @@ void GrpcClient::getUsers(
     req.mutable_facebook_ids()->Add()->assign(facebookId);
   }
 
-  auto responseReader = _stub->AsyncGetUsers(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncGetUsers(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*usersData), &ctx->status, (void*)ctx);
 }
@@ -1097,7 +1156,7 @@ void GrpcClient::addFriends(
     req.mutable_usernames()->Add()->assign(username);
   }
 
-  auto responseReader = _stub->AsyncAddFriends(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAddFriends(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1126,7 +1185,7 @@ void GrpcClient::deleteFriends(
     req.mutable_usernames()->Add()->assign(username);
   }
 
-  auto responseReader = _stub->AsyncDeleteFriends(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncDeleteFriends(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1155,7 +1214,7 @@ void GrpcClient::blockFriends(
     req.mutable_usernames()->Add()->assign(username);
   }
 
-  auto responseReader = _stub->AsyncBlockFriends(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncBlockFriends(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1191,7 +1250,7 @@ void GrpcClient::listFriends(
   if (!cursor.empty())
     req.set_cursor(cursor);
 
-  auto responseReader = _stub->AsyncListFriends(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListFriends(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1234,7 +1293,7 @@ void GrpcClient::createGroup(
     req.set_max_count(*maxCount);
   req.set_open(open);
 
-  auto responseReader = _stub->AsyncCreateGroup(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncCreateGroup(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*groupData), &ctx->status, (void*)ctx);
 }
@@ -1256,7 +1315,7 @@ void GrpcClient::deleteGroup(
 
   req.set_group_id(groupId);
 
-  auto responseReader = _stub->AsyncDeleteGroup(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncDeleteGroup(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1283,7 +1342,7 @@ void GrpcClient::addGroupUsers(
     req.add_user_ids(id);
   }
 
-  auto responseReader = _stub->AsyncAddGroupUsers(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncAddGroupUsers(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1321,7 +1380,7 @@ void GrpcClient::listGroupUsers(
   if (!cursor.empty())
     req.set_cursor(cursor);
 
-  auto responseReader = _stub->AsyncListGroupUsers(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListGroupUsers(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*groupData), &ctx->status, (void*)ctx);
 }
@@ -1348,7 +1407,7 @@ void GrpcClient::kickGroupUsers(
     req.add_user_ids(id);
   }
 
-  auto responseReader = _stub->AsyncKickGroupUsers(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncKickGroupUsers(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1370,7 +1429,7 @@ void GrpcClient::joinGroup(
 
   req.set_group_id(groupId);
 
-  auto responseReader = _stub->AsyncJoinGroup(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncJoinGroup(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1392,7 +1451,7 @@ void GrpcClient::leaveGroup(
 
   req.set_group_id(groupId);
 
-  auto responseReader = _stub->AsyncLeaveGroup(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncLeaveGroup(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1429,7 +1488,7 @@ void GrpcClient::listGroups(
   if (!cursor.empty())
     req.set_cursor(cursor);
 
-  auto responseReader = _stub->AsyncListGroups(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListGroups(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*groupData), &ctx->status, (void*)ctx);
 }
@@ -1487,7 +1546,7 @@ void GrpcClient::listUserGroups(
   if (!cursor.empty())
     req.set_cursor(cursor);
 
-  auto responseReader = _stub->AsyncListUserGroups(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListUserGroups(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*groupData), &ctx->status, (void*)ctx);
 }
@@ -1514,7 +1573,7 @@ void GrpcClient::promoteGroupUsers(
     req.add_user_ids(id);
   }
 
-  auto responseReader = _stub->AsyncPromoteGroupUsers(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncPromoteGroupUsers(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1541,7 +1600,7 @@ void GrpcClient::demoteGroupUsers(
     req.add_user_ids(id);
   }
 
-  auto responseReader = _stub->AsyncDemoteGroupUsers(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncDemoteGroupUsers(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1579,7 +1638,7 @@ void GrpcClient::updateGroup(
   if (open)
     req.mutable_open()->set_value(*open);
 
-  auto responseReader = _stub->AsyncUpdateGroup(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncUpdateGroup(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1620,7 +1679,7 @@ void GrpcClient::listLeaderboardRecords(
   if (cursor)
     req.set_cursor(*cursor);
 
-  auto responseReader = _stub->AsyncListLeaderboardRecords(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListLeaderboardRecords(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1655,7 +1714,7 @@ void GrpcClient::listLeaderboardRecordsAroundOwner(
   if (limit)
     req.mutable_limit()->set_value(*limit);
 
-  auto responseReader = _stub->AsyncListLeaderboardRecordsAroundOwner(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListLeaderboardRecordsAroundOwner(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1692,7 +1751,7 @@ void GrpcClient::writeLeaderboardRecord(
   if (metadata)
     req.mutable_record()->set_metadata(*metadata);
 
-  auto responseReader = _stub->AsyncWriteLeaderboardRecord(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncWriteLeaderboardRecord(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1729,7 +1788,7 @@ void GrpcClient::writeTournamentRecord(
   if (metadata)
     req.mutable_record()->set_metadata(*metadata);
 
-  auto responseReader = _stub->AsyncWriteTournamentRecord(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncWriteTournamentRecord(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1751,7 +1810,7 @@ void GrpcClient::deleteLeaderboardRecord(
 
   req.set_leaderboard_id(leaderboardId);
 
-  auto responseReader = _stub->AsyncDeleteLeaderboardRecord(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncDeleteLeaderboardRecord(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1796,7 +1855,7 @@ void GrpcClient::listMatches(
   if (authoritative)
     req.mutable_authoritative()->set_value(*authoritative);
 
-  auto responseReader = _stub->AsyncListMatches(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListMatches(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1829,7 +1888,7 @@ void GrpcClient::listNotifications(
   if (cacheableCursor)
     req.set_cacheable_cursor(*cacheableCursor);
 
-  auto responseReader = _stub->AsyncListNotifications(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListNotifications(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1853,7 +1912,7 @@ void GrpcClient::deleteNotifications(
     req.add_ids(id);
   }
 
-  auto responseReader = _stub->AsyncDeleteNotifications(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncDeleteNotifications(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -1891,7 +1950,7 @@ void GrpcClient::listChannelMessages(
   if (forward)
     req.mutable_forward()->set_value(*forward);
 
-  auto responseReader = _stub->AsyncListChannelMessages(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListChannelMessages(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1936,7 +1995,7 @@ void GrpcClient::listTournaments(
   if (cursor)
     req.set_cursor(*cursor);
 
-  auto responseReader = _stub->AsyncListTournaments(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListTournaments(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -1977,7 +2036,7 @@ void GrpcClient::listTournamentRecords(
     req.add_owner_ids(id);
   }
 
-  auto responseReader = _stub->AsyncListTournamentRecords(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListTournamentRecords(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -2012,7 +2071,7 @@ void GrpcClient::listTournamentRecordsAroundOwner(
   if (limit)
     req.mutable_limit()->set_value(*limit);
 
-  auto responseReader = _stub->AsyncListTournamentRecordsAroundOwner(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListTournamentRecordsAroundOwner(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -2034,7 +2093,7 @@ void GrpcClient::joinTournament(
 
   req.set_tournament_id(tournamentId);
 
-  auto responseReader = _stub->AsyncJoinTournament(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncJoinTournament(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -2070,7 +2129,7 @@ void GrpcClient::listStorageObjects(
   if (cursor)
     req.set_cursor(*cursor);
 
-  auto responseReader = _stub->AsyncListStorageObjects(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListStorageObjects(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -2108,7 +2167,7 @@ void GrpcClient::listUsersStorageObjects(
   if (cursor)
     req.set_cursor(*cursor);
 
-  auto responseReader = _stub->AsyncListStorageObjects(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncListStorageObjects(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -2150,7 +2209,7 @@ void GrpcClient::writeStorageObjects(
       write_obj->mutable_permission_write()->set_value(static_cast<::google::protobuf::int32>(*obj.permissionWrite));
   }
 
-  auto responseReader = _stub->AsyncWriteStorageObjects(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncWriteStorageObjects(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -2185,7 +2244,7 @@ void GrpcClient::readStorageObjects(
     write_obj->set_user_id(obj.userId);
   }
 
-  auto responseReader = _stub->AsyncReadStorageObjects(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncReadStorageObjects(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -2213,7 +2272,7 @@ void GrpcClient::deleteStorageObjects(
     write_obj->set_version(obj.version);
   }
 
-  auto responseReader = _stub->AsyncDeleteStorageObjects(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncDeleteStorageObjects(&ctx->context, req, &_cq);
 
   responseReader->Finish(&_emptyData, &ctx->status, (void*)ctx);
 }
@@ -2246,7 +2305,7 @@ void GrpcClient::rpc(
   if (payload)
     req.set_payload(*payload);
 
-  auto responseReader = _stub->AsyncRpcFunc(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncRpcFunc(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -2279,7 +2338,7 @@ void GrpcClient::rpc(
   if (payload)
     req.set_payload(*payload);
 
-  auto responseReader = _stub->AsyncRpcFunc(&ctx->context, req, &_cq);
+  auto responseReader = stub()->AsyncRpcFunc(&ctx->context, req, &_cq);
 
   responseReader->Finish(&(*data), &ctx->status, (void*)ctx);
 }
@@ -17,8 +17,14 @@
 #pragma once
 
 #include "../common/BaseClient.h"
+#include "../common/MpscQueue.h"
 #include "apigrpc/apigrpc.grpc.pb.h"
+#include "nakama-cpp/ClientFactory.h"
+#include <atomic>
+#include <mutex>
 #include <set>
+#include <thread>
+#include <vector>
 
 namespace Nakama {
 
@@ -35,13 +41,11 @@ struct ReqContext {
  */
 class GrpcClient : public BaseClient {
 public:
-  explicit GrpcClient(const NClientParameters& parameters);
+  explicit GrpcClient(const NClientParameters& parameters, const NGrpcClientParameters& grpcParameters = {});
   ~GrpcClient();
 
   void disconnect() override;
 
-  void tick() override;
-
   void authenticateDevice(
       const std::string& id,
       const opt::optional<std::string>& username,
@@ -546,17 +550,29 @@ public:
       std::function<void(const NRpc&)> successCallback,
       ErrorCallback errorCallback) override;
 
+protected:
+  void pumpTransport() override;
+
 private:
   ReqContext* createReqContext();
   void setBasicAuth(ReqContext* ctx);
   void setSessionAuth(ReqContext* ctx, NSessionPtr session);
+  // Picks a stub from the channel pool, round robin
+  nakama::api::Nakama::Stub* stub();
+  void completionThreadFunc();
   void onResponse(void* tag, bool ok);
   void reqError(ReqContext* reqContext, const NError& error);
+  // Dispatches callback, or hands it over to pumpTransport() when called from a completion thread
+  void deliver(std::function<void()> callback);
 
 private:
-  std::unique_ptr<nakama::api::Nakama::Stub> _stub;
+  std::vector<std::unique_ptr<nakama::api::Nakama::Stub>> _stubs;
+  std::atomic<size_t> _nextStub{0};
   grpc::CompletionQueue _cq;
+  std::vector<std::thread> _completionThreads;
+  MpscQueue<std::function<void()>> _completions;
   std::set<ReqContext*> _reqContexts;
+  std::mutex _reqContextsLock;
   google::protobuf::Empty _emptyData;
 };
 } // namespace Nakama
@@ -17,10 +17,10 @@
 #include "RestClient.h"
 #include "DataHelper.h"
 #include "DefaultSession.h"
+#include "RestResponse.h"
 #include <rapidjson/document.h>
 #include "StrUtil.h"
 #include "google/protobuf/util/json_util.h"
-#include "grpc_status_code_enum.h"
 #include "nakama-cpp/NakamaVersion.h"
 #include "nakama-cpp/log/NLogger.h"
 #include <rapidjson/stringbuffer.h>
@@ -85,6 +85,7 @@ RestClient::RestClient(const NClientParameters& parameters, NHttpTransportPtr ht
 }
 
 RestClient::~RestClient() {
+  stopIoThread();
   disconnect();
 
   if (_reqContexts.size() > 0) {
@@ -100,11 +101,12 @@ RestClient::~RestClient() {
 
 void RestClient::disconnect() { _httpClient->cancelAllRequests(); }
 
-void RestClient::tick() { _httpClient->tick(); }
+void RestClient::pumpTransport() { _httpClient->tick(); }
 
 RestReqContext* RestClient::createReqContext(google::protobuf::Message* data) {
   RestReqContext* ctx = new RestReqContext();
   ctx->data = data;
+  std::lock_guard<std::mutex> lock(_reqContextsLock);
   _reqContexts.emplace(ctx);
   return ctx;
 }
@@ -121,6 +123,7 @@ void RestClient::sendReq(
     std::string&& path,
     std::string&& body,
     NHttpQueryArgs&& args) {
+  auto sendStart = MetricsClock::now();
   NHttpRequest req;
 
   req.method = method;
@@ -133,24 +136,74 @@ void RestClient::sendReq(
   if (!ctx->auth.empty())
     req.headers.emplace("Authorization", std::move(ctx->auth));
 
-  _httpClient->request(req, [this, ctx](NHttpResponsePtr response) { onResponse(ctx, response); });
+  std::shared_ptr<EndpointRecorder> metrics = _metrics.endpoint(method, req.path);
+  addRelaxed(metrics->requests, 1);
+  addRelaxed(metrics->bytesSent, req.body.size());
+  ctx->metrics = metrics;
+
+  NTraceSinkPtr traceSink = _tracer.sink();
+  uint64_t traceId = traceSink ? _tracer.nextTraceId() : 0;
+  ctx->traceId = traceId;
+  ctx->sentAt = MetricsClock::now();
+
+  _httpClient->request(req, [this, ctx](NHttpResponsePtr response) {
+    ctx->receivedAt = MetricsClock::now();
+    ctx->metrics->network.record(ctx->sentAt, ctx->receivedAt);
+    addRelaxed(ctx->metrics->bytesReceived, response->body.size());
+
+    if (ctx->traceId) {
+      emitTransportSpans(_tracer.sink(), ctx->traceId, response->timings, ctx->receivedAt);
+    }
+
+    // JSON decoding is the expensive part, let tick(budget) spread it over frames
+    TickPriority priority = isResponseOk(*response) ? TickPriority::Normal : TickPriority::High;
+    _ioWorker.runOrDefer(priority, [this, ctx, response]() { onResponse(ctx, response); });
+  });
+
+  // ctx might be gone already if transport completed the request synchronously
+  if (traceSink) {
+    emitSpan(traceSink, "rest", "send", traceId, sendStart, MetricsClock::now(), {{"endpoint", metrics->name}});
+  }
+
+  if (_ioWorker.isRunning()) {
+    _ioWorker.wakeUp();
+  }
 }
 
 void RestClient::onResponse(RestReqContext* reqContext, NHttpResponsePtr response) {
-  auto it = _reqContexts.find(reqContext);
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(_reqContextsLock);
+    found = _reqContexts.erase(reqContext) > 0;
+  }
+
+  if (found) {
+    std::shared_ptr<EndpointRecorder> metrics = reqContext->metrics;
+    NTraceSinkPtr traceSink = reqContext->traceId ? _tracer.sink() : nullptr;
+    auto processingStart = MetricsClock::now();
 
-  if (it != _reqContexts.end()) {
-    if (response->statusCode == 200) // OK
-    {
+    if (metrics) {
+      metrics->queueWait.record(reqContext->receivedAt, processingStart);
+    }
+    emitSpan(traceSink, "rest", "queue wait", reqContext->traceId, reqContext->receivedAt, processingStart);
+
+    if (isResponseOk(*response)) {
       if (reqContext->successCallback) {
         bool ok = true;
 
         if (reqContext->data) {
           google::protobuf::util::JsonParseOptions options;
           options.ignore_unknown_fields = true;
+          auto decodeStart = MetricsClock::now();
           auto status = google::protobuf::util::JsonStringToMessage(response->body, reqContext->data, options);
           ok = status.ok();
 
+          auto decodeEnd = MetricsClock::now();
+          if (metrics) {
+            metrics->decode.record(decodeStart, decodeEnd);
+          }
+          emitSpan(traceSink, "rest", "decode", reqContext->traceId, decodeStart, decodeEnd);
+
           if (!ok) {
             reqError(
                 reqContext, NError(
@@ -160,98 +213,62 @@ void RestClient::onResponse(RestReqContext* reqContext, NHttpResponsePtr respons
         }
 
         if (ok) {
-          reqContext->successCallback();
+          dispatch(instrumentSuccessCallback(reqContext));
         }
       }
     } else {
-      std::string errMessage;
-      ErrorCode code = ErrorCode::Unknown;
-
-      if (response->statusCode == InternalStatusCodes::CONNECTION_ERROR) {
-        code = ErrorCode::ConnectionError;
-        errMessage.append("message: ").append(response->errorMessage);
-      } else if (response->statusCode == InternalStatusCodes::CANCELLED_BY_USER) {
-        code = ErrorCode::CancelledByUser;
-        errMessage.append("message: ").append(response->errorMessage);
-      } else if (response->statusCode == InternalStatusCodes::INTERNAL_TRANSPORT_ERROR) {
-        code = ErrorCode::InternalError;
-        errMessage.append("message: ").append(response->errorMessage);
-      } else if (!response->body.empty() && response->body[0] == '{') // have to be JSON
-      {
-        try {
-          rapidjson::Document document;
-
-          if (document.Parse(response->body).HasParseError()) {
-            errMessage = "Parse JSON failed: " + response->body;
-            code = ErrorCode::InternalError;
-          } else {
-            auto& jsonMessage = document["message"];
-            auto& jsonCode = document["code"];
-
-            if (jsonMessage.IsString()) {
-              errMessage.append("message: ").append(jsonMessage.GetString());
-            }
-
-            if (jsonCode.IsNumber()) {
-              int serverErrCode = jsonCode.GetInt();
-
-              switch (serverErrCode) {
-                case grpc::StatusCode::UNAVAILABLE:
-                  code = ErrorCode::ConnectionError;
-                  break;
-                case grpc::StatusCode::INTERNAL:
-                  code = ErrorCode::InternalError;
-                  break;
-                case grpc::StatusCode::NOT_FOUND:
-                  code = ErrorCode::NotFound;
-                  break;
-                case grpc::StatusCode::ALREADY_EXISTS:
-                  code = ErrorCode::AlreadyExists;
-                  break;
-                case grpc::StatusCode::INVALID_ARGUMENT:
-                  code = ErrorCode::InvalidArgument;
-                  break;
-                case grpc::StatusCode::UNAUTHENTICATED:
-                  code = ErrorCode::Unauthenticated;
-                  break;
-                case grpc::StatusCode::PERMISSION_DENIED:
-                  code = ErrorCode::PermissionDenied;
-                  break;
-
-                default:
-                  errMessage.append("\ncode: ").append(std::to_string(serverErrCode));
-                  break;
-              }
-            }
-          }
-        } catch (exception& e) {
-          NLOG_ERROR("exception: " + string(e.what()));
-        }
-      }
-
-      if (errMessage.empty()) {
-        errMessage.append("message: ").append(response->errorMessage);
-        errMessage.append("\nHTTP status: ").append(std::to_string(response->statusCode));
-        errMessage.append("\nbody: ").append(response->body);
-      }
-
-      reqError(reqContext, NError(std::move(errMessage), code));
+      reqError(reqContext, responseToError(*response));
     }
 
     delete reqContext;
-    _reqContexts.erase(it);
   } else {
     reqError(nullptr, NError("Not found request context.", ErrorCode::InternalError));
   }
 }
 
+std::function<void()> RestClient::instrumentSuccessCallback(RestReqContext* reqContext) {
+  std::shared_ptr<EndpointRecorder> metrics = reqContext->metrics;
+  NTraceSinkPtr traceSink = reqContext->traceId ? _tracer.sink() : nullptr;
+
+  if (!metrics && !traceSink) {
+    return std::move(reqContext->successCallback);
+  }
+
+  return [metrics, traceSink, traceId = reqContext->traceId, sentAt = reqContext->sentAt,
+          callback = std::move(reqContext->successCallback)]() {
+    auto callbackStart = MetricsClock::now();
+    callback();
+    auto callbackEnd = MetricsClock::now();
+
+    if (metrics) {
+      metrics->callback.record(callbackStart, callbackEnd);
+    }
+
+    if (traceSink) {
+      emitSpan(traceSink, "rest", "callback", traceId, callbackStart, callbackEnd);
+      emitSpan(traceSink, "rest", metrics ? metrics->name : "request", traceId, sentAt, callbackEnd);
+    }
+  };
+}
+
 void RestClient::reqError(RestReqContext* reqContext, const NError& error) {
   NLOG_ERROR(error);
 
-  if (reqContext && reqContext->errorCallback) {
-    reqContext->errorCallback(error);
-  } else if (_defaultErrorCallback) {
-    _defaultErrorCallback(error);
+  if (reqContext && reqContext->metrics) {
+    reqContext->metrics->recordError(error.code);
+  }
+
+  if (reqContext && reqContext->traceId) {
+    emitSpan(
+        _tracer.sink(), "rest", reqContext->metrics ? reqContext->metrics->name : "request", reqContext->traceId,
+        reqContext->sentAt, MetricsClock::now(), {{"error", toString(error.code)}});
+  }
+
+  ErrorCallback errorCallback =
+      reqContext && reqContext->errorCallback ? reqContext->errorCallback : _defaultErrorCallback;
+
+  if (errorCallback) {
+    dispatch([errorCallback, error]() { errorCallback(error); });
   } else {
     NLOG_WARN("^ error not handled");
   }
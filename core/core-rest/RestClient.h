@@ -18,6 +18,7 @@
 
 #include "../common/BaseClient.h"
 #include <google/protobuf/message.h>
+#include <mutex>
 #include <optional>
 #include <set>
 #include <string>
@@ -30,6 +31,10 @@ struct RestReqContext {
   std::function<void()> successCallback;
   ErrorCallback errorCallback;
   google::protobuf::Message* data = nullptr;
+  std::shared_ptr<EndpointRecorder> metrics;
+  MetricsClock::time_point sentAt;
+  MetricsClock::time_point receivedAt;
+  uint64_t traceId = 0; // 0 if request isn't traced
 };
 
 /**
@@ -43,8 +48,6 @@ public:
 
   void disconnect() override;
 
-  void tick() override;
-
   void authenticateDevice(
       const std::string& id,
       const std::optional<std::string>& username,
@@ -554,6 +557,9 @@ public:
       std::function<void(const NRpc&)> successCallback,
       ErrorCallback errorCallback) override;
 
+protected:
+  void pumpTransport() override;
+
 private:
   RestReqContext* createReqContext(google::protobuf::Message* data);
   void setBasicAuth(RestReqContext* ctx);
@@ -570,10 +576,13 @@ private:
   sendRpc(RestReqContext* ctx, const std::string& id, const std::optional<std::string>& payload, NHttpQueryArgs&& args);
 
   void onResponse(RestReqContext* reqContext, NHttpResponsePtr response);
+  // Wraps success callback to record its duration and close the request's trace.
+  std::function<void()> instrumentSuccessCallback(RestReqContext* reqContext);
   void reqError(RestReqContext* reqContext, const NError& error);
 
 private:
   std::set<RestReqContext*> _reqContexts;
+  std::mutex _reqContextsLock;
   NHttpTransportPtr _httpClient;
 };
 } // namespace Nakama
@@ -22,12 +22,118 @@
 #include "nakama-cpp/NUtils.h"
 #include "nakama-cpp/log/NLogger.h"
 #include "nakama-cpp/realtime/rtdata/NRtException.h"
+#include <cstdlib>
 
 #undef NMODULE_NAME
 #define NMODULE_NAME "NRtClient"
 
 namespace Nakama {
 
+static std::string envelopeTypeName(int messageType) {
+  auto* field = ::nakama::realtime::Envelope::descriptor()->FindFieldByNumber(messageType);
+  return field ? std::string(field->name()) : std::string();
+}
+
+// Interned variants leave ids and names empty and set the handles instead.
+template <class T, class B> static void assignEvent(T& event, const B& data, bool intern) {
+  if (intern) {
+    assignInterned(event, data);
+  } else {
+    assign(event, data);
+  }
+}
+
+static bool toEventType(int messageType, NRtEventType& eventType) {
+  using ::nakama::realtime::Envelope;
+
+  switch (messageType) {
+    case Envelope::kChannelMessageFieldNumber:
+      eventType = NRtEventType::ChannelMessage;
+      return true;
+    case Envelope::kChannelPresenceEventFieldNumber:
+      eventType = NRtEventType::ChannelPresence;
+      return true;
+    case Envelope::kMatchmakerMatchedFieldNumber:
+      eventType = NRtEventType::MatchmakerMatched;
+      return true;
+    case Envelope::kMatchDataFieldNumber:
+      eventType = NRtEventType::MatchData;
+      return true;
+    case Envelope::kMatchPresenceEventFieldNumber:
+      eventType = NRtEventType::MatchPresence;
+      return true;
+    case Envelope::kNotificationsFieldNumber:
+      eventType = NRtEventType::Notifications;
+      return true;
+    case Envelope::kPartyFieldNumber:
+      eventType = NRtEventType::Party;
+      return true;
+    case Envelope::kPartyCloseFieldNumber:
+      eventType = NRtEventType::PartyClose;
+      return true;
+    case Envelope::kPartyDataFieldNumber:
+      eventType = NRtEventType::PartyData;
+      return true;
+    case Envelope::kPartyJoinRequestFieldNumber:
+      eventType = NRtEventType::PartyJoinRequest;
+      return true;
+    case Envelope::kPartyLeaderFieldNumber:
+      eventType = NRtEventType::PartyLeader;
+      return true;
+    case Envelope::kPartyMatchmakerTicketFieldNumber:
+      eventType = NRtEventType::PartyMatchmakerTicket;
+      return true;
+    case Envelope::kPartyPresenceEventFieldNumber:
+      eventType = NRtEventType::PartyPresence;
+      return true;
+    case Envelope::kStatusPresenceEventFieldNumber:
+      eventType = NRtEventType::StatusPresence;
+      return true;
+    case Envelope::kStreamPresenceEventFieldNumber:
+      eventType = NRtEventType::StreamPresence;
+      return true;
+    case Envelope::kStreamDataFieldNumber:
+      eventType = NRtEventType::StreamData;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Droppable match and party data is state, chat messages and RPCs can be large and are written last.
+static NSendPriority sendPriority(int messageType, const std::optional<NSendDropKey>& dropKey) {
+  using ::nakama::realtime::Envelope;
+
+  if (dropKey) {
+    return NSendPriority::Latest;
+  }
+  switch (messageType) {
+    case Envelope::kChannelMessageSendFieldNumber:
+    case Envelope::kChannelMessageUpdateFieldNumber:
+    case Envelope::kRpcFieldNumber:
+      return NSendPriority::Bulk;
+    default:
+      return NSendPriority::Control;
+  }
+}
+
+// Unix time of a point in time of the steady clock.
+static std::chrono::microseconds unixTime(MetricsClock::time_point t) {
+  auto age = MetricsClock::now() - t;
+  auto then = std::chrono::system_clock::now() - age;
+  return std::chrono::duration_cast<std::chrono::microseconds>(then.time_since_epoch());
+}
+
+static std::chrono::microseconds unixTime(const google::protobuf::Timestamp& timestamp) {
+  return std::chrono::seconds(timestamp.seconds()) +
+         std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds(timestamp.nanos()));
+}
+
+// Stamps without a fraction of a second are taken to have a resolution of one second.
+static std::chrono::microseconds resolution(const google::protobuf::Timestamp& timestamp) {
+  return timestamp.nanos() == 0 ? std::chrono::seconds(1) : std::chrono::microseconds(1);
+}
+
 NRtClient::NRtClient(NRtTransportPtr transport, const std::string& host, int32_t port, bool ssl)
     : _host(host), _port(port), _ssl(ssl), _transport(transport), _connectPromise(nullptr) {
   NLOG_INFO("Created");
@@ -38,13 +144,37 @@ NRtClient::NRtClient(NRtTransportPtr transport, const std::string& host, int32_t
     NLOG(NLogLevel::Info, "using default port %d", _port);
   }
 
-  _transport->setConnectCallback(std::bind(&NRtClient::onTransportConnected, this));
-  _transport->setErrorCallback(std::bind(&NRtClient::onTransportError, this, std::placeholders::_1));
-  _transport->setDisconnectCallback(std::bind(&NRtClient::onTransportDisconnected, this, std::placeholders::_1));
-  _transport->setMessageCallback(std::bind(&NRtClient::onTransportMessage, this, std::placeholders::_1));
+  // Transport events fired while tick() pumps the transport are queued, so that tick(budget)
+  // can spread their processing over several frames. Same priority for all keeps them in order.
+  _transport->setConnectCallback(
+      [this]() { _ioWorker.runOrDefer(TickPriority::Normal, [this]() { onTransportConnected(); }); });
+  _transport->setErrorCallback([this](const std::string& description) {
+    _ioWorker.runOrDefer(TickPriority::Normal, [this, description]() { onTransportError(description); });
+  });
+  _transport->setDisconnectCallback([this](const NRtClientDisconnectInfo& info) {
+    _ioWorker.runOrDefer(TickPriority::Normal, [this, info]() { onTransportDisconnected(info); });
+  });
+  _transport->setWritableCallback([this]() {
+    _ioWorker.runOrDefer(TickPriority::Normal, [this]() {
+      notifyListener([](NRtClientListenerInterface& listener) { listener.onSendQueueWritable(); });
+    });
+  });
+  _transport->setMessageCallback([this](const NBytes& data) {
+    auto receivedAt = MetricsClock::now();
+    _metrics->recordReceivedBytes(data.size());
+    _ioWorker.runOrDefer(TickPriority::Normal, [this, data, receivedAt]() {
+      auto processingStart = MetricsClock::now();
+      _metrics->queueWait.record(receivedAt, processingStart);
+      emitSpan(_tracer.sink(), "rt", "queue wait", 0, receivedAt, processingStart);
+      onTransportMessage(data, receivedAt);
+    });
+  });
 }
 
 NRtClient::~NRtClient() {
+  // I/O thread pumps transport, stop it first
+  _ioWorker.stop();
+
   // transport destructor can invoke outstanding callbacks. Call destructor here manually
   // while rest of NRtClient is still intact
   _transport.reset();
@@ -56,13 +186,197 @@ NRtClient::~NRtClient() {
   }
 }
 
-void NRtClient::tick() {
+void NRtClient::tick() { tick(std::chrono::microseconds::max()); }
+
+void NRtClient::tick(std::chrono::microseconds budget) {
+  _ioWorker.tick([this]() { pump(); }, budget);
+}
+
+void NRtClient::pump() {
   heartbeat();
+  probeRtt();
   _transport->tick();
 }
 
+void NRtClient::startIoThread(NExecutorPtr callbackExecutor, std::chrono::milliseconds interval) {
+  _ioWorker.start([this]() { pump(); }, std::move(callbackExecutor), interval);
+}
+
+void NRtClient::stopIoThread() { _ioWorker.stop(); }
+
+void NRtClient::dispatch(std::function<void()> callback) {
+  if (!callback) {
+    return;
+  }
+
+  _ioWorker.dispatch([metrics = _metrics, traceSink = _tracer.sink(), callback = std::move(callback)]() {
+    auto callbackStart = MetricsClock::now();
+    callback();
+    auto callbackEnd = MetricsClock::now();
+    metrics->callback.record(callbackStart, callbackEnd);
+    emitSpan(traceSink, "rt", "callback", 0, callbackStart, callbackEnd);
+  });
+}
+
+NRtClientMetrics NRtClient::getMetrics() const { return _metrics->snapshot(envelopeTypeName); }
+
+void NRtClient::notifyListener(std::function<void(NRtClientListenerInterface&)> notify) {
+  dispatch([this, notify = std::move(notify)]() {
+    if (_listener) {
+      notify(*_listener);
+    }
+  });
+}
+
 void NRtClient::setListener(NRtClientListenerInterface* listener) { _listener = listener; }
 
+bool NRtClient::setPayloadCodec(const NPayloadCodecConfig& config) {
+  if (!_payloadCodec.configure(config)) {
+    NLOG_ERROR("Payload compression requires the SDK to be built with zstd");
+    return false;
+  }
+  return true;
+}
+
+bool NRtClient::setSendQueueConfig(const NSendQueueConfig& config) {
+  {
+    std::unordered_set<std::int64_t> droppableOpCodes(config.droppableOpCodes.begin(), config.droppableOpCodes.end());
+    std::lock_guard<std::mutex> lock(_droppableOpCodesMutex);
+    _droppableOpCodes.swap(droppableOpCodes);
+  }
+  if (!_transport->setSendQueueConfig(config)) {
+    NLOG_ERROR("The transport doesn't support a bounded send queue");
+    return false;
+  }
+  return true;
+}
+
+std::optional<NSendDropKey> NRtClient::payloadDropKey(const std::string& streamId, std::int64_t opCode) const {
+  std::lock_guard<std::mutex> lock(_droppableOpCodesMutex);
+  if (_droppableOpCodes.count(opCode) == 0) {
+    return std::nullopt;
+  }
+  return NSendDropKey{streamId, opCode};
+}
+
+void NRtClient::setRttConfig(const NRttConfig& config) {
+  std::lock_guard<std::mutex> lock(_rttConfigMutex);
+  _rttConfig = config;
+  _rtt.setMinRttWindow(config.minRttWindow);
+}
+
+void NRtClient::sampleRtt(
+    const ::nakama::realtime::Envelope& msg,
+    const RtRequestContext* ctx,
+    MetricsClock::time_point receivedAt) {
+  if (!ctx) {
+    // pushed by the server, stamped before we received it
+    if (msg.has_channel_message() && msg.channel_message().has_create_time()) {
+      const auto& stamp = msg.channel_message().create_time();
+      _rtt.addClockSample(unixTime(stamp), resolution(stamp), std::nullopt, unixTime(receivedAt));
+    }
+    return;
+  }
+
+  // server side processing of these takes arbitrarily long
+  if (!ctx->clockProbe && (msg.has_rpc() || msg.has_match())) {
+    return;
+  }
+  _rtt.addRttSample(std::chrono::duration_cast<std::chrono::microseconds>(receivedAt - ctx->sentAt), receivedAt);
+
+  if (ctx->clockProbe && msg.has_rpc()) {
+    char* end = nullptr;
+    const std::string& payload = msg.rpc().payload();
+    long long serverMs = std::strtoll(payload.c_str(), &end, 10);
+    if (end != payload.c_str() && serverMs > 0) {
+      _rtt.addClockSample(
+          std::chrono::milliseconds(serverMs), std::chrono::milliseconds(1), unixTime(ctx->sentAt),
+          unixTime(receivedAt));
+    } else {
+      NLOG(NLogLevel::Warn, "clock RPC returned no Unix time in milliseconds: %s", payload.c_str());
+    }
+  } else if (msg.has_channel_message_ack() && msg.channel_message_ack().has_create_time()) {
+    const auto& stamp = msg.channel_message_ack().create_time();
+    _rtt.addClockSample(unixTime(stamp), resolution(stamp), unixTime(ctx->sentAt), unixTime(receivedAt));
+  }
+}
+
+void NRtClient::probeRtt() {
+  NRttConfig config;
+  {
+    std::lock_guard<std::mutex> lock(_rttConfigMutex);
+    if (_rttConfig.mode != NRttProbeMode::Ping) {
+      return;
+    }
+    config = _rttConfig;
+  }
+
+  if (_wantDisconnect || !_transport->isConnected() || _rttProbeOutstanding) {
+    return;
+  }
+
+  auto now = MetricsClock::now();
+  if (now - _lastRttProbe < config.probeInterval) {
+    return;
+  }
+  _lastRttProbe = now;
+  _rttProbeOutstanding = true;
+
+  auto done = [this]() { _rttProbeOutstanding = false; };
+  if (config.clockRpcId.empty()) {
+    ping(done, [done](const NRtError&) { done(); });
+    return;
+  }
+
+  ::nakama::realtime::Envelope msg;
+  msg.mutable_rpc()->set_id(config.clockRpcId);
+  std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
+  ctx->internal = true;
+  ctx->clockProbe = true;
+  ctx->successCallback = [done](::nakama::realtime::Envelope& /*msg*/) { done(); };
+  ctx->errorCallback = [done](const NRtError&) { done(); };
+  send(msg);
+}
+
+void NRtClient::decodePayload(std::int64_t& opCode, NBytes& data) {
+  if ((opCode & NPayloadCompressedOpCodeFlag) == 0) {
+    return;
+  }
+
+  NBytes decoded;
+  if (!_payloadCodec.decode(data, decoded)) {
+    NLOG(NLogLevel::Warn, "Failed to decompress payload with op code %lld", static_cast<long long>(opCode));
+    return;
+  }
+
+  opCode &= ~NPayloadCompressedOpCodeFlag;
+  data = std::move(decoded);
+}
+
+bool NRtClient::isSubscribed(int messageType) const {
+  NRtEventType eventType;
+
+  // errors and unknown types are always decoded
+  if (!toEventType(messageType, eventType)) {
+    return true;
+  }
+
+  if (_presences->isEnabled()) {
+    switch (eventType) {
+      case NRtEventType::ChannelPresence:
+      case NRtEventType::MatchPresence:
+      case NRtEventType::Party:
+      case NRtEventType::PartyClose:
+      case NRtEventType::PartyPresence:
+        return true;
+      default:
+        break;
+    }
+  }
+
+  return _listener && _listener->isSubscribed(eventType);
+}
+
 void NRtClient::connect(NSessionPtr session, bool createStatus, NRtClientProtocol protocol) {
   if (_transport->isConnected() || _transport->isConnecting()) {
     return;
@@ -159,10 +473,11 @@ void NRtClient::disconnect(const NRtClientDisconnectInfo& info) {
 
 void NRtClient::onTransportConnected() {
   _heartbeatFailureReported = false;
+  _rtt.resetRtt();
+  _rttProbeOutstanding = false;
+  _metrics->recordConnect();
 
-  if (_listener) {
-    _listener->onConnect();
-  }
+  notifyListener([](NRtClientListenerInterface& listener) { listener.onConnect(); });
 
   try {
     if (_connectPromise) {
@@ -180,12 +495,15 @@ void NRtClient::onTransportConnected() {
 
 void NRtClient::onTransportDisconnected(const NRtClientDisconnectInfo& info) {
   NLOG(NLogLevel::Debug, "code: %u, remote: %d, %s", info.code, info.remote, info.reason.c_str());
+  _metrics->recordDisconnect();
 
   cancelAllRequests(RtErrorCode::DISCONNECTED);
 
-  if (_listener) {
-    _listener->onDisconnect(info);
+  if (_presences->isEnabled()) {
+    // server drops our presences with the connection
+    dispatch([presences = _presences]() { presences->clear(); });
   }
+  notifyListener([info](NRtClientListenerInterface& listener) { listener.onDisconnect(info); });
 
   try {
     if (_connectPromise) {
@@ -211,10 +529,9 @@ void NRtClient::onTransportError(const std::string& description) {
   error.code = _transport->isConnected() ? RtErrorCode::TRANSPORT_ERROR : RtErrorCode::CONNECT_ERROR;
 
   NLOG_ERROR(toString(error));
+  _metrics->recordError(error.code);
 
-  if (_listener) {
-    _listener->onError(error);
-  }
+  notifyListener([error](NRtClientListenerInterface& listener) { listener.onError(error); });
 
   try {
     if (_connectPromise) {
@@ -231,90 +548,151 @@ void NRtClient::onTransportError(const std::string& description) {
   }
 }
 
-void NRtClient::onTransportMessage(const NBytes& data) {
+void NRtClient::onTransportMessage(const NBytes& data, MetricsClock::time_point receivedAt) {
+  // Drop events nobody listens to before paying for parsing and conversion.
+  // Responses to our requests (with cid) are always decoded.
+  RtEnvelopePeek peek;
+  if (_protocol->peekEnvelope(data, peek) && !peek.hasCid && peek.messageType != 0 &&
+      !isSubscribed(peek.messageType)) {
+    _metrics->recordReceived(peek.messageType);
+    _metrics->recordSkipped(peek.messageType);
+    return;
+  }
+
   ::nakama::realtime::Envelope msg;
 
+  auto decodeStart = MetricsClock::now();
   if (!_protocol->parse(data, msg)) {
     onTransportError("parse message failed");
     return;
   }
+  auto decodeEnd = MetricsClock::now();
+  _metrics->decode.record(decodeStart, decodeEnd);
+  _metrics->recordReceived(msg.message_case());
+
+  NTraceSinkPtr traceSink = _tracer.sink();
+  if (traceSink) {
+    emitSpan(traceSink, "rt", "decode " + envelopeTypeName(msg.message_case()), 0, decodeStart, decodeEnd);
+  }
 
   NRtError error;
 
+  if (msg.cid().empty()) {
+    sampleRtt(msg, nullptr, receivedAt);
+  }
+
   if (msg.has_error()) {
     assign(error, msg.error());
 
     NLOG_ERROR(toString(error));
+    _metrics->recordError(error.code);
   }
 
   if (msg.cid().empty()) {
-    if (_listener) {
+    if (_listener || _presences->isEnabled()) {
       if (msg.has_error()) {
-        _listener->onError(error);
+        notifyListener([error](NRtClientListenerInterface& listener) { listener.onError(error); });
       } else if (msg.has_channel_message()) {
         NChannelMessage channelMessage;
-        assign(channelMessage, msg.channel_message());
-        _listener->onChannelMessage(channelMessage);
+        assignEvent(channelMessage, msg.channel_message(), _internStrings);
+        notifyListener([e = std::move(channelMessage)](NRtClientListenerInterface& listener) {
+          listener.onChannelMessage(e);
+        });
       } else if (msg.has_channel_presence_event()) {
         NChannelPresenceEvent channelPresenceEvent;
-        assign(channelPresenceEvent, msg.channel_presence_event());
-        _listener->onChannelPresence(channelPresenceEvent);
+        assignEvent(channelPresenceEvent, msg.channel_presence_event(), _internStrings);
+        dispatch([this, e = std::move(channelPresenceEvent)]() {
+          _presences->apply(e);
+          if (_listener) {
+            _listener->onChannelPresence(e);
+          }
+        });
       } else if (msg.has_match_data()) {
         NMatchData matchData;
-        assign(matchData, msg.match_data());
-        _listener->onMatchData(matchData);
+        assignEvent(matchData, msg.match_data(), _internStrings);
+        decodePayload(matchData.opCode, matchData.data);
+        notifyListener([e = std::move(matchData)](NRtClientListenerInterface& listener) { listener.onMatchData(e); });
       } else if (msg.has_match_presence_event()) {
         NMatchPresenceEvent matchPresenceEvent;
-        assign(matchPresenceEvent, msg.match_presence_event());
-        _listener->onMatchPresence(matchPresenceEvent);
+        assignEvent(matchPresenceEvent, msg.match_presence_event(), _internStrings);
+        dispatch([this, e = std::move(matchPresenceEvent)]() {
+          _presences->apply(e);
+          if (_listener) {
+            _listener->onMatchPresence(e);
+          }
+        });
       } else if (msg.has_matchmaker_matched()) {
         NMatchmakerMatchedPtr matchmakerMatched(new NMatchmakerMatched());
         assign(*matchmakerMatched, msg.matchmaker_matched());
-        _listener->onMatchmakerMatched(matchmakerMatched);
+        notifyListener([e = std::move(matchmakerMatched)](NRtClientListenerInterface& listener) {
+          listener.onMatchmakerMatched(e);
+        });
       } else if (msg.has_notifications()) {
         NNotificationList list;
         assign(list, msg.notifications());
-        _listener->onNotifications(list);
+        notifyListener([e = std::move(list)](NRtClientListenerInterface& listener) { listener.onNotifications(e); });
       } else if (msg.has_status_presence_event()) {
         NStatusPresenceEvent event;
-        assign(event, msg.status_presence_event());
-        _listener->onStatusPresence(event);
+        assignEvent(event, msg.status_presence_event(), _internStrings);
+        notifyListener([e = std::move(event)](NRtClientListenerInterface& listener) { listener.onStatusPresence(e); });
       } else if (msg.has_stream_data()) {
         NStreamData streamData;
-        assign(streamData, msg.stream_data());
-        _listener->onStreamData(streamData);
+        assignEvent(streamData, msg.stream_data(), _internStrings);
+        notifyListener([e = std::move(streamData)](NRtClientListenerInterface& listener) { listener.onStreamData(e); });
       } else if (msg.has_stream_presence_event()) {
         NStreamPresenceEvent event;
-        assign(event, msg.stream_presence_event());
-        _listener->onStreamPresence(event);
+        assignEvent(event, msg.stream_presence_event(), _internStrings);
+        notifyListener([e = std::move(event)](NRtClientListenerInterface& listener) { listener.onStreamPresence(e); });
       } else if (msg.has_party()) {
         NParty party;
         assign(party, msg.party());
-        _listener->onParty(party);
+        dispatch([this, e = std::move(party)]() {
+          _presences->reset(e);
+          if (_listener) {
+            _listener->onParty(e);
+          }
+        });
       } else if (msg.has_party_close()) {
         NPartyClose partyClose;
         assign(partyClose, msg.party_close());
-        _listener->onPartyClosed(partyClose);
+        dispatch([this, e = std::move(partyClose)]() {
+          _presences->remove(NPresenceStreamType::Party, e.id);
+          if (_listener) {
+            _listener->onPartyClosed(e);
+          }
+        });
       } else if (msg.has_party_data()) {
         NPartyData partyData;
-        assign(partyData, msg.party_data());
-        _listener->onPartyData(partyData);
+        assignEvent(partyData, msg.party_data(), _internStrings);
+        decodePayload(partyData.opCode, partyData.data);
+        notifyListener([e = std::move(partyData)](NRtClientListenerInterface& listener) { listener.onPartyData(e); });
       } else if (msg.has_party_join_request()) {
         NPartyJoinRequest partyRequest;
         assign(partyRequest, msg.party_join_request());
-        _listener->onPartyJoinRequest(partyRequest);
+        notifyListener([e = std::move(partyRequest)](NRtClientListenerInterface& listener) {
+          listener.onPartyJoinRequest(e);
+        });
       } else if (msg.has_party_leader()) {
         NPartyLeader partyLeader;
         assign(partyLeader, msg.party_leader());
-        _listener->onPartyLeader(partyLeader);
+        notifyListener([e = std::move(partyLeader)](NRtClientListenerInterface& listener) {
+          listener.onPartyLeader(e);
+        });
       } else if (msg.has_party_matchmaker_ticket()) {
         NPartyMatchmakerTicket partyTicket;
         assign(partyTicket, msg.party_matchmaker_ticket());
-        _listener->onPartyMatchmakerTicket(partyTicket);
+        notifyListener([e = std::move(partyTicket)](NRtClientListenerInterface& listener) {
+          listener.onPartyMatchmakerTicket(e);
+        });
       } else if (msg.has_party_presence_event()) {
         NPartyPresenceEvent presenceEvent;
-        assign(presenceEvent, msg.party_presence_event());
-        _listener->onPartyPresence(presenceEvent);
+        assignEvent(presenceEvent, msg.party_presence_event(), _internStrings);
+        dispatch([this, e = std::move(presenceEvent)]() {
+          _presences->apply(e);
+          if (_listener) {
+            _listener->onPartyPresence(e);
+          }
+        });
       } else {
         onTransportError("Unknown message received");
       }
@@ -335,16 +713,29 @@ void NRtClient::onTransportMessage(const NBytes& data) {
     }
 
     if (ctx) {
+      _metrics->requestRtt.record(ctx->sentAt, decodeEnd);
+      sampleRtt(msg, ctx.get(), receivedAt);
+
+      if (traceSink && ctx->traceId) {
+        emitSpan(
+            traceSink, "rt", "response " + envelopeTypeName(msg.message_case()), ctx->traceId, ctx->sentAt, decodeEnd,
+            {{"cid", msg.cid()}});
+      }
+
       if (msg.has_error()) {
         if (ctx->errorCallback) {
-          ctx->errorCallback(error);
+          dispatch([ctx, error]() { ctx->errorCallback(error); });
         } else if (_listener) {
-          _listener->onError(error);
+          notifyListener([error](NRtClientListenerInterface& listener) { listener.onError(error); });
         } else {
           NLOG_WARN("^ error not handled");
         }
       } else if (ctx->successCallback) {
-        ctx->successCallback(msg);
+        if (ctx->internal) {
+          ctx->successCallback(msg);
+        } else {
+          dispatch([ctx, msg = std::move(msg)]() mutable { ctx->successCallback(msg); });
+        }
       }
     } else {
       onTransportError("request context not found. cid: " + msg.cid());
@@ -374,11 +765,14 @@ void NRtClient::joinChat(
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
-  if (successCallback) {
-    ctx->successCallback = [successCallback](::nakama::realtime::Envelope& msg) {
+  if (successCallback || _presences->isEnabled()) {
+    ctx->successCallback = [presences = _presences, successCallback](::nakama::realtime::Envelope& msg) {
       NChannelPtr channel(new NChannel());
       assign(*channel, msg.channel());
-      successCallback(channel);
+      presences->reset(*channel);
+      if (successCallback) {
+        successCallback(channel);
+      }
     };
   }
   ctx->errorCallback = errorCallback;
@@ -398,8 +792,13 @@ void NRtClient::leaveChat(
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
-  if (successCallback) {
-    ctx->successCallback = [successCallback](::nakama::realtime::Envelope& /*msg*/) { successCallback(); };
+  if (successCallback || _presences->isEnabled()) {
+    ctx->successCallback = [presences = _presences, channelId, successCallback](::nakama::realtime::Envelope& /*msg*/) {
+      presences->remove(NPresenceStreamType::Channel, channelId);
+      if (successCallback) {
+        successCallback();
+      }
+    };
   }
   ctx->errorCallback = errorCallback;
 
@@ -499,11 +898,14 @@ void NRtClient::createMatch(std::function<void(const NMatch&)> successCallback,
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
-  if (successCallback) {
-    ctx->successCallback = [successCallback](::nakama::realtime::Envelope& msg) {
+  if (successCallback || _presences->isEnabled()) {
+    ctx->successCallback = [presences = _presences, successCallback](::nakama::realtime::Envelope& msg) {
       NMatch match;
       assign(match, msg.match());
-      successCallback(match);
+      presences->reset(match);
+      if (successCallback) {
+        successCallback(match);
+      }
     };
   }
   ctx->errorCallback = errorCallback;
@@ -529,11 +931,14 @@ void NRtClient::joinMatch(
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
-  if (successCallback) {
-    ctx->successCallback = [successCallback](::nakama::realtime::Envelope& msg) {
+  if (successCallback || _presences->isEnabled()) {
+    ctx->successCallback = [presences = _presences, successCallback](::nakama::realtime::Envelope& msg) {
       NMatch match;
       assign(match, msg.match());
-      successCallback(match);
+      presences->reset(match);
+      if (successCallback) {
+        successCallback(match);
+      }
     };
   }
   ctx->errorCallback = errorCallback;
@@ -553,11 +958,14 @@ void NRtClient::joinMatchByToken(
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
-  if (successCallback) {
-    ctx->successCallback = [successCallback](::nakama::realtime::Envelope& msg) {
+  if (successCallback || _presences->isEnabled()) {
+    ctx->successCallback = [presences = _presences, successCallback](::nakama::realtime::Envelope& msg) {
       NMatch match;
       assign(match, msg.match());
-      successCallback(match);
+      presences->reset(match);
+      if (successCallback) {
+        successCallback(match);
+      }
     };
   }
   ctx->errorCallback = errorCallback;
@@ -577,8 +985,13 @@ void NRtClient::leaveMatch(
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
-  if (successCallback) {
-    ctx->successCallback = [successCallback](::nakama::realtime::Envelope& /*msg*/) { successCallback(); };
+  if (successCallback || _presences->isEnabled()) {
+    ctx->successCallback = [presences = _presences, matchId, successCallback](::nakama::realtime::Envelope& /*msg*/) {
+      presences->remove(NPresenceStreamType::Match, matchId);
+      if (successCallback) {
+        successCallback();
+      }
+    };
   }
   ctx->errorCallback = errorCallback;
 
@@ -661,27 +1074,34 @@ void NRtClient::sendMatchData(
   auto* match_data = msg.mutable_match_data_send();
 
   match_data->set_match_id(matchId);
-  match_data->set_op_code(opCode);
-  match_data->set_data(data.data(), data.size());
+
+  NBytes compressed;
+  if (_payloadCodec.encode(matchId, data, compressed)) {
+    match_data->set_op_code(opCode | NPayloadCompressedOpCodeFlag);
+    match_data->set_data(std::move(compressed));
+  } else {
+    match_data->set_op_code(opCode);
+    match_data->set_data(data.data(), data.size());
+  }
 
   for (auto& presence : presences) {
-    if (presence.userId.empty()) {
+    if (presence.getUserId().empty()) {
       NLOG_ERROR("Please set 'userId' for user presence");
       continue;
     }
 
-    if (presence.sessionId.empty()) {
+    if (presence.getSessionId().empty()) {
       NLOG_ERROR("Please set 'sessionId' for user presence");
       continue;
     }
 
     auto* presenceData = match_data->mutable_presences()->Add();
 
-    presenceData->set_user_id(presence.userId);
-    presenceData->set_session_id(presence.sessionId);
+    presenceData->set_user_id(presence.getUserId());
+    presenceData->set_session_id(presence.getSessionId());
 
-    if (!presence.username.empty())
-      presenceData->set_username(presence.username);
+    if (!presence.getUsername().empty())
+      presenceData->set_username(presence.getUsername());
 
     if (!presence.status.empty())
       presenceData->mutable_status()->set_value(presence.status);
@@ -689,7 +1109,7 @@ void NRtClient::sendMatchData(
     presenceData->set_persistence(presence.persistence);
   }
 
-  send(msg);
+  send(msg, payloadDropKey(matchId, opCode));
 }
 
 void NRtClient::followUsers(
@@ -801,10 +1221,10 @@ void NRtClient::acceptPartyMember(
   ::nakama::realtime::Envelope msg;
 
   msg.mutable_party_accept()->set_party_id(partyId);
-  msg.mutable_party_accept()->mutable_presence()->set_user_id(presence.userId);
+  msg.mutable_party_accept()->mutable_presence()->set_user_id(presence.getUserId());
   msg.mutable_party_accept()->mutable_presence()->set_persistence(presence.persistence);
-  msg.mutable_party_accept()->mutable_presence()->set_session_id(presence.sessionId);
-  msg.mutable_party_accept()->mutable_presence()->set_username(presence.username);
+  msg.mutable_party_accept()->mutable_presence()->set_session_id(presence.getSessionId());
+  msg.mutable_party_accept()->mutable_presence()->set_username(presence.getUsername());
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
@@ -894,11 +1314,14 @@ void NRtClient::createParty(
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
-  if (successCallback) {
-    ctx->successCallback = [successCallback](::nakama::realtime::Envelope& msg) {
+  if (successCallback || _presences->isEnabled()) {
+    ctx->successCallback = [presences = _presences, successCallback](::nakama::realtime::Envelope& msg) {
       NParty party;
       assign(party, msg.party());
-      successCallback(party);
+      presences->reset(party);
+      if (successCallback) {
+        successCallback(party);
+      }
     };
   }
   ctx->errorCallback = errorCallback;
@@ -937,8 +1360,13 @@ void NRtClient::leaveParty(
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
-  if (successCallback) {
-    ctx->successCallback = [successCallback](::nakama::realtime::Envelope& /*msg*/) { successCallback(); };
+  if (successCallback || _presences->isEnabled()) {
+    ctx->successCallback = [presences = _presences, partyId, successCallback](::nakama::realtime::Envelope& /*msg*/) {
+      presences->remove(NPresenceStreamType::Party, partyId);
+      if (successCallback) {
+        successCallback();
+      }
+    };
   }
   ctx->errorCallback = errorCallback;
 
@@ -980,10 +1408,10 @@ void NRtClient::promotePartyMember(
 
   msg.mutable_party_promote()->set_party_id(partyId);
 
-  msg.mutable_party_promote()->mutable_presence()->set_user_id(partyMember.userId);
+  msg.mutable_party_promote()->mutable_presence()->set_user_id(partyMember.getUserId());
   msg.mutable_party_promote()->mutable_presence()->set_persistence(partyMember.persistence);
-  msg.mutable_party_promote()->mutable_presence()->set_session_id(partyMember.sessionId);
-  msg.mutable_party_promote()->mutable_presence()->set_username(partyMember.username);
+  msg.mutable_party_promote()->mutable_presence()->set_session_id(partyMember.getSessionId());
+  msg.mutable_party_promote()->mutable_presence()->set_username(partyMember.getUsername());
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
@@ -1028,10 +1456,10 @@ void NRtClient::removePartyMember(
 
   msg.mutable_party_remove()->set_party_id(partyId);
 
-  msg.mutable_party_remove()->mutable_presence()->set_user_id(presence.userId);
+  msg.mutable_party_remove()->mutable_presence()->set_user_id(presence.getUserId());
   msg.mutable_party_remove()->mutable_presence()->set_persistence(presence.persistence);
-  msg.mutable_party_remove()->mutable_presence()->set_session_id(presence.sessionId);
-  msg.mutable_party_remove()->mutable_presence()->set_username(presence.username);
+  msg.mutable_party_remove()->mutable_presence()->set_session_id(presence.getSessionId());
+  msg.mutable_party_remove()->mutable_presence()->set_username(presence.getUsername());
 
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
 
@@ -1049,12 +1477,19 @@ void NRtClient::sendPartyData(const std::string& partyId, long opCode, NBytes& d
   ::nakama::realtime::Envelope msg;
 
   msg.mutable_party_data_send()->set_party_id(partyId);
-  msg.mutable_party_data_send()->set_op_code(opCode);
-  msg.mutable_party_data_send()->set_data(data);
+
+  NBytes compressed;
+  if (_payloadCodec.encode(partyId, data, compressed)) {
+    msg.mutable_party_data_send()->set_op_code(std::int64_t(opCode) | NPayloadCompressedOpCodeFlag);
+    msg.mutable_party_data_send()->set_data(std::move(compressed));
+  } else {
+    msg.mutable_party_data_send()->set_op_code(opCode);
+    msg.mutable_party_data_send()->set_data(data);
+  }
 
   createReqContext(msg);
 
-  send(msg);
+  send(msg, payloadDropKey(partyId, opCode));
 }
 
 void NRtClient::ping(std::function<void()> successCallback, RtErrorCallback errorCallback) {
@@ -1064,6 +1499,8 @@ void NRtClient::ping(std::function<void()> successCallback, RtErrorCallback erro
 
   msg.mutable_ping();
   std::shared_ptr<RtRequestContext> ctx = createReqContext(msg);
+  // heartbeat bookkeeping must not wait for the user's executor
+  ctx->internal = true;
 
   if (successCallback) {
     ctx->successCallback = [successCallback](::nakama::realtime::Envelope& /*msg*/) { successCallback(); };
@@ -1351,6 +1788,10 @@ std::shared_ptr<RtRequestContext> NRtClient::createReqContext(::nakama::realtime
     }
   }
   msg.set_cid(std::to_string(cid));
+  it->second->sentAt = MetricsClock::now();
+  if (_tracer.sink()) {
+    it->second->traceId = _tracer.nextTraceId();
+  }
 
   // it is safe to return raw pointer from unique_ptr because only way entry
   //  can be removed from _reqContexts is after request was sent, but all callers
@@ -1362,6 +1803,7 @@ std::shared_ptr<RtRequestContext> NRtClient::createReqContext(::nakama::realtime
 
 void NRtClient::reqInternalError(int32_t cid, const NRtError& error) {
   NLOG_ERROR(toString(error));
+  _metrics->recordError(error.code);
 
   std::shared_ptr<RtRequestContext> ctx;
   {
@@ -1372,17 +1814,15 @@ void NRtClient::reqInternalError(int32_t cid, const NRtError& error) {
       _reqContexts.erase(it);
     } else {
       NLOG(NLogLevel::Error, "request context not found. cid: %d", cid);
-      if (_listener) {
-        _listener->onError(error);
-      }
+      notifyListener([error](NRtClientListenerInterface& listener) { listener.onError(error); });
       return;
     }
   }
 
   if (ctx && ctx->errorCallback) {
-    ctx->errorCallback(error);
+    dispatch([ctx, error]() { ctx->errorCallback(error); });
   } else if (_listener) {
-    _listener->onError(error);
+    notifyListener([error](NRtClientListenerInterface& listener) { listener.onError(error); });
   } else {
     NLOG_WARN("error not handled");
   }
@@ -1392,8 +1832,9 @@ void NRtClient::cancelAllRequests(RtErrorCode code) {
   NRtError err(code, "");
   std::lock_guard<std::mutex> lock(_reqContextsLock);
   for (auto& r : _reqContexts) {
+    _metrics->recordError(code);
     if (r.second->errorCallback) {
-      r.second->errorCallback(err);
+      dispatch([ctx = r.second, err]() { ctx->errorCallback(err); });
     }
   }
   _reqContexts.clear();
@@ -1451,7 +1892,8 @@ void NRtClient::heartbeat() {
   _lastHeartbeatTs = now;
 }
 
-void NRtClient::send(const ::nakama::realtime::Envelope& msg) {
+void NRtClient::send(const ::nakama::realtime::Envelope& msg, const std::optional<NSendDropKey>& dropKey) {
+  auto sendStart = MetricsClock::now();
   int cid = -1;
   if (msg.cid() != "") {
     cid = std::stoi(msg.cid());
@@ -1461,9 +1903,21 @@ void NRtClient::send(const ::nakama::realtime::Envelope& msg) {
     NBytes bytes;
 
     if (_protocol->serialize(msg, bytes)) {
-      if (!_transport->send(bytes)) {
+      NSendResult result = _transport->trySend(bytes, dropKey, sendPriority(msg.message_case(), dropKey));
+      if (result == NSendResult::Failed) {
         reqInternalError(cid, NRtError(RtErrorCode::TRANSPORT_ERROR, "Send message failed"));
         _transport->disconnect();
+      } else if (result == NSendResult::Rejected) {
+        reqInternalError(cid, NRtError(RtErrorCode::SEND_QUEUE_FULL, "Send queue is full"));
+      } else {
+        _metrics->recordSent(msg.message_case(), bytes.size());
+
+        NTraceSinkPtr traceSink = _tracer.sink();
+        if (traceSink) {
+          emitSpan(
+              traceSink, "rt", "send " + envelopeTypeName(msg.message_case()), 0, sendStart, MetricsClock::now(),
+              {{"cid", msg.cid()}, {"bytes", std::to_string(bytes.size())}});
+        }
       }
       _lastMessageTs = getUnixTimestampMs();
     } else {
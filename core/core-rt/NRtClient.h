@@ -16,17 +16,30 @@
 
 #pragma once
 
+#include "IoWorker.h"
+#include "Metrics.h"
+#include "Tracing.h"
 #include "NRtClientProtocolInterface.h"
+#include "PayloadCodec.h"
+#include "PresenceStore.h"
+#include "RttEstimator.h"
 #include "nakama-cpp/realtime/NRtClientInterface.h"
 #include "rtapi/realtime.pb.h"
 #include <map>
 #include <memory>
+#include <optional>
+#include <unordered_set>
 
 namespace Nakama {
 
 struct RtRequestContext {
   std::function<void(::nakama::realtime::Envelope&)> successCallback;
   RtErrorCallback errorCallback;
+  // internal requests (pings) run their callbacks on the I/O thread, not via user's executor
+  bool internal = false;
+  MetricsClock::time_point sentAt;
+  bool clockProbe = false; // rpc of NRttConfig::clockRpcId, its payload is the server time
+  uint64_t traceId = 0; // 0 if request isn't traced
 };
 
 /**
@@ -39,6 +52,28 @@ public:
   ~NRtClient();
 
   void tick() override;
+  void tick(std::chrono::microseconds budget) override;
+  NTickStats getTickStats() const override { return _ioWorker.getTickStats(); }
+
+  void startIoThread(NExecutorPtr callbackExecutor, std::chrono::milliseconds interval) override;
+  void stopIoThread() override;
+
+  NRtClientMetrics getMetrics() const override;
+  void resetMetrics() override { _metrics->reset(); }
+  void setTraceSink(NTraceSinkPtr sink) override { _tracer.setSink(std::move(sink)); }
+
+  void setPresenceTracking(bool enabled) override { _presences->setEnabled(enabled); }
+  NPresenceStorePtr getPresenceStore() const override { return _presences; }
+  void setStringInterning(bool enabled) override { _internStrings = enabled; }
+  bool setPayloadCodec(const NPayloadCodecConfig& config) override;
+  bool setPayloadDictionary(const std::string& streamId, const NBytes& dictionary) override {
+    return _payloadCodec.setDictionary(streamId, dictionary);
+  }
+  NPayloadCodecStats getPayloadCodecStats() const override { return _payloadCodec.getStats(); }
+  bool setSendQueueConfig(const NSendQueueConfig& config) override;
+  void setRttConfig(const NRttConfig& config) override;
+  NRttStats getRttStats() const override { return _rtt.getStats(); }
+  NSendQueueStats getSendQueueStats() const override { return _transport->getSendQueueStats(); }
 
   NRtTransportPtr getTransport() const override { return _transport; }
   void setListener(NRtClientListenerInterface* listener) override;
@@ -299,18 +334,32 @@ protected:
   void onTransportConnected();
   void onTransportDisconnected(const NRtClientDisconnectInfo& info);
   void onTransportError(const std::string& description);
-  void onTransportMessage(const NBytes& data);
+  void onTransportMessage(const NBytes& data, MetricsClock::time_point receivedAt);
 
   void reqInternalError(int32_t cid, const NRtError& error);
 
   std::shared_ptr<RtRequestContext> createReqContext(::nakama::realtime::Envelope& msg);
-  void send(const ::nakama::realtime::Envelope& msg);
+  void send(const ::nakama::realtime::Envelope& msg, const std::optional<NSendDropKey>& dropKey = std::nullopt);
 
 private:
   // Even though Ping message is in Nakama public API, there is no use case to call it directly
   // other than to implement client-driven heartbeat, which we already have.
   void ping(std::function<void()> successCallback, RtErrorCallback errorCallback = nullptr);
   void heartbeat();
+  // Sends the periodic probe of NRttProbeMode::Ping.
+  void probeRtt();
+  // Feeds RTT and clock offset samples of a received message to the estimator.
+  void sampleRtt(
+      const ::nakama::realtime::Envelope& msg, const RtRequestContext* ctx, MetricsClock::time_point receivedAt);
+  void pump();
+  void dispatch(std::function<void()> callback);
+  void notifyListener(std::function<void(NRtClientListenerInterface&)> notify);
+  // Whether a server pushed message of the given Envelope type has to be decoded.
+  bool isSubscribed(int messageType) const;
+  // Drop key of match or party data with the given op code, if the send queue config lists the op code.
+  std::optional<NSendDropKey> payloadDropKey(const std::string& streamId, std::int64_t opCode) const;
+  // Decompresses received match or party data sent with NPayloadCompressedOpCodeFlag.
+  void decodePayload(std::int64_t& opCode, NBytes& data);
   void cancelAllRequests(RtErrorCode code);
   void disconnect(const NRtClientDisconnectInfo& info);
 
@@ -326,11 +375,27 @@ private:
   int32_t _nextCid = 0;
   void* _userData = nullptr;
 
-  NTimestamp _lastMessageTs = 0;   // last message sent. Used to decide whether to send heartbeat
-  NTimestamp _lastHeartbeatTs = 0; // last heartbeat. != 0 when we are waiting for the heartbeat response
+  std::atomic<NTimestamp> _lastMessageTs = 0;   // last message sent. Used to decide whether to send heartbeat
+  std::atomic<NTimestamp> _lastHeartbeatTs = 0; // last heartbeat. != 0 when we are waiting for the heartbeat response
   bool _heartbeatFailureReported = false;
   std::optional<int> _heartbeatIntervalMs = 5000;
   std::atomic<bool> _wantDisconnect = false;
+  std::atomic<bool> _internStrings = false;
   std::unique_ptr<std::promise<void>> _connectPromise = nullptr;
+  // shared with dispatched callbacks, which may run after the client is gone
+  std::shared_ptr<RtMetrics> _metrics = std::make_shared<RtMetrics>();
+  Tracer _tracer;
+  // shared with request callbacks, which may run after the client is gone
+  std::shared_ptr<PresenceStore> _presences = std::make_shared<PresenceStore>();
+  PayloadCodec _payloadCodec;
+  // set by setSendQueueConfig, read by senders on any thread
+  mutable std::mutex _droppableOpCodesMutex;
+  std::unordered_set<std::int64_t> _droppableOpCodes;
+  RttEstimator _rtt;
+  mutable std::mutex _rttConfigMutex;
+  NRttConfig _rttConfig;
+  std::atomic<bool> _rttProbeOutstanding = false;
+  MetricsClock::time_point _lastRttProbe;
+  IoWorker _ioWorker;
 };
 } // namespace Nakama
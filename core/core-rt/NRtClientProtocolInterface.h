@@ -21,12 +21,21 @@
 
 namespace Nakama {
 
+// What a realtime Envelope contains, found without parsing it.
+struct RtEnvelopePeek {
+  int messageType = 0; // Envelope field number of the message, 0 if none
+  bool hasCid = false; // responses to our requests have cid
+};
+
 class NRtClientProtocolInterface {
 public:
   virtual ~NRtClientProtocolInterface() {}
 
   virtual bool serialize(const google::protobuf::Message& message, NBytes& output) = 0;
   virtual bool parse(const NBytes& input, google::protobuf::Message& message) = 0;
+
+  // Scans top level of a serialized Envelope. Returns false if input is malformed.
+  virtual bool peekEnvelope(const NBytes& input, RtEnvelopePeek& result) = 0;
 };
 
 using NRtClientProtocolPtr = std::shared_ptr<NRtClientProtocolInterface>;
@@ -16,6 +16,8 @@
 
 #include "NRtClientProtocol_Json.h"
 #include "google/protobuf/util/json_util.h"
+#include "rtapi/realtime.pb.h"
+#include <cctype>
 
 namespace Nakama {
 
@@ -33,4 +35,129 @@ bool NRtClientProtocol_Json::parse(const NBytes& input, google::protobuf::Messag
   return status.ok();
 }
 
+namespace {
+class JsonScanner {
+public:
+  explicit JsonScanner(const NBytes& input) : _input(input) {}
+
+  void skipWhitespace() {
+    while (_pos < _input.size() && std::isspace(static_cast<unsigned char>(_input[_pos]))) {
+      ++_pos;
+    }
+  }
+
+  bool consume(char c) {
+    skipWhitespace();
+    if (_pos < _input.size() && _input[_pos] == c) {
+      ++_pos;
+      return true;
+    }
+    return false;
+  }
+
+  // Reads a string without unescaping it, enough for field names.
+  bool readString(std::string& out) {
+    skipWhitespace();
+    if (_pos >= _input.size() || _input[_pos] != '"') {
+      return false;
+    }
+
+    size_t start = ++_pos;
+    while (_pos < _input.size() && _input[_pos] != '"') {
+      _pos += _input[_pos] == '\\' ? 2 : 1;
+    }
+
+    if (_pos >= _input.size()) {
+      return false;
+    }
+
+    out.assign(_input, start, _pos - start);
+    ++_pos;
+    return true;
+  }
+
+  bool skipValue() {
+    skipWhitespace();
+    if (_pos >= _input.size()) {
+      return false;
+    }
+
+    char c = _input[_pos];
+    if (c == '"') {
+      std::string ignored;
+      return readString(ignored);
+    }
+
+    if (c == '{' || c == '[') {
+      int depth = 0;
+      while (_pos < _input.size()) {
+        c = _input[_pos];
+        if (c == '"') {
+          if (!skipValue()) {
+            return false;
+          }
+          continue;
+        }
+
+        ++_pos;
+        if (c == '{' || c == '[') {
+          ++depth;
+        } else if ((c == '}' || c == ']') && --depth == 0) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // number, true, false, null
+    while (_pos < _input.size() && _input[_pos] != ',' && _input[_pos] != '}' && _input[_pos] != ']') {
+      ++_pos;
+    }
+    return true;
+  }
+
+private:
+  const NBytes& _input;
+  size_t _pos = 0;
+};
+} // namespace
+
+bool NRtClientProtocol_Json::peekEnvelope(const NBytes& input, RtEnvelopePeek& result) {
+  const auto* descriptor = ::nakama::realtime::Envelope::descriptor();
+  JsonScanner scanner(input);
+  std::string key;
+
+  if (!scanner.consume('{')) {
+    return false;
+  }
+
+  if (scanner.consume('}')) {
+    return true;
+  }
+
+  do {
+    if (!scanner.readString(key) || !scanner.consume(':')) {
+      return false;
+    }
+
+    // server may use either proto or JSON (lowerCamelCase) field names
+    const auto* field = descriptor->FindFieldByName(key);
+    if (!field) {
+      field = descriptor->FindFieldByCamelcaseName(key);
+    }
+
+    if (field && field->number() == ::nakama::realtime::Envelope::kCidFieldNumber) {
+      result.hasCid = true;
+    } else if (field && result.messageType == 0) {
+      result.messageType = field->number();
+    }
+
+    if (!scanner.skipValue()) {
+      return false;
+    }
+  } while (scanner.consume(','));
+
+  return scanner.consume('}');
+}
+
 } // namespace Nakama
@@ -15,6 +15,7 @@
  */
 
 #include "NRtClientProtocol_Protobuf.h"
+#include "rtapi/realtime.pb.h"
 
 namespace Nakama {
 
@@ -30,4 +31,68 @@ bool NRtClientProtocol_Protobuf::parse(const NBytes& input, google::protobuf::Me
   return message.ParseFromArray(input.data(), static_cast<int>(input.size()));
 }
 
+namespace {
+bool readVarint(const NBytes& input, size_t& pos, uint64_t& value) {
+  value = 0;
+  for (int shift = 0; shift < 64 && pos < input.size(); shift += 7) {
+    auto byte = static_cast<uint8_t>(input[pos++]);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
+bool NRtClientProtocol_Protobuf::peekEnvelope(const NBytes& input, RtEnvelopePeek& result) {
+  size_t pos = 0;
+
+  // walk top level fields by their wire tags, skipping over the payloads
+  while (pos < input.size()) {
+    uint64_t tag = 0;
+    if (!readVarint(input, pos, tag)) {
+      return false;
+    }
+
+    auto fieldNumber = static_cast<int>(tag >> 3);
+    uint64_t length = 0;
+
+    switch (tag & 7) {
+      case 0: // varint
+        if (!readVarint(input, pos, length)) {
+          return false;
+        }
+        length = 0;
+        break;
+      case 1: // 64-bit
+        length = 8;
+        break;
+      case 2: // length-delimited
+        if (!readVarint(input, pos, length)) {
+          return false;
+        }
+        break;
+      case 5: // 32-bit
+        length = 4;
+        break;
+      default:
+        return false;
+    }
+
+    if (length > input.size() - pos) {
+      return false;
+    }
+    pos += static_cast<size_t>(length);
+
+    if (fieldNumber == ::nakama::realtime::Envelope::kCidFieldNumber) {
+      result.hasCid = length > 0;
+    } else if (result.messageType == 0) {
+      result.messageType = fieldNumber;
+    }
+  }
+
+  return true;
+}
+
 } // namespace Nakama
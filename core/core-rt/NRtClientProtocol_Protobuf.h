@@ -24,6 +24,7 @@ class NRtClientProtocol_Protobuf : public NRtClientProtocolInterface {
 public:
   bool serialize(const google::protobuf::Message& message, NBytes& output) override;
   bool parse(const NBytes& input, google::protobuf::Message& message) override;
+  bool peekEnvelope(const NBytes& input, RtEnvelopePeek& result) override;
 };
 
 } // namespace Nakama
@@ -0,0 +1,233 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PayloadCodec.h"
+
+#ifdef WITH_ZSTD
+#include <zdict.h>
+#include <zstd.h>
+#endif
+
+namespace Nakama {
+
+#ifdef WITH_ZSTD
+
+struct PayloadCodec::Dictionary {
+  NBytes content;
+  unsigned id = 0;
+  ZSTD_DDict* ddict = nullptr;
+  // created for the current level on first use, guarded by _compressMutex
+  ZSTD_CDict* cdict = nullptr;
+  int cdictLevel = 0;
+
+  ~Dictionary() {
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeDDict(ddict);
+  }
+};
+
+PayloadCodec::PayloadCodec() : _cctx(ZSTD_createCCtx()), _dctx(ZSTD_createDCtx()) {}
+
+PayloadCodec::~PayloadCodec() {
+  ZSTD_freeCCtx(_cctx);
+  ZSTD_freeDCtx(_dctx);
+}
+
+bool PayloadCodec::configure(const NPayloadCodecConfig& config) {
+  _minSize = config.minSize;
+  _level = config.level;
+  _enabled = config.enabled;
+  return true;
+}
+
+bool PayloadCodec::setDictionary(const std::string& streamId, const NBytes& dictionary) {
+  std::lock_guard<std::mutex> lock(_dictionariesMutex);
+
+  if (dictionary.empty()) {
+    _byStream.erase(streamId);
+    return true;
+  }
+
+  // raw content dictionaries have no id, a receiver couldn't tell which one to use
+  unsigned id = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+  if (id == 0) {
+    return false;
+  }
+
+  std::shared_ptr<Dictionary>& known = _byId[id];
+  if (!known) {
+    known = std::make_shared<Dictionary>();
+    known->content = dictionary;
+    known->id = id;
+    known->ddict = ZSTD_createDDict(dictionary.data(), dictionary.size());
+  }
+
+  _byStream[streamId] = known;
+  return true;
+}
+
+bool PayloadCodec::encode(const std::string& streamId, const NBytes& data, NBytes& out) {
+  if (!_enabled) {
+    return false;
+  }
+
+  if (data.size() < _minSize) {
+    ++_skipped;
+    return false;
+  }
+
+  std::shared_ptr<Dictionary> dictionary = findDictionary(streamId);
+  int level = _level;
+  size_t size;
+
+  out.resize(ZSTD_compressBound(data.size()));
+  {
+    std::lock_guard<std::mutex> lock(_compressMutex);
+
+    if (dictionary) {
+      if (!dictionary->cdict || dictionary->cdictLevel != level) {
+        ZSTD_freeCDict(dictionary->cdict);
+        dictionary->cdict = ZSTD_createCDict(dictionary->content.data(), dictionary->content.size(), level);
+        dictionary->cdictLevel = level;
+      }
+      size = ZSTD_compress_usingCDict(_cctx, &out[0], out.size(), data.data(), data.size(), dictionary->cdict);
+    } else {
+      size = ZSTD_compressCCtx(_cctx, &out[0], out.size(), data.data(), data.size(), level);
+    }
+  }
+
+  if (ZSTD_isError(size) || size >= data.size()) {
+    ++_skipped;
+    return false;
+  }
+
+  out.resize(size);
+  ++_compressed;
+  _bytesIn += data.size();
+  _bytesOut += size;
+  return true;
+}
+
+bool PayloadCodec::decode(const NBytes& data, NBytes& out) {
+  unsigned long long contentSize = ZSTD_getFrameContentSize(data.data(), data.size());
+  if (contentSize == ZSTD_CONTENTSIZE_UNKNOWN || contentSize == ZSTD_CONTENTSIZE_ERROR ||
+      contentSize > kMaxPayloadSize) {
+    ++_decompressErrors;
+    return false;
+  }
+
+  std::shared_ptr<Dictionary> dictionary;
+  unsigned id = ZSTD_getDictID_fromFrame(data.data(), data.size());
+  if (id != 0) {
+    dictionary = findDictionary(id);
+    if (!dictionary) {
+      ++_decompressErrors;
+      return false;
+    }
+  }
+
+  out.resize(static_cast<size_t>(contentSize));
+  size_t size;
+  {
+    std::lock_guard<std::mutex> lock(_decompressMutex);
+    void* dst = out.empty() ? nullptr : &out[0];
+
+    if (dictionary) {
+      size = ZSTD_decompress_usingDDict(_dctx, dst, out.size(), data.data(), data.size(), dictionary->ddict);
+    } else {
+      size = ZSTD_decompressDCtx(_dctx, dst, out.size(), data.data(), data.size());
+    }
+  }
+
+  if (ZSTD_isError(size) || size != out.size()) {
+    ++_decompressErrors;
+    return false;
+  }
+
+  ++_decompressed;
+  return true;
+}
+
+std::shared_ptr<PayloadCodec::Dictionary> PayloadCodec::findDictionary(const std::string& streamId) const {
+  std::lock_guard<std::mutex> lock(_dictionariesMutex);
+  auto it = _byStream.find(streamId);
+  return it != _byStream.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<PayloadCodec::Dictionary> PayloadCodec::findDictionary(unsigned id) const {
+  std::lock_guard<std::mutex> lock(_dictionariesMutex);
+  auto it = _byId.find(id);
+  return it != _byId.end() ? it->second : nullptr;
+}
+
+NBytes trainPayloadDictionary(const std::vector<NBytes>& samples, size_t maxSize) {
+  NBytes buffer;
+  std::vector<size_t> sizes;
+
+  sizes.reserve(samples.size());
+  for (const NBytes& sample : samples) {
+    buffer += sample;
+    sizes.push_back(sample.size());
+  }
+
+  NBytes dictionary(maxSize, '\0');
+  size_t size = ZDICT_trainFromBuffer(
+      &dictionary[0],
+      dictionary.size(),
+      buffer.data(),
+      sizes.data(),
+      static_cast<unsigned>(sizes.size()));
+
+  if (ZDICT_isError(size)) {
+    return NBytes();
+  }
+
+  dictionary.resize(size);
+  return dictionary;
+}
+
+#else
+
+PayloadCodec::PayloadCodec() = default;
+PayloadCodec::~PayloadCodec() = default;
+
+bool PayloadCodec::configure(const NPayloadCodecConfig& config) { return !config.enabled; }
+
+bool PayloadCodec::setDictionary(const std::string&, const NBytes& dictionary) { return dictionary.empty(); }
+
+bool PayloadCodec::encode(const std::string&, const NBytes&, NBytes&) { return false; }
+
+bool PayloadCodec::decode(const NBytes&, NBytes&) {
+  ++_decompressErrors;
+  return false;
+}
+
+NBytes trainPayloadDictionary(const std::vector<NBytes>&, size_t) { return NBytes(); }
+
+#endif
+
+NPayloadCodecStats PayloadCodec::getStats() const {
+  NPayloadCodecStats stats;
+  stats.compressed = _compressed;
+  stats.skipped = _skipped;
+  stats.bytesIn = _bytesIn;
+  stats.bytesOut = _bytesOut;
+  stats.decompressed = _decompressed;
+  stats.decompressErrors = _decompressErrors;
+  return stats;
+}
+
+} // namespace Nakama
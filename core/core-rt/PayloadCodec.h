@@ -0,0 +1,97 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "nakama-cpp/realtime/NPayloadCodec.h"
+
+#ifdef WITH_ZSTD
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+#endif
+
+namespace Nakama {
+
+/**
+ * zstd compression of match and party data payloads. Thread safe.
+ *
+ * A compressed payload is a plain zstd frame, which records the id of the dictionary it was compressed with,
+ * so the receiver needs no other information than the op code flag. Compression and decompression have
+ * a context each and may run concurrently. Without WITH_ZSTD nothing is compressed and decoding fails.
+ */
+class PayloadCodec {
+public:
+  // Decompressed payloads larger than this are rejected.
+  static constexpr size_t kMaxPayloadSize = 16 * 1024 * 1024;
+
+  PayloadCodec();
+  ~PayloadCodec();
+
+  PayloadCodec(const PayloadCodec&) = delete;
+  PayloadCodec& operator=(const PayloadCodec&) = delete;
+
+  // Returns false if the codec isn't available.
+  bool configure(const NPayloadCodecConfig& config);
+
+  // Use a dictionary for payloads of the stream and accept payloads compressed with it.
+  // An empty dictionary drops the stream's one. Returns false if it isn't a trained zstd dictionary.
+  bool setDictionary(const std::string& streamId, const NBytes& dictionary);
+
+  // Compresses a payload of the stream into `out`. Returns false if it should be sent as it is.
+  bool encode(const std::string& streamId, const NBytes& data, NBytes& out);
+
+  // Decompresses a payload sent with `NPayloadCompressedOpCodeFlag`.
+  bool decode(const NBytes& data, NBytes& out);
+
+  NPayloadCodecStats getStats() const;
+
+private:
+#ifdef WITH_ZSTD
+  struct Dictionary;
+
+  std::shared_ptr<Dictionary> findDictionary(const std::string& streamId) const;
+  std::shared_ptr<Dictionary> findDictionary(unsigned id) const;
+
+  mutable std::mutex _dictionariesMutex;
+  std::unordered_map<std::string, std::shared_ptr<Dictionary>> _byStream;
+  // all dictionaries seen, received payloads may refer to one which is no longer used for sending
+  std::unordered_map<unsigned, std::shared_ptr<Dictionary>> _byId;
+
+  std::mutex _compressMutex;
+  ZSTD_CCtx_s* _cctx = nullptr;
+  std::mutex _decompressMutex;
+  ZSTD_DCtx_s* _dctx = nullptr;
+#endif
+
+  std::atomic<bool> _enabled = false;
+  std::atomic<size_t> _minSize = 0;
+  std::atomic<int> _level = 1;
+
+  std::atomic<uint64_t> _compressed = 0;
+  std::atomic<uint64_t> _skipped = 0;
+  std::atomic<uint64_t> _bytesIn = 0;
+  std::atomic<uint64_t> _bytesOut = 0;
+  std::atomic<uint64_t> _decompressed = 0;
+  std::atomic<uint64_t> _decompressErrors = 0;
+};
+
+} // namespace Nakama
@@ -0,0 +1,511 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PresenceStore.h"
+
+#include <iterator>
+#include <unordered_set>
+
+namespace Nakama {
+
+PresenceStore::StringId PresenceStore::StringPool::acquire(const std::string& str) {
+  auto it = _index.find(str);
+  if (it != _index.end()) {
+    ++_entries[it->second].refs;
+    return it->second;
+  }
+
+  StringId id;
+  if (!_free.empty()) {
+    id = _free.back();
+    _free.pop_back();
+  } else {
+    id = static_cast<StringId>(_entries.size());
+    _entries.emplace_back();
+  }
+
+  Entry& entry = _entries[id];
+  entry.str = str;
+  entry.refs = 1;
+  _index.emplace(entry.str, id);
+  _bytes += str.size();
+  return id;
+}
+
+void PresenceStore::StringPool::release(StringId id) {
+  Entry& entry = _entries[id];
+  if (--entry.refs > 0) {
+    return;
+  }
+
+  _index.erase(entry.str);
+  _bytes -= entry.str.size();
+  entry.str.clear();
+  entry.str.shrink_to_fit();
+  _free.push_back(id);
+}
+
+bool PresenceStore::StringPool::find(const std::string& str, StringId& id) const {
+  auto it = _index.find(str);
+  if (it == _index.end()) {
+    return false;
+  }
+
+  id = it->second;
+  return true;
+}
+
+void PresenceStore::StringPool::replace(StringId& id, const std::string& str) {
+  if (get(id) != str) {
+    StringId newId = acquire(str);
+    release(id);
+    id = newId;
+  }
+}
+
+void PresenceStore::setEnabled(bool enabled) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _enabled = enabled;
+
+  if (!enabled) {
+    for (Streams& streams : _streams) {
+      streams.clear();
+    }
+    _strings = StringPool();
+    _presenceCount = 0;
+  }
+}
+
+void PresenceStore::apply(const NMatchPresenceEvent& event) {
+  applyEvent(NPresenceStreamType::Match, event.matchId, event.joins, event.leaves);
+}
+
+void PresenceStore::apply(const NChannelPresenceEvent& event) {
+  applyEvent(NPresenceStreamType::Channel, event.channelId, event.joins, event.leaves);
+}
+
+void PresenceStore::apply(const NPartyPresenceEvent& event) {
+  applyEvent(NPresenceStreamType::Party, event.partyId, event.joins, event.leaves);
+}
+
+void PresenceStore::reset(const NMatch& match) {
+  resetStream(NPresenceStreamType::Match, match.matchId, match.presences, match.self);
+}
+
+void PresenceStore::reset(const NChannel& channel) {
+  resetStream(NPresenceStreamType::Channel, channel.id, channel.presences, channel.self);
+}
+
+void PresenceStore::reset(const NParty& party) {
+  resetStream(NPresenceStreamType::Party, party.id, party.presences, party.self);
+}
+
+void PresenceStore::applyEvent(
+    NPresenceStreamType type,
+    const std::string& streamId,
+    const std::vector<NUserPresence>& joins,
+    const std::vector<NUserPresence>& leaves) {
+  if (!_enabled || streamId.empty()) {
+    return;
+  }
+
+  std::vector<Notification> notifications;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_eventsApplied;
+
+    auto inserted = streams(type).try_emplace(streamId);
+    Stream& stream = inserted.first->second;
+    std::vector<NPresenceListener> listeners = listenersOf(type, streamId);
+    NPresenceDiff diff;
+    bool changed = false;
+
+    // joins first: a session which joined and left within one event is gone
+    for (const NUserPresence& presence : joins) {
+      if (join(stream, presence)) {
+        changed = true;
+        if (!listeners.empty()) {
+          diff.joins.push_back(presence);
+        }
+      }
+    }
+
+    for (const NUserPresence& presence : leaves) {
+      NUserPresence left;
+      if (leave(stream, presence.getSessionId(), listeners.empty() ? nullptr : &left)) {
+        changed = true;
+        if (!listeners.empty()) {
+          diff.leaves.push_back(std::move(left));
+        }
+      }
+    }
+
+    if (!changed) {
+      if (inserted.second) {
+        // leaves of a stream we don't track
+        streams(type).erase(inserted.first);
+      }
+      return;
+    }
+
+    stream.version = ++_version;
+    if (!listeners.empty()) {
+      diff.type = type;
+      diff.streamId = streamId;
+      diff.version = stream.version;
+      notifications.push_back({std::move(diff), std::move(listeners)});
+    }
+  }
+
+  notify(notifications);
+}
+
+void PresenceStore::resetStream(
+    NPresenceStreamType type,
+    const std::string& streamId,
+    const std::vector<NUserPresence>& presences,
+    const NUserPresence& self) {
+  if (!_enabled || streamId.empty()) {
+    return;
+  }
+
+  std::vector<Notification> notifications;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_eventsApplied;
+
+    Stream& stream = streams(type)[streamId];
+    std::vector<NPresenceListener> listeners = listenersOf(type, streamId);
+    NPresenceDiff diff;
+    bool changed = false;
+
+    std::unordered_set<std::string_view> current;
+    current.reserve(presences.size() + 1);
+    for (const NUserPresence& presence : presences) {
+      current.insert(presence.getSessionId());
+    }
+    if (!self.getSessionId().empty()) {
+      current.insert(self.getSessionId());
+    }
+
+    for (auto it = stream.presences.begin(); it != stream.presences.end();) {
+      if (current.count(_strings.get(it->first)) > 0) {
+        ++it;
+        continue;
+      }
+
+      NUserPresence left;
+      auto next = std::next(it);
+      erase(stream, it, listeners.empty() ? nullptr : &left);
+      it = next;
+      changed = true;
+      if (!listeners.empty()) {
+        diff.leaves.push_back(std::move(left));
+      }
+    }
+
+    auto add = [&](const NUserPresence& presence) {
+      if (!presence.getSessionId().empty() && join(stream, presence)) {
+        changed = true;
+        if (!listeners.empty()) {
+          diff.joins.push_back(presence);
+        }
+      }
+    };
+
+    for (const NUserPresence& presence : presences) {
+      add(presence);
+    }
+    add(self);
+
+    if (!changed) {
+      return;
+    }
+
+    stream.version = ++_version;
+    if (!listeners.empty()) {
+      diff.type = type;
+      diff.streamId = streamId;
+      diff.version = stream.version;
+      notifications.push_back({std::move(diff), std::move(listeners)});
+    }
+  }
+
+  notify(notifications);
+}
+
+void PresenceStore::remove(NPresenceStreamType type, const std::string& streamId) {
+  if (!_enabled) {
+    return;
+  }
+
+  std::vector<Notification> notifications;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = streams(type).find(streamId);
+    if (it == streams(type).end()) {
+      return;
+    }
+
+    ++_eventsApplied;
+    removeStream(type, it, notifications);
+  }
+
+  notify(notifications);
+}
+
+void PresenceStore::clear() {
+  if (!_enabled) {
+    return;
+  }
+
+  std::vector<Notification> notifications;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (size_t i = 0; i < std::size(_streams); ++i) {
+      NPresenceStreamType type = static_cast<NPresenceStreamType>(i);
+      while (!_streams[i].empty()) {
+        removeStream(type, _streams[i].begin(), notifications);
+      }
+    }
+  }
+
+  notify(notifications);
+}
+
+std::vector<NUserPresence> PresenceStore::getPresences(NPresenceStreamType type, const std::string& streamId) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::vector<NUserPresence> presences;
+
+  if (const Stream* stream = findStream(type, streamId)) {
+    presences.reserve(stream->presences.size());
+    for (const auto& p : stream->presences) {
+      presences.push_back(expand(p.first, p.second));
+    }
+  }
+
+  return presences;
+}
+
+std::optional<NUserPresence> PresenceStore::findPresence(
+    NPresenceStreamType type,
+    const std::string& streamId,
+    const std::string& sessionId) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const Stream* stream = findStream(type, streamId);
+  StringId id;
+
+  if (!stream || !_strings.find(sessionId, id)) {
+    return std::nullopt;
+  }
+
+  auto it = stream->presences.find(id);
+  if (it == stream->presences.end()) {
+    return std::nullopt;
+  }
+
+  return expand(it->first, it->second);
+}
+
+bool PresenceStore::hasUser(NPresenceStreamType type, const std::string& streamId, const std::string& userId) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const Stream* stream = findStream(type, streamId);
+  StringId id;
+
+  return stream && _strings.find(userId, id) && stream->sessionsPerUser.count(id) > 0;
+}
+
+size_t PresenceStore::getPresenceCount(NPresenceStreamType type, const std::string& streamId) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const Stream* stream = findStream(type, streamId);
+  return stream ? stream->presences.size() : 0;
+}
+
+uint64_t PresenceStore::getVersion(NPresenceStreamType type, const std::string& streamId) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const Stream* stream = findStream(type, streamId);
+  return stream ? stream->version : 0;
+}
+
+std::vector<std::string> PresenceStore::getStreamIds(NPresenceStreamType type) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  const Streams& typeStreams = _streams[static_cast<size_t>(type)];
+  std::vector<std::string> ids;
+
+  ids.reserve(typeStreams.size());
+  for (const auto& p : typeStreams) {
+    ids.push_back(p.first);
+  }
+
+  return ids;
+}
+
+uint64_t PresenceStore::subscribe(NPresenceStreamType type, const std::string& streamId, NPresenceListener listener) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  uint64_t id = _nextSubscriptionId++;
+  _subscriptions.emplace(id, Subscription{type, streamId, std::move(listener)});
+  return id;
+}
+
+void PresenceStore::unsubscribe(uint64_t subscriptionId) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _subscriptions.erase(subscriptionId);
+}
+
+NPresenceStoreStats PresenceStore::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  NPresenceStoreStats stats;
+
+  for (const Streams& typeStreams : _streams) {
+    stats.streams += typeStreams.size();
+  }
+  stats.presences = _presenceCount;
+  stats.internedStrings = _strings.size();
+  stats.internedBytes = _strings.bytes();
+  stats.eventsApplied = _eventsApplied;
+  return stats;
+}
+
+const PresenceStore::Stream* PresenceStore::findStream(NPresenceStreamType type, const std::string& streamId) const {
+  const Streams& typeStreams = _streams[static_cast<size_t>(type)];
+  auto it = typeStreams.find(streamId);
+  return it != typeStreams.end() ? &it->second : nullptr;
+}
+
+bool PresenceStore::join(Stream& stream, const NUserPresence& presence) {
+  StringId sessionId;
+  if (_strings.find(presence.getSessionId(), sessionId)) {
+    auto it = stream.presences.find(sessionId);
+    if (it != stream.presences.end()) {
+      // same session again, e.g. with a new status
+      _strings.replace(it->second.username, presence.getUsername());
+      _strings.replace(it->second.status, presence.status);
+      it->second.persistence = presence.persistence;
+      return false;
+    }
+  }
+
+  sessionId = _strings.acquire(presence.getSessionId());
+  Presence compact;
+  compact.userId = _strings.acquire(presence.getUserId());
+  compact.username = _strings.acquire(presence.getUsername());
+  compact.status = _strings.acquire(presence.status);
+  compact.persistence = presence.persistence;
+
+  stream.presences.emplace(sessionId, compact);
+  ++stream.sessionsPerUser[compact.userId];
+  ++_presenceCount;
+  return true;
+}
+
+bool PresenceStore::leave(Stream& stream, const std::string& sessionId, NUserPresence* left) {
+  StringId id;
+  if (!_strings.find(sessionId, id)) {
+    return false;
+  }
+
+  auto it = stream.presences.find(id);
+  if (it == stream.presences.end()) {
+    return false;
+  }
+
+  erase(stream, it, left);
+  return true;
+}
+
+void PresenceStore::erase(Stream& stream, std::unordered_map<StringId, Presence>::iterator it, NUserPresence* left) {
+  if (left) {
+    *left = expand(it->first, it->second);
+  }
+
+  const Presence& presence = it->second;
+  auto user = stream.sessionsPerUser.find(presence.userId);
+  if (--user->second == 0) {
+    stream.sessionsPerUser.erase(user);
+  }
+
+  _strings.release(it->first);
+  _strings.release(presence.userId);
+  _strings.release(presence.username);
+  _strings.release(presence.status);
+  stream.presences.erase(it);
+  --_presenceCount;
+}
+
+void PresenceStore::removeStream(
+    NPresenceStreamType type,
+    Streams::iterator it,
+    std::vector<Notification>& notifications) {
+  Stream& stream = it->second;
+  std::vector<NPresenceListener> listeners = listenersOf(type, it->first);
+  NPresenceDiff diff;
+
+  if (!listeners.empty()) {
+    diff.leaves.reserve(stream.presences.size());
+  }
+
+  while (!stream.presences.empty()) {
+    NUserPresence left;
+    erase(stream, stream.presences.begin(), listeners.empty() ? nullptr : &left);
+    if (!listeners.empty()) {
+      diff.leaves.push_back(std::move(left));
+    }
+  }
+
+  if (!listeners.empty()) {
+    diff.type = type;
+    diff.streamId = it->first;
+    diff.version = ++_version;
+    notifications.push_back({std::move(diff), std::move(listeners)});
+  }
+
+  streams(type).erase(it);
+}
+
+NUserPresence PresenceStore::expand(StringId sessionId, const Presence& presence) const {
+  NUserPresence result;
+  result.userId = _strings.get(presence.userId);
+  result.sessionId = _strings.get(sessionId);
+  result.username = _strings.get(presence.username);
+  result.persistence = presence.persistence;
+  result.status = _strings.get(presence.status);
+  return result;
+}
+
+std::vector<NPresenceListener> PresenceStore::listenersOf(NPresenceStreamType type, const std::string& streamId) const {
+  std::vector<NPresenceListener> listeners;
+
+  for (const auto& p : _subscriptions) {
+    const Subscription& subscription = p.second;
+    if (subscription.type == type && (subscription.streamId.empty() || subscription.streamId == streamId)) {
+      listeners.push_back(subscription.listener);
+    }
+  }
+
+  return listeners;
+}
+
+void PresenceStore::notify(std::vector<Notification>& notifications) {
+  for (const Notification& notification : notifications) {
+    for (const NPresenceListener& listener : notification.listeners) {
+      if (listener) {
+        listener(notification.diff);
+      }
+    }
+  }
+}
+
+} // namespace Nakama
@@ -0,0 +1,171 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "nakama-cpp/data/NMatch.h"
+#include "nakama-cpp/realtime/NPresenceStoreInterface.h"
+#include "nakama-cpp/realtime/rtdata/NChannel.h"
+#include "nakama-cpp/realtime/rtdata/NChannelPresenceEvent.h"
+#include "nakama-cpp/realtime/rtdata/NMatchPresenceEvent.h"
+#include "nakama-cpp/realtime/rtdata/NParty.h"
+#include "nakama-cpp/realtime/rtdata/NPartyPresenceEvent.h"
+
+namespace Nakama {
+
+/**
+ * Presence sets fed by `NRtClient` from join results and presence events. Thread safe.
+ *
+ * Strings are interned into a reference counted pool, a presence is four string ids and a flag.
+ * Streams map session ids to presences and count sessions per user, so every operation on a single
+ * presence is a few hash lookups. Diffs are only built when somebody is subscribed to the stream.
+ */
+class PresenceStore : public NPresenceStoreInterface {
+public:
+  // Disabling drops all streams without notifying subscribers.
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return _enabled; }
+
+  void apply(const NMatchPresenceEvent& event);
+  void apply(const NChannelPresenceEvent& event);
+  void apply(const NPartyPresenceEvent& event);
+
+  // Replace presences of the stream with the ones of a join result.
+  void reset(const NMatch& match);
+  void reset(const NChannel& channel);
+  void reset(const NParty& party);
+
+  void remove(NPresenceStreamType type, const std::string& streamId);
+  void clear();
+
+  std::vector<NUserPresence> getPresences(NPresenceStreamType type, const std::string& streamId) const override;
+  std::optional<NUserPresence> findPresence(
+      NPresenceStreamType type,
+      const std::string& streamId,
+      const std::string& sessionId) const override;
+  bool hasUser(NPresenceStreamType type, const std::string& streamId, const std::string& userId) const override;
+  size_t getPresenceCount(NPresenceStreamType type, const std::string& streamId) const override;
+  uint64_t getVersion(NPresenceStreamType type, const std::string& streamId) const override;
+  std::vector<std::string> getStreamIds(NPresenceStreamType type) const override;
+
+  uint64_t subscribe(NPresenceStreamType type, const std::string& streamId, NPresenceListener listener) override;
+  void unsubscribe(uint64_t subscriptionId) override;
+
+  NPresenceStoreStats getStats() const override;
+
+private:
+  using StringId = uint32_t;
+
+  // Reference counted strings. Ids of released strings are reused.
+  class StringPool {
+  public:
+    StringId acquire(const std::string& str);
+    void release(StringId id);
+    // Looks a string up without adding it.
+    bool find(const std::string& str, StringId& id) const;
+    const std::string& get(StringId id) const { return _entries[id].str; }
+    // Points `id` to `str`, releasing the string it pointed to.
+    void replace(StringId& id, const std::string& str);
+
+    size_t size() const { return _index.size(); }
+    size_t bytes() const { return _bytes; }
+
+  private:
+    struct Entry {
+      std::string str;
+      uint32_t refs = 0;
+    };
+
+    // deque doesn't move entries, the index keys point into them
+    std::deque<Entry> _entries;
+    std::vector<StringId> _free;
+    std::unordered_map<std::string_view, StringId> _index;
+    size_t _bytes = 0;
+  };
+
+  struct Presence {
+    StringId userId;
+    StringId username;
+    StringId status;
+    bool persistence;
+  };
+
+  struct Stream {
+    std::unordered_map<StringId, Presence> presences; // by session id
+    std::unordered_map<StringId, uint32_t> sessionsPerUser;
+    uint64_t version = 0;
+  };
+
+  struct Subscription {
+    NPresenceStreamType type;
+    std::string streamId;
+    NPresenceListener listener;
+  };
+
+  using Streams = std::unordered_map<std::string, Stream>;
+
+  struct Notification {
+    NPresenceDiff diff;
+    std::vector<NPresenceListener> listeners;
+  };
+
+  void applyEvent(
+      NPresenceStreamType type,
+      const std::string& streamId,
+      const std::vector<NUserPresence>& joins,
+      const std::vector<NUserPresence>& leaves);
+  void resetStream(
+      NPresenceStreamType type,
+      const std::string& streamId,
+      const std::vector<NUserPresence>& presences,
+      const NUserPresence& self);
+
+  // The following are called with the mutex held.
+  Streams& streams(NPresenceStreamType type) { return _streams[static_cast<size_t>(type)]; }
+  const Stream* findStream(NPresenceStreamType type, const std::string& streamId) const;
+  // Adds the presence if its session isn't in the stream, otherwise updates it.
+  bool join(Stream& stream, const NUserPresence& presence);
+  // Removes the session's presence, copying it to `left` if that isn't null.
+  bool leave(Stream& stream, const std::string& sessionId, NUserPresence* left);
+  void erase(Stream& stream, std::unordered_map<StringId, Presence>::iterator it, NUserPresence* left);
+  void removeStream(NPresenceStreamType type, Streams::iterator it, std::vector<Notification>& notifications);
+  NUserPresence expand(StringId sessionId, const Presence& presence) const;
+  std::vector<NPresenceListener> listenersOf(NPresenceStreamType type, const std::string& streamId) const;
+
+  static void notify(std::vector<Notification>& notifications);
+
+  std::atomic<bool> _enabled = false;
+  mutable std::mutex _mutex;
+  StringPool _strings;
+  Streams _streams[3];
+  size_t _presenceCount = 0;
+  uint64_t _version = 0; // shared by all streams, so a stream joined again doesn't repeat versions
+  uint64_t _eventsApplied = 0;
+  std::map<uint64_t, Subscription> _subscriptions;
+  uint64_t _nextSubscriptionId = 1;
+};
+
+} // namespace Nakama
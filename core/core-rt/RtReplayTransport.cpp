@@ -0,0 +1,223 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RtReplayTransport.h"
+
+#include <nakama-cpp/log/NLogger.h>
+
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Nakama {
+
+using RtTrafficLog::RecordHeader;
+using RtTrafficLog::RecordKind;
+
+RtReplayTransport::RtReplayTransport(NRtReplaySpeed speed) : _speed(speed) {}
+
+RtReplayTransport::~RtReplayTransport() {
+#ifndef _WIN32
+  if (_mapping) {
+    munmap(_mapping, _size);
+  }
+#endif
+}
+
+bool RtReplayTransport::open(const std::string& path) {
+#ifdef _WIN32
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    NLOG(NLogLevel::Error, "unable to open traffic log %s", path.c_str());
+    return false;
+  }
+  _buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+  _data = _buffer.data();
+  _size = _buffer.size();
+#else
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  struct stat st {};
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    NLOG(NLogLevel::Error, "unable to open traffic log %s: %s", path.c_str(), std::strerror(errno));
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    return false;
+  }
+
+  _size = static_cast<size_t>(st.st_size);
+  if (_size > 0) {
+    void* mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      NLOG(NLogLevel::Error, "unable to map traffic log %s: %s", path.c_str(), std::strerror(errno));
+      ::close(fd);
+      return false;
+    }
+    // records are read front to back, once
+    madvise(mapping, _size, MADV_SEQUENTIAL);
+    _mapping = mapping;
+    _data = static_cast<const uint8_t*>(mapping);
+  }
+  ::close(fd);
+#endif
+
+  _offset = RtTrafficLog::readFileHeader(_data, _size);
+  if (_offset == 0) {
+    NLOG(NLogLevel::Error, "%s is not a traffic log", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+bool RtReplayTransport::readRecord(size_t offset, RecordHeader& header) const {
+  return offset < _size && RtTrafficLog::readRecordHeader(_data + offset, _size - offset, header);
+}
+
+void RtReplayTransport::connect(const std::string& /*url*/, NRtTransportType type) {
+  // connected by the next tick, nothing may fire from here
+  _type = type;
+  _state = State::Connecting;
+  _connected = false;
+}
+
+void RtReplayTransport::disconnect() {
+  _state = State::Disconnected;
+  _connected = false;
+}
+
+bool RtReplayTransport::send(const NBytes& /*data*/) { return _state == State::Connected; }
+
+void RtReplayTransport::tick() {
+  if (_state == State::Connecting) {
+    start();
+  }
+  if (_state == State::Connected) {
+    deliver();
+  }
+}
+
+// Moves to the next recorded connection and connects.
+void RtReplayTransport::start() {
+  RecordHeader header;
+  while (readRecord(_offset, header) && header.kind != RecordKind::Connect && header.kind != RecordKind::Received) {
+    _offset = next(_offset, header);
+  }
+
+  if (!readRecord(_offset, header)) {
+    _state = State::Disconnected;
+    fireOnError("Traffic log has no more connections");
+    return;
+  }
+  if (header.transportType != static_cast<uint8_t>(_type)) {
+    _state = State::Disconnected;
+    fireOnError("Traffic log was recorded with the other transport type");
+    return;
+  }
+
+  // a log without connects, e.g. cut out of a longer one, starts with its first message
+  _sessionStartNs = header.timeNs;
+  if (header.kind == RecordKind::Connect) {
+    _offset = next(_offset, header);
+  }
+  _sessionOver = false;
+  _state = State::Connected;
+  _replayStart = std::chrono::steady_clock::now();
+  fireOnConnected();
+}
+
+void RtReplayTransport::deliver() {
+  if (_sessionOver) {
+    return;
+  }
+
+  const uint64_t elapsedNs = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _replayStart).count());
+
+  // callbacks may disconnect, which ends the replay of this connection
+  RecordHeader header;
+  while (_state == State::Connected && readRecord(_offset, header)) {
+    if (header.kind == RecordKind::Connect) {
+      _sessionOver = true; // the recording ended without a close, e.g. the process was killed
+      return;
+    }
+    if (_speed == NRtReplaySpeed::Original && header.timeNs > _sessionStartNs &&
+        header.timeNs - _sessionStartNs > elapsedNs) {
+      return;
+    }
+
+    const size_t offset = _offset;
+    _offset = next(offset, header);
+
+    switch (header.kind) {
+      case RecordKind::Received:
+        _replayedMessages++;
+        fireOnMessage(NBytes(reinterpret_cast<const char*>(payload(offset)), header.size));
+        break;
+      case RecordKind::Disconnect: {
+        NRtClientDisconnectInfo info;
+        if (header.size >= 3) {
+          info.code = RtTrafficLog::getU16(payload(offset));
+          info.remote = payload(offset)[2] != 0;
+          info.reason.assign(reinterpret_cast<const char*>(payload(offset)) + 3, header.size - 3);
+        }
+        _state = State::Disconnected;
+        fireOnDisconnected(info);
+        return;
+      }
+      case RecordKind::Closed:
+        _sessionOver = true;
+        return;
+      default: // messages sent and errors
+        break;
+    }
+  }
+}
+
+bool RtReplayTransport::isReplayDone() const {
+  if (_state != State::Connected) {
+    return _state == State::Disconnected;
+  }
+  if (_sessionOver) {
+    return true;
+  }
+
+  RecordHeader header;
+  for (size_t offset = _offset; readRecord(offset, header); offset = next(offset, header)) {
+    if (header.kind == RecordKind::Received || header.kind == RecordKind::Disconnect) {
+      return false;
+    }
+    if (header.kind == RecordKind::Connect || header.kind == RecordKind::Closed) {
+      return true;
+    }
+  }
+  return true;
+}
+
+NRtReplayTransportPtr createReplayTransport(const std::string& path, NRtReplaySpeed speed) {
+  auto transport = std::make_shared<RtReplayTransport>(speed);
+  return transport->open(path) ? transport : nullptr;
+}
+
+} // namespace Nakama
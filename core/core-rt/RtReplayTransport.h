@@ -0,0 +1,82 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "RtTrafficLog.h"
+
+#include <nakama-cpp/realtime/NRtTrafficLog.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Nakama {
+
+/**
+ * Plays a traffic log back, see createReplayTransport. Used from the thread which ticks it only.
+ */
+class RtReplayTransport : public NRtReplayTransportInterface {
+public:
+  explicit RtReplayTransport(NRtReplaySpeed speed);
+  ~RtReplayTransport() override;
+
+  RtReplayTransport(const RtReplayTransport&) = delete;
+  RtReplayTransport& operator=(const RtReplayTransport&) = delete;
+
+  bool open(const std::string& path);
+
+  void setActivityTimeout(uint32_t /*timeoutMs*/) override {}
+  uint32_t getActivityTimeout() const override { return 0; }
+  void tick() override;
+  void connect(const std::string& url, NRtTransportType type) override;
+  bool isConnecting() const override { return _state == State::Connecting; }
+  void disconnect() override;
+  bool send(const NBytes& data) override;
+
+  bool isReplayDone() const override;
+  uint64_t getReplayedMessages() const override { return _replayedMessages; }
+
+private:
+  enum class State { Disconnected, Connecting, Connected };
+
+  void start();
+  void deliver();
+  bool readRecord(size_t offset, RtTrafficLog::RecordHeader& header) const;
+  const uint8_t* payload(size_t offset) const { return _data + offset + RtTrafficLog::kRecordHeaderSize; }
+  size_t next(size_t offset, const RtTrafficLog::RecordHeader& header) const {
+    return offset + RtTrafficLog::kRecordHeaderSize + header.size;
+  }
+
+  const NRtReplaySpeed _speed;
+
+  // the log, mapped or, where mmap isn't available, read into _buffer
+  const uint8_t* _data = nullptr;
+  size_t _size = 0;
+  std::vector<uint8_t> _buffer;
+  void* _mapping = nullptr;
+
+  size_t _offset = 0; // of the next record
+  State _state = State::Disconnected;
+  NRtTransportType _type = NRtTransportType::Binary;
+  bool _sessionOver = false; // the application closed the recorded connection here
+
+  uint64_t _sessionStartNs = 0;
+  std::chrono::steady_clock::time_point _replayStart;
+  uint64_t _replayedMessages = 0;
+};
+
+} // namespace Nakama
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Layout of the traffic log, documented with createRecordingTransport in NRtTrafficLog.h.
+namespace Nakama {
+namespace RtTrafficLog {
+
+constexpr char kMagic[8] = {'N', 'K', 'R', 'T', 'L', 'O', 'G', '1'};
+constexpr uint32_t kVersion = 1;
+constexpr size_t kFileHeaderSize = 16;
+constexpr size_t kRecordHeaderSize = 16;
+
+enum class RecordKind : uint8_t {
+  Connect = 1,
+  Disconnect = 2,
+  Received = 3,
+  Sent = 4,
+  Error = 5,
+  Closed = 6, // disconnect() of the application, the transport doesn't report those
+};
+
+struct RecordHeader {
+  uint64_t timeNs = 0;
+  uint32_t size = 0;
+  RecordKind kind = RecordKind::Received;
+  uint8_t transportType = 0;
+};
+
+inline void putU16(uint8_t* out, uint16_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+inline void putU32(uint8_t* out, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+inline void putU64(uint8_t* out, uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    out[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+inline uint16_t getU16(const uint8_t* in) { return static_cast<uint16_t>(in[0] | (in[1] << 8)); }
+
+inline uint32_t getU32(const uint8_t* in) {
+  uint32_t value = 0;
+  for (int i = 3; i >= 0; i--) {
+    value = (value << 8) | in[i];
+  }
+  return value;
+}
+
+inline uint64_t getU64(const uint8_t* in) {
+  uint64_t value = 0;
+  for (int i = 7; i >= 0; i--) {
+    value = (value << 8) | in[i];
+  }
+  return value;
+}
+
+inline void writeFileHeader(uint8_t (&out)[kFileHeaderSize]) {
+  std::memcpy(out, kMagic, sizeof(kMagic));
+  putU32(out + 8, kVersion);
+  putU32(out + 12, static_cast<uint32_t>(kFileHeaderSize));
+}
+
+// Returns the size of the header, 0 if it isn't one of a log this version can read.
+inline size_t readFileHeader(const uint8_t* in, size_t size) {
+  if (size < kFileHeaderSize || std::memcmp(in, kMagic, sizeof(kMagic)) != 0 || getU32(in + 8) != kVersion) {
+    return 0;
+  }
+  uint32_t headerSize = getU32(in + 12);
+  return headerSize >= kFileHeaderSize && headerSize <= size ? headerSize : 0;
+}
+
+inline void writeRecordHeader(uint8_t (&out)[kRecordHeaderSize], const RecordHeader& header) {
+  putU64(out, header.timeNs);
+  putU32(out + 8, header.size);
+  out[12] = static_cast<uint8_t>(header.kind);
+  out[13] = header.transportType;
+  putU16(out + 14, 0);
+}
+
+// Returns false at the end of the log, or at a record cut short, e.g. by a crash of the recording process.
+inline bool readRecordHeader(const uint8_t* in, size_t available, RecordHeader& header) {
+  if (available < kRecordHeaderSize) {
+    return false;
+  }
+  header.timeNs = getU64(in);
+  header.size = getU32(in + 8);
+  header.kind = static_cast<RecordKind>(in[12]);
+  header.transportType = in[13];
+  return header.size <= available - kRecordHeaderSize;
+}
+
+} // namespace RtTrafficLog
+} // namespace Nakama
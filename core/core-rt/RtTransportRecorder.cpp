@@ -0,0 +1,170 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RtTransportRecorder.h"
+
+#include <nakama-cpp/log/NLogger.h>
+#include <nakama-cpp/realtime/NRtTrafficLog.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace Nakama {
+
+using RtTrafficLog::RecordKind;
+
+// Messages are written through a buffer this large, tick flushes it.
+static constexpr size_t kWriteBufferSize = 64 * 1024;
+
+RtTransportRecorder::RtTransportRecorder(NRtTransportPtr transport)
+    : _transport(std::move(transport)), _systemStart(std::chrono::system_clock::now()),
+      _steadyStart(std::chrono::steady_clock::now()) {
+  // the wrapped transport fires its callbacks in its tick, which runs in ours
+  _transport->setConnectCallback([this]() { fireOnConnected(); });
+  _transport->setDisconnectCallback([this](const NRtClientDisconnectInfo& info) {
+    recordDisconnect(RecordKind::Disconnect, info);
+    fireOnDisconnected(info);
+  });
+  _transport->setErrorCallback([this](const std::string& description) {
+    record(RecordKind::Error, description);
+    fireOnError(description);
+  });
+  _transport->setMessageCallback([this](const NBytes& data) {
+    record(RecordKind::Received, data);
+    fireOnMessage(data);
+  });
+  _transport->setWritableCallback([this]() { fireOnWritable(); });
+}
+
+RtTransportRecorder::~RtTransportRecorder() {
+  // the callbacks of the wrapped transport refer to this one
+  _transport->setConnectCallback(nullptr);
+  _transport->setDisconnectCallback(nullptr);
+  _transport->setErrorCallback(nullptr);
+  _transport->setMessageCallback(nullptr);
+  _transport->setWritableCallback(nullptr);
+
+  if (_file) {
+    std::fclose(_file);
+  }
+}
+
+bool RtTransportRecorder::open(const std::string& path) {
+  // "a+b" appends every write, whatever the position, and allows to check the header of an existing log
+  _file = std::fopen(path.c_str(), "a+b");
+  if (!_file) {
+    NLOG(NLogLevel::Error, "unable to open traffic log %s: %s", path.c_str(), std::strerror(errno));
+    return false;
+  }
+  std::setvbuf(_file, nullptr, _IOFBF, kWriteBufferSize);
+
+  uint8_t header[RtTrafficLog::kFileHeaderSize];
+  std::fseek(_file, 0, SEEK_END);
+  if (std::ftell(_file) == 0) {
+    RtTrafficLog::writeFileHeader(header);
+    std::fwrite(header, 1, sizeof(header), _file);
+    std::fflush(_file);
+    return true;
+  }
+
+  std::fseek(_file, 0, SEEK_SET);
+  if (std::fread(header, 1, sizeof(header), _file) != sizeof(header) ||
+      RtTrafficLog::readFileHeader(header, sizeof(header)) == 0) {
+    NLOG(NLogLevel::Error, "%s is not a traffic log", path.c_str());
+    std::fclose(_file);
+    _file = nullptr;
+    return false;
+  }
+  return true;
+}
+
+void RtTransportRecorder::record(RecordKind kind, const void* payload, size_t size) {
+  RtTrafficLog::RecordHeader header;
+  header.timeNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                            (_systemStart + (std::chrono::steady_clock::now() - _steadyStart))
+                                                .time_since_epoch())
+                                            .count());
+  header.size = static_cast<uint32_t>(size);
+  header.kind = kind;
+  header.transportType = static_cast<uint8_t>(_type);
+
+  uint8_t bytes[RtTrafficLog::kRecordHeaderSize];
+  RtTrafficLog::writeRecordHeader(bytes, header);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::fwrite(bytes, 1, sizeof(bytes), _file);
+  std::fwrite(payload, 1, size, _file);
+  _unflushed = true;
+}
+
+void RtTransportRecorder::recordDisconnect(RecordKind kind, const NRtClientDisconnectInfo& info) {
+  std::string payload(3, '\0');
+  RtTrafficLog::putU16(reinterpret_cast<uint8_t*>(&payload[0]), info.code);
+  payload[2] = info.remote ? 1 : 0;
+  payload += info.reason;
+  record(kind, payload);
+}
+
+void RtTransportRecorder::tick() {
+  _transport->tick();
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_unflushed) {
+    std::fflush(_file);
+    _unflushed = false;
+  }
+}
+
+void RtTransportRecorder::connect(const std::string& url, NRtTransportType type) {
+  _type = type;
+  record(RecordKind::Connect, url);
+  _transport->connect(url, type);
+}
+
+void RtTransportRecorder::disconnect() {
+  bool wasOpen = _transport->isConnected() || _transport->isConnecting();
+  _transport->disconnect();
+  if (wasOpen) {
+    recordDisconnect(RecordKind::Closed, {NRtClientDisconnectInfo::Code::NORMAL_CLOSURE, "", false});
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::fflush(_file);
+  _unflushed = false;
+}
+
+bool RtTransportRecorder::send(const NBytes& data) {
+  return trySend(data, std::nullopt, NSendPriority::Control) == NSendResult::Queued;
+}
+
+NSendResult RtTransportRecorder::trySend(
+    const NBytes& data, const std::optional<NSendDropKey>& dropKey, NSendPriority priority) {
+  NSendResult result = _transport->trySend(data, dropKey, priority);
+  if (result == NSendResult::Queued) {
+    record(RecordKind::Sent, data);
+  }
+  return result;
+}
+
+NRtTransportPtr createRecordingTransport(NRtTransportPtr transport, const std::string& path) {
+  if (!transport) {
+    return nullptr;
+  }
+  auto recorder = std::make_shared<RtTransportRecorder>(std::move(transport));
+  return recorder->open(path) ? recorder : nullptr;
+}
+
+} // namespace Nakama
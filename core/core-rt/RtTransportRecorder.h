@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "RtTrafficLog.h"
+
+#include <nakama-cpp/realtime/NRtTransportInterface.h>
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+namespace Nakama {
+
+/**
+ * Forwards everything to the wrapped transport and appends its traffic to a log, see createRecordingTransport.
+ *
+ * Messages received are recorded in tick, messages sent in the thread which sends them, so writes are serialized.
+ */
+class RtTransportRecorder : public NRtTransportInterface {
+public:
+  // Takes over the callbacks of `transport`. Call open before use.
+  explicit RtTransportRecorder(NRtTransportPtr transport);
+  ~RtTransportRecorder() override;
+
+  bool open(const std::string& path);
+
+  void setActivityTimeout(uint32_t timeoutMs) override { _transport->setActivityTimeout(timeoutMs); }
+  uint32_t getActivityTimeout() const override { return _transport->getActivityTimeout(); }
+  void tick() override;
+  void connect(const std::string& url, NRtTransportType type) override;
+  bool isConnected() const override { return _transport->isConnected(); }
+  bool isConnecting() const override { return _transport->isConnecting(); }
+  void disconnect() override;
+  bool send(const NBytes& data) override;
+  NSendResult trySend(const NBytes& data, const std::optional<NSendDropKey>& dropKey, NSendPriority priority) override;
+  bool setSendQueueConfig(const NSendQueueConfig& config) override { return _transport->setSendQueueConfig(config); }
+  NSendQueueStats getSendQueueStats() const override { return _transport->getSendQueueStats(); }
+  bool setDeflate(const NWebsocketDeflateConfig& config) override { return _transport->setDeflate(config); }
+  bool setSocketOptions(const NSocketOptions& options) override { return _transport->setSocketOptions(options); }
+
+private:
+  void record(RtTrafficLog::RecordKind kind, const void* payload, size_t size);
+  void record(RtTrafficLog::RecordKind kind, const std::string& payload) {
+    record(kind, payload.data(), payload.size());
+  }
+  void recordDisconnect(RtTrafficLog::RecordKind kind, const NRtClientDisconnectInfo& info);
+
+  NRtTransportPtr _transport;
+  NRtTransportType _type = NRtTransportType::Binary;
+
+  // timestamps are Unix time, advanced by the steady clock so they don't jump
+  std::chrono::system_clock::time_point _systemStart;
+  std::chrono::steady_clock::time_point _steadyStart;
+
+  std::mutex _mutex;
+  std::FILE* _file = nullptr;
+  bool _unflushed = false;
+};
+
+} // namespace Nakama
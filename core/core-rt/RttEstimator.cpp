@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "RttEstimator.h"
+
+#include <algorithm>
+
+namespace Nakama {
+
+namespace {
+
+// Clocks drift apart by tens of ppm, bounds older than this would bias the offset.
+constexpr std::chrono::minutes kBoundMaxAge{5};
+constexpr size_t kMaxBounds = 64;
+
+} // namespace
+
+void RttEstimator::setMinRttWindow(std::chrono::seconds window) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _minRttWindow = window;
+}
+
+void RttEstimator::addRttSample(Micros rtt, Clock::time_point at) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (_stats.samples == 0) {
+    _stats.smoothedRtt = rtt;
+    _stats.rttVariation = rtt / 2;
+  } else {
+    Micros deviation = _stats.smoothedRtt > rtt ? _stats.smoothedRtt - rtt : rtt - _stats.smoothedRtt;
+    _stats.rttVariation = (3 * _stats.rttVariation + deviation) / 4;
+    _stats.smoothedRtt = (7 * _stats.smoothedRtt + rtt) / 8;
+  }
+  _stats.latestRtt = rtt;
+  ++_stats.samples;
+
+  while (!_minRttCandidates.empty() && _minRttCandidates.back().second >= rtt) {
+    _minRttCandidates.pop_back();
+  }
+  _minRttCandidates.emplace_back(at, rtt);
+  while (_minRttCandidates.front().first < at - _minRttWindow) {
+    _minRttCandidates.pop_front();
+  }
+  _stats.minRtt = _minRttCandidates.front().second;
+}
+
+void RttEstimator::addClockSample(Micros serverTime, Micros resolution, std::optional<Micros> sent, Micros received) {
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  Clock::time_point now = Clock::now();
+  Bound bound{serverTime - received, std::nullopt, now};
+  if (sent) {
+    bound.upper = serverTime + resolution - *sent;
+  }
+
+  _bounds.push_back(bound);
+  while (_bounds.size() > kMaxBounds || _bounds.front().at < now - kBoundMaxAge) {
+    _bounds.pop_front();
+  }
+
+  updateClockOffset();
+}
+
+void RttEstimator::updateClockOffset() {
+  while (!_bounds.empty()) {
+    Micros lower = Micros::min();
+    std::optional<Micros> upper;
+    for (const Bound& bound : _bounds) {
+      lower = std::max(lower, bound.lower);
+      if (bound.upper) {
+        upper = upper ? std::min(*upper, *bound.upper) : *bound.upper;
+      }
+    }
+
+    if (!upper) {
+      break;
+    }
+
+    if (lower <= *upper) {
+      _stats.clockOffsetValid = true;
+      _stats.clockOffset = lower + (*upper - lower) / 2;
+      _stats.clockOffsetError = (*upper - lower) / 2;
+      return;
+    }
+
+    // one of the clocks jumped, the older bounds don't hold anymore
+    _bounds.pop_front();
+  }
+
+  _stats.clockOffsetValid = false;
+}
+
+void RttEstimator::resetRtt() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _stats.smoothedRtt = Micros(0);
+  _stats.rttVariation = Micros(0);
+  _stats.minRtt = Micros(0);
+  _stats.latestRtt = Micros(0);
+  _stats.samples = 0;
+  _minRttCandidates.clear();
+}
+
+NRttStats RttEstimator::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _stats;
+}
+
+} // namespace Nakama
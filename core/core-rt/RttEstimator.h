@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+
+#include "nakama-cpp/realtime/NRttStats.h"
+
+namespace Nakama {
+
+/**
+ * Smoothed RTT per RFC 6298 with a windowed minimum, and the server clock offset.
+ *
+ * Every timestamped message bounds the offset: the server stamped it at some point between our send
+ * and our receive, within the resolution of the stamp. The estimate is the intersection of the recent
+ * bounds, which narrows with every sample even when stamps have a resolution of a second. When the
+ * bounds stop intersecting, a clock jumped and the oldest ones are dropped. Thread safe.
+ */
+class RttEstimator {
+public:
+  using Clock = std::chrono::steady_clock;
+  using Micros = std::chrono::microseconds;
+
+  void setMinRttWindow(std::chrono::seconds window);
+
+  void addRttSample(Micros rtt, Clock::time_point at);
+
+  // Server stamped a message with `serverTime`, accurate to `resolution`, between local `sent` and `received`
+  // (Unix time). Without `sent` only the lower bound is known, e.g. for events the server pushed.
+  void addClockSample(Micros serverTime, Micros resolution, std::optional<Micros> sent, Micros received);
+
+  // Drops the RTT estimate, e.g. on connect. The clock offset doesn't depend on the connection and is kept.
+  void resetRtt();
+
+  NRttStats getStats() const;
+
+private:
+  struct Bound {
+    Micros lower;
+    std::optional<Micros> upper;
+    Clock::time_point at;
+  };
+
+  void updateClockOffset();
+
+  mutable std::mutex _mutex;
+  NRttStats _stats;
+  std::chrono::seconds _minRttWindow{10};
+  // RTT samples which may still become the minimum: increasing RTTs of increasing age
+  std::deque<std::pair<Clock::time_point, Micros>> _minRttCandidates;
+  std::deque<Bound> _bounds;
+};
+
+} // namespace Nakama
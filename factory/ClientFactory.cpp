@@ -47,7 +47,11 @@ NClientPtr createDefaultClient(const NClientParameters& parameters) {
 #ifdef WITH_GRPC_CLIENT
 
 NClientPtr createGrpcClient(const NClientParameters& parameters) {
-  NClientPtr client(new GrpcClient(parameters));
+  return createGrpcClient(parameters, NGrpcClientParameters());
+}
+
+NClientPtr createGrpcClient(const NClientParameters& parameters, const NGrpcClientParameters& grpcParameters) {
+  NClientPtr client(new GrpcClient(parameters, grpcParameters));
   return client;
 }
 
@@ -24,7 +24,10 @@
 #include "../../impl/wsLibHttpClient/NWebsocketLibHC.h"
 #elif defined(WITH_WS_WSLAY)
 #include "NWebsocketWslay.h"
-#if defined(CFG_WSLAY_CURL_IO)
+#include "WslayReactor.h"
+#if defined(CFG_WSLAY_SOCKET_IO)
+#include "WslayIOSocket.h"
+#elif defined(CFG_WSLAY_CURL_IO)
 #include "WslayIOCurl.h"
 #endif
 #elif defined(WITH_WS_CPPREST)
@@ -36,6 +39,8 @@ namespace Nakama {
 NRtTransportPtr createDefaultWebsocket([[maybe_unused]] const NPlatformParameters& platformParams) {
 #if defined(WITH_WS_LIBHTTPC)
   return NRtTransportPtr(NWebsocketLibHC::New(platformParams));
+#elif defined(WITH_WS_WSLAY) && defined(CFG_WSLAY_SOCKET_IO)
+  return NRtTransportPtr(new NWebsocketWslay(std::unique_ptr<WslayIOInterface>(new WslayIOSocket())));
 #elif defined(WITH_WS_WSLAY) && defined(CFG_WSLAY_CURL_IO)
   return NRtTransportPtr(new NWebsocketWslay(std::move(std::unique_ptr<WslayIOInterface>(new WslayIOCurl()))));
 #elif defined(WITH_WS_CPPREST)
@@ -44,6 +49,35 @@ NRtTransportPtr createDefaultWebsocket([[maybe_unused]] const NPlatformParameter
 #error Could not find default web socket transport or IO for platform.
 #endif
 }
+
+NRtTransportPtr createDefaultWebsocket(const NPlatformParameters& platformParams, const NRtReactorPtr& reactor) {
+  if (!reactor) {
+    return createDefaultWebsocket(platformParams);
+  }
+
+#if defined(WITH_WS_WSLAY)
+  // a reactor of another transport, or the application's own implementation, can't service this one
+  if (reactor->getTransportName() == WslayReactor::kTransportName) {
+    auto wslayReactor = std::static_pointer_cast<WslayReactor>(reactor);
+#if defined(CFG_WSLAY_SOCKET_IO)
+    return NRtTransportPtr(new NWebsocketWslay(std::make_unique<WslayIOSocket>(), std::move(wslayReactor)));
+#elif defined(CFG_WSLAY_CURL_IO)
+    return NRtTransportPtr(new NWebsocketWslay(std::make_unique<WslayIOCurl>(), std::move(wslayReactor)));
+#endif
+  }
+#endif
+
+  NLOG_ERROR("Reactor was not created by createRtReactor of this platform's websocket transport.");
+  return nullptr;
+}
+
+NRtReactorPtr createRtReactor([[maybe_unused]] const NRtReactorConfig& config) {
+#if defined(WITH_WS_WSLAY)
+  return std::make_shared<WslayReactor>(config);
+#else
+  return nullptr;
+#endif
+}
 } // namespace Nakama
 
 #endif
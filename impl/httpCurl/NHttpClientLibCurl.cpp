@@ -1,5 +1,7 @@
 #include "NHttpClientLibCurl.h"
 #include "nakama-cpp/log/NLogger.h"
+#include <algorithm>
+#include <cctype>
 #include <curl/curl.h>
 #include <memory.h>
 #include <nakama-cpp/NHttpTransportInterface.h>
@@ -10,6 +12,28 @@
 #include "AndroidCA.h"
 #endif
 
+// Phase timings for request tracing. Left at -1 when curl can't report them.
+static void fill_timings(CURL* handle, Nakama::NHttpTimings& timings) {
+#if LIBCURL_VERSION_NUM >= 0x073d00 // 7.61.0, *_TIME_T variants
+  auto get = [handle](CURLINFO info, int64_t& out) {
+    curl_off_t value = 0;
+    if (curl_easy_getinfo(handle, info, &value) == CURLE_OK) {
+      out = static_cast<int64_t>(value);
+    }
+  };
+
+  get(CURLINFO_NAMELOOKUP_TIME_T, timings.nameLookupUs);
+  get(CURLINFO_CONNECT_TIME_T, timings.connectUs);
+  get(CURLINFO_APPCONNECT_TIME_T, timings.tlsHandshakeUs);
+  get(CURLINFO_PRETRANSFER_TIME_T, timings.preTransferUs);
+  get(CURLINFO_STARTTRANSFER_TIME_T, timings.startTransferUs);
+  get(CURLINFO_TOTAL_TIME_T, timings.totalUs);
+#else
+  (void)handle;
+  (void)timings;
+#endif
+}
+
 static int debug_callback(CURL* handle, curl_infotype type, char* data, size_t size, void* userp) {
   const char* text;
   (void)handle; /* prevent compiler warning */
@@ -56,6 +80,33 @@ static size_t write_callback(char* buffer, size_t size, size_t nmemb, void* user
   return nmemb * size;
 }
 
+static size_t header_callback(char* buffer, size_t size, size_t nitems, void* user_ctx) {
+  Nakama::NHttpClientLibCurlContext* curl_ctx = (Nakama::NHttpClientLibCurlContext*)user_ctx;
+  size_t len = nitems * size;
+  std::string line(buffer, len);
+
+  if (line.compare(0, 5, "HTTP/") == 0) {
+    // status line of a new response, e.g. after a redirect
+    curl_ctx->clear_response_headers();
+    return len;
+  }
+
+  size_t colon = line.find(':');
+  if (colon == std::string::npos) {
+    return len;
+  }
+
+  std::string name = line.substr(0, colon);
+  std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) { return std::tolower(c); });
+
+  size_t begin = line.find_first_not_of(" \t", colon + 1);
+  size_t end = line.find_last_not_of(" \t\r\n");
+  std::string value = begin == std::string::npos || end < begin ? std::string() : line.substr(begin, end - begin + 1);
+
+  curl_ctx->add_response_header(std::move(name), std::move(value));
+  return len;
+}
+
 namespace Nakama {
 
 NHttpClientLibCurl::NHttpClientLibCurl(const NPlatformParameters& platformParameters)
@@ -166,6 +217,18 @@ void NHttpClientLibCurl::request(const NHttpRequest& req, const NHttpResponseCal
     return;
   }
 
+  curl_code = curl_easy_setopt(curl_easy.get(), CURLOPT_HEADERFUNCTION, header_callback);
+  if (curl_code != CURLE_OK) {
+    handle_curl_easy_set_opt_error("adding header function", curl_code, callback);
+    return;
+  }
+
+  curl_code = curl_easy_setopt(curl_easy.get(), CURLOPT_HEADERDATA, curl_ctx.get());
+  if (curl_code != CURLE_OK) {
+    handle_curl_easy_set_opt_error("adding header context", curl_code, callback);
+    return;
+  }
+
   /* ask libcurl to show us the verbose output */
 #ifdef CURL_DEBUG
   curl_code = curl_easy_setopt(curl_easy.get(), CURLOPT_VERBOSE, 1L);
@@ -266,6 +329,8 @@ void NHttpClientLibCurl::tick() {
 
         auto response = std::shared_ptr<NHttpResponse>(new NHttpResponse());
         response->body = context->get_body();
+        response->headers = context->get_response_headers();
+        fill_timings(e, response->timings);
 
         if (result != CURLE_OK) {
           NLOG(Nakama::NLogLevel::Error, "curl easy handle returned code: %d \n", (int)result);
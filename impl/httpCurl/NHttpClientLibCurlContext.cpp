@@ -36,4 +36,12 @@ curl_slist* NHttpClientLibCurlContext::get_headers() { return _headers; }
 std::string NHttpClientLibCurlContext::get_body() { return _body; }
 
 void NHttpClientLibCurlContext::append_body(std::string body) { _body += body; }
+
+NHttpHeaders NHttpClientLibCurlContext::get_response_headers() { return _response_headers; }
+
+void NHttpClientLibCurlContext::add_response_header(std::string name, std::string value) {
+  _response_headers[std::move(name)] = std::move(value);
+}
+
+void NHttpClientLibCurlContext::clear_response_headers() { _response_headers.clear(); }
 } // namespace Nakama
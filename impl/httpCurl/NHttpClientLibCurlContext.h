@@ -31,11 +31,15 @@ public:
   curl_slist* get_headers();
   std::string get_body();
   void append_body(std::string body);
+  NHttpHeaders get_response_headers();
+  void add_response_header(std::string name, std::string value);
+  void clear_response_headers();
 
 private:
   NHttpResponseCallback _callback;
   curl_slist* _headers;
   std::string _body;
+  NHttpHeaders _response_headers;
 };
 
 } // namespace Nakama
@@ -86,7 +86,15 @@ void NWebsocketCppRest::disconnect() {
 }
 
 void NWebsocketCppRest::disconnect(web::websockets::client::websocket_close_status status, const std::string& reason) {
-  if (!_wsClient)
+  std::unique_ptr<WsClient> wsClient;
+  {
+    std::lock_guard<std::mutex> guard(_sendMutex);
+    wsClient = std::move(_wsClient);
+    _sending = false;
+  }
+  _sendQueue.clear();
+
+  if (!wsClient)
     return;
 
   NLOG_DEBUG(reason);
@@ -94,31 +102,58 @@ void NWebsocketCppRest::disconnect(web::websockets::client::websocket_close_stat
   _disconnectInitiated = true;
   _connected = false;
 
-  _wsClient->close(status, FROM_STD_STR(reason));
+  wsClient->close(status, FROM_STD_STR(reason));
   // clear handlers to prevent them from firing again before server ack, then reset pointer
-  _wsClient->set_close_handler(
+  wsClient->set_close_handler(
       [](web::web_sockets::client::websocket_close_status, const utility::string_t&, const std::error_code&) {});
-  _wsClient->set_message_handler([](const web::web_sockets::client::websocket_incoming_message&) {});
-  _wsClient.reset();
+  wsClient->set_message_handler([](const web::web_sockets::client::websocket_incoming_message&) {});
+  wsClient.reset();
 }
 
 bool NWebsocketCppRest::send(const NBytes& data) {
+  return trySend(data, std::nullopt, NSendPriority::Control) == NSendResult::Queued;
+}
+
+NSendResult NWebsocketCppRest::trySend(
+    const NBytes& data, const std::optional<NSendDropKey>& dropKey, NSendPriority priority) {
   if (!isConnected()) {
     NLOG_ERROR("send failed - not connected");
-    return false;
+    return NSendResult::Failed;
   }
 
-  bool res = false;
+  NSendResult result = _sendQueue.push(data, dropKey, priority);
+  if (result == NSendResult::Queued) {
+    sendNext();
+  }
+  return result;
+}
+
+bool NWebsocketCppRest::setSendQueueConfig(const NSendQueueConfig& config) {
+  _sendQueue.configure(config);
+  return true;
+}
+
+// called from the user thread and from send completions on internal threads of WsClient
+void NWebsocketCppRest::sendNext() {
+  std::lock_guard<std::mutex> guard(_sendMutex);
+
+  NBytes data;
+  if (_sending || !_wsClient || !_sendQueue.pop(data)) {
+    return;
+  }
+
+  _sending = true;
+  _sendQueue.setInFlight(data.size(), 1);
 
   try {
     web::websockets::client::websocket_outgoing_message msg;
 
     if (_type == NRtTransportType::Binary) {
       NLOG(NLogLevel::Debug, "sending %d bytes binary ...", data.size());
-      msg.set_binary_message(concurrency::streams::bytestream::open_istream(data));
+      msg.set_binary_message(concurrency::streams::bytestream::open_istream(std::move(data)));
     } else {
       NLOG(NLogLevel::Debug, "sending %d bytes text ...", data.size());
-      msg.set_utf8_message(data);
+      msg.set_utf8_message(std::move(data));
     }
 
     auto task = _wsClient->send(std::move(msg));
@@ -129,14 +164,22 @@ bool NWebsocketCppRest::send(const NBytes& data) {
       } catch (const std::exception& e) {
         addErrorEvent("[NWebsocketCppRest::send] exception: " + std::string(e.what()));
       }
-    });
 
-    res = true;
+      {
+        std::lock_guard<std::mutex> guard(_sendMutex);
+        _sending = false;
+      }
+      _sendQueue.setInFlight(0, 0);
+      if (_sendQueue.takeWritable()) {
+        executeInUserThread([this]() { fireOnWritable(); });
+      }
+      sendNext();
+    });
   } catch (std::exception const& e) {
+    _sending = false;
+    _sendQueue.setInFlight(0, 0);
     addErrorEvent("[NWebsocketCppRest::send] exception: " + std::string(e.what()));
   }
-
-  return res;
 }
 
 void NWebsocketCppRest::executeInUserThread(UserThreadFunc&& userThreadFunc) {
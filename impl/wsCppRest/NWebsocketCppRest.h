@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "SendQueue.h"
 #include "cpprest/http_client.h"
 #include "cpprest/ws_client.h"
 #include "nakama-cpp/realtime/NRtTransportInterface.h"
@@ -42,6 +43,9 @@ public:
   void disconnect() override;
 
   bool send(const NBytes& data) override;
+  NSendResult trySend(const NBytes& data, const std::optional<NSendDropKey>& dropKey, NSendPriority priority) override;
+  bool setSendQueueConfig(const NSendQueueConfig& config) override;
+  NSendQueueStats getSendQueueStats() const override { return _sendQueue.getStats(); }
 
 protected:
   using UserThreadFunc = std::function<void()>;
@@ -57,6 +61,9 @@ protected:
 
   void addErrorEvent(std::string&& err);
 
+  // Hands the oldest queued message to the client unless one is being sent already.
+  void sendNext();
+
   void disconnect(web::websockets::client::websocket_close_status status, const std::string& reason);
 
 protected:
@@ -68,6 +75,12 @@ protected:
   std::list<UserThreadFunc> _userThreadFuncs;
   uint32_t _activityTimeoutMs = 0;
   std::atomic<uint64_t> _lastReceivedMessageTimeMs;
+
+  // One message at a time is handed to the client, the rest waits in the send queue where its
+  // watermarks apply. _sendMutex guards _wsClient against send completions.
+  SendQueue _sendQueue;
+  std::mutex _sendMutex;
+  bool _sending = false;
 };
 
 } // namespace Nakama
\ No newline at end of file
@@ -1,18 +1,29 @@
+#include <algorithm>
 #include <cassert>
+#include <cctype>
 #include <chrono>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <random>
 #include <string>
 
 #include "NWebsocketWslay.h"
 #include "StrUtil.h"
+#include "WslayReactor.h"
 #include "sha1.h"
 #include <nakama-cpp/log/NLogger.h>
 #include <wslay/wslay.h>
 
 namespace Nakama {
 
+// Messages are moved from the send queue into wslay only while it holds less than this. The backlog of a
+// stalled connection stays in the send queue, where its watermarks apply and stale messages can be dropped.
+static constexpr size_t kMaxInFlightBytes = 64 * 1024;
+
+// Bulk messages only while it holds less than this, wslay writes in order and a message queued after them waits.
+static constexpr size_t kMaxBulkInFlightBytes = 16 * 1024;
+
 void NWebsocketWslay::on_msg_recv_callback(
     wslay_event_context_ptr /*ctx*/,
     const struct wslay_event_on_msg_recv_arg* arg,
@@ -26,6 +37,14 @@ void NWebsocketWslay::on_msg_recv_callback(
       NLOG(NLogLevel::Info, "Remote server closed connection with status code %d", arg->status_code);
       ws->_state.store(State::RemoteDisconnect);
     }
+  } else if (wslay_get_rsv1(arg->rsv)) {
+    NBytes data;
+    if (!ws->_deflate || !ws->_deflate->inflate(arg->msg, arg->msg_length, data)) {
+      NLOG_ERROR("[wslay] unable to inflate message from peer");
+      ws->_inflateFailed = true;
+      return;
+    }
+    ws->enqueueCallback([ws, data = std::move(data)]() { ws->fireOnMessage(data); });
   } else {
     // Copy message data — arg memory is only valid during this callback
     NBytes data(reinterpret_cast<const char*>(arg->msg), arg->msg_length);
@@ -100,6 +119,30 @@ static std::string get_random16() {
   return {reinterpret_cast<char*>(&rnd[0]), sizeof(rnd)};
 }
 
+// Value of a response header, header names are case insensitive.
+static std::optional<std::string_view> find_header(std::string_view headers, std::string_view name) {
+  size_t pos = headers.find("\r\n");
+  while (pos != std::string_view::npos) {
+    std::string_view line = headers.substr(pos + 2);
+    size_t next = line.find("\r\n");
+    line = line.substr(0, next);
+
+    if (line.size() > name.size() && line[name.size()] == ':' &&
+        std::equal(name.begin(), name.end(), line.begin(), [](char a, char b) {
+          return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+        })) {
+      line.remove_prefix(name.size() + 1);
+      while (!line.empty() && (line.front() == ' ' || line.front() == '\t')) {
+        line.remove_prefix(1);
+      }
+      return line;
+    }
+
+    pos = next == std::string_view::npos ? next : pos + 2 + next;
+  }
+  return std::nullopt;
+}
+
 NetIOAsyncResult NWebsocketWslay::http_handshake_init() {
   _client_key = Nakama::base64Encode(get_random16());
 
@@ -113,8 +156,11 @@ NetIOAsyncResult NWebsocketWslay::http_handshake_init() {
        << "Upgrade: websocket\r\n"
        << "Connection: Upgrade\r\n"
        << "Sec-WebSocket-Version: 13\r\n"
-       << "Sec-WebSocket-Key: " << _client_key << "\r\n"
-       << "\r\n";
+       << "Sec-WebSocket-Key: " << _client_key << "\r\n";
+  if (_deflate) {
+    reqb << "Sec-WebSocket-Extensions: " << _deflate->offer() << "\r\n";
+  }
+  reqb << "\r\n";
   _buf = reqb.str();
   _buf_iter = _buf.begin();
   return NetIOAsyncResult::DONE;
@@ -172,6 +218,21 @@ NetIOAsyncResult NWebsocketWslay::http_handshake_receive() {
   }
 
   auto rnrn_pos = _buf.find("\r\n\r\n");
+
+  auto extensions = find_header(std::string_view(_buf).substr(0, rnrn_pos + 2), "Sec-WebSocket-Extensions");
+  if (_deflate) {
+    if (!_deflate->accept(extensions.value_or(std::string_view()))) {
+      return NetIOAsyncResult::ERR;
+    }
+    if (_deflate->isNegotiated()) {
+      NLOG_DEBUG("permessage-deflate negotiated");
+      wslay_event_config_set_allowed_rsv_bits(_ctx.get(), WSLAY_RSV1_BIT);
+    }
+  } else if (extensions) {
+    NLOG_ERROR("http_upgrade: server responded with extensions which weren't offered");
+    return NetIOAsyncResult::ERR;
+  }
+
   // clear handshake response from buffer. if server sent us message immediately after HTTP upgrade, buffer will still
   // contain it.
   _buf.erase(_buf.begin(), std::next(_buf.begin(), rnrn_pos + 4));
@@ -179,13 +240,15 @@ NetIOAsyncResult NWebsocketWslay::http_handshake_receive() {
   return NetIOAsyncResult::DONE;
 }
 
-NWebsocketWslay::NWebsocketWslay(std::unique_ptr<WslayIOInterface> io)
+NWebsocketWslay::NWebsocketWslay(std::unique_ptr<WslayIOInterface> io, std::shared_ptr<WslayReactor> reactor)
     : _io(std::move(io)),
       _callbacks{recv_callback, send_callback, genmask_callback, nullptr, nullptr, nullptr, on_msg_recv_callback},
-      _ctx(nullptr, wslay_event_context_free) {}
+      _ctx(nullptr, wslay_event_context_free), _reactor(std::move(reactor)) {}
 
 NWebsocketWslay::~NWebsocketWslay() {
   _ioRunning.store(false);
+  if (_reactor)
+    _reactor->detach(this, _reactorLoop);
   if (_ioThread.joinable())
     _ioThread.join();
   cleanupConnection();
@@ -196,6 +259,14 @@ void NWebsocketWslay::enqueueCallback(std::function<void()> cb) {
   _callbackQueue.push_back(std::move(cb));
 }
 
+void NWebsocketWslay::closeIO() {
+  // the reactor must stop waiting on the socket before its descriptor can be reused
+  if (_reactor)
+    _reactor->unwatch(this, _reactorLoop);
+  _io->close();
+  _ctx.reset(nullptr);
+}
+
 void NWebsocketWslay::cleanupConnection() {
   if (_state.exchange(State::Disconnected) == State::Connected && _ctx) {
     // Best-effort close frame
@@ -207,11 +278,7 @@ void NWebsocketWslay::cleanupConnection() {
   _connected = false;
   _ctx.reset(nullptr);
 
-  {
-    std::lock_guard<std::mutex> lock(_sendMutex);
-    std::queue<NBytes> empty;
-    _outgoingQueue.swap(empty);
-  }
+  _sendQueue.clear();
 }
 
 void NWebsocketWslay::connect(const std::string& url, NRtTransportType transportType) {
@@ -222,6 +289,11 @@ void NWebsocketWslay::connect(const std::string& url, NRtTransportType transport
     _ctx.reset(p);
   }
 
+  _deflate = _deflateConfig.enabled ? std::make_unique<WslayDeflate>(_deflateConfig) : nullptr;
+  _inflateFailed = false;
+  // messages of a connection which failed on the I/O thread must not go out on the new one
+  _sendQueue.clear();
+
   if (transportType == NRtTransportType::Binary) {
     _opcode = WSLAY_BINARY_FRAME;
   } else {
@@ -244,7 +316,11 @@ void NWebsocketWslay::connect(const std::string& url, NRtTransportType transport
 
   _state.store(State::Connecting);
   _ioRunning.store(true);
-  _ioThread = std::thread(&NWebsocketWslay::ioThreadFunc, this);
+  if (_reactor) {
+    _reactorLoop = _reactor->attach(this);
+  } else {
+    _ioThread = std::thread(&NWebsocketWslay::ioThreadFunc, this);
+  }
 }
 
 void NWebsocketWslay::disconnect() {
@@ -252,6 +328,8 @@ void NWebsocketWslay::disconnect() {
     return;
 
   _ioRunning.store(false);
+  if (_reactor)
+    _reactor->detach(this, _reactorLoop);
   if (_ioThread.joinable())
     _ioThread.join();
 
@@ -267,12 +345,28 @@ void NWebsocketWslay::disconnect() {
 
 uint32_t NWebsocketWslay::getActivityTimeout() const { return this->_timeout; }
 
+bool NWebsocketWslay::setDeflate(const NWebsocketDeflateConfig& config) {
+  _deflateConfig = config;
+  return true;
+}
+
 bool NWebsocketWslay::send(const NBytes& data) {
+  return trySend(data, std::nullopt, NSendPriority::Control) == NSendResult::Queued;
+}
+
+NSendResult NWebsocketWslay::trySend(
+    const NBytes& data, const std::optional<NSendDropKey>& dropKey, NSendPriority priority) {
   if (_state.load() != State::Connected)
-    return false;
+    return NSendResult::Failed;
 
-  std::lock_guard<std::mutex> lock(_sendMutex);
-  _outgoingQueue.push(data);
+  NSendResult result = _sendQueue.push(data, dropKey, priority);
+  if (result == NSendResult::Queued && _reactor)
+    _reactor->wake(this, _reactorLoop);
+  return result;
+}
+
+bool NWebsocketWslay::setSendQueueConfig(const NSendQueueConfig& config) {
+  _sendQueue.configure(config);
   return true;
 }
 
@@ -291,131 +385,162 @@ void NWebsocketWslay::tick() {
 
 void NWebsocketWslay::ioThreadFunc() {
   while (_ioRunning.load()) {
-    State currentState = _state.load();
-
-    if (currentState == State::Connected) {
-      // 1. Drain outgoing queue into wslay
-      {
-        std::lock_guard<std::mutex> lock(_sendMutex);
-        while (!_outgoingQueue.empty()) {
-          auto& data = _outgoingQueue.front();
-          struct wslay_event_msg msg {
-            _opcode, reinterpret_cast<const uint8_t*>(data.data()), data.size()
-          };
-          int ret = wslay_event_queue_msg(_ctx.get(), &msg);
-          if (ret != 0) {
-            NLOG(NLogLevel::Error, "[wslay] unable to queue egress message: %d", ret);
-          }
-          _outgoingQueue.pop();
-        }
-      }
+    IOStep step = service();
+    if (step == IOStep::Closed) {
+      break;
+    }
+    if (step == IOStep::Idle) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+  }
+}
 
-      // 2. Receive
-      int ret = wslay_event_recv(_ctx.get());
-      if (ret != 0 && ret != WSLAY_ERR_WOULDBLOCK) {
-        NLOG(NLogLevel::Error, "[wslay] unable to receive message from peer: %d", ret);
-        _io->close();
-        _state.store(State::Disconnected);
-        _ctx.reset(nullptr);
-        enqueueCallback([this]() {
-          NRtClientDisconnectInfo info;
-          info.code = NRtClientDisconnectInfo::Code::TRANSPORT_ERROR;
-          info.remote = false;
-          fireOnDisconnected(info);
-        });
-        break;
-      }
+NWebsocketWslay::IOStep NWebsocketWslay::service() {
+  State currentState = _state.load();
 
-      // 3. Check for remote disconnect (set by on_msg_recv_callback for WSLAY_CONNECTION_CLOSE)
-      State expected = State::RemoteDisconnect;
-      if (_state.compare_exchange_strong(expected, State::Disconnected)) {
-        uint16_t code = wslay_event_get_status_code_received(_ctx.get());
-        _io->close();
-        _ctx.reset(nullptr);
-        enqueueCallback([this, code]() {
-          NRtClientDisconnectInfo info;
-          info.code = code;
-          info.remote = true;
-          fireOnDisconnected(info);
-        });
+  if (currentState == State::Connected) {
+    // 1. Move queued messages into wslay
+    NBytes data;
+    while (true) {
+      size_t inWslay = wslay_event_get_queued_msg_length(_ctx.get());
+      NSendPriority lowest = inWslay < kMaxBulkInFlightBytes ? NSendPriority::Bulk : NSendPriority::Latest;
+      if (inWslay >= kMaxInFlightBytes || !_sendQueue.pop(data, lowest)) {
         break;
       }
 
-      // 4. Send
-      ret = wslay_event_send(_ctx.get());
+      int ret;
+      if (_deflate && _deflate->deflate(reinterpret_cast<const uint8_t*>(data.data()), data.size(), _deflateBuf)) {
+        struct wslay_event_msg msg {
+          _opcode, reinterpret_cast<const uint8_t*>(_deflateBuf.data()), _deflateBuf.size()
+        };
+        ret = wslay_event_queue_msg_ex(_ctx.get(), &msg, WSLAY_RSV1_BIT);
+      } else {
+        struct wslay_event_msg msg {
+          _opcode, reinterpret_cast<const uint8_t*>(data.data()), data.size()
+        };
+        ret = wslay_event_queue_msg(_ctx.get(), &msg);
+      }
       if (ret != 0) {
-        NLOG(NLogLevel::Error, "[wslay] unable to send message to peer: %d", ret);
-        _io->close();
-        _state.store(State::Disconnected);
-        _ctx.reset(nullptr);
-        enqueueCallback([this]() {
-          NRtClientDisconnectInfo info;
-          info.code = NRtClientDisconnectInfo::Code::TRANSPORT_ERROR;
-          info.remote = false;
-          fireOnDisconnected(info);
-        });
-        break;
+        NLOG(NLogLevel::Error, "[wslay] unable to queue egress message: %d", ret);
       }
+    }
 
-      std::this_thread::sleep_for(std::chrono::milliseconds(10));
-    } else {
-      // Drive connection state machine: Connecting → Handshake_Sending → Handshake_Receiving → Connected
-      NetIOAsyncResult res = NetIOAsyncResult::AGAIN;
-      do {
-        currentState = _state.load();
-        if (currentState == State::Connecting) {
-          NLOG_DEBUG("Wslay state: Connecting");
-          res = _io->connect_tick();
-          if (res == NetIOAsyncResult::DONE) {
-            _state.store(State::Handshake_Sending);
-            res = http_handshake_init();
-          }
-        } else if (currentState == State::Handshake_Sending) {
-          NLOG_DEBUG("Wslay state: Handshake sending");
-          res = http_handshake_send();
-          if (res == NetIOAsyncResult::DONE) {
-            _state.store(State::Handshake_Receiving);
-          }
-        } else if (currentState == State::Handshake_Receiving) {
-          NLOG_DEBUG("Wslay state: Handshake receiving");
-          res = http_handshake_receive();
-          if (res == NetIOAsyncResult::DONE) {
-            _state.store(State::Connected);
-            enqueueCallback([this]() { fireOnConnected(); });
-            break;
-          }
-        } else {
-          break;
-        }
-      } while (res == NetIOAsyncResult::DONE);
-
-      if (res == NetIOAsyncResult::ERR) {
-        std::string errMessage;
-        currentState = _state.load();
-        switch (currentState) {
-          case State::Connecting:
-            errMessage = "Failed connect";
-            break;
-          case State::Handshake_Receiving:
-          case State::Handshake_Sending:
-            errMessage = "Failed HTTP handshake";
-            break;
-          default:
-            break;
-        }
-        NLOG(NLogLevel::Debug, "Wslay result: ERROR %s", errMessage.c_str());
-        _state.store(State::Disconnected);
-        _io->close();
-        _ctx.reset(nullptr);
-        enqueueCallback([this, errMessage]() { fireOnError(errMessage); });
-        break;
-      }
+    // 2. Receive
+    int ret = wslay_event_recv(_ctx.get());
+    if ((ret != 0 && ret != WSLAY_ERR_WOULDBLOCK) || _inflateFailed) {
+      NLOG(NLogLevel::Error, "[wslay] unable to receive message from peer: %d", ret);
+      _state.store(State::Disconnected);
+      closeIO();
+      enqueueCallback([this]() {
+        NRtClientDisconnectInfo info;
+        info.code = NRtClientDisconnectInfo::Code::TRANSPORT_ERROR;
+        info.remote = false;
+        fireOnDisconnected(info);
+      });
+      return IOStep::Closed;
+    }
+
+    // 3. Check for remote disconnect (set by on_msg_recv_callback for WSLAY_CONNECTION_CLOSE)
+    State expected = State::RemoteDisconnect;
+    if (_state.compare_exchange_strong(expected, State::Disconnected)) {
+      uint16_t code = wslay_event_get_status_code_received(_ctx.get());
+      closeIO();
+      enqueueCallback([this, code]() {
+        NRtClientDisconnectInfo info;
+        info.code = code;
+        info.remote = true;
+        fireOnDisconnected(info);
+      });
+      return IOStep::Closed;
+    }
+
+    // 4. Send
+    ret = wslay_event_send(_ctx.get());
+    if (ret != 0) {
+      NLOG(NLogLevel::Error, "[wslay] unable to send message to peer: %d", ret);
+      _state.store(State::Disconnected);
+      closeIO();
+      enqueueCallback([this]() {
+        NRtClientDisconnectInfo info;
+        info.code = NRtClientDisconnectInfo::Code::TRANSPORT_ERROR;
+        info.remote = false;
+        fireOnDisconnected(info);
+      });
+      return IOStep::Closed;
+    }
+
+    // what the socket didn't take is the backlog below the send queue
+    size_t inFlight = wslay_event_get_queued_msg_count(_ctx.get());
+    _sendQueue.setInFlight(wslay_event_get_queued_msg_length(_ctx.get()), inFlight);
+    if (_sendQueue.takeWritable()) {
+      enqueueCallback([this]() { fireOnWritable(); });
+    }
+
+    // the socket took everything wslay had, keep feeding it while messages are queued
+    if (inFlight == 0 && !_sendQueue.empty()) {
+      return IOStep::Again;
+    }
+
+    return IOStep::Idle;
+  }
 
-      if (res == NetIOAsyncResult::AGAIN) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  // Drive connection state machine: Connecting → Handshake_Sending → Handshake_Receiving → Connected
+  NetIOAsyncResult res = NetIOAsyncResult::AGAIN;
+  do {
+    currentState = _state.load();
+    if (currentState == State::Connecting) {
+      NLOG_DEBUG("Wslay state: Connecting");
+      res = _io->connect_tick();
+      if (res == NetIOAsyncResult::DONE) {
+        _state.store(State::Handshake_Sending);
+        res = http_handshake_init();
+      }
+    } else if (currentState == State::Handshake_Sending) {
+      NLOG_DEBUG("Wslay state: Handshake sending");
+      res = http_handshake_send();
+      if (res == NetIOAsyncResult::DONE) {
+        _state.store(State::Handshake_Receiving);
+      }
+    } else if (currentState == State::Handshake_Receiving) {
+      NLOG_DEBUG("Wslay state: Handshake receiving");
+      res = http_handshake_receive();
+      if (res == NetIOAsyncResult::DONE) {
+        _state.store(State::Connected);
+        enqueueCallback([this]() { fireOnConnected(); });
+        break;
       }
+    } else {
+      break;
+    }
+  } while (res == NetIOAsyncResult::DONE);
+
+  if (res == NetIOAsyncResult::ERR) {
+    std::string errMessage;
+    currentState = _state.load();
+    switch (currentState) {
+      case State::Connecting:
+        errMessage = "Failed connect";
+        break;
+      case State::Handshake_Receiving:
+      case State::Handshake_Sending:
+        errMessage = "Failed HTTP handshake";
+        break;
+      default:
+        break;
     }
+    NLOG(NLogLevel::Debug, "Wslay result: ERROR %s", errMessage.c_str());
+    _state.store(State::Disconnected);
+    closeIO();
+    enqueueCallback([this, errMessage]() { fireOnError(errMessage); });
+    return IOStep::Closed;
   }
+
+  return res == NetIOAsyncResult::AGAIN ? IOStep::Idle : IOStep::Again;
+}
+
+bool NWebsocketWslay::wantsWrite() const {
+  State s = _state.load();
+  return s == State::Handshake_Sending || (s == State::Connected && _ctx && wslay_event_want_write(_ctx.get()));
 }
 
 bool NWebsocketWslay::isConnecting() const {
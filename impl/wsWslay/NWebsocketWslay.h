@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include "SendQueue.h"
+#include "WslayDeflate.h"
 #include "WslayIOInterface.h"
 #include <atomic>
 #include <functional>
@@ -23,17 +25,19 @@
 #include <memory>
 #include <mutex>
 #include <nakama-cpp/realtime/NRtTransportInterface.h>
-#include <queue>
 #include <string>
 #include <thread>
 #include <wslay/wslay.h>
 
 namespace Nakama {
 
+class WslayReactor;
+
 enum class State { RemoteDisconnect, Disconnected, Connecting, Handshake_Sending, Handshake_Receiving, Connected };
 class NWebsocketWslay : public NRtTransportInterface {
 public:
-  NWebsocketWslay(std::unique_ptr<WslayIOInterface> io);
+  // Without a reactor, every connection runs its I/O on a thread of its own.
+  NWebsocketWslay(std::unique_ptr<WslayIOInterface> io, std::shared_ptr<WslayReactor> reactor = nullptr);
   ~NWebsocketWslay() override;
 
   void setActivityTimeout(uint32_t timeout) override;
@@ -43,6 +47,25 @@ public:
   void connect(const std::string& url, NRtTransportType type) override;
   void disconnect() override;
   bool send(const NBytes& data) override;
+  NSendResult trySend(const NBytes& data, const std::optional<NSendDropKey>& dropKey, NSendPriority priority) override;
+  bool setSendQueueConfig(const NSendQueueConfig& config) override;
+  NSendQueueStats getSendQueueStats() const override { return _sendQueue.getStats(); }
+  bool setDeflate(const NWebsocketDeflateConfig& config) override;
+  bool setSocketOptions(const NSocketOptions& options) override { return _io->setSocketOptions(options); }
+
+  // Outcome of one pass of the I/O loop.
+  enum class IOStep {
+    Again,  // there is more to do right away
+    Idle,   // wait for the socket or a send
+    Closed, // the connection is gone, callbacks are queued
+  };
+
+  // Called only by the I/O thread or the reactor servicing the connection.
+  IOStep service();
+  // Socket to wait on, -1 until there is one.
+  int socket() const { return _io->getSocket(); }
+  // Whether the socket has to become writable for the pass to make progress.
+  bool wantsWrite() const;
 
 protected:
   bool isConnecting() const override;
@@ -59,6 +82,7 @@ private:
   NetIOAsyncResult http_handshake_receive();
   void ioThreadFunc();
   void enqueueCallback(std::function<void()> cb);
+  void closeIO();
   void cleanupConnection();
 
   std::unique_ptr<WslayIOInterface> _io;
@@ -67,6 +91,12 @@ private:
   uint32_t _timeout = 0;
   uint8_t _opcode = 0xFF; // invalid opcode by default
 
+  // permessage-deflate, created by connect() when enabled and used by the I/O thread
+  NWebsocketDeflateConfig _deflateConfig;
+  std::unique_ptr<WslayDeflate> _deflate;
+  std::string _deflateBuf;
+  bool _inflateFailed = false;
+
   URLParts _url;
   std::string _client_key;
   std::atomic<State> _state{State::Disconnected};
@@ -75,17 +105,18 @@ private:
   std::string _buf;
   std::string::iterator _buf_iter;
 
-  // I/O thread lifecycle
+  // I/O thread lifecycle, or the reactor running the I/O instead
   std::thread _ioThread;
   std::atomic<bool> _ioRunning{false};
+  std::shared_ptr<WslayReactor> _reactor;
+  size_t _reactorLoop = 0;
 
   // Callback dispatch queue: I/O thread enqueues, tick() drains
   std::mutex _callbackMutex;
   std::list<std::function<void()>> _callbackQueue;
 
-  // Outgoing message queue: send() enqueues, I/O thread drains
-  std::mutex _sendMutex;
-  std::queue<NBytes> _outgoingQueue;
+  // Outgoing message queue: send() enqueues, I/O thread drains into wslay as the socket takes them
+  SendQueue _sendQueue;
 };
 
 } // namespace Nakama
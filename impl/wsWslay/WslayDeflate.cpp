@@ -0,0 +1,323 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WslayDeflate.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <sstream>
+
+#include <nakama-cpp/log/NLogger.h>
+#include <zlib.h>
+
+namespace Nakama {
+
+namespace {
+
+constexpr std::string_view kExtension = "permessage-deflate";
+
+// Every message is flushed with Z_SYNC_FLUSH, which ends in this empty stored block. RFC 7692 drops it
+// from the wire and the receiver appends it again.
+constexpr uint8_t kTail[4] = {0x00, 0x00, 0xff, 0xff};
+
+// zlib can't produce raw deflate streams with a 256 byte window, 9 is its smallest.
+constexpr int kMinWindowBits = 9;
+constexpr int kMaxWindowBits = 15;
+
+std::string_view trim(std::string_view s) {
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.front()))) {
+    s.remove_prefix(1);
+  }
+  while (!s.empty() && std::isspace(static_cast<unsigned char>(s.back()))) {
+    s.remove_suffix(1);
+  }
+  return s;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+  return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+           return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+         });
+}
+
+// Parses a window bits value, which may be quoted. Returns 0 if it's invalid.
+int parseWindowBits(std::string_view value) {
+  if (value.size() >= 2 && value.front() == '"' && value.back() == '"') {
+    value = value.substr(1, value.size() - 2);
+  }
+
+  if (value.empty() || value.size() > 2 || value.front() == '0' ||
+      !std::all_of(value.begin(), value.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+    return 0;
+  }
+
+  int bits = std::stoi(std::string(value));
+  return bits >= 8 && bits <= kMaxWindowBits ? bits : 0;
+}
+
+} // namespace
+
+WslayDeflate::WslayDeflate(const NWebsocketDeflateConfig& config) : _config(config) {
+  _config.clientMaxWindowBits = uint8_t(std::clamp<int>(_config.clientMaxWindowBits, kMinWindowBits, kMaxWindowBits));
+  _config.serverMaxWindowBits = uint8_t(std::clamp<int>(_config.serverMaxWindowBits, kMinWindowBits, kMaxWindowBits));
+  _config.level = std::clamp(_config.level, 1, 9);
+}
+
+WslayDeflate::~WslayDeflate() { end(); }
+
+std::string WslayDeflate::offer() const {
+  std::ostringstream offer;
+  offer << kExtension;
+
+  // the bare parameter tells the server it may limit our window
+  offer << "; client_max_window_bits";
+  if (_config.clientMaxWindowBits < kMaxWindowBits) {
+    offer << "=" << int(_config.clientMaxWindowBits);
+  }
+  if (_config.serverMaxWindowBits < kMaxWindowBits) {
+    offer << "; server_max_window_bits=" << int(_config.serverMaxWindowBits);
+  }
+  if (_config.clientNoContextTakeover) {
+    offer << "; client_no_context_takeover";
+  }
+  if (_config.serverNoContextTakeover) {
+    offer << "; server_no_context_takeover";
+  }
+
+  return offer.str();
+}
+
+bool WslayDeflate::accept(std::string_view response) {
+  end();
+
+  response = trim(response);
+  if (response.empty()) {
+    return true;
+  }
+
+  // only one extension was offered, so it is the only one the server may respond with
+  if (response.find(',') != std::string_view::npos) {
+    NLOG(NLogLevel::Error, "Websocket server responded with unexpected extensions: %s", std::string(response).c_str());
+    return false;
+  }
+
+  bool clientNoContextTakeover = false;
+  bool serverNoContextTakeover = false;
+  int clientWindowBits = 0;
+  int serverWindowBits = 0;
+  bool first = true;
+
+  while (!response.empty()) {
+    size_t next = response.find(';');
+    std::string_view param = trim(response.substr(0, next));
+    response = next == std::string_view::npos ? std::string_view() : response.substr(next + 1);
+
+    if (first) {
+      if (!equalsIgnoreCase(param, kExtension)) {
+        NLOG(NLogLevel::Error, "Websocket server responded with unexpected extension: %s", std::string(param).c_str());
+        return false;
+      }
+      first = false;
+      continue;
+    }
+
+    std::string_view name = param;
+    std::string_view value;
+    size_t eq = param.find('=');
+    if (eq != std::string_view::npos) {
+      name = trim(param.substr(0, eq));
+      value = trim(param.substr(eq + 1));
+    }
+
+    bool valid;
+    if (equalsIgnoreCase(name, "client_no_context_takeover")) {
+      valid = eq == std::string_view::npos && !clientNoContextTakeover;
+      clientNoContextTakeover = true;
+    } else if (equalsIgnoreCase(name, "server_no_context_takeover")) {
+      valid = eq == std::string_view::npos && !serverNoContextTakeover;
+      serverNoContextTakeover = true;
+    } else if (equalsIgnoreCase(name, "client_max_window_bits")) {
+      valid = clientWindowBits == 0;
+      clientWindowBits = parseWindowBits(value);
+      valid = valid && clientWindowBits != 0;
+    } else if (equalsIgnoreCase(name, "server_max_window_bits")) {
+      valid = serverWindowBits == 0;
+      serverWindowBits = parseWindowBits(value);
+      valid = valid && serverWindowBits != 0 && serverWindowBits <= _config.serverMaxWindowBits;
+    } else {
+      valid = false;
+    }
+
+    if (!valid) {
+      NLOG(
+          NLogLevel::Error,
+          "Websocket server sent invalid permessage-deflate parameter: %s",
+          std::string(param).c_str());
+      return false;
+    }
+  }
+
+  // a window we asked the server to limit has to be confirmed
+  if (_config.serverMaxWindowBits < kMaxWindowBits && serverWindowBits == 0) {
+    NLOG_ERROR("Websocket server ignored server_max_window_bits of permessage-deflate");
+    return false;
+  }
+
+  _clientNoContextTakeover = clientNoContextTakeover || _config.clientNoContextTakeover;
+  _serverNoContextTakeover = serverNoContextTakeover;
+  _clientWindowBits = std::min<int>(_config.clientMaxWindowBits, clientWindowBits ? clientWindowBits : kMaxWindowBits);
+  if (_clientWindowBits < kMinWindowBits) {
+    // sending uncompressed is always allowed, receiving still works
+    _clientWindowBits = 0;
+  }
+
+  if (_clientWindowBits != 0) {
+    // zlib slides its hash table along with the window, a table larger than the window makes that costly
+    int memLevel = std::min(8, _clientWindowBits - 7);
+    _deflater = std::make_unique<z_stream>();
+    if (deflateInit2(_deflater.get(), _config.level, Z_DEFLATED, -_clientWindowBits, memLevel, Z_DEFAULT_STRATEGY) !=
+        Z_OK) {
+      _deflater.reset();
+      return false;
+    }
+  }
+
+  // a full window inflates whatever window the server compresses with
+  _inflater = std::make_unique<z_stream>();
+  if (inflateInit2(_inflater.get(), -kMaxWindowBits) != Z_OK) {
+    _inflater.reset();
+    end();
+    return false;
+  }
+
+  _negotiated = true;
+  return true;
+}
+
+bool WslayDeflate::deflate(const uint8_t* data, size_t len, std::string& out) {
+  if (!_deflater || len < _config.minSize) {
+    return false;
+  }
+
+  z_stream& z = *_deflater;
+  z.next_in = const_cast<Bytef*>(data);
+  z.avail_in = uInt(len);
+
+  size_t produced = 0;
+  out.resize(deflateBound(&z, uLong(len)) + sizeof(kTail) + 8);
+
+  int ret;
+  do {
+    if (produced == out.size()) {
+      out.resize(out.size() * 2);
+    }
+    z.next_out = reinterpret_cast<Bytef*>(&out[produced]);
+    z.avail_out = uInt(out.size() - produced);
+    ret = ::deflate(&z, Z_SYNC_FLUSH);
+    produced = out.size() - z.avail_out;
+  } while (ret == Z_OK && z.avail_out == 0);
+
+  bool compressed = ret == Z_OK && z.avail_in == 0 && produced >= sizeof(kTail) &&
+                    std::memcmp(&out[produced - sizeof(kTail)], kTail, sizeof(kTail)) == 0 &&
+                    produced - sizeof(kTail) < len;
+
+  // The peer only sees the compressed messages, the window must not keep data it won't receive.
+  if (!compressed || _clientNoContextTakeover) {
+    deflateReset(&z);
+  }
+
+  if (!compressed) {
+    return false;
+  }
+
+  out.resize(produced - sizeof(kTail));
+  return true;
+}
+
+bool WslayDeflate::inflate(const uint8_t* data, size_t len, std::string& out) {
+  if (!_inflater) {
+    return false;
+  }
+
+  z_stream& z = *_inflater;
+  size_t produced = 0;
+  out.resize(std::max<size_t>(len * 4, 1024));
+
+  bool ended = false;
+
+  auto run = [&](const uint8_t* in, size_t inLen) {
+    z.next_in = const_cast<Bytef*>(in);
+    z.avail_in = uInt(inLen);
+
+    while (true) {
+      if (produced == out.size()) {
+        if (out.size() >= kMaxMessageSize) {
+          return false;
+        }
+        out.resize(std::min(out.size() * 2, kMaxMessageSize));
+      }
+
+      z.next_out = reinterpret_cast<Bytef*>(&out[produced]);
+      z.avail_out = uInt(out.size() - produced);
+      int ret = ::inflate(&z, Z_SYNC_FLUSH);
+      produced = out.size() - z.avail_out;
+
+      if (ret == Z_STREAM_END) {
+        // The sender ended its stream with a final block and starts a new one with the next message,
+        // the appended empty block belongs to neither.
+        ended = true;
+        inflateReset(&z);
+        return true;
+      }
+
+      if (ret != Z_OK && !(ret == Z_BUF_ERROR && z.avail_out == 0)) {
+        return ret == Z_BUF_ERROR && z.avail_in == 0;
+      }
+
+      if (z.avail_in == 0 && z.avail_out != 0) {
+        return true;
+      }
+    }
+  };
+
+  // after the appended empty block the inflater has to wait for the next block header, see zlib's data_type
+  bool ok = run(data, len) && (ended || (run(kTail, sizeof(kTail)) && (z.data_type & 128) != 0));
+  if (!ok || _serverNoContextTakeover) {
+    inflateReset(&z);
+  }
+
+  if (!ok) {
+    return false;
+  }
+
+  out.resize(produced);
+  return true;
+}
+
+void WslayDeflate::end() {
+  if (_deflater) {
+    deflateEnd(_deflater.get());
+    _deflater.reset();
+  }
+  if (_inflater) {
+    inflateEnd(_inflater.get());
+    _inflater.reset();
+  }
+  _negotiated = false;
+}
+
+} // namespace Nakama
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <nakama-cpp/realtime/NRtTransportInterface.h>
+
+typedef struct z_stream_s z_stream;
+
+namespace Nakama {
+
+/**
+ * RFC 7692 permessage-deflate: the extension offer, validation of the server's response and the
+ * compression streams of one connection.
+ *
+ * Streams are created once per connection and reset between messages only when a no_context_takeover
+ * parameter was negotiated. Not thread safe, NWebsocketWslay uses it from its I/O thread.
+ */
+class WslayDeflate {
+public:
+  // Inflated messages larger than this fail the connection.
+  static constexpr size_t kMaxMessageSize = 16 * 1024 * 1024;
+
+  explicit WslayDeflate(const NWebsocketDeflateConfig& config);
+  ~WslayDeflate();
+
+  WslayDeflate(const WslayDeflate&) = delete;
+  WslayDeflate& operator=(const WslayDeflate&) = delete;
+
+  // Value of the Sec-WebSocket-Extensions request header.
+  std::string offer() const;
+
+  // Applies the Sec-WebSocket-Extensions response header, empty if the server sent none.
+  // Returns false if the response doesn't answer the offer and the connection must be failed.
+  bool accept(std::string_view response);
+
+  bool isNegotiated() const { return _negotiated; }
+
+  // Compresses a message into `out`. Returns false if it should be sent uncompressed.
+  bool deflate(const uint8_t* data, size_t len, std::string& out);
+
+  // Decompresses a message received with RSV1 set. Returns false on corrupt or oversized data.
+  bool inflate(const uint8_t* data, size_t len, std::string& out);
+
+private:
+  void end();
+
+  NWebsocketDeflateConfig _config;
+  bool _negotiated = false;
+  bool _clientNoContextTakeover = false;
+  bool _serverNoContextTakeover = false;
+  // window of the compressor, 0 if the server asked for one zlib can't produce and nothing is compressed
+  int _clientWindowBits = 15;
+  std::unique_ptr<z_stream> _deflater;
+  std::unique_ptr<z_stream> _inflater;
+};
+
+} // namespace Nakama
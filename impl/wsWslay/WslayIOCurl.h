@@ -100,12 +100,23 @@ public:
         return NetIOAsyncResult::ERR;
       }
 
+      _connected = true;
       return NetIOAsyncResult::DONE;
     }
 
     return NetIOAsyncResult::AGAIN;
   }
 
+  // only once connected, while connecting curl may try several sockets
+  int getSocket() const override {
+    curl_socket_t socket = CURL_SOCKET_BAD;
+    if (!_connected || curl_easy_getinfo(_curl.get(), CURLINFO_ACTIVESOCKET, &socket) != CURLE_OK ||
+        socket == CURL_SOCKET_BAD) {
+      return -1;
+    }
+    return static_cast<int>(socket);
+  }
+
   // returns number of bytes sent or negative error code
   int send(const void* buf, size_t len, int* would_block) noexcept override {
     size_t sent;
@@ -139,6 +150,7 @@ public:
   }
 
   void close() noexcept override {
+    _connected = false;
     if (_curl) {
       curl_multi_remove_handle(_curlm.get(), _curl.get());
     }
@@ -150,6 +162,7 @@ private:
   std::unique_ptr<CURL, decltype(&curl_easy_cleanup)> _curl;
   std::unique_ptr<CURLM, decltype(&curl_multi_cleanup)> _curlm;
   std::unique_ptr<CURLU, decltype(&curl_url_cleanup)> _curl_url;
+  bool _connected = false;
 };
 
 NAKAMA_NAMESPACE_END
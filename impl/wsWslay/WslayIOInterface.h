@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nakama-cpp/URLParts.h>
+#include <nakama-cpp/realtime/NRtTransportInterface.h>
 
 namespace Nakama {
 
@@ -19,6 +20,11 @@ public:
   virtual void close() = 0;
   virtual NetIOAsyncResult connect_init(const URLParts& urlParts) = 0;
   virtual NetIOAsyncResult connect_tick() = 0;
+
+  // Returns false if the options aren't supported, they apply from the next connect_init.
+  virtual bool setSocketOptions(const NSocketOptions& /*options*/) { return false; }
+  // Connected socket to wait on for readiness, -1 if there is none or the IO doesn't expose it.
+  virtual int getSocket() const { return -1; }
 };
 
 } // namespace Nakama
@@ -0,0 +1,407 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WslayIOSocket.h"
+
+#include <cerrno>
+#include <cstring>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <openssl/err.h>
+#include <openssl/ssl.h>
+#include <openssl/x509v3.h>
+
+#include <nakama-cpp/log/NLogger.h>
+
+#if __ANDROID__
+#include "AndroidCA.h"
+#else
+#include "roots_pem.h"
+#endif
+
+namespace Nakama {
+
+namespace {
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0; // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+std::string sslError() {
+  char buf[256];
+  unsigned long err = ERR_get_error();
+  ERR_clear_error();
+  if (err == 0) {
+    return std::strerror(errno);
+  }
+  ERR_error_string_n(err, buf, sizeof(buf));
+  return buf;
+}
+
+void addPemCertificates(SSL_CTX* ctx, const void* pem, int len) {
+  BIO* bio = BIO_new_mem_buf(pem, len);
+  X509_STORE* store = SSL_CTX_get_cert_store(ctx);
+  while (X509* cert = PEM_read_bio_X509(bio, nullptr, nullptr, nullptr)) {
+    // duplicates of certificates in the system store fail, that's fine
+    X509_STORE_add_cert(store, cert);
+    X509_free(cert);
+  }
+  BIO_free(bio);
+  ERR_clear_error();
+}
+
+// Shared by all connections, so certificates are loaded once and TLS sessions can be resumed.
+// Never freed, like OpenSSL's own globals.
+SSL_CTX* sslContext() {
+  static std::mutex mutex;
+  static SSL_CTX* context = nullptr;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (context) {
+    return context;
+  }
+
+  SSL_CTX* ctx = SSL_CTX_new(TLS_client_method());
+  if (!ctx) {
+    NLOG(NLogLevel::Error, "SSL_CTX_new failed: %s", sslError().c_str());
+    return nullptr;
+  }
+
+  SSL_CTX_set_min_proto_version(ctx, TLS1_2_VERSION);
+  SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, nullptr);
+  // wslay retries with the same buffer after WANT_WRITE, but may have moved its data in between
+  SSL_CTX_set_mode(ctx, SSL_MODE_ENABLE_PARTIAL_WRITE | SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+
+#if __ANDROID__
+  CACertificateData* data = getCaCertificates();
+  if (data == nullptr) {
+    // Has System.loadLibrary("nakama-sdk") been called?
+    NLOG_ERROR("could not access CA Certificates.");
+    SSL_CTX_free(ctx);
+    return nullptr;
+  }
+  addPemCertificates(ctx, data->data, data->len);
+#else
+  SSL_CTX_set_default_verify_paths(ctx);
+  addPemCertificates(ctx, g_roots_pem, int(g_roots_pem_size));
+#endif
+
+  context = ctx;
+  return context;
+}
+
+} // namespace
+
+struct WslayIOSocket::Resolution {
+  std::mutex mutex;
+  bool done = false;
+  int error = 0;
+  addrinfo* addresses = nullptr;
+
+  ~Resolution() {
+    if (addresses) {
+      freeaddrinfo(addresses);
+    }
+  }
+};
+
+WslayIOSocket::~WslayIOSocket() { close(); }
+
+NetIOAsyncResult WslayIOSocket::connect_init(const URLParts& urlParts) {
+  close();
+
+  _host = urlParts.host;
+  _tls = urlParts.scheme == "wss";
+  _deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(_options.connectTimeoutMs);
+
+  std::string port = std::to_string(urlParts.port.value_or(_tls ? 443 : 80));
+  auto resolution = std::make_shared<Resolution>();
+
+  // getaddrinfo blocks and has no portable async variant
+  try {
+    std::thread([resolution, host = _host, port]() {
+      addrinfo hints{};
+      hints.ai_family = AF_UNSPEC;
+      hints.ai_socktype = SOCK_STREAM;
+      hints.ai_flags = AI_ADDRCONFIG;
+
+      addrinfo* addresses = nullptr;
+      int error = getaddrinfo(host.c_str(), port.c_str(), &hints, &addresses);
+
+      std::lock_guard<std::mutex> lock(resolution->mutex);
+      resolution->error = error;
+      resolution->addresses = addresses;
+      resolution->done = true;
+    }).detach();
+  } catch (const std::system_error& e) {
+    NLOG(NLogLevel::Error, "unable to start DNS resolution: %s", e.what());
+    return NetIOAsyncResult::ERR;
+  }
+
+  _resolution = std::move(resolution);
+  _state = State::Resolving;
+  return NetIOAsyncResult::DONE;
+}
+
+NetIOAsyncResult WslayIOSocket::connect_tick() {
+  if (_state != State::Connected && std::chrono::steady_clock::now() > _deadline) {
+    NLOG(NLogLevel::Error, "connecting to %s timed out", _host.c_str());
+    return NetIOAsyncResult::ERR;
+  }
+
+  switch (_state) {
+    case State::Resolving: {
+      std::lock_guard<std::mutex> lock(_resolution->mutex);
+      if (!_resolution->done) {
+        return NetIOAsyncResult::AGAIN;
+      }
+      if (_resolution->error != 0) {
+        NLOG(NLogLevel::Error, "unable to resolve %s: %s", _host.c_str(), gai_strerror(_resolution->error));
+        return NetIOAsyncResult::ERR;
+      }
+      _nextAddress = _resolution->addresses;
+      _state = State::Connecting;
+      return connectNext() ? NetIOAsyncResult::AGAIN : NetIOAsyncResult::ERR;
+    }
+
+    case State::Connecting: {
+      pollfd pfd{_fd, POLLOUT, 0};
+      int ready = poll(&pfd, 1, 0);
+      if (ready == 0) {
+        return NetIOAsyncResult::AGAIN;
+      }
+
+      int error = 0;
+      socklen_t errorLen = sizeof(error);
+      if (ready < 0 || getsockopt(_fd, SOL_SOCKET, SO_ERROR, &error, &errorLen) != 0 || error != 0) {
+        NLOG(NLogLevel::Debug, "connecting to %s failed: %s", _host.c_str(), std::strerror(error ? error : errno));
+        return connectNext() ? NetIOAsyncResult::AGAIN : NetIOAsyncResult::ERR;
+      }
+
+      _resolution.reset();
+      _nextAddress = nullptr;
+      if (!_tls) {
+        _state = State::Connected;
+        return NetIOAsyncResult::DONE;
+      }
+      return startTls();
+    }
+
+    case State::Handshaking: {
+      int ret = SSL_connect(_ssl);
+      if (ret == 1) {
+        _state = State::Connected;
+        return NetIOAsyncResult::DONE;
+      }
+
+      int err = SSL_get_error(_ssl, ret);
+      if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+        return NetIOAsyncResult::AGAIN;
+      }
+
+      long verify = SSL_get_verify_result(_ssl);
+      if (verify != X509_V_OK) {
+        NLOG(
+            NLogLevel::Error,
+            "TLS certificate of %s rejected: %s",
+            _host.c_str(),
+            X509_verify_cert_error_string(verify));
+      } else {
+        NLOG(NLogLevel::Error, "TLS handshake with %s failed: %s", _host.c_str(), sslError().c_str());
+      }
+      return NetIOAsyncResult::ERR;
+    }
+
+    case State::Connected:
+      return NetIOAsyncResult::DONE;
+
+    case State::Idle:
+      break;
+  }
+
+  return NetIOAsyncResult::ERR;
+}
+
+bool WslayIOSocket::connectNext() {
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+
+  for (; _nextAddress; _nextAddress = _nextAddress->ai_next) {
+    const addrinfo* address = _nextAddress;
+
+    _fd = socket(address->ai_family, address->ai_socktype, address->ai_protocol);
+    if (_fd < 0) {
+      continue;
+    }
+
+    int one = 1;
+    fcntl(_fd, F_SETFL, fcntl(_fd, F_GETFL, 0) | O_NONBLOCK);
+    fcntl(_fd, F_SETFD, FD_CLOEXEC);
+#ifdef SO_NOSIGPIPE
+    setsockopt(_fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    if (_options.tcpNoDelay) {
+      setsockopt(_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    }
+    // before connect, so the receive buffer is considered for the window scale of the handshake
+    if (_options.sendBufferSize > 0) {
+      setsockopt(_fd, SOL_SOCKET, SO_SNDBUF, &_options.sendBufferSize, sizeof(_options.sendBufferSize));
+    }
+    if (_options.receiveBufferSize > 0) {
+      setsockopt(_fd, SOL_SOCKET, SO_RCVBUF, &_options.receiveBufferSize, sizeof(_options.receiveBufferSize));
+    }
+
+    if (::connect(_fd, address->ai_addr, address->ai_addrlen) == 0 || errno == EINPROGRESS) {
+      _nextAddress = address->ai_next;
+      return true;
+    }
+
+    NLOG(NLogLevel::Debug, "connecting to %s failed: %s", _host.c_str(), std::strerror(errno));
+    ::close(_fd);
+    _fd = -1;
+  }
+
+  NLOG(NLogLevel::Error, "unable to connect to %s", _host.c_str());
+  return false;
+}
+
+NetIOAsyncResult WslayIOSocket::startTls() {
+  SSL_CTX* ctx = sslContext();
+  if (!ctx) {
+    return NetIOAsyncResult::ERR;
+  }
+
+  _ssl = SSL_new(ctx);
+  if (!_ssl || SSL_set_fd(_ssl, _fd) != 1) {
+    NLOG(NLogLevel::Error, "unable to set up TLS: %s", sslError().c_str());
+    return NetIOAsyncResult::ERR;
+  }
+
+  // SNI and certificate name checks are for host names, addresses are matched against IP SANs
+  X509_VERIFY_PARAM* param = SSL_get0_param(_ssl);
+  unsigned char addr[sizeof(in6_addr)];
+  if (inet_pton(AF_INET, _host.c_str(), addr) == 1 || inet_pton(AF_INET6, _host.c_str(), addr) == 1) {
+    X509_VERIFY_PARAM_set1_ip_asc(param, _host.c_str());
+  } else {
+    SSL_set_tlsext_host_name(_ssl, _host.c_str());
+    X509_VERIFY_PARAM_set_hostflags(param, X509_CHECK_FLAG_NO_PARTIAL_WILDCARDS);
+    X509_VERIFY_PARAM_set1_host(param, _host.c_str(), _host.size());
+  }
+
+  _state = State::Handshaking;
+  return connect_tick();
+}
+
+int WslayIOSocket::send(const void* data, size_t len, int* wouldBlock) {
+  *wouldBlock = 0;
+
+  if (_ssl) {
+    int ret = SSL_write(_ssl, data, int(len));
+    if (ret > 0) {
+      return ret;
+    }
+
+    int err = SSL_get_error(_ssl, ret);
+    if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+      *wouldBlock = 1;
+      return 0;
+    }
+    NLOG(NLogLevel::Error, "TLS send error: %s", sslError().c_str());
+    return -1;
+  }
+
+  ssize_t ret = ::send(_fd, data, len, kSendFlags);
+  if (ret >= 0) {
+    return int(ret);
+  }
+  if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+    *wouldBlock = 1;
+    return 0;
+  }
+  NLOG(NLogLevel::Error, "socket send error: %s", std::strerror(errno));
+  return -1;
+}
+
+int WslayIOSocket::recv(void* buf, size_t len, int* wouldBlock) {
+  *wouldBlock = 0;
+
+  if (_ssl) {
+    int ret = SSL_read(_ssl, buf, int(len));
+    if (ret > 0) {
+      return ret;
+    }
+
+    int err = SSL_get_error(_ssl, ret);
+    if (err == SSL_ERROR_WANT_READ || err == SSL_ERROR_WANT_WRITE) {
+      *wouldBlock = 1;
+      return 0;
+    }
+    if (err == SSL_ERROR_ZERO_RETURN) {
+      return 0;
+    }
+    NLOG(NLogLevel::Error, "TLS recv error: %s", sslError().c_str());
+    return -1;
+  }
+
+  ssize_t ret = ::recv(_fd, buf, len, 0);
+  if (ret >= 0) {
+    return int(ret);
+  }
+  if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+    *wouldBlock = 1;
+    return 0;
+  }
+  NLOG(NLogLevel::Error, "socket recv error: %s", std::strerror(errno));
+  return -1;
+}
+
+void WslayIOSocket::close() {
+  if (_ssl) {
+    if (_state == State::Connected) {
+      // best effort close_notify, the socket is non-blocking
+      SSL_shutdown(_ssl);
+    }
+    SSL_free(_ssl);
+    _ssl = nullptr;
+    ERR_clear_error();
+  }
+
+  if (_fd >= 0) {
+    ::close(_fd);
+    _fd = -1;
+  }
+
+  _resolution.reset();
+  _nextAddress = nullptr;
+  _state = State::Idle;
+}
+
+} // namespace Nakama
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "WslayIOInterface.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+struct addrinfo;
+struct ssl_st;
+
+namespace Nakama {
+
+/**
+ * WslayIOInterface on a non-blocking socket, with OpenSSL (or BoringSSL) for wss.
+ *
+ * DNS resolution runs on a short lived thread so connect_tick never blocks, every resolved address is
+ * tried in turn. Certificates are verified against the system store and the bundled roots, or the
+ * Android CA store. POSIX only, like the wslay transport itself.
+ */
+class WslayIOSocket : public WslayIOInterface {
+public:
+  WslayIOSocket() = default;
+  ~WslayIOSocket() override;
+
+  int recv(void* buf, size_t len, int* wouldBlock) override;
+  int send(const void* data, size_t len, int* wouldBlock) override;
+  void close() override;
+  NetIOAsyncResult connect_init(const URLParts& urlParts) override;
+  NetIOAsyncResult connect_tick() override;
+
+  bool setSocketOptions(const NSocketOptions& options) override {
+    _options = options;
+    return true;
+  }
+  int getSocket() const override { return _state == State::Connected ? _fd : -1; }
+
+private:
+  enum class State { Idle, Resolving, Connecting, Handshaking, Connected };
+  struct Resolution;
+
+  // Starts a connection to the next resolved address. Returns false when there is none left.
+  bool connectNext();
+  NetIOAsyncResult startTls();
+
+  NSocketOptions _options;
+  State _state = State::Idle;
+  std::string _host;
+  bool _tls = false;
+  std::chrono::steady_clock::time_point _deadline;
+
+  // shared with the resolver thread, which may still run after close
+  std::shared_ptr<Resolution> _resolution;
+  const addrinfo* _nextAddress = nullptr;
+
+  int _fd = -1;
+  ssl_st* _ssl = nullptr;
+};
+
+} // namespace Nakama
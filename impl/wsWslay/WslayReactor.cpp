@@ -0,0 +1,354 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "WslayReactor.h"
+#include "NWebsocketWslay.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include <nakama-cpp/log/NLogger.h>
+
+#if defined(__linux__)
+#define WSLAY_REACTOR_EPOLL
+#include <cerrno>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+namespace Nakama {
+
+// Cadence of connections without a socket to wait on, the sleep of a connection's own I/O thread.
+static constexpr std::chrono::milliseconds kPollInterval{10};
+// Passes a busy connection gets in a row before the other connections have their turn.
+static constexpr int kMaxPasses = 16;
+#ifdef WSLAY_REACTOR_EPOLL
+static constexpr int kMaxEvents = 256;
+
+static uint32_t epollEvents(bool out) { return out ? uint32_t(EPOLLIN | EPOLLOUT) : uint32_t(EPOLLIN); }
+#endif
+
+struct WslayReactor::Loop {
+  struct Entry {
+    int fd = -1;          // socket waited on
+    bool out = false;     // waiting for it to become writable too
+    bool pending = false; // in `pending`
+  };
+
+  std::mutex mutex;
+  std::condition_variable serviced; // a pass ended, detach waits for it
+  std::unordered_map<NWebsocketWslay*, Entry> entries;
+  std::vector<NWebsocketWslay*> pending;
+  size_t unwatched = 0; // entries without a socket, they are polled
+  NWebsocketWslay* servicing = nullptr;
+  bool stopping = false;
+
+  std::atomic<uint64_t> wakeups{0};
+  std::atomic<uint64_t> services{0};
+
+#ifdef WSLAY_REACTOR_EPOLL
+  int epoll = -1;
+  int event = -1; // eventfd interrupting epoll_wait
+  bool signaled = false;
+#else
+  std::condition_variable wakeup;
+#endif
+
+  std::thread thread;
+
+  // The functions below are called with `mutex` held.
+
+  // Returns false if the connection is going to be serviced anyway.
+  bool mark(NWebsocketWslay* ws, Entry& entry) {
+    if (entry.pending) {
+      return false;
+    }
+    entry.pending = true;
+    pending.push_back(ws);
+    return true;
+  }
+
+  void signal() {
+#ifdef WSLAY_REACTOR_EPOLL
+    if (!signaled) {
+      signaled = true;
+      uint64_t one = 1;
+      [[maybe_unused]] ssize_t n = ::write(event, &one, sizeof(one));
+    }
+#else
+    wakeup.notify_one();
+#endif
+  }
+
+  // Waits on the connection's socket once there is one, for writability while wslay has data for it.
+  void watch([[maybe_unused]] NWebsocketWslay* ws, [[maybe_unused]] Entry& entry) {
+#ifdef WSLAY_REACTOR_EPOLL
+    bool out = ws->wantsWrite();
+    if (entry.fd >= 0) {
+      if (out != entry.out) {
+        epoll_event ev{};
+        ev.events = epollEvents(out);
+        ev.data.ptr = ws;
+        epoll_ctl(epoll, EPOLL_CTL_MOD, entry.fd, &ev);
+        entry.out = out;
+      }
+      return;
+    }
+
+    int fd = ws->socket();
+    if (fd < 0) {
+      return;
+    }
+    epoll_event ev{};
+    ev.events = epollEvents(out);
+    ev.data.ptr = ws;
+    if (epoll_ctl(epoll, EPOLL_CTL_ADD, fd, &ev) != 0) {
+      NLOG(NLogLevel::Error, "[wslay] unable to wait on socket, polling it: %s", std::strerror(errno));
+      return;
+    }
+    entry.fd = fd;
+    entry.out = out;
+    unwatched--;
+#endif
+  }
+
+  void unwatch([[maybe_unused]] Entry& entry) {
+#ifdef WSLAY_REACTOR_EPOLL
+    if (entry.fd >= 0) {
+      epoll_ctl(epoll, EPOLL_CTL_DEL, entry.fd, nullptr);
+      entry.fd = -1;
+      entry.out = false;
+      unwatched++;
+    }
+#endif
+  }
+
+  void erase(std::unordered_map<NWebsocketWslay*, Entry>::iterator it) {
+    unwatch(it->second);
+    unwatched--;
+    entries.erase(it);
+  }
+};
+
+WslayReactor::WslayReactor(const NRtReactorConfig& config) {
+  size_t threads = std::max<size_t>(config.threads, 1);
+  for (size_t i = 0; i < threads; i++) {
+    auto loop = std::make_unique<Loop>();
+#ifdef WSLAY_REACTOR_EPOLL
+    loop->epoll = epoll_create1(EPOLL_CLOEXEC);
+    loop->event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.ptr = nullptr;
+    if (loop->epoll < 0 || loop->event < 0 || epoll_ctl(loop->epoll, EPOLL_CTL_ADD, loop->event, &ev) != 0) {
+      NLOG(NLogLevel::Error, "[wslay] unable to create event loop: %s", std::strerror(errno));
+    }
+#endif
+    _loops.push_back(std::move(loop));
+  }
+
+  for (auto& loop : _loops) {
+    loop->thread = std::thread(&WslayReactor::run, this, std::ref(*loop));
+  }
+}
+
+WslayReactor::~WslayReactor() {
+  for (auto& loop : _loops) {
+    std::lock_guard<std::mutex> lock(loop->mutex);
+    loop->stopping = true;
+    loop->signal();
+  }
+
+  for (auto& loop : _loops) {
+    loop->thread.join();
+#ifdef WSLAY_REACTOR_EPOLL
+    ::close(loop->event);
+    ::close(loop->epoll);
+#endif
+  }
+}
+
+NRtReactorStats WslayReactor::getStats() const {
+  NRtReactorStats stats;
+  stats.threads = _loops.size();
+  for (auto& loop : _loops) {
+    {
+      std::lock_guard<std::mutex> lock(loop->mutex);
+      stats.transports += loop->entries.size();
+    }
+    stats.wakeups += loop->wakeups.load(std::memory_order_relaxed);
+    stats.services += loop->services.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+size_t WslayReactor::attach(NWebsocketWslay* ws) {
+  size_t index = _next.fetch_add(1, std::memory_order_relaxed) % _loops.size();
+  Loop& loop = *_loops[index];
+
+  std::lock_guard<std::mutex> lock(loop.mutex);
+  auto& entry = loop.entries[ws];
+  loop.unwatched++;
+  loop.mark(ws, entry);
+  loop.signal();
+  return index;
+}
+
+void WslayReactor::detach(NWebsocketWslay* ws, size_t index) {
+  Loop& loop = *_loops[index];
+  assert(std::this_thread::get_id() != loop.thread.get_id());
+
+  std::unique_lock<std::mutex> lock(loop.mutex);
+  loop.serviced.wait(lock, [&]() { return loop.servicing != ws; });
+  auto it = loop.entries.find(ws);
+  if (it != loop.entries.end()) {
+    loop.erase(it);
+  }
+}
+
+void WslayReactor::wake(NWebsocketWslay* ws, size_t index) {
+  Loop& loop = *_loops[index];
+
+  std::lock_guard<std::mutex> lock(loop.mutex);
+  auto it = loop.entries.find(ws);
+  if (it != loop.entries.end() && loop.mark(ws, it->second)) {
+    loop.signal();
+  }
+}
+
+void WslayReactor::unwatch(NWebsocketWslay* ws, size_t index) {
+  Loop& loop = *_loops[index];
+
+  std::lock_guard<std::mutex> lock(loop.mutex);
+  auto it = loop.entries.find(ws);
+  if (it != loop.entries.end()) {
+    loop.unwatch(it->second);
+  }
+}
+
+void WslayReactor::run(Loop& loop) {
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point nextPoll = Clock::now();
+  std::vector<NWebsocketWslay*> ready;
+#ifdef WSLAY_REACTOR_EPOLL
+  epoll_event events[kMaxEvents];
+#endif
+
+  std::unique_lock<std::mutex> lock(loop.mutex);
+  while (!loop.stopping) {
+    // wait for sockets, sends or the next poll of the connections without a socket
+#ifdef WSLAY_REACTOR_EPOLL
+    int timeout = -1;
+    if (!loop.pending.empty()) {
+      timeout = 0;
+    } else if (loop.unwatched > 0) {
+      auto wait = std::chrono::ceil<std::chrono::milliseconds>(nextPoll - Clock::now());
+      timeout = static_cast<int>(std::max<int64_t>(wait.count(), 0));
+    }
+
+    lock.unlock();
+    int n = epoll_wait(loop.epoll, events, kMaxEvents, timeout);
+    lock.lock();
+
+    for (int i = 0; i < n; i++) {
+      auto ws = static_cast<NWebsocketWslay*>(events[i].data.ptr);
+      if (ws == nullptr) {
+        uint64_t count;
+        [[maybe_unused]] ssize_t r = ::read(loop.event, &count, sizeof(count));
+        loop.signaled = false;
+        continue;
+      }
+      // the connection may have been detached since epoll_wait returned
+      auto it = loop.entries.find(ws);
+      if (it != loop.entries.end()) {
+        loop.mark(ws, it->second);
+      }
+    }
+#else
+    auto woken = [&]() { return loop.stopping || !loop.pending.empty(); };
+    if (loop.unwatched > 0) {
+      loop.wakeup.wait_until(lock, nextPoll, woken);
+    } else {
+      loop.wakeup.wait(lock, woken);
+    }
+#endif
+    loop.wakeups.fetch_add(1, std::memory_order_relaxed);
+
+    Clock::time_point now = Clock::now();
+    if (loop.unwatched > 0 && now >= nextPoll) {
+      for (auto& [ws, entry] : loop.entries) {
+        if (entry.fd < 0) {
+          loop.mark(ws, entry);
+        }
+      }
+      nextPoll = now + kPollInterval;
+    }
+
+    ready.clear();
+    for (NWebsocketWslay* ws : loop.pending) {
+      auto it = loop.entries.find(ws);
+      if (it != loop.entries.end() && it->second.pending) {
+        it->second.pending = false;
+        ready.push_back(ws);
+      }
+    }
+    loop.pending.clear();
+
+    for (NWebsocketWslay* ws : ready) {
+      if (loop.stopping) {
+        break;
+      }
+      if (loop.entries.count(ws) == 0) {
+        continue; // detached by a previous pass' callbacks or the application
+      }
+
+      // the pass runs unlocked so sends and the pass' own unwatch() don't wait, detach() waits for it instead
+      loop.servicing = ws;
+      lock.unlock();
+      NWebsocketWslay::IOStep step;
+      int passes = 0;
+      do {
+        step = ws->service();
+      } while (step == NWebsocketWslay::IOStep::Again && ++passes < kMaxPasses);
+      loop.services.fetch_add(1, std::memory_order_relaxed);
+      lock.lock();
+      loop.servicing = nullptr;
+      loop.serviced.notify_all();
+
+      auto it = loop.entries.find(ws);
+      if (it == loop.entries.end()) {
+        continue;
+      }
+      if (step == NWebsocketWslay::IOStep::Closed) {
+        loop.erase(it);
+        continue;
+      }
+      if (step == NWebsocketWslay::IOStep::Again) {
+        loop.mark(ws, it->second);
+      }
+      loop.watch(ws, it->second);
+    }
+  }
+}
+
+} // namespace Nakama
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <nakama-cpp/realtime/NRtReactor.h>
+
+namespace Nakama {
+
+class NWebsocketWslay;
+
+/**
+ * Services the I/O of many NWebsocketWslay connections on a few threads.
+ *
+ * A connection is serviced when its socket is readable, or writable while wslay has data the socket didn't take,
+ * when a message is sent, and every 10ms while there is no socket to wait on: during the TCP and TLS handshake,
+ * with an I/O which doesn't expose its socket, or on platforms without epoll, where all connections are polled.
+ */
+class WslayReactor : public NRtReactorInterface {
+public:
+  explicit WslayReactor(const NRtReactorConfig& config);
+  ~WslayReactor() override;
+
+  WslayReactor(const WslayReactor&) = delete;
+  WslayReactor& operator=(const WslayReactor&) = delete;
+
+  // compared by address, so that only reactors of this class match
+  static constexpr char kTransportName[] = "wslay";
+
+  NRtReactorStats getStats() const override;
+  const char* getTransportName() const override { return kTransportName; }
+
+  // Starts servicing a connection which is connecting. Returns the loop to pass to the other calls.
+  size_t attach(NWebsocketWslay* ws);
+
+  // Stops servicing, waiting for a pass in progress. Must not be called by a reactor thread.
+  void detach(NWebsocketWslay* ws, size_t loop);
+
+  // Services the connection soon, e.g. because a message was sent.
+  void wake(NWebsocketWslay* ws, size_t loop);
+
+  // Stops waiting on the socket, called by the connection's pass before it closes the socket.
+  void unwatch(NWebsocketWslay* ws, size_t loop);
+
+private:
+  struct Loop;
+
+  void run(Loop& loop);
+
+  std::vector<std::unique_ptr<Loop>> _loops;
+  std::atomic<size_t> _next{0};
+};
+
+} // namespace Nakama
@@ -40,11 +40,12 @@ NTest::NTest(std::string name, bool threadedTick)
   _isDone.store(false);
 }
 
-NTest::NTest(std::string name, Nakama::NClientParameters parameters)
-    : _name(name), _threadedTick(false), client(NTest::ClientFactory(parameters)),
+NTest::NTest(std::string name, Nakama::NClientParameters parameters, bool threadedTick)
+    : _name(name), _threadedTick(threadedTick), _rtTickPaused(false), client(NTest::ClientFactory(parameters)),
       rtClient(NTest::RtClientFactory(client)) {
   client->setErrorCallback([this](const NError& error) { stopTest(error); });
   rtClient->setListener(&listener);
+  _isDone.store(false);
 }
 
 NTest::NTest(const char* name, bool threadedTick) : NTest(std::string(name), threadedTick) {}
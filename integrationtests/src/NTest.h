@@ -39,7 +39,7 @@ public:
   static std::string ServerHttpKey;
   NTest(const char* name, bool threadedTick = false);
   NTest(std::string name, bool threadedTick = false);
-  NTest(std::string name, Nakama::NClientParameters parameters);
+  NTest(std::string name, Nakama::NClientParameters parameters, bool threadedTick = false);
   ~NTest();
 
   virtual void runTest();
@@ -50,6 +50,12 @@ void test_stress();
 void test_realtime();
 void test_throughput();
 void test_cancellation();
+void test_executor();
+void test_tickBudget();
+void test_metrics();
+void test_tracing();
+void test_paginator();
+void test_mockServer();
 
 static void runSuiteSafely(const char* suiteName, void (*suite)()) {
   try {
@@ -128,6 +134,12 @@ int runAllTests(
   startSuite("test_realtime", test_realtime);
   startSuite("test_throughput", test_throughput);
   startSuite("test_cancellation", test_cancellation);
+  startSuite("test_executor", test_executor);
+  startSuite("test_tickBudget", test_tickBudget);
+  startSuite("test_metrics", test_metrics);
+  startSuite("test_tracing", test_tracing);
+  startSuite("test_paginator", test_paginator);
+  startSuite("test_mockServer", test_mockServer);
 
 #ifndef ANDROID
   for (auto& t : threads) {
@@ -17,6 +17,7 @@
 #include "NTest.h"
 #include "TestGuid.h"
 #include "nakama-cpp/log/NLogger.h"
+#include <thread>
 
 namespace Nakama {
 namespace Test {
@@ -55,5 +56,36 @@ void test_rt_joinGroupChat() {
   const NChannelPtr channelPtr = test.rtClient->joinChatAsync(group.id, NChannelType::GROUP, {}, {}).get();
   test.stopTest(true);
 }
+
+void test_rt_rtt() {
+  bool threadedTick = true;
+  NTest test(__func__, threadedTick);
+  test.runTest();
+
+  NSessionPtr session = test.client->authenticateCustomAsync(TestGuid::newGuid(), std::string(), true).get();
+  bool createStatus = false;
+  test.rtClient->connectAsync(session, createStatus, NTest::RtProtocol).get();
+
+  NRttConfig config;
+  config.mode = NRttProbeMode::Ping;
+  config.probeInterval = std::chrono::milliseconds(100);
+  test.rtClient->setRttConfig(config);
+
+  // the ack carries the server's create_time, which gives a clock sample
+  const NChannelPtr channel = test.rtClient->joinChatAsync("chat", NChannelType::ROOM, {}, {}).get();
+  test.rtClient->writeChatMessageAsync(channel->id, "{\"msg\":\"what time is it?\"}").get();
+  std::this_thread::sleep_for(std::chrono::seconds(1));
+
+  const NRttStats stats = test.rtClient->getRttStats();
+  NLOG(
+      NLogLevel::Info,
+      "rtt: %d samples, srtt %lld us, offset %lld +- %lld us",
+      int(stats.samples),
+      (long long)stats.smoothedRtt.count(),
+      (long long)stats.clockOffset.count(),
+      (long long)stats.clockOffsetError.count());
+
+  test.stopTest(stats.samples > 1 && stats.smoothedRtt.count() > 0 && stats.clockOffsetValid);
+}
 } // namespace Test
 } // namespace Nakama
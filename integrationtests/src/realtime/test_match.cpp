@@ -17,6 +17,7 @@
 #include "NTest.h"
 #include "TestGuid.h"
 #include "nakama-cpp/log/NLogger.h"
+#include <future>
 
 namespace Nakama {
 namespace Test {
@@ -108,9 +109,150 @@ void test_rt_matchmaker() {
   test2.stopTest(true);
 }
 
+void test_rt_match_presence_store() {
+  bool threadedTick = true;
+  NTest test1(__func__, threadedTick);
+  NTest test2(std::string(__func__) + std::string("2"), threadedTick);
+
+  test1.runTest();
+  test2.runTest();
+
+  NSessionPtr session = test1.client->authenticateCustomAsync(TestGuid::newGuid(), std::string(), true).get();
+  NSessionPtr session2 = test2.client->authenticateCustomAsync(TestGuid::newGuid(), std::string(), true).get();
+  test1.rtClient->setPresenceTracking(true);
+  test1.rtClient->connectAsync(session, false, NTest::RtProtocol).get();
+  test2.rtClient->connectAsync(session2, false, NTest::RtProtocol).get();
+
+  NPresenceStorePtr store = test1.rtClient->getPresenceStore();
+  NMatch match = test1.rtClient->createMatchAsync().get();
+  bool ok = store->getPresenceCount(NPresenceStreamType::Match, match.matchId) == 1;
+
+  // listener runs on the tick thread, diffs are handed over one at a time
+  auto joined = std::make_shared<std::promise<NPresenceDiff>>();
+  auto left = std::make_shared<std::promise<NPresenceDiff>>();
+  auto diffs = std::make_shared<int>(0);
+  store->subscribe(NPresenceStreamType::Match, match.matchId, [joined, left, diffs](const NPresenceDiff& diff) {
+    int n = (*diffs)++;
+    if (n == 0) {
+      joined->set_value(diff);
+    } else if (n == 1) {
+      left->set_value(diff);
+    }
+  });
+
+  NMatch match2 = test2.rtClient->joinMatchAsync(match.matchId, {}).get();
+  NPresenceDiff joinDiff = joined->get_future().get();
+  ok = ok && joinDiff.joins.size() == 1 && joinDiff.joins[0].sessionId == match2.self.sessionId;
+  ok = ok && store->hasUser(NPresenceStreamType::Match, match.matchId, session2->getUserId());
+  uint64_t version = store->getVersion(NPresenceStreamType::Match, match.matchId);
+
+  test2.rtClient->leaveMatchAsync(match.matchId).get();
+  NPresenceDiff leaveDiff = left->get_future().get();
+  ok = ok && leaveDiff.version > version && leaveDiff.leaves.size() == 1 &&
+       leaveDiff.leaves[0].userId == session2->getUserId();
+  ok = ok && store->getPresenceCount(NPresenceStreamType::Match, match.matchId) == 1;
+
+  test1.rtClient->leaveMatchAsync(match.matchId).get();
+  ok = ok && store->getStreamIds(NPresenceStreamType::Match).empty();
+
+  NPresenceStoreStats stats = store->getStats();
+  NLOG(NLogLevel::Info, "presence store: %u strings, %u bytes", stats.internedStrings, stats.internedBytes);
+
+  test1.stopTest(ok);
+  test2.stopTest(ok);
+}
+
+void test_rt_match_data_interned() {
+  bool threadedTick = true;
+  NTest test1(__func__, threadedTick);
+  NTest test2(std::string(__func__) + std::string("2"), threadedTick);
+
+  test1.runTest();
+  test2.runTest();
+
+  NSessionPtr session = test1.client->authenticateCustomAsync(TestGuid::newGuid(), std::string(), true).get();
+  NSessionPtr session2 = test2.client->authenticateCustomAsync(TestGuid::newGuid(), std::string(), true).get();
+  test2.rtClient->setStringInterning(true);
+  test1.rtClient->connectAsync(session, false, NTest::RtProtocol).get();
+  test2.rtClient->connectAsync(session2, false, NTest::RtProtocol).get();
+
+  auto received = std::make_shared<std::promise<NMatchData>>();
+  auto count = std::make_shared<int>(0);
+  test2.listener.setMatchDataCallback([received, count](const NMatchData& data) {
+    if ((*count)++ == 0) {
+      received->set_value(data);
+    }
+  });
+
+  NMatch match = test1.rtClient->createMatchAsync().get();
+  test2.rtClient->joinMatchAsync(match.matchId, {}).get();
+  test1.rtClient->sendMatchDataAsync(match.matchId, 1, "payload").get();
+
+  NMatchData data = received->get_future().get();
+  bool ok = data.matchId.empty() && data.getMatchId() == match.matchId;
+  ok = ok && data.presence.userId.empty() && data.presence.getUserId() == session->getUserId();
+  ok = ok && data.presence.userIdHandle == NInternedString(session->getUserId());
+
+  test1.stopTest(ok);
+  test2.stopTest(ok);
+}
+
+void test_rt_match_send_queue() {
+  bool threadedTick = true;
+  NTest test1(__func__, threadedTick);
+  NTest test2(std::string(__func__) + std::string("2"), threadedTick);
+
+  test1.runTest();
+  test2.runTest();
+
+  NSendQueueConfig config;
+  config.highWatermarkMessages = 8;
+  config.overflowPolicy = NSendOverflowPolicy::DropOldest;
+  config.droppableOpCodes = {1};
+  if (!test1.rtClient->setSendQueueConfig(config)) {
+    NLOG_INFO("transport doesn't support a bounded send queue, skipping");
+    test1.stopTest(true);
+    test2.stopTest(true);
+    return;
+  }
+
+  NSessionPtr session = test1.client->authenticateCustomAsync(TestGuid::newGuid(), std::string(), true).get();
+  NSessionPtr session2 = test2.client->authenticateCustomAsync(TestGuid::newGuid(), std::string(), true).get();
+  test1.rtClient->connectAsync(session, false, NTest::RtProtocol).get();
+  test2.rtClient->connectAsync(session2, false, NTest::RtProtocol).get();
+
+  constexpr int kMessages = 200;
+  auto last = std::make_shared<std::promise<void>>();
+  test2.listener.setMatchDataCallback([last](const NMatchData& data) {
+    if (data.data == std::to_string(kMessages - 1)) {
+      last->set_value();
+    }
+  });
+
+  NMatch match = test1.rtClient->createMatchAsync().get();
+  test2.rtClient->joinMatchAsync(match.matchId, {}).get();
+
+  // much faster than the transport writes, older state is superseded or dropped but the newest always goes out
+  for (int i = 0; i < kMessages; ++i) {
+    test1.rtClient->sendMatchData(match.matchId, 1, std::to_string(i));
+  }
+
+  bool ok = last->get_future().wait_for(std::chrono::seconds(10)) == std::future_status::ready;
+  NSendQueueStats stats = test1.rtClient->getSendQueueStats();
+  NLOG(NLogLevel::Info, "send queue superseded %d and dropped %d of %d messages", int(stats.latest.supersededMessages),
+      int(stats.droppedMessages), kMessages);
+  ok = ok && stats.rejectedMessages == 0 && test1.rtClient->isConnected();
+
+  test1.stopTest(ok);
+  test2.stopTest(ok);
+}
+
 void test_rt_match() {
   test_rt_create_match();
   test_rt_matchmaker();
+  test_rt_match_presence_store();
+  test_rt_match_data_interned();
+  test_rt_match_send_queue();
 }
 
 } // namespace Test
@@ -31,6 +31,7 @@ void test_rpc();
 void test_rt_party();
 void test_rt_joinChat();
 void test_rt_joinGroupChat();
+void test_rt_rtt();
 void test_rt_quickdestroy();
 void test_rt_rapiddisconnect();
 void test_rt_reconnect();
@@ -44,6 +45,7 @@ void test_connectivity_loss();
 void run_realtime_tests() {
   test_rt_joinChat();
   test_rt_joinGroupChat();
+  test_rt_rtt();
   test_rt_match();
   test_notifications();
   test_authoritative_match();
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2026 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NTest.h"
+#include "TestGuid.h"
+#include <nakama-cpp/NExecutor.h>
+#include <nakama-cpp/log/NLogger.h>
+
+#include <thread>
+
+namespace Nakama {
+namespace Test {
+
+using namespace std;
+
+// I/O thread running, no executor: tick() only executes callbacks, in the ticking thread
+void test_executor_tickQueue() {
+  NTest test(__func__);
+  test.client->startIoThread();
+
+  auto callerThreadId = this_thread::get_id();
+
+  auto successCallback = [&test, callerThreadId](NSessionPtr session) {
+    test.addSession(session);
+    test.stopTest(this_thread::get_id() == callerThreadId);
+  };
+
+  test.client->authenticateCustom(TestGuid::newGuid(), "", true, {}, successCallback);
+
+  test.runTest();
+  test.client->stopIoThread();
+}
+
+// I/O thread running, user executor: client is never ticked, callbacks arrive via executor
+void test_executor_userExecutor() {
+  NTest test(__func__);
+  auto executor = make_shared<NQueueExecutor>();
+  test.client->startIoThread(executor);
+
+  auto callerThreadId = this_thread::get_id();
+
+  auto successCallback = [&test, callerThreadId](NSessionPtr session) {
+    test.addSession(session);
+    test.stopTest(this_thread::get_id() == callerThreadId);
+  };
+
+  test.client->authenticateCustom(TestGuid::newGuid(), "", true, {}, successCallback);
+
+  for (int waitedMs = 0; !test.isDone() && waitedMs < 10000; waitedMs += 5) {
+    executor->run();
+    this_thread::sleep_for(chrono::milliseconds(5));
+  }
+
+  if (!test.isDone()) {
+    NLOG_ERROR("No callback received through executor");
+    test.stopTest(false);
+  }
+
+  // go back to ticking so NTest can clean up sessions
+  test.client->stopIoThread();
+  test.runTest();
+}
+
+void test_executor() {
+  test_executor_tickQueue();
+  test_executor_userExecutor();
+}
+
+} // namespace Test
+} // namespace Nakama
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2026 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NTest.h"
+#include "TestGuid.h"
+#include <nakama-cpp/log/NLogger.h>
+#include <nakama-cpp/realtime/NRtTransportInterface.h>
+
+namespace Nakama {
+namespace Test {
+
+using namespace std;
+
+void test_metrics_rest() {
+  NTest test(__func__);
+
+  auto successCallback = [&test](NSessionPtr session) {
+    test.addSession(session);
+
+    NClientMetrics metrics = test.client->getMetrics();
+    auto it = metrics.endpoints.find("POST /v2/account/authenticate/custom");
+
+    if (it == metrics.endpoints.end()) {
+      NLOG_ERROR("authenticate endpoint not found in metrics");
+      test.stopTest(false);
+      return;
+    }
+
+    const NEndpointMetrics& endpoint = it->second;
+    NLOG_INFO(
+        "requests=" + to_string(endpoint.requests) + " networkP50Us=" + to_string(endpoint.network.percentileUs(50)) +
+        " bytesReceived=" + to_string(endpoint.bytesReceived));
+
+    test.stopTest(
+        endpoint.requests == 1 && endpoint.errors == 0 && endpoint.network.count == 1 && endpoint.decode.count == 1 &&
+        endpoint.bytesReceived > 0);
+  };
+
+  test.client->authenticateCustom(TestGuid::newGuid(), "", true, {}, successCallback);
+
+  test.runTest();
+}
+
+void test_metrics_restError() {
+  NTest test(__func__);
+
+  auto errorCallback = [&test](const NError& error) {
+    NClientMetrics metrics = test.client->getMetrics();
+    auto it = metrics.endpoints.find("POST /v2/account/authenticate/device");
+    bool recorded = it != metrics.endpoints.end() && it->second.errors == 1 &&
+                    it->second.errorsByCode[ErrorCode::InvalidArgument] == 1;
+
+    test.client->resetMetrics();
+    bool reset = test.client->getMetrics().requests == 0;
+
+    test.stopTest(error.code == ErrorCode::InvalidArgument && recorded && reset);
+  };
+
+  test.client->authenticateDevice("", std::nullopt, false, {}, nullptr, errorCallback);
+
+  test.runTest();
+}
+
+// Connects on the next tick and never writes, its send queue holds highWatermarkMessages messages.
+class StalledTransport : public NRtTransportInterface {
+public:
+  void setActivityTimeout(uint32_t) override {}
+  uint32_t getActivityTimeout() const override { return 0; }
+  void tick() override {
+    if (_connecting) {
+      _connecting = false;
+      fireOnConnected();
+    }
+  }
+  void connect(const std::string&, NRtTransportType) override { _connecting = true; }
+  bool isConnecting() const override { return _connecting; }
+  void disconnect() override {
+    _connecting = false;
+    _connected = false;
+  }
+  bool send(const NBytes& data) override {
+    return trySend(data, std::nullopt, NSendPriority::Control) == NSendResult::Queued;
+  }
+
+  NSendResult trySend(const NBytes&, const std::optional<NSendDropKey>&, NSendPriority) override {
+    if (!_connected) {
+      return NSendResult::Failed;
+    }
+    if (_queued >= _capacity) {
+      return NSendResult::Rejected;
+    }
+    ++_queued;
+    return NSendResult::Queued;
+  }
+
+  bool setSendQueueConfig(const NSendQueueConfig& config) override {
+    _capacity = config.highWatermarkMessages;
+    return true;
+  }
+
+private:
+  bool _connecting = false;
+  size_t _capacity = 0;
+  size_t _queued = 0;
+};
+
+// Sends rejected by a full send queue are counted under their own error code.
+void test_metrics_rtSendQueueFull() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  auto transport = make_shared<StalledTransport>();
+  NRtClientPtr rtClient = test.client->createRtClient(transport);
+  // fake token with exp in 2100, good enough to open a connection to StalledTransport
+  auto session = restoreSession("e30.eyJleHAiOjQxMDI0NDQ4MDAsInVpZCI6ImJlbmNoIiwidXNuIjoiYmVuY2gifQ.sig", "");
+  rtClient->connect(session, false, NRtClientProtocol::Json);
+  rtClient->tick();
+
+  NSendQueueConfig config;
+  config.highWatermarkMessages = 2;
+  rtClient->setSendQueueConfig(config);
+  for (int i = 0; i < 5; i++) {
+    rtClient->sendMatchData("match", 1, "state");
+  }
+
+  NRtClientMetrics metrics = rtClient->getMetrics();
+  bool connected = rtClient->isConnected();
+  rtClient->disconnect();
+  test.stopTest(
+      connected && metrics.errorsByCode[RtErrorCode::SEND_QUEUE_FULL] == 3 &&
+      metrics.errorsByCode.count(RtErrorCode::UNKNOWN) == 0);
+}
+
+void test_metrics() {
+  test_metrics_rest();
+  test_metrics_restError();
+  test_metrics_rtSendQueueFull();
+}
+
+} // namespace Test
+} // namespace Nakama
@@ -0,0 +1,577 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NTest.h"
+#include "TestGuid.h"
+#include "nakama-cpp/log/NLogger.h"
+
+#include <nakama-cpp/NException.h>
+#include <nakama-cpp/realtime/NRtTrafficLog.h>
+#include <nakama-cpp/realtime/NWebsocketsFactory.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef WITH_MOCK_SERVER
+#include "MockServer.h"
+#endif
+
+namespace Nakama {
+namespace Test {
+
+using namespace std;
+
+#ifdef WITH_MOCK_SERVER
+
+static NClientParameters mockParameters(const MockServer& server) {
+  NClientParameters parameters = NTest::NClientParameters;
+  parameters.host = "127.0.0.1";
+  parameters.port = server.port();
+  parameters.ssl = false;
+  return parameters;
+}
+
+void test_mockServer_rest(MockServer& server) {
+  NTest test(__func__, mockParameters(server), true);
+  test.runTest();
+
+  try {
+    std::string customId = TestGuid::newGuid();
+    auto session = test.client->authenticateCustomAsync(customId, "", true).get();
+    auto again = test.client->authenticateCustomAsync(customId, "", false).get();
+    auto account = test.client->getAccountAsync(session).get();
+    auto rpc = test.client->rpcAsync(session, "echo", "{\"n\":1}").get();
+
+    server.setHttpResponse("POST", "/v2/rpc/canned", 200, "{\"id\":\"canned\",\"payload\":\"from the mock\"}");
+    auto canned = test.client->rpcAsync(session, "canned", "{}").get();
+    server.clearCannedResponses();
+
+    NStorageObjectWrite write;
+    write.collection = "saves";
+    write.key = "slot-1";
+    write.value = "{\"level\":3}";
+    auto acks = test.client->writeStorageObjectsAsync(session, {write}).get();
+    // objects which don't exist are left out
+    std::vector<NReadStorageObjectId> ids = {
+        {"saves", "slot-1", session->getUserId()}, {"saves", "missing", session->getUserId()}};
+    auto objects = test.client->readStorageObjectsAsync(session, ids).get();
+
+    test.stopTest(
+        session->isCreated() && !again->isCreated() && again->getUserId() == session->getUserId() &&
+        account.user.id == session->getUserId() && rpc.payload == "{\"n\":1}" && canned.payload == "from the mock" &&
+        acks.size() == 1 && objects.size() == 1 && objects[0].value == write.value &&
+        objects[0].version == acks[0].version);
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+    test.stopTest(false);
+  }
+}
+
+void test_mockServer_match(MockServer& server, NRtClientProtocol protocol) {
+  const bool threadedTick = true;
+  NTest test1(std::string(__func__) + (protocol == NRtClientProtocol::Json ? "_json" : "_protobuf"),
+      mockParameters(server), threadedTick);
+  NTest test2(std::string(__func__) + (protocol == NRtClientProtocol::Json ? "_json2" : "_protobuf2"),
+      mockParameters(server), threadedTick);
+
+  test1.runTest();
+  test2.runTest();
+
+  try {
+    auto session1 = test1.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    auto session2 = test2.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    test1.rtClient->connectAsync(session1, false, protocol).get();
+    test2.rtClient->connectAsync(session2, false, protocol).get();
+
+    auto received = std::make_shared<std::promise<NMatchData>>();
+    test2.listener.setMatchDataCallback([received](const NMatchData& data) {
+      try {
+        received->set_value(data);
+      } catch (const std::future_error&) {
+      }
+    });
+
+    NMatch match = test1.rtClient->createMatchAsync().get();
+    NMatch joined = test2.rtClient->joinMatchAsync(match.matchId, {}).get();
+
+    test1.rtClient->sendMatchData(match.matchId, 7, "state");
+
+    auto future = received->get_future();
+    bool ok = joined.matchId == match.matchId && joined.presences.size() == 1 &&
+              future.wait_for(std::chrono::seconds(5)) == std::future_status::ready;
+    if (ok) {
+      NMatchData data = future.get();
+      ok = data.opCode == 7 && data.data == "state" && data.presence.userId == session1->getUserId();
+    }
+
+    test1.stopTest(ok);
+    test2.stopTest(ok);
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+    test1.stopTest(false);
+    test2.stopTest(false);
+  }
+}
+
+#ifdef HAVE_DEFAULT_RT_TRANSPORT_FACTORY
+// Claims the name of the platform's reactor, but wasn't created by createRtReactor.
+class ForeignReactor : public NRtReactorInterface {
+public:
+  explicit ForeignReactor(std::string name) : _name(std::move(name)) {}
+  NRtReactorStats getStats() const override { return {}; }
+  const char* getTransportName() const override { return _name.c_str(); }
+
+private:
+  std::string _name;
+};
+
+// Realtime clients sharing a one thread reactor, a match among them gets everybody the host's match data.
+void test_mockServer_reactor(MockServer& server) {
+  NTest test(__func__, mockParameters(server), true);
+  test.runTest();
+
+  NRtReactorConfig config;
+  config.threads = 1;
+  NRtReactorPtr reactor = createRtReactor(config);
+  if (!reactor) {
+    NLOG_INFO("the websocket transport has no reactor");
+    test.stopTest(true);
+    return;
+  }
+
+  constexpr size_t kClients = 8;
+  std::vector<NRtClientPtr> clients;
+  std::vector<std::unique_ptr<NRtDefaultClientListener>> listeners;
+  std::atomic<size_t> received{0};
+  bool ok = false;
+
+  // the clients are ticked here, not by the test
+  auto wait = [&clients](auto future) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready &&
+           std::chrono::steady_clock::now() < deadline) {
+      for (auto& client : clients) {
+        client->tick();
+      }
+    }
+    return future.get();
+  };
+
+  try {
+    std::vector<NSessionPtr> sessions;
+    for (size_t i = 0; i < kClients; i++) {
+      sessions.push_back(test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get());
+      clients.push_back(test.client->createRtClient(createDefaultWebsocket(NPlatformParameters(), reactor)));
+      listeners.push_back(std::make_unique<NRtDefaultClientListener>());
+      listeners.back()->setMatchDataCallback([&received](const NMatchData& data) {
+        if (data.opCode == 7 && data.data == "state") {
+          received++;
+        }
+      });
+      clients.back()->setListener(listeners.back().get());
+    }
+    for (size_t i = 0; i < kClients; i++) {
+      wait(clients[i]->connectAsync(sessions[i], false, NTest::RtProtocol));
+    }
+    NRtReactorStats connected = reactor->getStats();
+
+    NMatch match = wait(clients[0]->createMatchAsync());
+    for (size_t i = 1; i < kClients; i++) {
+      wait(clients[i]->joinMatchAsync(match.matchId, {}));
+    }
+    clients[0]->sendMatchData(match.matchId, 7, "state");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received < kClients - 1 && std::chrono::steady_clock::now() < deadline) {
+      for (auto& client : clients) {
+        client->tick();
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (auto& client : clients) {
+      client->disconnect();
+    }
+    NRtReactorStats disconnected = reactor->getStats();
+
+    // only reactors of createRtReactor can service the transport
+    bool foreignRefused =
+        !createDefaultWebsocket(NPlatformParameters(), std::make_shared<ForeignReactor>(reactor->getTransportName()));
+
+    ok = connected.threads == 1 && connected.transports == kClients && received == kClients - 1 &&
+         disconnected.transports == 0 && disconnected.services > 0 && foreignRefused;
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+  }
+
+  clients.clear();
+  test.stopTest(ok);
+}
+
+// Clients connect to and disconnect from a one thread reactor while it services a match, which keeps going. Sends
+// wake the reactor up, it doesn't wait for a poll.
+void test_mockServer_reactorChurn(MockServer& server) {
+  NTest test(__func__, mockParameters(server), true);
+  test.runTest();
+
+  NRtReactorConfig config;
+  config.threads = 1;
+  NRtReactorPtr reactor = createRtReactor(config);
+  if (!reactor) {
+    NLOG_INFO("the websocket transport has no reactor");
+    test.stopTest(true);
+    return;
+  }
+
+  constexpr size_t kClients = 4;
+  constexpr size_t kChurn = 20;
+  std::vector<NRtClientPtr> clients;
+  std::vector<std::unique_ptr<NRtDefaultClientListener>> listeners;
+  std::vector<size_t> received(kClients, 0);
+  bool ok = false;
+
+  auto tickAll = [&clients](const NRtClientPtr& extra) {
+    for (auto& client : clients) {
+      client->tick();
+    }
+    if (extra) {
+      extra->tick();
+    }
+  };
+  auto wait = [&tickAll](auto future, const NRtClientPtr& extra = nullptr) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready &&
+           std::chrono::steady_clock::now() < deadline) {
+      tickAll(extra);
+    }
+    return future.get();
+  };
+
+  try {
+    for (size_t i = 0; i < kClients; i++) {
+      auto session = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+      clients.push_back(test.client->createRtClient(createDefaultWebsocket(NPlatformParameters(), reactor)));
+      listeners.push_back(std::make_unique<NRtDefaultClientListener>());
+      listeners.back()->setMatchDataCallback([&received, i](const NMatchData&) { received[i]++; });
+      clients.back()->setListener(listeners.back().get());
+      wait(clients.back()->connectAsync(session, false, NTest::RtProtocol));
+    }
+
+    NMatch match = wait(clients[0]->createMatchAsync());
+    for (size_t i = 1; i < kClients; i++) {
+      wait(clients[i]->joinMatchAsync(match.matchId, {}));
+    }
+
+    // the host sends between the steps of every connect and disconnect
+    NRtReactorStats before = reactor->getStats();
+    size_t sent = 0;
+    for (size_t i = 0; i < kChurn; i++) {
+      auto session = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+      NRtClientPtr extra = test.client->createRtClient(createDefaultWebsocket(NPlatformParameters(), reactor));
+      clients[0]->sendMatchData(match.matchId, 1, "state");
+      sent++;
+      wait(extra->connectAsync(session, false, NTest::RtProtocol), extra);
+      clients[0]->sendMatchData(match.matchId, 1, "state");
+      sent++;
+      extra->disconnect();
+      tickAll(nullptr);
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    auto allReceived = [&]() {
+      for (size_t i = 1; i < kClients; i++) {
+        if (received[i] < sent) {
+          return false;
+        }
+      }
+      return true;
+    };
+    while (!allReceived() && std::chrono::steady_clock::now() < deadline) {
+      tickAll(nullptr);
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    NRtReactorStats after = reactor->getStats();
+
+    ok = allReceived() && after.transports == kClients && after.wakeups - before.wakeups >= kChurn;
+    for (auto& client : clients) {
+      client->disconnect();
+    }
+    ok = ok && reactor->getStats().transports == 0;
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+  }
+
+  clients.clear();
+  test.stopTest(ok);
+}
+
+// Records a websocket session against the mock server and replays it: the replay delivers the same match data.
+void test_mockServer_trafficLog(MockServer& server, NRtClientProtocol protocol) {
+  NTest test(std::string(__func__) + (protocol == NRtClientProtocol::Json ? "_json" : "_protobuf"),
+      mockParameters(server), true);
+  test.runTest();
+
+  constexpr size_t kMessages = 50;
+  const std::string path = "rt_traffic_" + TestGuid::newGuid() + ".log";
+  std::vector<NRtClientPtr> clients;
+  std::vector<std::string> recorded;
+  std::vector<std::string> replayed;
+  bool ok = false;
+
+  // the clients are ticked here, not by the test
+  auto tickAll = [&clients]() {
+    for (auto& client : clients) {
+      client->tick();
+    }
+  };
+  auto wait = [&tickAll](auto future) {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready &&
+           std::chrono::steady_clock::now() < deadline) {
+      tickAll();
+    }
+    return future.get();
+  };
+
+  try {
+    NRtTransportPtr recorder = createRecordingTransport(createDefaultWebsocket(NPlatformParameters()), path);
+    if (!recorder) {
+      NLOG_INFO("unable to record to " + path);
+      test.stopTest(false);
+      return;
+    }
+
+    auto recordedSession = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    auto senderSession = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    clients.push_back(test.client->createRtClient(recorder));
+    clients.push_back(test.client->createRtClient(createDefaultWebsocket(NPlatformParameters())));
+
+    NRtDefaultClientListener recordedListener;
+    recordedListener.setMatchDataCallback([&recorded](const NMatchData& data) { recorded.push_back(data.data); });
+    clients[0]->setListener(&recordedListener);
+    wait(clients[0]->connectAsync(recordedSession, false, protocol));
+    wait(clients[1]->connectAsync(senderSession, false, protocol));
+
+    NMatch match = wait(clients[0]->createMatchAsync());
+    wait(clients[1]->joinMatchAsync(match.matchId, {}));
+    for (size_t i = 0; i < kMessages; i++) {
+      clients[1]->sendMatchData(match.matchId, 3, "state-" + std::to_string(i));
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (recorded.size() < kMessages && std::chrono::steady_clock::now() < deadline) {
+      tickAll();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (auto& client : clients) {
+      client->disconnect();
+    }
+    tickAll();
+    clients.clear();
+    recorder.reset();
+
+    NRtReplayTransportPtr replay = createReplayTransport(path, NRtReplaySpeed::Maximum);
+    if (replay) {
+      NRtClientPtr client = test.client->createRtClient(replay);
+      NRtDefaultClientListener listener;
+      listener.setMatchDataCallback([&replayed](const NMatchData& data) { replayed.push_back(data.data); });
+      client->setListener(&listener);
+      client->connect(recordedSession, false, protocol);
+      // connects and delivers the whole recording
+      client->tick();
+      ok = recorded.size() == kMessages && replayed == recorded && replay->isReplayDone();
+      client->disconnect();
+    }
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+  }
+
+  clients.clear();
+  std::remove(path.c_str());
+  test.stopTest(ok);
+}
+
+// Match state sent while RPCs saturate a slow uplink is written ahead of them, so its latency stays bounded by
+// what the socket already holds rather than growing with the RPC backlog.
+void test_mockServer_sendPriority(MockServer& server) {
+  NTest test(__func__, mockParameters(server), true);
+  test.runTest();
+
+  constexpr size_t kBulkMessages = 128;
+  constexpr size_t kBulkBytes = 16 * 1024; // 2s of the uplink
+  constexpr int64_t kStateOpCode = 1;
+
+  MockServerConfig config = server.getConfig();
+  MockServerConfig slow = config;
+  slow.uploadBandwidth = 1024 * 1024;
+  slow.echoMatchData = true;
+  server.setConfig(slow);
+
+  NRtTransportPtr transport = createDefaultWebsocket(NPlatformParameters());
+  NSocketOptions options;
+  options.sendBufferSize = 16 * 1024;
+  if (!transport->setSocketOptions(options)) {
+    NLOG_INFO("the websocket transport doesn't manage its socket, skipping");
+    server.setConfig(config);
+    test.stopTest(true);
+    return;
+  }
+
+  NRtClientPtr client = test.client->createRtClient(transport);
+  NRtDefaultClientListener listener;
+  client->setListener(&listener);
+
+  using Clock = std::chrono::steady_clock;
+  const Clock::time_point start = Clock::now();
+  size_t echoes = 0;
+  std::chrono::microseconds maxLatency{0};
+  listener.setMatchDataCallback([&](const NMatchData& data) {
+    if (data.opCode == kStateOpCode) {
+      auto sentAt = start + std::chrono::microseconds(std::stoll(data.data));
+      maxLatency = std::max(maxLatency, std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - sentAt));
+      echoes++;
+    }
+  });
+
+  // the client is ticked here, not by the test
+  auto wait = [&client](auto future) {
+    const auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (future.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready && Clock::now() < deadline) {
+      client->tick();
+    }
+    return future.get();
+  };
+
+  bool ok = false;
+  try {
+    auto session = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    wait(client->connectAsync(session, false, NTest::RtProtocol));
+
+    NSendQueueConfig queueConfig;
+    queueConfig.droppableOpCodes = {kStateOpCode};
+    client->setSendQueueConfig(queueConfig);
+    NMatch match = wait(client->createMatchAsync());
+
+    size_t rpcs = 0;
+    const std::string payload(kBulkBytes, 'x');
+    for (size_t i = 0; i < kBulkMessages; i++) {
+      client->rpc("echo", payload, [&rpcs](const NRpc&) { rpcs++; });
+    }
+
+    // state at 50Hz until the RPCs are through
+    const auto deadline = Clock::now() + std::chrono::seconds(20);
+    Clock::time_point nextState = Clock::now();
+    while (rpcs < kBulkMessages && Clock::now() < deadline) {
+      if (Clock::now() >= nextState) {
+        auto sentAt = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start);
+        client->sendMatchData(match.matchId, kStateOpCode, std::to_string(sentAt.count()));
+        nextState += std::chrono::milliseconds(20);
+      }
+      client->tick();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    NSendQueueStats stats = client->getSendQueueStats();
+    NLOG(NLogLevel::Info, "state: %d echoes, max latency %dms, max queue delay %dms; rpc: max queue delay %dms",
+        int(echoes), int(maxLatency.count() / 1000), int(stats.latest.maxQueueDelay.count() / 1000),
+        int(stats.bulk.maxQueueDelay.count() / 1000));
+
+    // the RPCs queued for a good part of the 2s, the state for not much longer than a tick of the transport
+    ok = rpcs == kBulkMessages && echoes > 0 && stats.bulk.maxQueueDelay > std::chrono::milliseconds(500) &&
+         stats.latest.maxQueueDelay < std::chrono::milliseconds(100) && maxLatency < std::chrono::milliseconds(500);
+    client->disconnect();
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+  }
+
+  server.setConfig(config);
+  test.stopTest(ok);
+}
+#endif
+
+void test_mockServer_faults(MockServer& server) {
+  NTest test(__func__, mockParameters(server), true);
+  test.runTest();
+
+  MockServerConfig config = server.getConfig();
+  bool ok = true;
+
+  try {
+    MockServerConfig slow = config;
+    slow.latency = std::chrono::milliseconds(50);
+    server.setConfig(slow);
+
+    auto start = std::chrono::steady_clock::now();
+    test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    ok = std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(50);
+
+    MockServerConfig failing = config;
+    failing.httpErrorRate = 1.0;
+    failing.httpErrorStatus = 503;
+    server.setConfig(failing);
+
+    try {
+      test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+      ok = false;
+    } catch (const NException&) {
+    }
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+    ok = false;
+  }
+
+  server.setConfig(config);
+  test.stopTest(ok && server.getStats().httpErrors > 0);
+}
+
+void test_mockServer() {
+  MockServer server;
+  if (!server.start()) {
+    NTest test(__func__);
+    NLOG_INFO("unable to start the mock server");
+    test.stopTest(false);
+    return;
+  }
+
+  test_mockServer_rest(server);
+  test_mockServer_match(server, NRtClientProtocol::Json);
+  test_mockServer_match(server, NRtClientProtocol::Protobuf);
+#ifdef HAVE_DEFAULT_RT_TRANSPORT_FACTORY
+  test_mockServer_reactor(server);
+  test_mockServer_reactorChurn(server);
+  test_mockServer_trafficLog(server, NRtClientProtocol::Json);
+  test_mockServer_trafficLog(server, NRtClientProtocol::Protobuf);
+  test_mockServer_sendPriority(server);
+#endif
+  test_mockServer_faults(server);
+
+  server.stop();
+}
+
+#else
+
+void test_mockServer() {}
+
+#endif
+
+} // namespace Test
+} // namespace Nakama
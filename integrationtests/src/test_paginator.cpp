@@ -0,0 +1,107 @@
+/*
+ * Copyright 2026 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NTest.h"
+#include "TestGuid.h"
+#include <nakama-cpp/NPaginators.h>
+#include <nakama-cpp/log/NLogger.h>
+
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace Nakama {
+namespace Test {
+
+using namespace std;
+
+// Collects every item of the paginator, waiting for pages as they come in
+template <typename Item> vector<Item> drain(NPaginatorPtr<Item> paginator, chrono::milliseconds timeout) {
+  vector<Item> items;
+  Item item;
+  auto deadline = chrono::steady_clock::now() + timeout;
+
+  while (!paginator->isDone() && chrono::steady_clock::now() < deadline) {
+    while (paginator->tryNext(item)) {
+      items.push_back(move(item));
+    }
+    this_thread::sleep_for(chrono::milliseconds(1));
+  }
+
+  return items;
+}
+
+// Walks a user's storage collection page by page with look-ahead and with an item limit
+void test_paginator_storageObjects() {
+  NTest test(__func__, true);
+  test.setTestTimeoutMs(60000);
+  test.runTest();
+
+  try {
+    auto session = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    test.addSession(session);
+
+    constexpr int kObjects = 25;
+    vector<NStorageObjectWrite> writes;
+    for (int i = 0; i < kObjects; i++) {
+      NStorageObjectWrite obj;
+      obj.collection = "paginator";
+      obj.key = "key" + to_string(i);
+      obj.value = "{\"index\": " + to_string(i) + "}";
+      writes.push_back(obj);
+    }
+    test.client->writeStorageObjectsAsync(session, writes).get();
+
+    bool ok = true;
+
+    for (size_t lookAhead : {1, 3}) {
+      NPaginatorOptions options;
+      options.lookAhead = lookAhead;
+
+      auto start = chrono::steady_clock::now();
+      auto objects = drain(
+          paginateUsersStorageObjects(test.client, session, "paginator", session->getUserId(), 10, options),
+          chrono::seconds(20));
+      auto ms = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+      set<string> keys;
+      for (const auto& obj : objects) {
+        keys.insert(obj.key);
+      }
+
+      NLOG_INFO(
+          "lookAhead " + to_string(lookAhead) + ": " + to_string(objects.size()) + " objects in " + to_string(ms) +
+          "ms");
+      ok = ok && objects.size() == kObjects && keys.size() == kObjects;
+    }
+
+    NPaginatorOptions limited;
+    limited.maxItems = 12;
+    auto paginator = paginateUsersStorageObjects(test.client, session, "paginator", session->getUserId(), 10, limited);
+    auto objects = drain(paginator, chrono::seconds(20));
+    ok = ok && objects.size() == 12 && paginator->getPagesFetched() == 2 && !paginator->getError();
+
+    test.stopTest(ok);
+  } catch (const exception& e) {
+    NLOG_INFO("test failed: " + string(e.what()));
+    test.stopTest(false);
+  }
+}
+
+void test_paginator() { test_paginator_storageObjects(); }
+
+} // namespace Test
+} // namespace Nakama
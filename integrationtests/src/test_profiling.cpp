@@ -19,7 +19,10 @@
 #include "nakama-cpp/log/NLogger.h"
 
 #include <nakama-cpp/NException.h>
+#include <nakama-cpp/realtime/NRtTrafficLog.h>
+#include <nakama-cpp/realtime/NRtTransportInterface.h>
 #include <chrono>
+#include <cstdio>
 #include <thread>
 #include <vector>
 
@@ -138,11 +141,211 @@ void test_profiling_clientCreateDestroy() {
   }
 }
 
+// Feeds a canned message trace to the realtime client instead of talking to the server.
+class ReplayTransport : public NRtTransportInterface {
+public:
+  void setActivityTimeout(uint32_t) override {}
+  uint32_t getActivityTimeout() const override { return 0; }
+  void tick() override {}
+  void connect(const std::string&, NRtTransportType) override { fireOnConnected(); }
+  bool isConnecting() const override { return false; }
+  void disconnect() override { _connected = false; }
+  bool send(const NBytes&) override { return true; }
+
+  void replay(const vector<NBytes>& messages) {
+    for (const auto& message : messages) {
+      fireOnMessage(message);
+    }
+  }
+};
+
+// Mixed realtime traffic as seen by a match client: half match data, the rest chat and presence.
+static vector<NBytes> makeMixedRtTrace(size_t count) {
+  const NBytes matchData =
+      R"({"match_data":{"match_id":"9a6b2c.nakama","presence":{"user_id":"u1","session_id":"s1","username":"bob"},)"
+      R"("op_code":"1","data":"AAECAwQFBgcICQoLDA0ODw==","reliable":true}})";
+  const NBytes channelMessage =
+      R"({"channel_message":{"channel_id":"2...lobby","message_id":"m-1","code":0,"sender_id":"u2",)"
+      R"("username":"alice","content":"{\"text\":\"hello everyone\"}","create_time":"2024-01-01T00:00:00Z",)"
+      R"("update_time":"2024-01-01T00:00:00Z","persistent":true,"room_name":"lobby"}})";
+  const NBytes statusPresence =
+      R"({"status_presence_event":{"joins":[{"user_id":"u3","session_id":"s3","username":"carol",)"
+      R"("status":"{\"mood\":\"happy\"}"}]}})";
+  const NBytes streamPresence =
+      R"({"stream_presence_event":{"stream":{"mode":2,"subject":"lobby","label":"lobby"},)"
+      R"("joins":[{"user_id":"u4","session_id":"s4","username":"dave"}]}})";
+
+  vector<NBytes> trace;
+  trace.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    switch (i % 20) {
+      case 0:
+      case 1:
+      case 2:
+      case 3:
+      case 4:
+        trace.push_back(channelMessage);
+        break;
+      case 5:
+      case 6:
+      case 7:
+        trace.push_back(statusPresence);
+        break;
+      case 8:
+      case 9:
+        trace.push_back(streamPresence);
+        break;
+      default:
+        trace.push_back(matchData);
+    }
+  }
+  return trace;
+}
+
+// Events the listener didn't subscribe to are skipped undecoded, the cost of both is in nakama-sdk-bench
+// (RtDispatch).
+void test_profiling_rtLazyDecode() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  const size_t kMessages = 2000;
+  const vector<NBytes> trace = makeMixedRtTrace(kMessages);
+  // fake token with exp in 2100, good enough to open a connection to ReplayTransport
+  auto session = restoreSession("e30.eyJleHAiOjQxMDI0NDQ4MDAsInVpZCI6ImJlbmNoIiwidXNuIjoiYmVuY2gifQ.sig", "");
+
+  auto run = [&](bool subscribeAll, NRtClientMetrics& metrics) {
+    auto transport = make_shared<ReplayTransport>();
+    NRtClientPtr rtClient = test.client->createRtClient(transport);
+    NRtDefaultClientListener listener;
+    size_t matchDataCount = 0;
+
+    listener.setMatchDataCallback([&matchDataCount](const NMatchData&) { ++matchDataCount; });
+    if (subscribeAll) {
+      listener.setChannelMessageCallback([](const NChannelMessage&) {});
+      listener.setStatusPresenceCallback([](const NStatusPresenceEvent&) {});
+      listener.setStreamPresenceCallback([](const NStreamPresenceEvent&) {});
+    } else {
+      listener.setSubscribed(NRtEventType::ChannelMessage, false);
+      listener.setSubscribed(NRtEventType::StatusPresence, false);
+      listener.setSubscribed(NRtEventType::StreamPresence, false);
+    }
+
+    rtClient->setListener(&listener);
+    rtClient->connect(session, false, NRtClientProtocol::Json);
+    transport->replay(trace);
+
+    metrics = rtClient->getMetrics();
+    rtClient->disconnect();
+    return matchDataCount;
+  };
+
+  NRtClientMetrics eagerMetrics, lazyMetrics;
+  size_t eagerMatchData = run(true, eagerMetrics);
+  size_t lazyMatchData = run(false, lazyMetrics);
+
+  uint64_t skipped = 0;
+  for (const auto& entry : lazyMetrics.messagesSkipped) {
+    skipped += entry.second;
+  }
+
+  NLOG_INFO("skipped: " + to_string(skipped) + " of " + to_string(kMessages));
+  test.stopTest(
+      eagerMatchData == kMessages / 2 && lazyMatchData == kMessages / 2 && eagerMetrics.messagesSkipped.empty() &&
+      skipped == kMessages / 2);
+}
+
+// Handles events by overriding the default listener's handlers, without setting callbacks.
+class OverridingListener : public NRtDefaultClientListener {
+public:
+  size_t matchData = 0;
+  size_t channelMessages = 0;
+
+protected:
+  void onMatchData(const NMatchData&) override { ++matchData; }
+  void onChannelMessage(const NChannelMessage&) override { ++channelMessages; }
+};
+
+// Nothing is skipped for a subclass of the default listener which didn't opt out of event types.
+void test_profiling_rtListenerOverride() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  const size_t kMessages = 200;
+  const vector<NBytes> trace = makeMixedRtTrace(kMessages);
+  auto session = restoreSession("e30.eyJleHAiOjQxMDI0NDQ4MDAsInVpZCI6ImJlbmNoIiwidXNuIjoiYmVuY2gifQ.sig", "");
+
+  auto transport = make_shared<ReplayTransport>();
+  NRtClientPtr rtClient = test.client->createRtClient(transport);
+  OverridingListener listener;
+  rtClient->setListener(&listener);
+  rtClient->connect(session, false, NRtClientProtocol::Json);
+  transport->replay(trace);
+
+  NRtClientMetrics metrics = rtClient->getMetrics();
+  rtClient->disconnect();
+  test.stopTest(
+      listener.matchData == kMessages / 2 && listener.channelMessages == kMessages / 4 &&
+      metrics.messagesSkipped.empty());
+}
+
+// Records the mixed trace as NRtClient receives it and replays the log, nakama-sdk-bench (RtReplay)
+// benchmarks decode and dispatch of replayed logs.
+void test_profiling_rtTrafficLog() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  const size_t kMessages = 2000;
+  const vector<NBytes> trace = makeMixedRtTrace(kMessages);
+  auto session = restoreSession("e30.eyJleHAiOjQxMDI0NDQ4MDAsInVpZCI6ImJlbmNoIiwidXNuIjoiYmVuY2gifQ.sig", "");
+  const string path = "rt_traffic_" + TestGuid::newGuid() + ".log";
+
+  {
+    auto source = make_shared<ReplayTransport>();
+    NRtTransportPtr recorder = createRecordingTransport(source, path);
+    if (!recorder) {
+      NLOG_INFO("unable to record to " + path);
+      test.stopTest(false);
+      return;
+    }
+
+    NRtClientPtr rtClient = test.client->createRtClient(recorder);
+    NRtDefaultClientListener listener;
+    rtClient->setListener(&listener);
+    rtClient->connect(session, false, NRtClientProtocol::Json);
+    source->replay(trace);
+    rtClient->disconnect();
+  }
+
+  auto replay = createReplayTransport(path, NRtReplaySpeed::Maximum);
+  bool ok = replay != nullptr;
+  if (ok) {
+    NRtClientPtr rtClient = test.client->createRtClient(replay);
+    NRtDefaultClientListener listener;
+    size_t matchDataCount = 0;
+    listener.setMatchDataCallback([&matchDataCount](const NMatchData&) { ++matchDataCount; });
+    rtClient->setListener(&listener);
+    rtClient->connect(session, false, NRtClientProtocol::Json);
+
+    // connects and delivers the whole recording
+    rtClient->tick();
+
+    ok = replay->getReplayedMessages() == kMessages && matchDataCount == kMessages / 2 && replay->isReplayDone();
+    rtClient->disconnect();
+  }
+
+  replay.reset();
+  std::remove(path.c_str());
+  test.stopTest(ok);
+}
+
 void test_profiling() {
   test_profiling_authLatency();
   test_profiling_storageLatency();
   test_profiling_accountGetLatency();
   test_profiling_clientCreateDestroy();
+  test_profiling_rtLazyDecode();
+  test_profiling_rtListenerOverride();
+  test_profiling_rtTrafficLog();
 }
 
 } // namespace Test
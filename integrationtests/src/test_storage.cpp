@@ -19,6 +19,9 @@
 #include "nakama-cpp/log/NLogger.h"
 
 #include <nakama-cpp/NException.h>
+#include <cstdio>
+#include <future>
+#include <memory>
 #include <optional>
 
 namespace Nakama {
@@ -487,6 +490,165 @@ void test_listStorage_withLimit() {
   }
 }
 
+// Repeated writes of the same keys go out as one request with the latest values
+void test_storageWriteBuffer_coalesce() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  try {
+    auto session = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    test.addSession(session);
+    string collection = "buffered_" + TestGuid::newGuid();
+
+    for (int i = 0; i < 30; i++) {
+      NStorageObjectWrite obj;
+      obj.collection = collection;
+      obj.key = "key_" + to_string(i % 3);
+      obj.value = "{ \"i\": " + to_string(i) + " }";
+      test.client->bufferStorageWrite(session, obj);
+    }
+
+    test.client->flushStorageWrites().get();
+
+    NStorageWriteBufferStats stats = test.client->getStorageWriteBufferStats();
+    vector<NReadStorageObjectId> ids;
+    for (int i = 0; i < 3; i++) {
+      ids.push_back({collection, "key_" + to_string(i), session->getUserId()});
+    }
+    auto objects = test.client->readStorageObjectsAsync(session, ids).get();
+
+    bool latest = objects.size() == 3;
+    for (const auto& obj : objects) {
+      // last values written were 27, 28 and 29
+      latest = latest && obj.value.find(to_string(27 + (obj.key.back() - '0'))) != string::npos;
+    }
+
+    NLOG_INFO(
+        "buffered " + to_string(stats.buffered) + ", requests " + to_string(stats.requests) + ", written " +
+        to_string(stats.written));
+    test.stopTest(stats.requests == 1 && stats.written == 3 && stats.coalesced == 27 && latest);
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+    test.stopTest(false);
+  }
+}
+
+// Writes of two users to the same key go out as one request each, with the session of their user
+void test_storageWriteBuffer_users() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  try {
+    auto session1 = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    auto session2 = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    string collection = "buffered_" + TestGuid::newGuid();
+
+    NStorageObjectWrite obj;
+    obj.collection = collection;
+    obj.key = "profile";
+    obj.value = "{ \"user\": 1 }";
+    test.client->bufferStorageWrite(session1, obj);
+    obj.value = "{ \"user\": 2 }";
+    test.client->bufferStorageWrite(session2, obj);
+    test.client->flushStorageWrites().get();
+
+    auto objects1 =
+        test.client->readStorageObjectsAsync(session1, {{collection, "profile", session1->getUserId()}}).get();
+    auto objects2 =
+        test.client->readStorageObjectsAsync(session2, {{collection, "profile", session2->getUserId()}}).get();
+    NStorageWriteBufferStats stats = test.client->getStorageWriteBufferStats();
+
+    test.stopTest(
+        stats.requests == 2 && stats.written == 2 && objects1.size() == 1 && objects2.size() == 1 &&
+        objects1[0].value.find('1') != string::npos && objects2[0].value.find('2') != string::npos);
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+    test.stopTest(false);
+  }
+}
+
+// A journal left by one user isn't written to the storage of the next user who logs in
+void test_storageWriteBuffer_journalOwner() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  const string path = "storage_journal_" + TestGuid::newGuid() + ".log";
+  try {
+    auto session1 = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    auto session2 = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    string collection = "buffered_" + TestGuid::newGuid();
+
+    NStorageWriteBufferConfig config;
+    config.flushInterval = std::chrono::hours(1);
+    config.journalFilePath = path;
+
+    NStorageObjectWrite obj;
+    obj.collection = collection;
+    obj.key = "profile";
+    {
+      // left unsent, as if the app was killed
+      NTest previousRun(string(__func__) + "_previousRun");
+      previousRun.client->configureStorageWriteBuffer(config);
+      obj.value = "{ \"user\": 1 }";
+      previousRun.client->bufferStorageWrite(session1, obj);
+    }
+
+    test.client->configureStorageWriteBuffer(config);
+    obj.key = "settings";
+    obj.value = "{ \"user\": 2 }";
+    test.client->bufferStorageWrite(session2, obj);
+    test.client->flushStorageWrites().get();
+
+    auto objects1 =
+        test.client->readStorageObjectsAsync(session1, {{collection, "profile", session1->getUserId()}}).get();
+    auto objects2 =
+        test.client->readStorageObjectsAsync(session2, {{collection, "profile", session2->getUserId()}}).get();
+    NStorageWriteBufferStats stats = test.client->getStorageWriteBufferStats();
+
+    test.stopTest(
+        stats.replayed == 1 && stats.failed == 1 && stats.written == 1 && objects1.empty() && objects2.empty());
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+    test.stopTest(false);
+  }
+  std::remove(path.c_str());
+}
+
+// Batched loads keep the owner they were asked for: an empty one is the system, not the session's user
+void test_loadStorageObject_owner() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  try {
+    auto session = test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get();
+    string collection = "loaded_" + TestGuid::newGuid();
+
+    NStorageObjectWrite obj;
+    obj.collection = collection;
+    obj.key = "profile";
+    obj.value = "{ \"level\": 3 }";
+    test.client->writeStorageObjectsAsync(session, {obj}).get();
+
+    auto owned = std::make_shared<std::promise<std::optional<NStorageObject>>>();
+    auto system = std::make_shared<std::promise<std::optional<NStorageObject>>>();
+    test.client->loadStorageObject(
+        session, {collection, "profile", session->getUserId()}, [owned](const std::optional<NStorageObject>& object) {
+          owned->set_value(object);
+        });
+    test.client->loadStorageObject(
+        session, {collection, "profile", ""}, [system](const std::optional<NStorageObject>& object) {
+          system->set_value(object);
+        });
+
+    std::optional<NStorageObject> ownedObject = owned->get_future().get();
+    std::optional<NStorageObject> systemObject = system->get_future().get();
+    test.stopTest(ownedObject && ownedObject->userId == session->getUserId() && !systemObject);
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+    test.stopTest(false);
+  }
+}
+
 void test_storage() {
   test_writeStorageInvalidArgument();
   test_writeStorage();
@@ -502,6 +664,10 @@ void test_storage() {
   test_readStorage_multiple();
   test_deleteStorage_multiple();
   test_listStorage_withLimit();
+  test_storageWriteBuffer_coalesce();
+  test_storageWriteBuffer_users();
+  test_storageWriteBuffer_journalOwner();
+  test_loadStorageObject_owner();
 }
 
 } // namespace Test
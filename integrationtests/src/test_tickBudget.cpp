@@ -0,0 +1,77 @@
+/*
+ * Copyright 2026 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NTest.h"
+#include "TestGuid.h"
+#include <nakama-cpp/log/NLogger.h>
+
+#include <atomic>
+#include <thread>
+
+namespace Nakama {
+namespace Test {
+
+using namespace std;
+
+// Responses which don't fit into the budget must be carried over, not dropped
+void test_tickBudget_carryOver() {
+  NTest test(__func__);
+  test.setTestTimeoutMs(20000);
+
+  constexpr int kNumRequests = 10;
+  atomic<int> completed{0};
+  size_t maxBacklog = 0;
+
+  for (int i = 0; i < kNumRequests; i++) {
+    test.client->authenticateCustom(TestGuid::newGuid(), "", true, {}, [&test, &completed](NSessionPtr session) {
+      test.addSession(session);
+      ++completed;
+    });
+  }
+
+  for (int waitedMs = 0; completed < kNumRequests && waitedMs < 15000; waitedMs += 5) {
+    // tiny budget: every tick processes exactly one response
+    test.client->tick(chrono::microseconds(1));
+
+    NTickStats stats = test.client->getTickStats();
+    maxBacklog = max(maxBacklog, stats.backlog);
+
+    if (stats.lastProcessed > 1) {
+      NLOG_ERROR("Tick processed more than one response: " + to_string(stats.lastProcessed));
+      test.stopTest(false);
+      break;
+    }
+
+    this_thread::sleep_for(chrono::milliseconds(5));
+  }
+
+  NTickStats stats = test.client->getTickStats();
+  NLOG_INFO(
+      "completed=" + to_string(completed.load()) + " maxBacklog=" + to_string(maxBacklog) +
+      " maxTickUs=" + to_string(stats.maxTickDuration.count()));
+
+  if (!test.isDone()) {
+    test.stopTest(completed == kNumRequests && stats.backlog == 0 && stats.totalProcessed >= kNumRequests);
+  }
+
+  // cleans up sessions
+  test.runTest();
+}
+
+void test_tickBudget() { test_tickBudget_carryOver(); }
+
+} // namespace Test
+} // namespace Nakama
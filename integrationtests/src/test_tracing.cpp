@@ -0,0 +1,87 @@
+/*
+ * Copyright 2026 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "NTest.h"
+#include "TestGuid.h"
+#include <nakama-cpp/NTrace.h>
+#include <nakama-cpp/log/NLogger.h>
+
+#include <mutex>
+#include <set>
+
+namespace Nakama {
+namespace Test {
+
+using namespace std;
+
+class CollectingTraceSink : public NTraceSinkInterface {
+public:
+  void onSpan(const NTraceSpan& span) override {
+    lock_guard<mutex> lock(_mutex);
+    _names.insert(span.name);
+    _traceIds.insert(span.traceId);
+  }
+
+  bool hasSpan(const string& name) {
+    lock_guard<mutex> lock(_mutex);
+    return _names.count(name) > 0;
+  }
+
+  size_t traceCount() {
+    lock_guard<mutex> lock(_mutex);
+    return _traceIds.size();
+  }
+
+private:
+  mutex _mutex;
+  set<string> _names;
+  set<uint64_t> _traceIds;
+};
+
+void test_tracing_rest() {
+  NTest test(__func__);
+
+  auto sink = make_shared<CollectingTraceSink>();
+  test.client->setTraceSink(sink);
+
+  // request and callback spans are emitted after callback returns, so check them from the next request
+  auto accountCallback = [&test, sink](const NAccount&) {
+    bool ok = sink->hasSpan("send") && sink->hasSpan("queue wait") && sink->hasSpan("decode") &&
+              sink->hasSpan("callback") && sink->hasSpan("POST /v2/account/authenticate/custom") &&
+              sink->traceCount() == 2;
+
+    if (!ok) {
+      NLOG_ERROR("expected spans not recorded");
+    }
+
+    test.stopTest(ok);
+  };
+
+  auto successCallback = [&test, accountCallback](NSessionPtr session) {
+    test.addSession(session);
+    test.client->getAccount(session, accountCallback);
+  };
+
+  test.client->authenticateCustom(TestGuid::newGuid(), "", true, {}, successCallback);
+
+  test.runTest();
+  test.client->setTraceSink(nullptr);
+}
+
+void test_tracing() { test_tracing_rest(); }
+
+} // namespace Test
+} // namespace Nakama
@@ -19,6 +19,7 @@
 #include "nakama-cpp/log/NLogger.h"
 
 #include <nakama-cpp/NException.h>
+#include <future>
 
 namespace Nakama {
 namespace Test {
@@ -103,12 +104,53 @@ void test_getUsersByFacebookId_empty() {
   }
 }
 
+// Point reads issued in the same frame go out as one getUsers request
+void test_loadUser_batched() {
+  NTest test(__func__, true);
+  test.runTest();
+
+  try {
+    vector<NSessionPtr> sessions;
+    for (int i = 0; i < 3; i++) {
+      sessions.push_back(test.client->authenticateCustomAsync(TestGuid::newGuid(), "", true).get());
+      test.addSession(sessions.back());
+    }
+    test.client->resetMetrics();
+
+    vector<string> ids = {sessions[0]->getUserId(), sessions[1]->getUserId(), sessions[2]->getUserId()};
+    ids.push_back(TestGuid::newGuid()); // no such user
+    ids.push_back(ids[0]);              // duplicate read
+
+    vector<promise<optional<NUser>>> results(ids.size());
+    for (size_t i = 0; i < ids.size(); i++) {
+      test.client->loadUser(
+          sessions[0],
+          ids[i],
+          [&results, i](const optional<NUser>& user) { results[i].set_value(user); },
+          [&results, i](const NError& error) { results[i].set_exception(make_exception_ptr(NException(error))); });
+    }
+
+    bool ok = true;
+    for (size_t i = 0; i < ids.size(); i++) {
+      optional<NUser> user = results[i].get_future().get();
+      ok = ok && (i == 3 ? !user : user && user->id == ids[i]);
+    }
+
+    NLOG_INFO("requests: " + to_string(test.client->getMetrics().requests));
+    test.stopTest(ok && test.client->getMetrics().requests <= 1);
+  } catch (const std::exception& e) {
+    NLOG_INFO("test failed: " + std::string(e.what()));
+    test.stopTest(false);
+  }
+}
+
 void test_users() {
   test_getUsersById();
   test_getUsersByUsername();
   test_getUsersEmpty();
   test_getUsersEmpty_emptyRequest();
   test_getUsersByFacebookId_empty();
+  test_loadUser_batched();
 }
 
 } // namespace Test
@@ -73,12 +73,33 @@ NAKAMA_API NClientPtr createDefaultClient(const NClientParameters &parameters);
 #endif
 
 #ifdef WITH_GRPC_CLIENT
+struct NGrpcClientParameters {
+  /// Number of threads blocking on the gRPC completion queue. Responses are
+  /// received and deserialized on these threads and handed to `tick()` (or to
+  /// the I/O thread) through a lock-free queue. 0 (default) polls the
+  /// completion queue from `tick()`.
+  uint32_t completionThreads = 0;
+
+  /// Number of channels calls are spread over, round robin. Each channel has
+  /// its own connection to the server. Defaults to 1.
+  uint32_t channels = 1;
+};
+
 /**
  * Creates the gRPC client to interact with Nakama server.
  *
  * @param parameters the client parameters
  */
 NAKAMA_API NClientPtr createGrpcClient(const NClientParameters &parameters);
+
+/**
+ * Creates the gRPC client to interact with Nakama server.
+ *
+ * @param parameters the client parameters
+ * @param grpcParameters threading and channel pool of the gRPC client
+ */
+NAKAMA_API NClientPtr createGrpcClient(const NClientParameters &parameters,
+                                       const NGrpcClientParameters &grpcParameters);
 #endif
 
 /**
@@ -16,15 +16,22 @@
 
 #pragma once
 
+#include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <nakama-cpp/NClientMetrics.h>
 #include <nakama-cpp/NError.h>
+#include <nakama-cpp/NExecutor.h>
 #include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NReadBatchConfig.h>
 #include <nakama-cpp/NSessionInterface.h>
+#include <nakama-cpp/NStorageWriteBuffer.h>
+#include <nakama-cpp/NTickStats.h>
+#include <nakama-cpp/NTrace.h>
 #include <nakama-cpp/NTypes.h>
 #include <nakama-cpp/data/NAccount.h>
 #include <nakama-cpp/data/NChannelMessageList.h>
@@ -93,6 +100,61 @@ public:
    */
   virtual void tick() = 0;
 
+  /**
+   * Pumps requests queue in your thread, spending at most `budget` on processing responses.
+   *
+   * Responses are processed in priority order, failed requests first. Whatever doesn't fit
+   * into the budget is carried over to the next call. At least one response is processed per call.
+   *
+   * @param budget Processing time allowed for this call.
+   */
+  virtual void tick(std::chrono::microseconds budget) = 0;
+
+  /**
+   * Get backlog size and processing time of `tick`.
+   */
+  virtual NTickStats getTickStats() const = 0;
+
+  /**
+   * Run transport I/O and response decoding on an internal thread, so `tick` doesn't have to pump it.
+   *
+   * Callbacks are posted to `callbackExecutor`. If it is nullptr, callbacks are queued and
+   * executed from `tick`, which then does nothing else.
+   * Must be called from the thread which owns the client.
+   *
+   * @param callbackExecutor The executor to post callbacks to.
+   * @param interval How often the internal thread polls the transport.
+   */
+  virtual void startIoThread(
+      NExecutorPtr callbackExecutor = nullptr,
+      std::chrono::milliseconds interval = std::chrono::milliseconds(10)) = 0;
+
+  /**
+   * Stop the internal I/O thread started by `startIoThread`. `tick` pumps the transport again
+   * and executes callbacks which are still queued.
+   */
+  virtual void stopIoThread() = 0;
+
+  /**
+   * Get request counts, errors, traffic and latency histograms per endpoint.
+   *
+   * Recording is lock-free and always on. Safe to call from any thread.
+   */
+  virtual NClientMetrics getMetrics() const = 0;
+
+  /**
+   * Zero all metrics, e.g. after loading screen to measure a gameplay session only.
+   */
+  virtual void resetMetrics() = 0;
+
+  /**
+   * Record request lifecycle spans into `sink`: send, transport phases (dns, connect, tls, server),
+   * queue wait, decode and callback. Pass nullptr to stop tracing.
+   *
+   * @param sink Where to send spans, e.g. `NChromeTraceExporter`.
+   */
+  virtual void setTraceSink(NTraceSinkPtr sink) = 0;
+
 #ifdef HAVE_DEFAULT_RT_TRANSPORT_FACTORY
   /**
    * Create a new real-time client with parameters from client.
@@ -564,6 +626,20 @@ public:
       std::function<void(const NUsers&)> successCallback = nullptr,
       ErrorCallback errorCallback = nullptr) = 0;
 
+  /**
+   * Fetch one user by id. Loads issued until the next `tick()`, or within `NReadBatchConfig::window`,
+   * are sent as one `getUsers` request.
+   *
+   * @param session The session of the user.
+   * @param id The id of the user to fetch.
+   * @param successCallback Receives the user, or nullopt if there is no such user.
+   */
+  virtual void loadUser(
+      NSessionPtr session,
+      const std::string& id,
+      std::function<void(const std::optional<NUser>&)> successCallback = nullptr,
+      ErrorCallback errorCallback = nullptr) = 0;
+
   /**
    * Add one or more friends by id.
    *
@@ -1101,6 +1177,26 @@ public:
       std::function<void(const NStorageObjects&)> successCallback = nullptr,
       ErrorCallback errorCallback = nullptr) = 0;
 
+  /**
+   * Read one storage object. Loads issued until the next `tick()`, or within `NReadBatchConfig::window`,
+   * are sent as one `readStorageObjects` request.
+   *
+   * @param session The session of the user.
+   * @param objectId The object to read. Empty `userId` reads an object owned by the system, as with
+   * `readStorageObjects`.
+   * @param successCallback Receives the object, or nullopt if it doesn't exist or can't be read.
+   */
+  virtual void loadStorageObject(
+      NSessionPtr session,
+      const NReadStorageObjectId& objectId,
+      std::function<void(const std::optional<NStorageObject>&)> successCallback = nullptr,
+      ErrorCallback errorCallback = nullptr) = 0;
+
+  /**
+   * Set the batching window and request size limits of `loadStorageObject` and `loadUser`.
+   */
+  virtual void configureReadBatching(const NReadBatchConfig& config) = 0;
+
   /**
    * Delete one or more storage objects.
    *
@@ -1113,6 +1209,34 @@ public:
       std::function<void()> successCallback = nullptr,
       ErrorCallback errorCallback = nullptr) = 0;
 
+  /**
+   * Buffer a storage write instead of sending it right away. Only the latest value per user, collection
+   * and key is kept, buffered writes are sent in batches from `tick()` or the I/O thread according
+   * to `NStorageWriteBufferConfig`.
+   *
+   * @param session The session of the user. The user's buffered writes are sent with the latest session of
+   * the same user passed here.
+   * @param object The object to write.
+   */
+  virtual void bufferStorageWrite(NSessionPtr session, const NStorageObjectWrite& object) = 0;
+
+  /**
+   * Set flush policy and journal file of buffered storage writes. Writes left in the journal by
+   * a previous run are buffered again and sent with the next session of their user. They are dropped
+   * if another user buffers a write first.
+   */
+  virtual void configureStorageWriteBuffer(const NStorageWriteBufferConfig& config) = 0;
+
+  /**
+   * Send buffered storage writes now, e.g. before the app goes to background.
+   *
+   * @return Completes once the buffer has been written out, holds an NException if the server
+   * rejected some of the writes.
+   */
+  virtual std::future<void> flushStorageWrites() = 0;
+
+  virtual NStorageWriteBufferStats getStorageWriteBufferStats() const = 0;
+
   /**
    * Execute a server framework function with an input payload on the server.
    *
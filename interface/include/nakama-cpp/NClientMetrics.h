@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <nakama-cpp/NError.h>
+#include <nakama-cpp/NLatencyHistogram.h>
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+/// Metrics of a single REST endpoint.
+struct NEndpointMetrics {
+  uint64_t requests = 0;                   ///< Requests sent.
+  uint64_t errors = 0;                     ///< Requests which failed.
+  std::map<ErrorCode, uint64_t> errorsByCode;
+  uint64_t bytesSent = 0;                  ///< Request body bytes.
+  uint64_t bytesReceived = 0;              ///< Response body bytes.
+  NLatencyHistogram network;               ///< From sending the request until transport delivered response.
+  NLatencyHistogram queueWait;             ///< From response delivery until client started processing it.
+  NLatencyHistogram decode;                ///< Parsing response body.
+  NLatencyHistogram callback;              ///< Time spent in the success callback.
+};
+
+/// Snapshot of client metrics, see `NClientInterface::getMetrics`.
+struct NClientMetrics {
+  /// Keyed by HTTP method and path with ids replaced, e.g. "GET /v2/group/{id}/user".
+  std::map<std::string, NEndpointMetrics> endpoints;
+  uint64_t requests = 0;
+  uint64_t errors = 0;
+  uint64_t bytesSent = 0;
+  uint64_t bytesReceived = 0;
+};
+
+NAKAMA_NAMESPACE_END
@@ -0,0 +1,100 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+/**
+ * Executor which client callbacks are posted to when the client runs its I/O on an internal thread.
+ *
+ * `post` is called from the client's I/O thread, so implementations must be thread safe.
+ * Implement it to forward callbacks to your game thread queue, a thread pool, or anything else.
+ */
+class NAKAMA_API NExecutorInterface {
+public:
+  virtual ~NExecutorInterface();
+
+  /**
+   * Schedule task for execution.
+   *
+   * @param task The callback to run.
+   */
+  virtual void post(std::function<void()> task) = 0;
+};
+
+using NExecutorPtr = std::shared_ptr<NExecutorInterface>;
+
+/**
+ * Runs tasks immediately in the thread which posted them, i.e. in the client's I/O thread.
+ */
+class NInlineExecutor : public NExecutorInterface {
+public:
+  void post(std::function<void()> task) override { task(); }
+};
+
+/**
+ * Holds tasks until `run` is called. Typically `run` is called once per frame from the game thread.
+ */
+class NQueueExecutor : public NExecutorInterface {
+public:
+  void post(std::function<void()> task) override {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tasks.emplace_back(std::move(task));
+  }
+
+  /**
+   * Run all tasks posted so far in the calling thread.
+   *
+   * @return The number of tasks executed.
+   */
+  size_t run() {
+    std::deque<std::function<void()>> tasks;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      tasks.swap(_tasks);
+    }
+
+    for (auto& task : tasks) {
+      task();
+    }
+
+    return tasks.size();
+  }
+
+  /**
+   * @return The number of tasks waiting for `run`.
+   */
+  size_t size() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _tasks.size();
+  }
+
+private:
+  mutable std::mutex _mutex;
+  std::deque<std::function<void()>> _tasks;
+};
+
+NAKAMA_NAMESPACE_END
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstdint>
 #include <functional>
 #include <map>
 #include <memory>
@@ -44,11 +45,24 @@ struct NHttpRequest {
   std::string body;
 };
 
+/// Phases of a request as reported by the transport, in microseconds since the transfer started.
+/// Each phase is cumulative (connect includes name lookup). -1 if the transport doesn't report it.
+struct NHttpTimings {
+  int64_t nameLookupUs = -1;    /// DNS resolved
+  int64_t connectUs = -1;       /// TCP connected
+  int64_t tlsHandshakeUs = -1;  /// TLS handshake done, 0 for plain HTTP
+  int64_t preTransferUs = -1;   /// about to send the request
+  int64_t startTransferUs = -1; /// first response byte received
+  int64_t totalUs = -1;         /// response fully received
+};
+
 struct NHttpResponse {
   int statusCode = 0;       /// HTTP status code, 200 - OK
   std::string body;         /// response body
   std::string errorMessage; /// error message string, intended for use if a local
                             /// failure (i.e., no error body returned from server)
+  NHttpTimings timings;     /// optional, used for tracing
+  NHttpHeaders headers;     /// optional, response headers with lower case names
 };
 
 using NHttpResponsePtr = std::shared_ptr<NHttpResponse>;
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+struct NInternedStringEntry;
+
+/**
+ * Handle to a string stored once per process, see `NRtClientInterface::setStringInterning`.
+ *
+ * A handle is a single pointer. Copying it bumps a reference count and the string is freed together with
+ * its last handle. Handles of equal strings point to the same entry, so comparing and hashing them doesn't
+ * look at the characters. A default constructed handle and the handle of an empty string are null.
+ * Handles may be created, copied and destroyed from any thread.
+ */
+class NAKAMA_API NInternedString {
+public:
+  NInternedString() = default;
+
+  /// Find the entry of `str`, adding it if there is none.
+  explicit NInternedString(std::string_view str);
+
+  NInternedString(const NInternedString& other) noexcept;
+  NInternedString(NInternedString&& other) noexcept : _entry(other._entry) { other._entry = nullptr; }
+  ~NInternedString();
+
+  NInternedString& operator=(NInternedString other) noexcept {
+    std::swap(_entry, other._entry);
+    return *this;
+  }
+
+  /// The string, empty for a null handle.
+  const std::string& str() const noexcept;
+
+  bool isNull() const noexcept { return _entry == nullptr; }
+
+  size_t hash() const noexcept { return std::hash<const void*>()(_entry); }
+
+  friend bool operator==(const NInternedString& a, const NInternedString& b) noexcept {
+    return a._entry == b._entry;
+  }
+  friend bool operator!=(const NInternedString& a, const NInternedString& b) noexcept {
+    return a._entry != b._entry;
+  }
+
+  /// Number of distinct strings with live handles in the process.
+  static size_t getInternedCount() noexcept;
+
+private:
+  NInternedStringEntry* _entry = nullptr;
+};
+
+NAKAMA_NAMESPACE_END
+
+namespace std {
+template <> struct hash<NAKAMA_NAMESPACE::NInternedString> {
+  size_t operator()(const NAKAMA_NAMESPACE::NInternedString& str) const noexcept { return str.hash(); }
+};
+} // namespace std
@@ -0,0 +1,62 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+/**
+ * Snapshot of a latency distribution in microseconds.
+ *
+ * Buckets are HDR-style log-linear: every power of two range is split into 8 linear
+ * sub-buckets, which keeps relative error of percentiles under 12.5% from 1us up to hours.
+ */
+struct NAKAMA_API NLatencyHistogram {
+  static constexpr size_t kSubBucketBits = 3;
+  static constexpr size_t kBucketCount = 280;
+
+  std::vector<uint64_t> buckets; ///< Sample count per bucket, empty when there are no samples.
+  uint64_t count = 0;            ///< Number of samples.
+  uint64_t sumUs = 0;            ///< Sum of all samples.
+  uint64_t minUs = 0;            ///< Smallest sample.
+  uint64_t maxUs = 0;            ///< Largest sample.
+
+  /// Bucket index a value falls into.
+  static size_t bucketIndex(uint64_t valueUs);
+
+  /// Largest value which falls into the bucket.
+  static uint64_t bucketUpperBoundUs(size_t index);
+
+  /// Mean of all samples, 0 if there are none.
+  double meanUs() const { return count ? static_cast<double>(sumUs) / count : 0.0; }
+
+  /**
+   * Estimate a percentile.
+   *
+   * @param percentile Value in range [0, 100], e.g. 99.9
+   * @return upper bound of the bucket containing the percentile, clamped to maxUs.
+   */
+  uint64_t percentileUs(double percentile) const;
+};
+
+NAKAMA_NAMESPACE_END
@@ -0,0 +1,250 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <nakama-cpp/NError.h>
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+struct NPaginatorOptions {
+  /// Pages buffered ahead of the consumer, counting the one being requested. With 1 the next page is
+  /// requested only once the current one is consumed, with 2 (default) it is fetched while the current
+  /// one is consumed. Bounds memory use to about `lookAhead` pages.
+  size_t lookAhead = 2;
+
+  /// Stop after this many items. 0 (default) walks the whole list.
+  size_t maxItems = 0;
+};
+
+/**
+ * Walks a cursor based list endpoint, yielding items one at a time and fetching following pages ahead.
+ *
+ * The next page is requested as soon as the previous one arrives, until `lookAhead` pages are buffered.
+ * Items are moved out of their page as they are consumed and a page is released once it is empty.
+ * The list ends when the server returns no cursor, an empty page or the same cursor again.
+ *
+ * Pages arrive through client callbacks, so the client must be ticked (or run its I/O thread).
+ * All methods are thread safe. Dropping the last reference stops the walk, responses still in flight are ignored.
+ * Use the `paginate*` functions from NPaginators.h to create paginators for Nakama endpoints.
+ */
+template <typename Item> class NPaginator : public std::enable_shared_from_this<NPaginator<Item>> {
+public:
+  using PageCallback = std::function<void(std::vector<Item> items, std::string nextCursor)>;
+  using ErrorCallback = std::function<void(const NError&)>;
+
+  /// Requests the page at `cursor` (empty for the first page) and calls either callback with the outcome.
+  using FetchFunction = std::function<void(const std::string& cursor, PageCallback onPage, ErrorCallback onError)>;
+
+  /**
+   * Creates a paginator and requests the first page.
+   *
+   * @param fetch Requests one page.
+   * @param options Look-ahead and item limit.
+   */
+  static std::shared_ptr<NPaginator> create(FetchFunction fetch, NPaginatorOptions options = {}) {
+    std::shared_ptr<NPaginator> paginator(new NPaginator(std::move(fetch), options));
+    paginator->fetchIfNeeded();
+    return paginator;
+  }
+
+  /**
+   * Takes the next item if one is buffered.
+   *
+   * @return false when no item is available right now. Check `isDone` to tell the end of the list from a page
+   * still being fetched.
+   */
+  bool tryNext(Item& item) {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+
+      if (_pages.empty()) {
+        return false;
+      }
+
+      item = std::move(_pages.front()[_position++]);
+      --_buffered;
+
+      if (_position == _pages.front().size()) {
+        _pages.pop_front();
+        _position = 0;
+      }
+    }
+
+    fetchIfNeeded();
+    return true;
+  }
+
+  /// All items have been consumed, or the walk failed or was cancelled.
+  bool isDone() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _buffered == 0 && !_fetching && (_end || _error || _cancelled);
+  }
+
+  /// Error which stopped the walk. Items received before it can still be consumed.
+  std::optional<NError> getError() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _error;
+  }
+
+  /// Items received and not consumed yet.
+  size_t getBuffered() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _buffered;
+  }
+
+  size_t getPagesFetched() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pagesFetched;
+  }
+
+  /// Stops requesting pages and drops buffered items. A response in flight is ignored.
+  void cancel() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cancelled = true;
+    _pages.clear();
+    _position = 0;
+    _buffered = 0;
+  }
+
+  /**
+   * Called when items become available, the list ends or the walk fails.
+   * It runs in the thread which handles client callbacks, with no paginator lock held.
+   */
+  void setListener(std::function<void()> listener) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _listener = std::move(listener);
+  }
+
+private:
+  NPaginator(FetchFunction fetch, const NPaginatorOptions& options) : _fetch(std::move(fetch)), _options(options) {
+    if (_options.lookAhead == 0) {
+      _options.lookAhead = 1;
+    }
+  }
+
+  void fetchIfNeeded() {
+    std::string cursor;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+
+      if (_fetching || _end || _error || _cancelled || _pages.size() >= _options.lookAhead) {
+        return;
+      }
+
+      _fetching = true;
+      cursor = _cursor;
+    }
+
+    std::weak_ptr<NPaginator> weakThis = this->shared_from_this();
+
+    _fetch(
+        cursor,
+        [weakThis](std::vector<Item> items, std::string nextCursor) {
+          if (auto paginator = weakThis.lock()) {
+            paginator->onPage(std::move(items), std::move(nextCursor));
+          }
+        },
+        [weakThis](const NError& error) {
+          if (auto paginator = weakThis.lock()) {
+            paginator->onError(error);
+          }
+        });
+  }
+
+  void onPage(std::vector<Item> items, std::string nextCursor) {
+    std::function<void()> listener;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _fetching = false;
+
+      if (_cancelled) {
+        return;
+      }
+
+      ++_pagesFetched;
+
+      if (_options.maxItems > 0) {
+        size_t remaining = _options.maxItems - _received;
+        if (items.size() >= remaining) {
+          items.resize(remaining);
+          _end = true;
+        }
+      }
+
+      _received += items.size();
+      _end = _end || items.empty() || nextCursor.empty() || nextCursor == _cursor;
+      _cursor = std::move(nextCursor);
+
+      if (!items.empty()) {
+        _buffered += items.size();
+        _pages.emplace_back(std::move(items));
+      }
+
+      listener = _listener;
+    }
+
+    fetchIfNeeded();
+
+    if (listener) {
+      listener();
+    }
+  }
+
+  void onError(const NError& error) {
+    std::function<void()> listener;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _fetching = false;
+      _error = error;
+      listener = _listener;
+    }
+
+    if (listener) {
+      listener();
+    }
+  }
+
+  FetchFunction _fetch;
+  NPaginatorOptions _options;
+  mutable std::mutex _mutex;
+  std::deque<std::vector<Item>> _pages;
+  size_t _position = 0;
+  size_t _buffered = 0;
+  size_t _received = 0;
+  size_t _pagesFetched = 0;
+  std::string _cursor;
+  bool _fetching = false;
+  bool _end = false;
+  bool _cancelled = false;
+  std::optional<NError> _error;
+  std::function<void()> _listener;
+};
+
+template <typename Item> using NPaginatorPtr = std::shared_ptr<NPaginator<Item>>;
+
+NAKAMA_NAMESPACE_END
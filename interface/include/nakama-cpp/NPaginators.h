@@ -0,0 +1,274 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nakama-cpp/NClientInterface.h>
+#include <nakama-cpp/NPaginator.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+// Paginators for the cursor based list endpoints of `NClientInterface`. Each one walks the whole list
+// (or `options.maxItems`), `limit` is the page size. The paginator keeps the client and session alive.
+//
+//   auto records = paginateLeaderboardRecords(client, session, "weekly", {}, 100);
+//   NLeaderboardRecord record;
+//   while (!records->isDone()) {
+//     client->tick();
+//     while (records->tryNext(record)) { ... }
+//   }
+
+namespace NPaginatorDetail {
+
+inline std::optional<std::string> optionalCursor(const std::string& cursor) {
+  return cursor.empty() ? std::nullopt : std::optional<std::string>(cursor);
+}
+
+} // namespace NPaginatorDetail
+
+inline NPaginatorPtr<NLeaderboardRecord> paginateLeaderboardRecords(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::string& leaderboardId,
+    const std::vector<std::string>& ownerIds = {},
+    const std::optional<int32_t>& limit = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NLeaderboardRecord>::create(
+      [client, session, leaderboardId, ownerIds, limit](const std::string& cursor, auto onPage, auto onError) {
+        client->listLeaderboardRecords(
+            session,
+            leaderboardId,
+            ownerIds,
+            limit,
+            NPaginatorDetail::optionalCursor(cursor),
+            [onPage](NLeaderboardRecordListPtr list) { onPage(std::move(list->records), std::move(list->nextCursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NLeaderboardRecord> paginateTournamentRecords(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::string& tournamentId,
+    const std::optional<int32_t>& limit = std::nullopt,
+    const std::vector<std::string>& ownerIds = {},
+    NPaginatorOptions options = {}) {
+  return NPaginator<NLeaderboardRecord>::create(
+      [client, session, tournamentId, limit, ownerIds](const std::string& cursor, auto onPage, auto onError) {
+        client->listTournamentRecords(
+            session,
+            tournamentId,
+            limit,
+            NPaginatorDetail::optionalCursor(cursor),
+            ownerIds,
+            [onPage](NTournamentRecordListPtr list) { onPage(std::move(list->records), std::move(list->nextCursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NTournament> paginateTournaments(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::optional<uint32_t>& categoryStart = std::nullopt,
+    const std::optional<uint32_t>& categoryEnd = std::nullopt,
+    const std::optional<uint32_t>& startTime = std::nullopt,
+    const std::optional<uint32_t>& endTime = std::nullopt,
+    const std::optional<int32_t>& limit = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NTournament>::create(
+      [client, session, categoryStart, categoryEnd, startTime, endTime, limit](
+          const std::string& cursor, auto onPage, auto onError) {
+        client->listTournaments(
+            session,
+            categoryStart,
+            categoryEnd,
+            startTime,
+            endTime,
+            limit,
+            NPaginatorDetail::optionalCursor(cursor),
+            [onPage](NTournamentListPtr list) { onPage(std::move(list->tournaments), std::move(list->cursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NStorageObject> paginateStorageObjects(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::string& collection,
+    const std::optional<int32_t>& limit = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NStorageObject>::create(
+      [client, session, collection, limit](const std::string& cursor, auto onPage, auto onError) {
+        client->listStorageObjects(
+            session,
+            collection,
+            limit,
+            NPaginatorDetail::optionalCursor(cursor),
+            [onPage](NStorageObjectListPtr list) { onPage(std::move(list->objects), std::move(list->cursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NStorageObject> paginateUsersStorageObjects(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::string& collection,
+    const std::string& userId,
+    const std::optional<int32_t>& limit = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NStorageObject>::create(
+      [client, session, collection, userId, limit](const std::string& cursor, auto onPage, auto onError) {
+        client->listUsersStorageObjects(
+            session,
+            collection,
+            userId,
+            limit,
+            NPaginatorDetail::optionalCursor(cursor),
+            [onPage](NStorageObjectListPtr list) { onPage(std::move(list->objects), std::move(list->cursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NFriend> paginateFriends(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::optional<int32_t>& limit = std::nullopt,
+    const std::optional<NFriend::State>& state = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NFriend>::create(
+      [client, session, limit, state](const std::string& cursor, auto onPage, auto onError) {
+        client->listFriends(
+            session,
+            limit,
+            state,
+            cursor,
+            [onPage](NFriendListPtr list) { onPage(std::move(list->friends), std::move(list->cursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NGroup> paginateGroups(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::string& name,
+    int32_t limit = 0,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NGroup>::create(
+      [client, session, name, limit](const std::string& cursor, auto onPage, auto onError) {
+        client->listGroups(
+            session,
+            name,
+            limit,
+            cursor,
+            [onPage](NGroupListPtr list) { onPage(std::move(list->groups), std::move(list->cursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NGroupUser> paginateGroupUsers(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::string& groupId,
+    const std::optional<int32_t>& limit = std::nullopt,
+    const std::optional<NUserGroupState>& state = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NGroupUser>::create(
+      [client, session, groupId, limit, state](const std::string& cursor, auto onPage, auto onError) {
+        client->listGroupUsers(
+            session,
+            groupId,
+            limit,
+            state,
+            cursor,
+            [onPage](NGroupUserListPtr list) { onPage(std::move(list->groupUsers), std::move(list->cursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NUserGroup> paginateUserGroups(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::optional<int32_t>& limit = std::nullopt,
+    const std::optional<NUserGroupState>& state = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NUserGroup>::create(
+      [client, session, limit, state](const std::string& cursor, auto onPage, auto onError) {
+        client->listUserGroups(
+            session,
+            limit,
+            state,
+            cursor,
+            [onPage](NUserGroupListPtr list) { onPage(std::move(list->userGroups), std::move(list->cursor)); },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NChannelMessage> paginateChannelMessages(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::string& channelId,
+    const std::optional<int32_t>& limit = std::nullopt,
+    const std::optional<bool>& forward = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NChannelMessage>::create(
+      [client, session, channelId, limit, forward](const std::string& cursor, auto onPage, auto onError) {
+        client->listChannelMessages(
+            session,
+            channelId,
+            limit,
+            NPaginatorDetail::optionalCursor(cursor),
+            forward,
+            [onPage](NChannelMessageListPtr list) {
+              onPage(std::move(list->messages), std::move(list->nextCursor));
+            },
+            onError);
+      },
+      options);
+}
+
+inline NPaginatorPtr<NNotification> paginateNotifications(
+    NClientPtr client,
+    NSessionPtr session,
+    const std::optional<int32_t>& limit = std::nullopt,
+    NPaginatorOptions options = {}) {
+  return NPaginator<NNotification>::create(
+      [client, session, limit](const std::string& cursor, auto onPage, auto onError) {
+        client->listNotifications(
+            session,
+            limit,
+            NPaginatorDetail::optionalCursor(cursor),
+            [onPage](NNotificationListPtr list) {
+              onPage(std::move(list->notifications), std::move(list->cacheableCursor));
+            },
+            onError);
+      },
+      options);
+}
+
+NAKAMA_NAMESPACE_END
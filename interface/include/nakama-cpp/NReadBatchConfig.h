@@ -0,0 +1,39 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+/// How point reads are batched, see `NClientInterface::loadStorageObject` and `NClientInterface::loadUser`.
+struct NReadBatchConfig {
+  /// Time reads are collected for before a request is sent. 0 (default) sends reads issued since the
+  /// previous tick with the next one.
+  std::chrono::milliseconds window{0};
+
+  /// Maximum number of objects in one `readStorageObjects` request, larger batches are split.
+  size_t maxStorageObjectsPerRequest = 100;
+
+  /// Maximum number of ids in one `getUsers` request, larger batches are split.
+  size_t maxUsersPerRequest = 100;
+};
+
+NAKAMA_NAMESPACE_END
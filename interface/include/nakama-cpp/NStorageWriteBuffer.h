@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+/// Flush policy of buffered storage writes, see `NClientInterface::bufferStorageWrite`.
+struct NStorageWriteBufferConfig {
+  /// Send buffered writes once the oldest one is this old.
+  std::chrono::milliseconds flushInterval{5000};
+
+  /// Send as soon as this many objects are buffered. Also the maximum number of objects in one request.
+  size_t maxBatchObjects = 100;
+
+  /// Writes without a version are sent with the version the server acknowledged for the object last,
+  /// so that a concurrent change from another device is rejected instead of overwritten.
+  bool trackVersions = true;
+
+  /// Delay before resending writes which failed to reach the server, doubled with each attempt up
+  /// to `maxRetryBackoff`.
+  std::chrono::milliseconds retryBackoff{1000};
+  std::chrono::milliseconds maxRetryBackoff{60000};
+
+  /// Buffered writes are appended to this file and replayed by `configureStorageWriteBuffer`, so that
+  /// they survive a crash or a restart. Empty keeps them in memory only.
+  std::string journalFilePath;
+};
+
+/// Counters of the storage write buffer.
+struct NStorageWriteBufferStats {
+  size_t pending = 0;          ///< Objects waiting to be sent.
+  size_t inFlight = 0;         ///< Objects in the request being sent.
+  uint64_t buffered = 0;       ///< `bufferStorageWrite` calls.
+  uint64_t coalesced = 0;      ///< Writes replaced by a newer value before they were sent.
+  uint64_t written = 0;        ///< Objects acknowledged by the server.
+  uint64_t requests = 0;       ///< Write requests sent.
+  uint64_t retries = 0;        ///< Requests sent again after a connection failure.
+  uint64_t failed = 0;         ///< Objects dropped because the server rejected them.
+  uint64_t replayed = 0;       ///< Objects loaded from the journal.
+};
+
+NAKAMA_NAMESPACE_END
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+/// Statistics of work processed by client's `tick`.
+struct NTickStats {
+  size_t backlog = 0;                             ///< Work items waiting for the next tick.
+  size_t lastProcessed = 0;                       ///< Work items processed by the last tick.
+  std::chrono::microseconds lastTickDuration{0};  ///< Time the last tick spent processing work.
+  std::chrono::microseconds maxTickDuration{0};   ///< Longest time a single tick spent processing work.
+  uint64_t totalProcessed = 0;                    ///< Work items processed since the client was created.
+  uint64_t budgetExhaustedTicks = 0;              ///< Ticks which ran out of budget and carried work over.
+};
+
+NAKAMA_NAMESPACE_END
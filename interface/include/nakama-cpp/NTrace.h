@@ -0,0 +1,90 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+/**
+ * A timed phase of a request's lifecycle, e.g. transport connect, response decode or user callback.
+ */
+struct NTraceSpan {
+  std::string name;     ///< e.g. "decode", "tls", "callback"
+  std::string category; ///< "rest", "transport" or "rt"
+  std::chrono::steady_clock::time_point start;
+  std::chrono::microseconds duration{0};
+  uint64_t traceId = 0;  ///< Same for all spans of one request, 0 if span isn't tied to a request.
+  uint64_t threadId = 0; ///< Hash of the thread which recorded the span.
+  NStringMap args;       ///< Extra details, e.g. endpoint and HTTP status.
+};
+
+/**
+ * Receives spans from clients, see `NClientInterface::setTraceSink`.
+ *
+ * `onSpan` is called from whichever thread finished the span, implementations must be thread safe.
+ */
+class NAKAMA_API NTraceSinkInterface {
+public:
+  virtual ~NTraceSinkInterface();
+
+  virtual void onSpan(const NTraceSpan& span) = 0;
+};
+
+using NTraceSinkPtr = std::shared_ptr<NTraceSinkInterface>;
+
+/**
+ * Writes spans to a file in Chrome trace-event JSON format.
+ *
+ * Open the file in chrome://tracing or https://ui.perfetto.dev to see where request time goes.
+ * Events are streamed to disk as they arrive, so the file is usable even if the process dies
+ * before the exporter is destroyed.
+ */
+class NAKAMA_API NChromeTraceExporter : public NTraceSinkInterface {
+public:
+  /**
+   * @param path File to write. Overwritten if it exists.
+   */
+  explicit NChromeTraceExporter(const std::string& path);
+  ~NChromeTraceExporter() override;
+
+  NChromeTraceExporter(const NChromeTraceExporter&) = delete;
+  NChromeTraceExporter& operator=(const NChromeTraceExporter&) = delete;
+
+  void onSpan(const NTraceSpan& span) override;
+
+  /// false if file couldn't be opened
+  bool isOpen() const { return _file.is_open(); }
+
+  void flush();
+
+private:
+  std::mutex _mutex;
+  std::ofstream _file;
+  bool _first = true;
+  std::chrono::steady_clock::time_point _epoch;
+};
+
+NAKAMA_NAMESPACE_END
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <nakama-cpp/ClientFactory.h>
+#include <nakama-cpp/NPaginators.h>
 #include <nakama-cpp/realtime/NRtDefaultClientListener.h>
 #include <nakama-cpp/log/NLogger.h>
 #include <nakama-cpp/NakamaVersion.h>
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <nakama-cpp/NInternedString.h>
 #include <nakama-cpp/NTypes.h>
 
 NAKAMA_NAMESPACE_BEGIN
@@ -36,6 +37,15 @@ NAKAMA_NAMESPACE_BEGIN
         std::string groupId;           ///< The ID of the group, or an empty string if this message was not sent through a group channel.
         std::string userIdOne;         ///< The ID of the first DM user, or an empty string if this message was not sent through a DM chat.
         std::string userIdTwo;         ///< The ID of the second DM user, or an empty string if this message was not sent through a DM chat.
+
+        /// Set instead of channelId, senderId and username for realtime messages with string interning enabled.
+        NInternedString channelIdHandle;
+        NInternedString senderIdHandle;
+        NInternedString usernameHandle;
+
+        const std::string& getChannelId() const { return channelIdHandle.isNull() ? channelId : channelIdHandle.str(); }
+        const std::string& getSenderId() const { return senderIdHandle.isNull() ? senderId : senderIdHandle.str(); }
+        const std::string& getUsername() const { return usernameHandle.isNull() ? username : usernameHandle.str(); }
     };
 
 NAKAMA_NAMESPACE_END
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+    /// Set in the op code of match and party data which is compressed. Peers without the codec receive the
+    /// flagged op code and the compressed bytes, so every client of a match has to enable it.
+    /// Server side match handlers see the flag too.
+    inline constexpr int64_t NPayloadCompressedOpCodeFlag = int64_t(1) << 62;
+
+    /// Compression of outgoing match and party data, see `NRtClientInterface::setPayloadCodec`.
+    /// Requires the SDK to be built with zstd (`WITH_ZSTD`).
+    struct NPayloadCodecConfig
+    {
+        bool enabled = false;
+
+        /// Payloads smaller than this are sent as they are, compressing them rarely pays off.
+        size_t minSize = 128;
+
+        /// zstd compression level, 1 (fastest) to 19. Levels up to 3 keep CPU cost low enough for realtime traffic.
+        int level = 1;
+    };
+
+    struct NPayloadCodecStats
+    {
+        uint64_t compressed = 0;         ///< Payloads sent compressed.
+        uint64_t skipped = 0;            ///< Payloads sent as they are because they were small or didn't shrink.
+        uint64_t bytesIn = 0;            ///< Size of compressed payloads before compression.
+        uint64_t bytesOut = 0;           ///< Size of compressed payloads after compression.
+        uint64_t decompressed = 0;       ///< Received payloads decompressed.
+        uint64_t decompressErrors = 0;   ///< Received payloads delivered still compressed, e.g. unknown dictionary.
+    };
+
+    /**
+     * Train a compression dictionary from typical payloads, e.g. a few hundred state snapshots of a match.
+     *
+     * Small payloads compress much better with a dictionary. Every peer of a match must know it, distribute it
+     * with the match, e.g. as a storage object or RPC result, and set it with `setPayloadDictionary`.
+     *
+     * @param samples Payloads to train from.
+     * @param maxSize Maximum dictionary size in bytes.
+     * @return The dictionary, empty if training failed or the SDK was built without zstd.
+     */
+    NAKAMA_API NBytes trainPayloadDictionary(const std::vector<NBytes>& samples, size_t maxSize = 16 * 1024);
+
+NAKAMA_NAMESPACE_END
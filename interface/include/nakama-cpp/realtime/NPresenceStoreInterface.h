@@ -0,0 +1,141 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NTypes.h>
+#include <nakama-cpp/realtime/rtdata/NUserPresence.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+    enum class NPresenceStreamType
+    {
+        Match,
+        Channel,
+        Party
+    };
+
+    /// Change of a stream's presences, see `NPresenceStoreInterface::subscribe`.
+    struct NPresenceDiff
+    {
+        NPresenceStreamType type = NPresenceStreamType::Match;
+        std::string streamId;                 ///< Match, channel or party ID.
+        uint64_t version = 0;                 ///< Stream version after the change.
+        std::vector<NUserPresence> joins;     ///< Presences which weren't in the stream before.
+        std::vector<NUserPresence> leaves;    ///< Presences which were in the stream and left.
+    };
+
+    struct NPresenceStoreStats
+    {
+        size_t streams = 0;                   ///< Matches, channels and parties tracked.
+        size_t presences = 0;                 ///< Presences over all streams.
+        size_t internedStrings = 0;           ///< Distinct ids, usernames and statuses stored.
+        size_t internedBytes = 0;             ///< Characters of the distinct strings.
+        uint64_t eventsApplied = 0;           ///< Presence events, join results and leaves applied.
+    };
+
+    using NPresenceListener = std::function<void(const NPresenceDiff& diff)>;
+
+    /**
+     * Presences of the matches, channels and parties the user is in, kept up to date by the realtime client.
+     *
+     * Join results seed a stream, presence events update it and leaving, closing the party or disconnecting
+     * removes it. Presences are keyed by session ID. Every string is stored once and shared by all streams,
+     * a presence costs a few words plus its strings the first time they are seen. Join, leave and lookup
+     * don't depend on the size of the stream.
+     *
+     * The store is updated in the thread which runs client callbacks, right before the listener is notified,
+     * so a listener sees the state including the event it's handling. Reading is thread safe.
+     */
+    class NAKAMA_API NPresenceStoreInterface
+    {
+    public:
+        virtual ~NPresenceStoreInterface() {}
+
+        /**
+         * @return Presences of the stream in no particular order, empty if the stream isn't tracked.
+         */
+        virtual std::vector<NUserPresence> getPresences(
+            NPresenceStreamType type,
+            const std::string& streamId
+        ) const = 0;
+
+        /**
+         * Find the presence of a session in a stream.
+         *
+         * @param sessionId The session of the presence.
+         */
+        virtual std::optional<NUserPresence> findPresence(
+            NPresenceStreamType type,
+            const std::string& streamId,
+            const std::string& sessionId
+        ) const = 0;
+
+        /**
+         * @return Whether any session of the user is in the stream.
+         */
+        virtual bool hasUser(
+            NPresenceStreamType type,
+            const std::string& streamId,
+            const std::string& userId
+        ) const = 0;
+
+        virtual size_t getPresenceCount(NPresenceStreamType type, const std::string& streamId) const = 0;
+
+        /**
+         * Version of a stream. Grows with every change, a reader can compare it to skip rebuilding its state.
+         *
+         * @return 0 if the stream isn't tracked.
+         */
+        virtual uint64_t getVersion(NPresenceStreamType type, const std::string& streamId) const = 0;
+
+        /**
+         * @return IDs of the tracked streams of the type.
+         */
+        virtual std::vector<std::string> getStreamIds(NPresenceStreamType type) const = 0;
+
+        /**
+         * Call `listener` with the joins and leaves of every change of a stream.
+         *
+         * The listener runs in the thread which runs client callbacks, with no store lock held.
+         * A stream which is removed reports all its presences as leaves.
+         *
+         * @param streamId The stream to watch, empty to watch all streams of the type.
+         * @return Subscription ID for `unsubscribe`.
+         */
+        virtual uint64_t subscribe(
+            NPresenceStreamType type,
+            const std::string& streamId,
+            NPresenceListener listener
+        ) = 0;
+
+        virtual void unsubscribe(uint64_t subscriptionId) = 0;
+
+        virtual NPresenceStoreStats getStats() const = 0;
+    };
+
+    using NPresenceStorePtr = std::shared_ptr<NPresenceStoreInterface>;
+
+NAKAMA_NAMESPACE_END
@@ -22,12 +22,20 @@
 #include <vector>
 #include <future>
 #include <optional>
+#include <chrono>
 #include <nakama-cpp/NTypes.h>
+#include <nakama-cpp/NExecutor.h>
+#include <nakama-cpp/NTickStats.h>
+#include <nakama-cpp/NTrace.h>
 #include <nakama-cpp/NExport.h>
 #include <nakama-cpp/NSessionInterface.h>
 #include <nakama-cpp/data/NMatch.h>
 #include <nakama-cpp/data/NRpc.h>
 #include <nakama-cpp/realtime/NRtClientListenerInterface.h>
+#include <nakama-cpp/realtime/NRtClientMetrics.h>
+#include <nakama-cpp/realtime/NPayloadCodec.h>
+#include <nakama-cpp/realtime/NPresenceStoreInterface.h>
+#include <nakama-cpp/realtime/NRttStats.h>
 #include <nakama-cpp/realtime/NRtTransportInterface.h>
 #include <nakama-cpp/realtime/rtdata/NChannel.h>
 #include <nakama-cpp/realtime/rtdata/NChannelMessageAck.h>
@@ -89,6 +97,149 @@ NAKAMA_NAMESPACE_BEGIN
          */
         virtual void tick() = 0;
 
+        /**
+         * Pumps requests queue in your thread, spending at most `budget` on processing
+         * received messages. Whatever doesn't fit into the budget is carried over to the next call.
+         * At least one message is processed per call.
+         *
+         * @param budget Processing time allowed for this call.
+         */
+        virtual void tick(std::chrono::microseconds budget) = 0;
+
+        /**
+         * Get backlog size and processing time of `tick`.
+         */
+        virtual NTickStats getTickStats() const = 0;
+
+        /**
+         * Run transport I/O, heartbeats and message decoding on an internal thread,
+         * so `tick` doesn't have to pump them.
+         *
+         * Listener and request callbacks are posted to `callbackExecutor`. If it is nullptr,
+         * callbacks are queued and executed from `tick`, which then does nothing else.
+         * Must be called from the thread which owns the client.
+         *
+         * @param callbackExecutor The executor to post callbacks to.
+         * @param interval How often the internal thread polls the transport.
+         */
+        virtual void startIoThread(
+            NExecutorPtr callbackExecutor = nullptr,
+            std::chrono::milliseconds interval = std::chrono::milliseconds(10)
+        ) = 0;
+
+        /**
+         * Stop the internal I/O thread started by `startIoThread`. `tick` pumps the transport
+         * again and executes callbacks which are still queued.
+         */
+        virtual void stopIoThread() = 0;
+
+        /**
+         * Get message counts per type, errors, traffic, reconnects and latency histograms.
+         *
+         * Recording is lock-free and always on. Safe to call from any thread.
+         */
+        virtual NRtClientMetrics getMetrics() const = 0;
+
+        /**
+         * Zero all metrics.
+         */
+        virtual void resetMetrics() = 0;
+
+        /**
+         * Record spans for sent messages, request round trips, decoding and callbacks into `sink`.
+         * Pass nullptr to stop tracing.
+         *
+         * @param sink Where to send spans, e.g. `NChromeTraceExporter`.
+         */
+        virtual void setTraceSink(NTraceSinkPtr sink) = 0;
+
+        /**
+         * Keep presences of joined matches, channels and parties in the store returned by `getPresenceStore`.
+         *
+         * While enabled, presence and party events are decoded even if the listener isn't subscribed to them.
+         * Disabled by default. Disabling empties the store.
+         *
+         * @param enabled Whether to track presences.
+         */
+        virtual void setPresenceTracking(bool enabled) = 0;
+
+        /**
+         * Get the store of presences tracked since `setPresenceTracking(true)`.
+         */
+        virtual NPresenceStorePtr getPresenceStore() const = 0;
+
+        /**
+         * Intern user ids, session ids, usernames, match ids and channel ids of received realtime messages.
+         *
+         * Instead of copying them into new strings for every message, presences, match data, channel
+         * messages and stream data get `NInternedString` handles to strings shared by all messages.
+         * The id and name fields stay empty then, read them with the `get*` accessors of the structs.
+         * Disabled by default.
+         *
+         * @param enabled Whether to intern strings of messages received from now on.
+         */
+        virtual void setStringInterning(bool enabled) = 0;
+
+        /**
+         * Compress outgoing match and party data with zstd.
+         *
+         * Compressed payloads are sent with `NPayloadCompressedOpCodeFlag` set in the op code. Received payloads
+         * with the flag are decompressed and delivered without it whatever the config, payloads which fail
+         * to decompress are delivered as they are.
+         *
+         * @param config Compression settings. Disabled by default.
+         * @return False if the SDK was built without zstd and compression stays off.
+         */
+        virtual bool setPayloadCodec(const NPayloadCodecConfig& config) = 0;
+
+        /**
+         * Compress data of a match or party with a dictionary from `trainPayloadDictionary`.
+         *
+         * Received payloads compressed with any dictionary set before can be decompressed, so set it on
+         * every peer before anyone sends with it.
+         *
+         * @param streamId Match or party id.
+         * @param dictionary The trained dictionary, empty to stop using one for the stream.
+         * @return False if the dictionary isn't a trained zstd dictionary.
+         */
+        virtual bool setPayloadDictionary(const std::string& streamId, const NBytes& dictionary) = 0;
+
+        virtual NPayloadCodecStats getPayloadCodecStats() const = 0;
+
+        /**
+         * Bound the queue of messages waiting to be written to the socket.
+         *
+         * Sends which overflow the queue fail with `RtErrorCode::SEND_QUEUE_FULL` instead of piling up behind a
+         * stalled connection, `onSendQueueWritable` of the listener tells when to resume. Match and party data
+         * with an op code from `droppableOpCodes` supersedes older queued data of its match or party and op code.
+         *
+         * Messages are written by class, see `NSendPriority`: requests and other match and party data first, then
+         * droppable match and party data, then chat messages and RPCs. The watermarks apply to all classes together.
+         *
+         * @param config Watermarks and overflow policy. The queue is unbounded by default.
+         * @return False if the transport doesn't support a bounded send queue.
+         */
+        virtual bool setSendQueueConfig(const NSendQueueConfig& config) = 0;
+
+        /**
+         * Get depth and queueing delay of the send queue, in total and by class. Safe to call from any thread.
+         */
+        virtual NSendQueueStats getSendQueueStats() const = 0;
+
+        /**
+         * Configure sampling of round trip time and server clock offset.
+         *
+         * Existing traffic is always sampled. `NRttProbeMode::Ping` adds probes at a fixed interval.
+         *
+         * @param config Probe mode and interval. Piggybacks on existing traffic by default.
+         */
+        virtual void setRttConfig(const NRttConfig& config) = 0;
+
+        /**
+         * Get smoothed RTT, jitter, minimum RTT and the server clock offset. Safe to call from any thread.
+         */
+        virtual NRttStats getRttStats() const = 0;
+
         /**
          * Get websocket transport which RtClient uses.
          */
@@ -38,6 +38,29 @@
 
 NAKAMA_NAMESPACE_BEGIN
 
+    /**
+     * Server pushed events which can be delivered to <c>NRtClientListenerInterface</c>.
+     */
+    enum class NRtEventType
+    {
+        ChannelMessage,
+        ChannelPresence,
+        MatchmakerMatched,
+        MatchData,
+        MatchPresence,
+        Notifications,
+        Party,
+        PartyClose,
+        PartyData,
+        PartyJoinRequest,
+        PartyLeader,
+        PartyMatchmakerTicket,
+        PartyPresence,
+        StatusPresence,
+        StreamPresence,
+        StreamData
+    };
+
     /**
      * A listener for receiving <c>NRtClientInterface</c> events.
      */
@@ -46,6 +69,18 @@ NAKAMA_NAMESPACE_BEGIN
     public:
         virtual ~NRtClientListenerInterface() {}
 
+        /**
+         * Whether the listener handles events of the given type.
+         *
+         * Events nobody is subscribed to are dropped by the client before they are decoded.
+         * Called from the thread processing realtime messages, so the answer must not change
+         * concurrently with it.
+         *
+         * @param type The event type.
+         * @return true by default, i.e. every event is decoded and delivered.
+         */
+        virtual bool isSubscribed(NRtEventType type) const { (void)type; return true; }
+
         /**
          * Called when the client socket has been connected.
          */
@@ -65,6 +100,12 @@ NAKAMA_NAMESPACE_BEGIN
          */
         virtual void onError(const NRtError& error) { (void)error; }
 
+        /**
+         * Called when the send queue of the transport drained to its low watermarks after it was full,
+         * see `NRtClientInterface::setSendQueueConfig`.
+         */
+        virtual void onSendQueueWritable() {}
+
         /**
          * Called when a new channel message has been received.
          *
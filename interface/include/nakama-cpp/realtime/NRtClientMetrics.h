@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include <nakama-cpp/NLatencyHistogram.h>
+#include <nakama-cpp/NTypes.h>
+#include <nakama-cpp/realtime/rtdata/NRtError.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+    /// Snapshot of realtime client metrics, see `NRtClientInterface::getMetrics`.
+    struct NRtClientMetrics
+    {
+        /// Keyed by envelope message type, e.g. "match_data", "channel_message_ack".
+        std::map<std::string, uint64_t> messagesSent;
+        std::map<std::string, uint64_t> messagesReceived;
+        /// Received events dropped undecoded because listener isn't subscribed to them.
+        std::map<std::string, uint64_t> messagesSkipped;
+        std::map<RtErrorCode, uint64_t> errorsByCode;
+        uint64_t bytesSent = 0;
+        uint64_t bytesReceived = 0;
+        uint64_t connects = 0;
+        uint64_t disconnects = 0;
+        uint64_t reconnects = 0;          ///< Connects after the first one.
+        NLatencyHistogram requestRtt;     ///< From sending a request until its response arrived.
+        NLatencyHistogram queueWait;      ///< From message arrival until client started processing it.
+        NLatencyHistogram decode;         ///< Parsing message.
+        NLatencyHistogram callback;       ///< Time spent in listener and request callbacks.
+    };
+
+NAKAMA_NAMESPACE_END
@@ -32,6 +32,7 @@ NAKAMA_NAMESPACE_BEGIN
         using ConnectCallback = std::function<void()>;
         using DisconnectCallback = std::function<void(const NRtClientDisconnectInfo& info)>;
         using ErrorCallback = std::function<void(const NRtError&)>;
+        using SendQueueWritableCallback = std::function<void()>;
         using ChannelMessageCallback = std::function<void(const NChannelMessage&)>;
         using ChannelPresenceCallback = std::function<void(const NChannelPresenceEvent&)>;
         using MatchmakerMatchedCallback = std::function<void(NMatchmakerMatchedPtr)>;
@@ -52,6 +53,7 @@ NAKAMA_NAMESPACE_BEGIN
         void setConnectCallback(ConnectCallback callback) { _connectCallback = callback; }
         void setDisconnectCallback(DisconnectCallback callback) { _disconnectCallback = callback; }
         void setErrorCallback(ErrorCallback callback) { _errorCallback = callback; }
+        void setSendQueueWritableCallback(SendQueueWritableCallback callback) { _sendQueueWritableCallback = callback; }
         void setChannelMessageCallback(ChannelMessageCallback callback) { _channelMessageCallback = callback; }
         void setChannelPresenceCallback(ChannelPresenceCallback callback) { _channelPresenceCallback = callback; }
         void setMatchmakerMatchedCallback(MatchmakerMatchedCallback callback) { _matchmakerMatchedCallback = callback; }
@@ -69,10 +71,27 @@ NAKAMA_NAMESPACE_BEGIN
         void setStreamPresenceCallback(StreamPresenceCallback callback) { _streamPresenceCallback = callback; }
         void setStreamDataCallback(StreamDataCallback callback) { _streamDataCallback = callback; }
 
+        /**
+         * Opt out of an event type, so the client drops its events before decoding them.
+         *
+         * Every type is decoded and delivered by default, whether a callback is set or an `on*` method overridden.
+         * Call from the thread processing realtime messages or before connecting.
+         */
+        void setSubscribed(NRtEventType type, bool subscribed)
+        {
+            if (subscribed)
+                _unsubscribed &= ~eventBit(type);
+            else
+                _unsubscribed |= eventBit(type);
+        }
+
+        bool isSubscribed(NRtEventType type) const override { return (_unsubscribed & eventBit(type)) == 0; }
+
     protected:
         void onConnect() override { if (_connectCallback) _connectCallback(); }
         void onDisconnect(const NRtClientDisconnectInfo& info) override { if (_disconnectCallback) _disconnectCallback(info); }
         void onError(const NRtError& error) override { if (_errorCallback) _errorCallback(error); }
+        void onSendQueueWritable() override { if (_sendQueueWritableCallback) _sendQueueWritableCallback(); }
         void onChannelMessage(const NChannelMessage& message) override { if (_channelMessageCallback) _channelMessageCallback(message); }
         void onChannelPresence(const NChannelPresenceEvent& presence) override { if (_channelPresenceCallback) _channelPresenceCallback(presence); }
         void onMatchmakerMatched(NMatchmakerMatchedPtr matched) override { if (_matchmakerMatchedCallback) _matchmakerMatchedCallback(matched); }
@@ -94,6 +113,7 @@ NAKAMA_NAMESPACE_BEGIN
         ConnectCallback _connectCallback;
         DisconnectCallback _disconnectCallback;
         ErrorCallback _errorCallback;
+        SendQueueWritableCallback _sendQueueWritableCallback;
         ChannelMessageCallback _channelMessageCallback;
         ChannelPresenceCallback _channelPresenceCallback;
         MatchmakerMatchedCallback _matchmakerMatchedCallback;
@@ -110,6 +130,11 @@ NAKAMA_NAMESPACE_BEGIN
         StatusPresenceCallback _statusPresenceCallback;
         StreamPresenceCallback _streamPresenceCallback;
         StreamDataCallback _streamDataCallback;
+
+    private:
+        static uint32_t eventBit(NRtEventType type) { return uint32_t(1) << static_cast<uint32_t>(type); }
+
+        uint32_t _unsubscribed = 0; // bits of NRtEventType
     };
 
 NAKAMA_NAMESPACE_END
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+    struct NRtReactorConfig
+    {
+        size_t threads = 1;  ///< I/O threads, transports are spread over them round robin.
+    };
+
+    struct NRtReactorStats
+    {
+        size_t threads = 0;
+        size_t transports = 0;      ///< Attached now, i.e. connecting or connected.
+        uint64_t wakeups = 0;       ///< Times an I/O thread woke up, for readiness, a send or the polling timer.
+        uint64_t services = 0;      ///< Times a transport was serviced.
+    };
+
+    /**
+     * Event loop shared by many realtime transports, see `createRtReactor`.
+     *
+     * By default every websocket transport runs its I/O on a thread of its own. Transports created with a reactor
+     * are serviced by its threads instead, which wait for socket readiness rather than polling, so a process
+     * with thousands of connections, e.g. a bot farm or a server talking to Nakama, needs a handful of threads.
+     * Messages are still delivered by `NRtClientInterface::tick` of each client, in the thread which calls it.
+     *
+     * The reactor lives as long as a transport or the application holds it.
+     */
+    class NAKAMA_API NRtReactorInterface
+    {
+    public:
+        virtual ~NRtReactorInterface() {}
+
+        virtual NRtReactorStats getStats() const = 0;
+
+        /**
+         * The websocket implementation which services the reactor, only its transports can run on it.
+         */
+        virtual const char* getTransportName() const = 0;
+    };
+
+    using NRtReactorPtr = std::shared_ptr<NRtReactorInterface>;
+
+NAKAMA_NAMESPACE_END
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <nakama-cpp/NExport.h>
+#include <nakama-cpp/NTypes.h>
+#include <nakama-cpp/realtime/NRtTransportInterface.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+    /**
+     * How fast `createReplayTransport` delivers recorded messages.
+     */
+    enum class NRtReplaySpeed
+    {
+        Original,  ///< With the recorded gaps between messages, counted from the connect.
+        Maximum    ///< Everything of a connection in the first tick after it connected.
+    };
+
+    /**
+     * A transport which plays a traffic log back, see `createReplayTransport`.
+     *
+     * Every `connect` replays the next connection of the log: its messages from the server are delivered by
+     * `tick`, messages the client sends are accepted and dropped. A connection closed by the server in the log is
+     * closed the same way, one the application closed stays connected once it is done.
+     */
+    class NRtReplayTransportInterface : public NRtTransportInterface
+    {
+    public:
+        /**
+         * @return True if the connection being replayed has no messages or disconnect left to deliver.
+         */
+        virtual bool isReplayDone() const = 0;
+
+        /**
+         * @return Messages delivered since the transport was created.
+         */
+        virtual uint64_t getReplayedMessages() const = 0;
+    };
+
+    using NRtReplayTransportPtr = std::shared_ptr<NRtReplayTransportInterface>;
+
+    /**
+     * Wrap a transport to record its traffic, e.g. to profile message handling offline with `createReplayTransport`.
+     *
+     * Connects, disconnects, errors and every message in either direction are appended to the file at `path`
+     * with a timestamp and the transport type, so recordings of several connections or runs can share a file.
+     * Recording costs a buffered write per message, the buffer is flushed by `tick`.
+     *
+     * Log format, all integers little endian: a 16 byte file header, "NKRTLOG1", the version (uint32, 1) and the
+     * header size (uint32, 16). Records follow: Unix time in nanoseconds (uint64), payload size (uint32), kind
+     * (uint8: 1 connect, 2 disconnect, 3 message received, 4 message sent, 5 error, 6 closed by the application),
+     * `NRtTransportType` (uint8), 2 reserved bytes and the payload. Connects carry the URL, disconnects
+     * the close code (uint16), whether the server closed (uint8) and the reason, errors their description.
+     *
+     * @param transport The transport to record, e.g. from `createDefaultWebsocket`.
+     * @param path Log file, created if it doesn't exist.
+     * @return nullptr if the file can't be opened for appending or isn't a traffic log.
+     */
+    NAKAMA_API NRtTransportPtr createRecordingTransport(NRtTransportPtr transport, const std::string& path);
+
+    /**
+     * Create a transport which replays a traffic log written by `createRecordingTransport`.
+     *
+     * The file is memory mapped and must not change during the replay. Connect with the protocol it was recorded
+     * with, a connection of the other transport type fails with an error.
+     *
+     * @return nullptr if the file can't be read or isn't a traffic log.
+     */
+    NAKAMA_API NRtReplayTransportPtr createReplayTransport(const std::string& path,
+                                                          NRtReplaySpeed speed = NRtReplaySpeed::Original);
+
+NAKAMA_NAMESPACE_END
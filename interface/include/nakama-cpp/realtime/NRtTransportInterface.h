@@ -18,8 +18,13 @@
 
 #include <nakama-cpp/NTypes.h>
 #include <nakama-cpp/realtime/NRtClientDisconnectInfo.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
 NAKAMA_NAMESPACE_BEGIN
@@ -30,6 +35,146 @@ NAKAMA_NAMESPACE_BEGIN
         Text     ///< used by `Json` protocol
     };
 
+    /**
+     * RFC 7692 permessage-deflate settings, see `NRtTransportInterface::setDeflate`.
+     *
+     * The client offers the extension and compresses messages only if the server accepts it.
+     * Window bits range from 9 to 15, every bit less halves the memory of a stream.
+     */
+    struct NWebsocketDeflateConfig
+    {
+        bool enabled = false;                   ///< Offer permessage-deflate in the handshake.
+        uint8_t clientMaxWindowBits = 15;       ///< Window of the client's compressor.
+        uint8_t serverMaxWindowBits = 15;       ///< Window the server is asked to compress with.
+        bool clientNoContextTakeover = false;   ///< Compress every message on its own: worse ratio, no window kept.
+        bool serverNoContextTakeover = false;   ///< Ask the server to do the same for the messages it sends.
+        size_t minSize = 64;                    ///< Messages smaller than this are sent uncompressed.
+        int level = 1;                          ///< zlib compression level, 1 (fastest) to 9.
+    };
+
+    /**
+     * Socket settings of transports which manage their own socket, see `NRtTransportInterface::setSocketOptions`.
+     */
+    struct NSocketOptions
+    {
+        bool tcpNoDelay = true;             ///< Send small messages right away instead of coalescing them (Nagle).
+        int sendBufferSize = 0;             ///< SO_SNDBUF in bytes, 0 keeps the system default.
+        int receiveBufferSize = 0;          ///< SO_RCVBUF in bytes, 0 keeps the system default.
+        uint32_t connectTimeoutMs = 5000;   ///< Limit of DNS resolution, TCP connect and TLS handshake together.
+    };
+
+    /**
+     * What happens to a message sent while the send queue is at its high watermark.
+     */
+    enum class NSendOverflowPolicy
+    {
+        Reject,      ///< Refuse the new message.
+        DropOldest,  ///< Drop the oldest queued messages with the new one's drop key, refuse it if that isn't enough.
+        Block        ///< Wait up to `blockTimeoutMs` for the queue to drain, then refuse the message.
+    };
+
+    enum class NSendResult
+    {
+        Queued,      ///< The message will be sent.
+        Rejected,    ///< The send queue is full, see `NSendOverflowPolicy`. The connection is fine.
+        Failed       ///< Not connected or the transport failed.
+    };
+
+    /**
+     * Class of an outgoing message. The transport writes queued messages of a more urgent class first, order is kept
+     * within a class only.
+     */
+    enum class NSendPriority
+    {
+        Control,     ///< Requests and reliable match or party data, never dropped.
+        Latest,      ///< State which a newer message with the same drop key supersedes while it is queued.
+        Bulk         ///< Chat messages and RPCs, written when nothing more urgent is queued.
+    };
+
+    /**
+     * What a queued message can be superseded or dropped for, see `NRtTransportInterface::trySend`. `NRtClient` keys
+     * match and party data by the match or party id and the op code.
+     */
+    struct NSendDropKey
+    {
+        std::string streamId;
+        int64_t opCode = 0;
+
+        bool operator==(const NSendDropKey& other) const
+        {
+            return opCode == other.opCode && streamId == other.streamId;
+        }
+    };
+
+    /**
+     * Limits of the outgoing message queue of a transport, see `NRtTransportInterface::setSendQueueConfig`.
+     *
+     * The high watermarks are the capacity of the queue, a message which would exceed one overflows. A limit of 0
+     * disables it. Once the queue was full, the writable callback fires when it drains down to both low watermarks.
+     * A single message larger than the capacity is accepted into an empty queue.
+     */
+    struct NSendQueueConfig
+    {
+        size_t highWatermarkBytes = 0;          ///< Capacity in bytes, 0 for no limit.
+        size_t lowWatermarkBytes = 0;           ///< Queued bytes at which a full queue is writable again.
+        size_t highWatermarkMessages = 0;       ///< Capacity in messages, 0 for no limit.
+        size_t lowWatermarkMessages = 0;        ///< Queued messages at which a full queue is writable again.
+        NSendOverflowPolicy overflowPolicy = NSendOverflowPolicy::Reject;
+        uint32_t blockTimeoutMs = 50;           ///< Longest wait of a send with `NSendOverflowPolicy::Block`.
+        /// Op codes of match and party data which `NRtClient` sends as `NSendPriority::Latest` with a drop key of
+        /// their match or party and op code, so newer state supersedes queued state. Ignored by transports.
+        std::vector<int64_t> droppableOpCodes;
+    };
+
+    /**
+     * Depth of the queue of one `NSendPriority` and how long its messages wait in it.
+     *
+     * Queued counts leave out messages handed to the socket layer, which has no classes.
+     */
+    struct NSendLaneStats
+    {
+        size_t queuedMessages = 0;
+        size_t queuedBytes = 0;
+        uint64_t sentMessages = 0;                      ///< Handed to the socket layer.
+        uint64_t supersededMessages = 0;                ///< Replaced by a newer message with the same drop key.
+        std::chrono::microseconds lastQueueDelay{0};
+        std::chrono::microseconds averageQueueDelay{0}; ///< Exponential moving average over recent messages.
+        std::chrono::microseconds maxQueueDelay{0};
+    };
+
+    /**
+     * Depth of the outgoing message queue and how long messages wait in it.
+     *
+     * Queued counts include messages handed to the socket layer of the transport but not written yet.
+     * Delays run from the send call until the message is handed to the socket layer.
+     */
+    struct NSendQueueStats
+    {
+        size_t queuedMessages = 0;
+        size_t queuedBytes = 0;
+        size_t peakQueuedBytes = 0;
+        uint64_t rejectedMessages = 0;
+        uint64_t droppedMessages = 0;                   ///< Dropped by `NSendOverflowPolicy::DropOldest`.
+        uint64_t blockedSends = 0;                      ///< Sends which waited with `NSendOverflowPolicy::Block`.
+        std::chrono::microseconds lastQueueDelay{0};
+        std::chrono::microseconds averageQueueDelay{0}; ///< Exponential moving average over recent messages.
+        std::chrono::microseconds maxQueueDelay{0};
+        bool writable = true;                           ///< False from overflow until the low watermarks are reached.
+        NSendLaneStats control;
+        NSendLaneStats latest;
+        NSendLaneStats bulk;
+
+        NSendLaneStats& lane(NSendPriority priority)
+        {
+            switch (priority)
+            {
+                case NSendPriority::Control: return control;
+                case NSendPriority::Latest: return latest;
+                default: return bulk;
+            }
+        }
+    };
+
     /**
      * A real-time transport interface to send and receive data.
      */
@@ -42,11 +187,13 @@ NAKAMA_NAMESPACE_BEGIN
         using DisconnectCallback = std::function<void(const NRtClientDisconnectInfo& info)>;
         using ErrorCallback = std::function<void(const std::string&)>;
         using MessageCallback = std::function<void(const NBytes&)>;
+        using WritableCallback = std::function<void()>;
 
         void setConnectCallback(ConnectCallback callback) { _connectCallback = callback; }
         void setDisconnectCallback(DisconnectCallback callback) { _disconnectCallback = callback; }
         void setErrorCallback(ErrorCallback callback) { _errorCallback = callback; }
         void setMessageCallback(MessageCallback callback) { _messageCallback = callback; }
+        void setWritableCallback(WritableCallback callback) { _writableCallback = callback; }
 
         /**
          * Set activity timeout, milliseconds.
@@ -110,17 +257,63 @@ NAKAMA_NAMESPACE_BEGIN
          */
         virtual bool send(const NBytes& data) = 0;
 
+        /**
+         * Send bytes data to the server, telling a full send queue apart from a failed transport.
+         *
+         * @param data The byte data to send.
+         * @param dropKey Messages with a key may be dropped for a newer one with the same key while they are queued.
+         * @param priority Class of the message. A `NSendPriority::Latest` message with a drop key supersedes queued
+         *        messages with the same key if the queue has room for the difference in size, otherwise it
+         *        overflows like any other message.
+         * @return Whether the message was queued, see `NSendResult`.
+         */
+        virtual NSendResult trySend(const NBytes& data, const std::optional<NSendDropKey>& dropKey = std::nullopt,
+            NSendPriority priority = NSendPriority::Control)
+        {
+            (void)dropKey;
+            (void)priority;
+            return send(data) ? NSendResult::Queued : NSendResult::Failed;
+        }
+
+        /**
+         * Configure the limits of the send queue, takes effect immediately.
+         *
+         * @return False if the transport doesn't support a bounded send queue.
+         */
+        virtual bool setSendQueueConfig(const NSendQueueConfig& /*config*/) { return false; }
+
+        /**
+         * Get depth and delays of the send queue. Safe to call from any thread.
+         */
+        virtual NSendQueueStats getSendQueueStats() const { return {}; }
+
+        /**
+         * Configure permessage-deflate compression of messages. Takes effect on the next `connect`.
+         *
+         * @return False if the transport doesn't support compression.
+         */
+        virtual bool setDeflate(const NWebsocketDeflateConfig& /*config*/) { return false; }
+
+        /**
+         * Configure the socket of the connection. Takes effect on the next `connect`.
+         *
+         * @return False if the transport doesn't manage its socket, e.g. the wslay transport with curl IO.
+         */
+        virtual bool setSocketOptions(const NSocketOptions& /*options*/) { return false; }
+
     protected:
         void fireOnConnected() { _connected = true; if (_connectCallback) _connectCallback(); }
         void fireOnDisconnected(const NRtClientDisconnectInfo& info) { _connected = false; if (_disconnectCallback) _disconnectCallback(info); }
         void fireOnError(const std::string& description) { if (_errorCallback) _errorCallback(description); }
         void fireOnMessage(const NBytes& data) { if (_messageCallback) _messageCallback(data); }
+        void fireOnWritable() { if (_writableCallback) _writableCallback(); }
 
     protected:
         ConnectCallback _connectCallback;
         DisconnectCallback _disconnectCallback;
         ErrorCallback _errorCallback;
         MessageCallback _messageCallback;
+        WritableCallback _writableCallback;
         bool _connected = false;
     };
 
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <nakama-cpp/NTypes.h>
+
+NAKAMA_NAMESPACE_BEGIN
+
+    enum class NRttProbeMode
+    {
+        /// Sample only existing traffic: heartbeat pings, request/response pairs and timestamped messages.
+        Piggyback,
+        /// Additionally send a probe every `probeInterval`, also while other requests are pending.
+        Ping
+    };
+
+    /// Round trip time and server clock estimation, see `NRtClientInterface::setRttConfig`.
+    struct NRttConfig
+    {
+        NRttProbeMode mode = NRttProbeMode::Piggyback;
+
+        std::chrono::milliseconds probeInterval{1000};
+
+        /// Realtime RPC probed instead of ping in `NRttProbeMode::Ping`. It has to return the server's Unix time
+        /// in milliseconds as its payload, e.g. `return tostring(nk.time())` in Lua, which gives clock offset samples
+        /// far more precise than the second resolution timestamps of chat messages.
+        std::string clockRpcId;
+
+        /// Window of the minimum RTT.
+        std::chrono::seconds minRttWindow{10};
+    };
+
+    /**
+     * Round trip time and server clock offset, see `NRtClientInterface::getRttStats`.
+     *
+     * RTT samples run from sending a request until the transport delivered its response, so they include the
+     * I/O latency of the transport. Responses of RPCs and match creation or joins are not sampled, their
+     * server side processing time would distort the estimate.
+     */
+    struct NRttStats
+    {
+        std::chrono::microseconds smoothedRtt{0};       ///< SRTT of RFC 6298, gain 1/8.
+        std::chrono::microseconds rttVariation{0};      ///< RTTVAR of RFC 6298, gain 1/4. A measure of jitter.
+        std::chrono::microseconds minRtt{0};            ///< Lowest RTT within `NRttConfig::minRttWindow`.
+        std::chrono::microseconds latestRtt{0};
+        uint64_t samples = 0;                           ///< RTT samples since connect.
+
+        /// Whether `clockOffset` is known: it needs a timestamped response to a request of this client,
+        /// e.g. the ack of a chat message or the clock RPC.
+        bool clockOffsetValid = false;
+        /// Server clock minus local system clock. Server time is `system_clock::now() + clockOffset`.
+        std::chrono::microseconds clockOffset{0};
+        /// The offset is within +- this of the true one, as long as neither clock jumped.
+        std::chrono::microseconds clockOffsetError{0};
+    };
+
+NAKAMA_NAMESPACE_END
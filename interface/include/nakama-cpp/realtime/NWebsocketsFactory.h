@@ -18,6 +18,7 @@
 
 #include <nakama-cpp/NTypes.h>
 #include <nakama-cpp/NExport.h>
+#include <nakama-cpp/realtime/NRtReactor.h>
 #include <nakama-cpp/realtime/NRtTransportInterface.h>
 #include <nakama-cpp/NPlatformParams.h>
 
@@ -29,6 +30,23 @@ NAKAMA_NAMESPACE_BEGIN
      */
 #ifdef HAVE_DEFAULT_RT_TRANSPORT_FACTORY
     NAKAMA_API NRtTransportPtr createDefaultWebsocket(const NPlatformParameters& platformParameters);
+
+    /**
+     * Create default websocket transport which runs its I/O on `reactor` instead of a thread of its own.
+     *
+     * A null `reactor` creates a transport with its own I/O thread, like the overload without one.
+     *
+     * @return nullptr if `reactor` wasn't created by `createRtReactor`.
+     */
+    NAKAMA_API NRtTransportPtr createDefaultWebsocket(const NPlatformParameters& platformParameters,
+                                                      const NRtReactorPtr& reactor);
+
+    /**
+     * Create an event loop to share among websocket transports, see `NRtReactorInterface`.
+     *
+     * @return nullptr if the default websocket transport of the platform has no reactor support.
+     */
+    NAKAMA_API NRtReactorPtr createRtReactor(const NRtReactorConfig& config = {});
 #endif
 
 
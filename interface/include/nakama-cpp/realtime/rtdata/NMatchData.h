@@ -28,6 +28,11 @@ NAKAMA_NAMESPACE_BEGIN
         NUserPresence presence;    ///< A reference to the user presence that sent this data, if any.
         std::int64_t opCode;            ///< Op code value.
         NBytes data;               ///< Data payload, if any.
+
+        /// Set instead of matchId with string interning enabled.
+        NInternedString matchIdHandle;
+
+        const std::string& getMatchId() const { return matchIdHandle.isNull() ? matchId : matchIdHandle.str(); }
     };
 
 NAKAMA_NAMESPACE_END
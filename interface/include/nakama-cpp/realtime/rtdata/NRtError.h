@@ -30,6 +30,7 @@ NAKAMA_NAMESPACE_BEGIN
         CONNECT_ERROR                 = -1,           ///< Connect has failed.
         TRANSPORT_ERROR               = -2,           ///< Transport error.
         DISCONNECTED                  = -3,           ///< Request cancelled due to transport disconnect
+        SEND_QUEUE_FULL               = -4,           ///< The transport's send queue is full, see `NSendQueueConfig`.
 
         // server side errors
         RUNTIME_EXCEPTION             = 0,            ///< An unexpected result from the server.
@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include <nakama-cpp/NInternedString.h>
 #include <nakama-cpp/NTypes.h>
 
 NAKAMA_NAMESPACE_BEGIN
@@ -30,6 +31,16 @@ NAKAMA_NAMESPACE_BEGIN
         std::string username;           ///< The username for display purposes.
         bool persistence = false;       ///< Whether this presence generates persistent data/messages, if applicable for the stream type.
         std::string status;             ///< A user-set status message for this stream, if applicable.
+
+        /// With string interning enabled these are set instead of userId, sessionId and username,
+        /// which stay empty. The get* accessors read either.
+        NInternedString userIdHandle;
+        NInternedString sessionIdHandle;
+        NInternedString usernameHandle;
+
+        const std::string& getUserId() const { return userIdHandle.isNull() ? userId : userIdHandle.str(); }
+        const std::string& getSessionId() const { return sessionIdHandle.isNull() ? sessionId : sessionIdHandle.str(); }
+        const std::string& getUsername() const { return usernameHandle.isNull() ? username : usernameHandle.str(); }
     };
 
 NAKAMA_NAMESPACE_END
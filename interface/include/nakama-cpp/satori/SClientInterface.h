@@ -20,6 +20,8 @@
 #include <memory>
 
 #include "HardcodedLowLevelSatoriAPI.h"
+#include "SConfigCache.h"
+#include "SEventQueue.h"
 #include "nakama-cpp/NClientInterface.h"
 
 namespace Satori {
@@ -36,6 +38,22 @@ public:
   virtual void disconnect() = 0;
   virtual void tick() = 0;
 
+  /**
+   * Pumps requests queue, spending at most `budget` on processing responses, failed requests first.
+   * Whatever doesn't fit into the budget is carried over to the next call.
+   */
+  virtual void tick(std::chrono::microseconds budget) = 0;
+  virtual Nakama::NTickStats getTickStats() const = 0;
+
+  /**
+   * Run transport I/O and response decoding on an internal thread, so `tick` doesn't have to pump it.
+   * Callbacks are posted to `callbackExecutor`, or executed from `tick` if it is nullptr.
+   */
+  virtual void startIoThread(
+      Nakama::NExecutorPtr callbackExecutor = nullptr,
+      std::chrono::milliseconds interval = std::chrono::milliseconds(10)) = 0;
+  virtual void stopIoThread() = 0;
+
   virtual void authenticate(
       const std::string& id,
       const std::unordered_map<std::string, std::string>& defaultProperties = {},
@@ -84,6 +102,53 @@ public:
 
   virtual std::future<void> serverEventAsync(const std::vector<SEvent>& events) = 0;
 
+  /**
+   * Set the flush policy of the event queue. Applies to events queued afterwards.
+   */
+  virtual void configureEventQueue(const SEventQueueConfig& config) = 0;
+
+  /**
+   * Session queued events are published with. Events spilled to disk by a previous run are replayed
+   * when a session is set. Without a session events are kept queued.
+   */
+  virtual void setEventQueueSession(SSessionPtr session) = 0;
+
+  /**
+   * Queue an event to be published in a batch, according to `SEventQueueConfig`.
+   * Events without `id` get a random one, so the server can de-duplicate retransmissions.
+   * Can be called from any thread.
+   */
+  virtual void queueEvent(SEvent event) = 0;
+
+  /**
+   * Send queued events now regardless of flush policy, e.g. when the application goes to background.
+   * The request still needs `tick` or the I/O thread to complete.
+   */
+  virtual void flushEvents() = 0;
+
+  virtual SEventQueueStats getEventQueueStats() const = 0;
+
+  /**
+   * Keep flags and live events of `session` cached locally, see `getConfigCache`. The snapshot file is
+   * loaded right away and the cache is refreshed from `tick` or the I/O thread every `refreshInterval`,
+   * revalidating with ETags where the transport supports response headers.
+   * Call again with a refreshed session or to change the config.
+   */
+  virtual void startConfigCache(SSessionPtr session, const SConfigCacheConfig& config = SConfigCacheConfig()) = 0;
+  virtual void stopConfigCache() = 0;
+
+  /**
+   * Refresh the config cache now instead of waiting for `refreshInterval`.
+   */
+  virtual void refreshConfigCache() = 0;
+
+  /**
+   * Called with the names of changed flags and live events after a refresh changed the cache.
+   */
+  virtual void setConfigChangedCallback(std::function<void(const SConfigChanges&)> callback) = 0;
+
+  virtual const SConfigCacheInterface& getConfigCache() const = 0;
+
   virtual void getExperiments(
       SSessionPtr session,
       const SGetExperimentsRequest& request = SGetExperimentsRequest(),
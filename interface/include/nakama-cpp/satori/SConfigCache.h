@@ -0,0 +1,74 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "HardcodedLowLevelSatoriAPI.h"
+#include "nakama-cpp/NExport.h"
+
+namespace Satori {
+
+// What the config cache fetches and how often, see `SClientInterface::startConfigCache`.
+struct SConfigCacheConfig {
+  // Time between background refreshes.
+  std::chrono::milliseconds refreshInterval{60000};
+  // Filter of cached flags.
+  SGetFlagsRequest flagsRequest;
+  // Whether to cache live events as well.
+  bool liveEvents = true;
+  // Filter of cached live events.
+  SGetLiveEventsRequest liveEventsRequest{};
+  // Fetched data is saved to this file and loaded on start, so values are available before the first
+  // refresh completes. Empty disables the snapshot.
+  std::string snapshotFilePath;
+};
+
+// Names of flags and live events which were added, removed or changed by a refresh.
+struct SConfigChanges {
+  std::vector<std::string> flags;
+  std::vector<std::string> liveEvents;
+};
+
+/**
+ * Local copy of flags and live events, kept up to date by the client.
+ * Lookups don't touch the network and can be called from any thread.
+ */
+class NAKAMA_API SConfigCacheInterface {
+public:
+  virtual ~SConfigCacheInterface();
+
+  // True once data was fetched from the server or loaded from the snapshot.
+  virtual bool isReady() const = 0;
+
+  virtual bool getFlag(const std::string& name, SFlag& flag) const = 0;
+
+  // Flag value, or `defaultValue` if the flag is unknown or its value can't be converted.
+  virtual std::string getString(const std::string& name, const std::string& defaultValue = std::string()) const = 0;
+  virtual bool getBool(const std::string& name, bool defaultValue) const = 0;
+  virtual int64_t getInt(const std::string& name, int64_t defaultValue) const = 0;
+  virtual double getDouble(const std::string& name, double defaultValue) const = 0;
+
+  // Looks up both live events and explicit join live events by name.
+  virtual bool getLiveEvent(const std::string& name, SLiveEvent& liveEvent) const = 0;
+  virtual SLiveEventList getLiveEvents() const = 0;
+};
+
+} // namespace Satori
@@ -0,0 +1,67 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Satori {
+
+// Flush policy of the event queue, see `SClientInterface::queueEvent`.
+// A batch is sent as soon as any of the limits is reached.
+struct SEventQueueConfig {
+  // Maximum number of events in one request.
+  size_t maxBatchEvents = 100;
+  // Send once queued events take about this many bytes of JSON.
+  size_t maxBatchBytes = 64 * 1024;
+  // Send once the oldest queued event is this old.
+  std::chrono::milliseconds maxBatchAge{10000};
+  // Attempts for a batch the server failed to process, after which it is dropped.
+  int maxRetries = 3;
+  // Delay before retrying a failed batch, doubled with each attempt up to `maxRetryBackoff`.
+  std::chrono::milliseconds retryBackoff{1000};
+  std::chrono::milliseconds maxRetryBackoff{60000};
+  // Events which can't be delivered while offline are appended to this file and
+  // replayed with the next session. Empty keeps them in memory only.
+  std::string spillFilePath;
+  // Events which don't fit into the spill file any more are dropped.
+  size_t maxSpillBytes = 1024 * 1024;
+  // Limit of events kept in memory. Oldest events are spilled to disk, or dropped without a spill file.
+  size_t maxQueuedEvents = 10000;
+};
+
+struct SEventQueueStats {
+  // Events waiting in memory.
+  size_t queued = 0;
+  // Events in the request being sent.
+  size_t inFlight = 0;
+  // Events accepted by the server.
+  uint64_t sent = 0;
+  uint64_t batchesSent = 0;
+  // Batches sent again after a failure.
+  uint64_t retries = 0;
+  // Events written to the spill file.
+  uint64_t spilled = 0;
+  // Events read back from the spill file.
+  uint64_t replayed = 0;
+  // Events rejected by the server or evicted from a full queue.
+  uint64_t dropped = 0;
+};
+
+} // namespace Satori
@@ -0,0 +1,48 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "SClientInterface.h"
+#include "nakama-cpp/NPaginator.h"
+
+namespace Satori {
+
+// Walks the identity's messages page by page, see `Nakama::NPaginator`. `limit` is the page size.
+inline Nakama::NPaginatorPtr<SMessage> paginateMessages(
+    SClientPtr client,
+    SSessionPtr session,
+    int32_t limit,
+    bool forward = true,
+    Nakama::NPaginatorOptions options = {}) {
+  return Nakama::NPaginator<SMessage>::create(
+      [client, session, limit, forward](const std::string& cursor, auto onPage, auto onError) {
+        client->getMessages(
+            session,
+            limit,
+            forward,
+            cursor,
+            [onPage](SGetMessageListResponse response) {
+              onPage(std::move(response.messages), std::move(response.next_cursor));
+            },
+            onError);
+      },
+      options);
+}
+
+} // namespace Satori
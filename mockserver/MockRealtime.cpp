@@ -0,0 +1,411 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MockRealtime.h"
+#include "MockUtil.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Nakama {
+namespace Test {
+
+namespace {
+
+constexpr int kBadInput = 3;
+
+// ChannelJoin.type
+constexpr int kChannelRoom = 1;
+constexpr int kChannelDirectMessage = 2;
+constexpr int kChannelGroup = 3;
+
+// ChannelMessage.code
+constexpr int kMessageChat = 0;
+constexpr int kMessageUpdate = 1;
+constexpr int kMessageRemove = 2;
+
+void setNow(google::protobuf::Timestamp* timestamp) {
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  auto seconds = std::chrono::duration_cast<std::chrono::seconds>(now);
+  timestamp->set_seconds(seconds.count());
+  timestamp->set_nanos(int32_t(std::chrono::duration_cast<std::chrono::nanoseconds>(now - seconds).count()));
+}
+
+template <class T> bool remove(std::vector<T>& v, const T& value) {
+  auto it = std::find(v.begin(), v.end(), value);
+  if (it == v.end()) {
+    return false;
+  }
+  v.erase(it);
+  return true;
+}
+
+template <class T> bool contains(const std::vector<T>& v, const T& value) {
+  return std::find(v.begin(), v.end(), value) != v.end();
+}
+
+} // namespace
+
+void MockRealtime::connect(uint64_t connection, const std::string& userId, const std::string& username) {
+  Session& session = _sessions[connection];
+  session.userId = userId;
+  session.username = username;
+  session.sessionId = newUuid(_rng);
+}
+
+void MockRealtime::disconnect(uint64_t connection) {
+  auto it = _sessions.find(connection);
+  if (it == _sessions.end()) {
+    return;
+  }
+
+  // matchLeave and channelLeave edit these lists
+  for (const std::string& matchId : std::vector<std::string>(it->second.matches)) {
+    matchLeave(connection, matchId, {});
+  }
+  for (const std::string& channelId : std::vector<std::string>(it->second.channels)) {
+    channelLeave(connection, channelId, {});
+  }
+
+  _sessions.erase(connection);
+}
+
+void MockRealtime::handle(uint64_t connection, const Envelope& request) {
+  if (!_sessions.count(connection)) {
+    return;
+  }
+
+  Envelope response;
+
+  switch (request.message_case()) {
+  case Envelope::kPing:
+    response.mutable_pong();
+    reply(connection, request, std::move(response));
+    break;
+  case Envelope::kRpc:
+    *response.mutable_rpc() = request.rpc();
+    response.mutable_rpc()->clear_http_key();
+    reply(connection, request, std::move(response));
+    break;
+  case Envelope::kMatchCreate:
+    matchCreate(connection, request);
+    break;
+  case Envelope::kMatchJoin:
+    matchJoin(connection, request);
+    break;
+  case Envelope::kMatchLeave:
+    matchLeave(connection, request.match_leave().match_id(), request.cid());
+    break;
+  case Envelope::kMatchDataSend:
+    matchData(connection, request);
+    break;
+  case Envelope::kChannelJoin:
+    channelJoin(connection, request);
+    break;
+  case Envelope::kChannelLeave:
+    channelLeave(connection, request.channel_leave().channel_id(), request.cid());
+    break;
+  case Envelope::kChannelMessageSend:
+  case Envelope::kChannelMessageUpdate:
+  case Envelope::kChannelMessageRemove:
+    channelMessage(connection, request);
+    break;
+  case Envelope::kStatusFollow:
+    // nobody the mock knows is followed
+    response.mutable_status();
+    reply(connection, request, std::move(response));
+    break;
+  case Envelope::kStatusUnfollow:
+  case Envelope::kStatusUpdate:
+    reply(connection, request, std::move(response));
+    break;
+  default:
+    if (!request.cid().empty()) {
+      _send(connection, error(request.cid(), kRuntimeException, "Not supported by the mock server."));
+    }
+    break;
+  }
+}
+
+MockRealtime::Envelope MockRealtime::error(const std::string& cid, int code, const std::string& message) {
+  Envelope envelope;
+  envelope.set_cid(cid);
+  envelope.mutable_error()->set_code(code);
+  envelope.mutable_error()->set_message(message);
+  return envelope;
+}
+
+void MockRealtime::matchCreate(uint64_t connection, const Envelope& request) {
+  // relayed match ids have an empty node name
+  std::string matchId = newUuid(_rng) + ".";
+  _matches[matchId].push_back(connection);
+  _sessions[connection].matches.push_back(matchId);
+
+  Envelope response;
+  auto* match = response.mutable_match();
+  match->set_match_id(matchId);
+  match->set_authoritative(false);
+  match->set_size(1);
+  setPresence(match->mutable_self(), connection);
+  reply(connection, request, std::move(response));
+}
+
+void MockRealtime::matchJoin(uint64_t connection, const Envelope& request) {
+  const std::string& matchId = request.match_join().match_id();
+  auto it = _matches.find(matchId);
+  if (it == _matches.end()) {
+    _send(connection, error(request.cid(), kMatchNotFound, "Match not found"));
+    return;
+  }
+
+  std::vector<uint64_t>& members = it->second;
+  if (!contains(members, connection)) {
+    Envelope event;
+    event.mutable_match_presence_event()->set_match_id(matchId);
+    setPresence(event.mutable_match_presence_event()->add_joins(), connection);
+    for (uint64_t member : members) {
+      _send(member, event);
+    }
+
+    members.push_back(connection);
+    _sessions[connection].matches.push_back(matchId);
+  }
+
+  Envelope response;
+  auto* match = response.mutable_match();
+  match->set_match_id(matchId);
+  match->set_authoritative(false);
+  match->set_size(int32_t(members.size()));
+  for (uint64_t member : members) {
+    setPresence(member == connection ? match->mutable_self() : match->add_presences(), member);
+  }
+  reply(connection, request, std::move(response));
+}
+
+void MockRealtime::matchLeave(uint64_t connection, const std::string& matchId, const std::string& cid) {
+  auto it = _matches.find(matchId);
+  if (it != _matches.end() && remove(it->second, connection)) {
+    remove(_sessions[connection].matches, matchId);
+
+    Envelope event;
+    event.mutable_match_presence_event()->set_match_id(matchId);
+    setPresence(event.mutable_match_presence_event()->add_leaves(), connection);
+    for (uint64_t member : it->second) {
+      _send(member, event);
+    }
+
+    if (it->second.empty()) {
+      _matches.erase(it);
+    }
+  }
+
+  if (!cid.empty()) {
+    Envelope response;
+    response.set_cid(cid);
+    _send(connection, response);
+  }
+}
+
+void MockRealtime::matchData(uint64_t connection, const Envelope& request) {
+  const auto& send = request.match_data_send();
+  auto it = _matches.find(send.match_id());
+  // like the server, data for matches the sender isn't part of is dropped silently
+  if (it == _matches.end() || !contains(it->second, connection)) {
+    return;
+  }
+
+  Envelope envelope;
+  auto* data = envelope.mutable_match_data();
+  data->set_match_id(send.match_id());
+  setPresence(data->mutable_presence(), connection);
+  data->set_op_code(send.op_code());
+  data->set_data(send.data());
+  data->set_reliable(send.reliable());
+
+  for (uint64_t member : it->second) {
+    if (member == connection && !_echoMatchData) {
+      continue;
+    }
+
+    if (send.presences_size() > 0) {
+      const std::string& sessionId = _sessions[member].sessionId;
+      bool addressed = std::any_of(send.presences().begin(), send.presences().end(), [&](const auto& presence) {
+        return presence.session_id() == sessionId;
+      });
+      if (!addressed) {
+        continue;
+      }
+    }
+
+    _send(member, envelope);
+  }
+}
+
+void MockRealtime::channelJoin(uint64_t connection, const Envelope& request) {
+  const auto& join = request.channel_join();
+  const Session& session = _sessions[connection];
+
+  std::string channelId;
+  Channel details;
+  if (join.type() == kChannelGroup) {
+    channelId = "3." + join.target() + "..";
+    details.groupId = join.target();
+  } else if (join.type() == kChannelDirectMessage) {
+    details.userIdOne = std::min(session.userId, join.target());
+    details.userIdTwo = std::max(session.userId, join.target());
+    channelId = "4." + details.userIdOne + "." + details.userIdTwo + ".";
+  } else if (join.type() == kChannelRoom || join.type() == 0) {
+    channelId = "2..." + join.target();
+    details.roomName = join.target();
+  } else {
+    _send(connection, error(request.cid(), kBadInput, "Invalid channel type."));
+    return;
+  }
+
+  Channel& channel = _channels.emplace(channelId, std::move(details)).first->second;
+  if (!contains(channel.members, connection)) {
+    Envelope event;
+    auto* presenceEvent = event.mutable_channel_presence_event();
+    presenceEvent->set_channel_id(channelId);
+    setChannelFields(presenceEvent, channel);
+    setPresence(presenceEvent->add_joins(), connection);
+    for (uint64_t member : channel.members) {
+      _send(member, event);
+    }
+
+    channel.members.push_back(connection);
+    _sessions[connection].channels.push_back(channelId);
+  }
+
+  Envelope response;
+  auto* joined = response.mutable_channel();
+  joined->set_id(channelId);
+  setChannelFields(joined, channel);
+  for (uint64_t member : channel.members) {
+    setPresence(member == connection ? joined->mutable_self() : joined->add_presences(), member);
+  }
+  reply(connection, request, std::move(response));
+}
+
+void MockRealtime::channelLeave(uint64_t connection, const std::string& channelId, const std::string& cid) {
+  auto it = _channels.find(channelId);
+  if (it != _channels.end() && remove(it->second.members, connection)) {
+    remove(_sessions[connection].channels, channelId);
+
+    Envelope event;
+    auto* presenceEvent = event.mutable_channel_presence_event();
+    presenceEvent->set_channel_id(channelId);
+    setChannelFields(presenceEvent, it->second);
+    setPresence(presenceEvent->add_leaves(), connection);
+    for (uint64_t member : it->second.members) {
+      _send(member, event);
+    }
+
+    if (it->second.members.empty()) {
+      _channels.erase(it);
+    }
+  }
+
+  if (!cid.empty()) {
+    Envelope response;
+    response.set_cid(cid);
+    _send(connection, response);
+  }
+}
+
+void MockRealtime::channelMessage(uint64_t connection, const Envelope& request) {
+  std::string channelId, messageId, content;
+  int code;
+
+  if (request.has_channel_message_send()) {
+    channelId = request.channel_message_send().channel_id();
+    messageId = newUuid(_rng);
+    content = request.channel_message_send().content();
+    code = kMessageChat;
+  } else if (request.has_channel_message_update()) {
+    channelId = request.channel_message_update().channel_id();
+    messageId = request.channel_message_update().message_id();
+    content = request.channel_message_update().content();
+    code = kMessageUpdate;
+  } else {
+    channelId = request.channel_message_remove().channel_id();
+    messageId = request.channel_message_remove().message_id();
+    code = kMessageRemove;
+  }
+
+  auto it = _channels.find(channelId);
+  if (it == _channels.end() || !contains(it->second.members, connection)) {
+    _send(connection, error(request.cid(), kBadInput, "Channel not joined."));
+    return;
+  }
+
+  const Session& session = _sessions[connection];
+
+  Envelope response;
+  auto* ack = response.mutable_channel_message_ack();
+  ack->set_channel_id(channelId);
+  ack->set_message_id(messageId);
+  ack->mutable_code()->set_value(code);
+  ack->set_username(session.username);
+  setNow(ack->mutable_create_time());
+  *ack->mutable_update_time() = ack->create_time();
+  ack->mutable_persistent()->set_value(true);
+  setChannelFields(ack, it->second);
+
+  Envelope envelope;
+  auto* message = envelope.mutable_channel_message();
+  message->set_channel_id(channelId);
+  message->set_message_id(messageId);
+  message->mutable_code()->set_value(code);
+  message->set_sender_id(session.userId);
+  message->set_username(session.username);
+  message->set_content(content);
+  *message->mutable_create_time() = ack->create_time();
+  *message->mutable_update_time() = ack->update_time();
+  message->mutable_persistent()->set_value(true);
+  setChannelFields(message, it->second);
+
+  reply(connection, request, std::move(response));
+
+  // the sender gets its own message too
+  for (uint64_t member : it->second.members) {
+    _send(member, envelope);
+  }
+}
+
+void MockRealtime::setPresence(::nakama::realtime::UserPresence* presence, uint64_t connection) const {
+  auto it = _sessions.find(connection);
+  if (it != _sessions.end()) {
+    presence->set_user_id(it->second.userId);
+    presence->set_session_id(it->second.sessionId);
+    presence->set_username(it->second.username);
+  }
+}
+
+template <class Event> void MockRealtime::setChannelFields(Event* event, const Channel& channel) const {
+  event->set_room_name(channel.roomName);
+  event->set_group_id(channel.groupId);
+  event->set_user_id_one(channel.userIdOne);
+  event->set_user_id_two(channel.userIdTwo);
+}
+
+void MockRealtime::reply(uint64_t connection, const Envelope& request, Envelope&& response) {
+  response.set_cid(request.cid());
+  _send(connection, response);
+}
+
+} // namespace Test
+} // namespace Nakama
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "rtapi/realtime.pb.h"
+
+namespace Nakama {
+namespace Test {
+
+/**
+ * Built-in handlers of the realtime API: ping, RPC, relayed matches, chat channels and status.
+ *
+ * Sessions, matches and channels live as long as their connections. Requests it doesn't know are
+ * answered with an error. Runs on the I/O thread.
+ */
+class MockRealtime {
+public:
+  using Envelope = ::nakama::realtime::Envelope;
+  using SendFn = std::function<void(uint64_t connection, const Envelope& envelope)>;
+
+  // Error codes of realtime error envelopes, see RtErrorCode.
+  static constexpr int kRuntimeException = 0;
+  static constexpr int kMatchNotFound = 4;
+
+  MockRealtime(std::mt19937& rng, SendFn send) : _rng(rng), _send(std::move(send)) {}
+
+  // Starts a session for a connection whose token was accepted.
+  void connect(uint64_t connection, const std::string& userId, const std::string& username);
+  void disconnect(uint64_t connection);
+
+  void handle(uint64_t connection, const Envelope& request);
+
+  void setEchoMatchData(bool echo) { _echoMatchData = echo; }
+
+  static Envelope error(const std::string& cid, int code, const std::string& message);
+
+private:
+  struct Session {
+    std::string userId;
+    std::string sessionId;
+    std::string username;
+    std::vector<std::string> matches;
+    std::vector<std::string> channels;
+  };
+
+  struct Channel {
+    std::string roomName;
+    std::string groupId;
+    std::string userIdOne;
+    std::string userIdTwo;
+    std::vector<uint64_t> members;
+  };
+
+  void matchCreate(uint64_t connection, const Envelope& request);
+  void matchJoin(uint64_t connection, const Envelope& request);
+  void matchLeave(uint64_t connection, const std::string& matchId, const std::string& cid);
+  void matchData(uint64_t connection, const Envelope& request);
+  void channelJoin(uint64_t connection, const Envelope& request);
+  void channelLeave(uint64_t connection, const std::string& channelId, const std::string& cid);
+  void channelMessage(uint64_t connection, const Envelope& request);
+
+  void setPresence(::nakama::realtime::UserPresence* presence, uint64_t connection) const;
+  template <class Event> void setChannelFields(Event* event, const Channel& channel) const;
+
+  void reply(uint64_t connection, const Envelope& request, Envelope&& response);
+
+  std::mt19937& _rng;
+  SendFn _send;
+  bool _echoMatchData = false;
+
+  std::unordered_map<uint64_t, Session> _sessions;
+  std::unordered_map<std::string, std::vector<uint64_t>> _matches;
+  std::unordered_map<std::string, Channel> _channels;
+};
+
+} // namespace Test
+} // namespace Nakama
@@ -0,0 +1,246 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MockRest.h"
+#include "MockUtil.h"
+
+#include <chrono>
+
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/wrappers.pb.h>
+
+#include "api/api.pb.h"
+
+namespace Nakama {
+namespace Test {
+
+namespace {
+
+// gRPC status codes, which Nakama puts into REST errors
+constexpr int kInvalidArgument = 3;
+constexpr int kNotFound = 5;
+constexpr int kUnauthenticated = 16;
+
+constexpr std::chrono::hours kTokenLifetime{1};
+constexpr std::chrono::hours kRefreshTokenLifetime{24};
+
+constexpr std::string_view kAuthenticatePrefix = "/v2/account/authenticate/";
+constexpr std::string_view kRpcPrefix = "/v2/rpc/";
+
+int64_t expiresIn(std::chrono::seconds lifetime) {
+  auto now = std::chrono::system_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::seconds>(now + lifetime).count();
+}
+
+std::string storageKey(const std::string& collection, const std::string& key, const std::string& userId) {
+  return collection + '\0' + key + '\0' + userId;
+}
+
+bool startsWith(const std::string& s, std::string_view prefix) { return s.compare(0, prefix.size(), prefix) == 0; }
+
+// Reads the session of a bearer token.
+bool authorize(const MockHttpRequest& request, std::string& userId, std::string& username) {
+  auto it = request.headers.find("authorization");
+  return it != request.headers.end() && startsWith(it->second, "Bearer ") &&
+         parseToken(std::string_view(it->second).substr(7), userId, username);
+}
+
+} // namespace
+
+MockHttpResponse mockHttpError(int status, int code, const std::string& message) {
+  google::protobuf::Struct error;
+  auto& fields = *error.mutable_fields();
+  fields["error"].set_string_value(message);
+  fields["code"].set_number_value(code);
+  fields["message"].set_string_value(message);
+  return {status, toJson(error)};
+}
+
+MockHttpResponse MockRest::handle(const MockHttpRequest& request) {
+  if (request.method == "POST" && startsWith(request.path, kAuthenticatePrefix)) {
+    return authenticate(request.path.substr(kAuthenticatePrefix.size()), request);
+  }
+  if (request.method == "POST" && request.path == "/v2/account/session/refresh") {
+    return refresh(request);
+  }
+  if (request.method == "POST" && request.path == "/v2/session/logout") {
+    return {200, "{}"};
+  }
+  if (request.method == "GET" && request.path == "/v2/account") {
+    return account(request);
+  }
+  if (request.method == "PUT" && request.path == "/v2/storage") {
+    return writeStorage(request);
+  }
+  if (request.method == "POST" && request.path == "/v2/storage") {
+    return readStorage(request);
+  }
+  if ((request.method == "POST" || request.method == "GET") && startsWith(request.path, kRpcPrefix)) {
+    return rpc(percentDecode(request.path.substr(kRpcPrefix.size())), request);
+  }
+
+  return mockHttpError(404, kNotFound, "Not supported by the mock server: " + request.method + " " + request.path);
+}
+
+MockHttpResponse MockRest::authenticate(const std::string& kind, const MockHttpRequest& request) {
+  google::protobuf::Struct body;
+  if (!fromJson(request.body, body)) {
+    return mockHttpError(400, kInvalidArgument, "Unable to parse the request body.");
+  }
+
+  // whatever identifies the account of this kind
+  std::string id;
+  for (const std::string name : {"id", "email", "token", "player_id"}) {
+    auto it = body.fields().find(name);
+    if (it != body.fields().end() && it->second.has_string_value()) {
+      id = it->second.string_value();
+      break;
+    }
+  }
+  if (id.empty()) {
+    return mockHttpError(400, kInvalidArgument, "Account id is required.");
+  }
+
+  std::string userId = uuidFrom(kind + ":" + id);
+  auto it = _usernames.find(userId);
+  bool created = it == _usernames.end();
+
+  if (created) {
+    if (queryParam(request.query, "create") == "false") {
+      return mockHttpError(404, kNotFound, "User account not found.");
+    }
+
+    std::string username = queryParam(request.query, "username");
+    if (username.empty()) {
+      username = "user" + userId.substr(0, 8);
+    }
+    it = _usernames.emplace(userId, username).first;
+  }
+
+  return session(userId, it->second, created);
+}
+
+MockHttpResponse MockRest::refresh(const MockHttpRequest& request) {
+  google::protobuf::Struct body;
+  std::string userId, username;
+
+  if (!fromJson(request.body, body) || !body.fields().count("token") ||
+      !parseToken(body.fields().at("token").string_value(), userId, username)) {
+    return mockHttpError(401, kUnauthenticated, "Refresh token invalid or expired.");
+  }
+
+  return session(userId, username, false);
+}
+
+MockHttpResponse MockRest::account(const MockHttpRequest& request) {
+  std::string userId, username;
+  if (!authorize(request, userId, username)) {
+    return mockHttpError(401, kUnauthenticated, "Auth token invalid");
+  }
+
+  nakama::api::Account account;
+  account.mutable_user()->set_id(userId);
+  account.mutable_user()->set_username(username);
+  account.set_wallet("{}");
+  return {200, toJson(account)};
+}
+
+MockHttpResponse MockRest::rpc(const std::string& id, const MockHttpRequest& request) {
+  // the payload is sent as a JSON string, which is how a StringValue reads from JSON
+  google::protobuf::StringValue payload;
+  if (!request.body.empty() && !fromJson(request.body, payload)) {
+    return mockHttpError(400, kInvalidArgument, "Unable to parse the RPC payload.");
+  }
+
+  nakama::api::Rpc rpc;
+  rpc.set_id(id);
+  rpc.set_payload(payload.value());
+  return {200, toJson(rpc)};
+}
+
+MockHttpResponse MockRest::writeStorage(const MockHttpRequest& request) {
+  std::string userId, username;
+  if (!authorize(request, userId, username)) {
+    return mockHttpError(401, kUnauthenticated, "Auth token invalid");
+  }
+
+  nakama::api::WriteStorageObjectsRequest body;
+  if (!fromJson(request.body, body)) {
+    return mockHttpError(400, kInvalidArgument, "Unable to parse the request body.");
+  }
+
+  nakama::api::StorageObjectAcks acks;
+  for (const auto& write : body.objects()) {
+    if (write.collection().empty() || write.key().empty()) {
+      return mockHttpError(400, kInvalidArgument, "Invalid collection or key.");
+    }
+
+    StoredObject& object = _storage[storageKey(write.collection(), write.key(), userId)];
+    object.value = write.value();
+    object.version = std::to_string(++_storageVersion);
+    object.permissionRead = write.has_permission_read() ? write.permission_read().value() : 1;
+    object.permissionWrite = write.has_permission_write() ? write.permission_write().value() : 1;
+
+    auto* ack = acks.add_acks();
+    ack->set_collection(write.collection());
+    ack->set_key(write.key());
+    ack->set_version(object.version);
+    ack->set_user_id(userId);
+  }
+  return {200, toJson(acks)};
+}
+
+MockHttpResponse MockRest::readStorage(const MockHttpRequest& request) {
+  std::string userId, username;
+  if (!authorize(request, userId, username)) {
+    return mockHttpError(401, kUnauthenticated, "Auth token invalid");
+  }
+
+  nakama::api::ReadStorageObjectsRequest body;
+  if (!fromJson(request.body, body)) {
+    return mockHttpError(400, kInvalidArgument, "Unable to parse the request body.");
+  }
+
+  // objects which don't exist are left out, like the server does
+  nakama::api::StorageObjects objects;
+  for (const auto& id : body.object_ids()) {
+    auto it = _storage.find(storageKey(id.collection(), id.key(), id.user_id()));
+    if (it == _storage.end()) {
+      continue;
+    }
+
+    auto* object = objects.add_objects();
+    object->set_collection(id.collection());
+    object->set_key(id.key());
+    object->set_user_id(id.user_id());
+    object->set_value(it->second.value);
+    object->set_version(it->second.version);
+    object->set_permission_read(it->second.permissionRead);
+    object->set_permission_write(it->second.permissionWrite);
+  }
+  return {200, toJson(objects)};
+}
+
+MockHttpResponse MockRest::session(const std::string& userId, const std::string& username, bool created) {
+  nakama::api::Session session;
+  session.set_created(created);
+  session.set_token(makeToken(userId, username, expiresIn(kTokenLifetime)));
+  session.set_refresh_token(makeToken(userId, username, expiresIn(kRefreshTokenLifetime)));
+  return {200, toJson(session)};
+}
+
+} // namespace Test
+} // namespace Nakama
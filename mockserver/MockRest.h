@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+namespace Nakama {
+namespace Test {
+
+struct MockHttpRequest {
+  std::string method;
+  std::string path;
+  std::string query;
+  std::map<std::string, std::string> headers; ///< names in lower case
+  std::string body;
+};
+
+struct MockHttpResponse {
+  int status = 200;
+  std::string body;
+};
+
+// Nakama's REST error body.
+MockHttpResponse mockHttpError(int status, int code, const std::string& message);
+
+/**
+ * Built-in handlers of the REST API: authentication, session refresh and logout, account, storage and RPC.
+ * Accounts are remembered so that `create` behaves, storage objects so that reads return what was written,
+ * RPCs echo their payload. Runs on the I/O thread.
+ */
+class MockRest {
+public:
+  MockHttpResponse handle(const MockHttpRequest& request);
+
+private:
+  MockHttpResponse authenticate(const std::string& kind, const MockHttpRequest& request);
+  MockHttpResponse refresh(const MockHttpRequest& request);
+  MockHttpResponse account(const MockHttpRequest& request);
+  MockHttpResponse rpc(const std::string& id, const MockHttpRequest& request);
+  MockHttpResponse writeStorage(const MockHttpRequest& request);
+  MockHttpResponse readStorage(const MockHttpRequest& request);
+
+  MockHttpResponse session(const std::string& userId, const std::string& username, bool created);
+
+  struct StoredObject {
+    std::string value;
+    std::string version;
+    int permissionRead = 1;
+    int permissionWrite = 1;
+  };
+
+  std::unordered_map<std::string, std::string> _usernames; ///< of accounts created so far, by user id
+  std::unordered_map<std::string, StoredObject> _storage;  ///< by storageKey(), versions and permissions aren't checked
+  uint64_t _storageVersion = 0;
+};
+
+} // namespace Test
+} // namespace Nakama
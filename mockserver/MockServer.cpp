@@ -0,0 +1,966 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MockServer.h"
+#include "MockRealtime.h"
+#include "MockRest.h"
+#include "MockUtil.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace Nakama {
+namespace Test {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using Envelope = ::nakama::realtime::Envelope;
+
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0; // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+constexpr size_t kMaxHeaderSize = 64 * 1024;
+constexpr size_t kMaxBodySize = 16 * 1024 * 1024;
+constexpr size_t kReadSize = 64 * 1024;
+
+// bytes read from one connection per loop iteration, so a busy client can't starve the others
+constexpr size_t kMaxReadPerIteration = 1024 * 1024;
+
+// burst allowed by the bandwidth limit: 10ms worth, but at least a full size TCP segment
+constexpr uint64_t kMinBurst = 1500;
+
+// SO_RCVBUF of connections with a limited upload bandwidth
+constexpr int kUploadReceiveBuffer = 16 * 1024;
+
+// gRPC status code of injected REST errors
+constexpr int kInternal = 13;
+
+// Error code of realtime messages that don't parse.
+constexpr int kUnrecognizedPayload = 1;
+
+enum Opcode : uint8_t { Continuation = 0, Text = 1, Binary = 2, Close = 8, Ping = 9, Pong = 10 };
+
+struct Outgoing {
+  Clock::time_point due;
+  std::string bytes;
+};
+
+struct Connection {
+  uint64_t id = 0;
+  int fd = -1;
+
+  std::string in;
+  bool continueSent = false;
+
+  std::deque<Outgoing> out;
+  size_t outOffset = 0;
+  Clock::time_point lastDue;
+  bool wantWrite = false;
+
+  // bandwidth limits
+  double budget = 0;
+  Clock::time_point refilled;
+  double readBudget = 0;
+  Clock::time_point readRefilled;
+
+  bool websocket = false;
+  bool binary = false;
+  std::string fragments;
+  uint8_t fragmentOpcode = 0;
+
+  // closed once the output is flushed
+  bool closing = false;
+  bool dead = false;
+};
+
+const char* reason(int status) {
+  switch (status) {
+  case 100:
+    return "Continue";
+  case 101:
+    return "Switching Protocols";
+  case 200:
+    return "OK";
+  case 400:
+    return "Bad Request";
+  case 401:
+    return "Unauthorized";
+  case 404:
+    return "Not Found";
+  case 411:
+    return "Length Required";
+  case 413:
+    return "Payload Too Large";
+  case 431:
+    return "Request Header Fields Too Large";
+  case 500:
+    return "Internal Server Error";
+  case 503:
+    return "Service Unavailable";
+  default:
+    return "Status";
+  }
+}
+
+std::string lower(std::string s) {
+  std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return char(std::tolower(c)); });
+  return s;
+}
+
+std::string trim(const std::string& s) {
+  size_t start = s.find_first_not_of(" \t");
+  size_t end = s.find_last_not_of(" \t\r");
+  return start == std::string::npos ? std::string() : s.substr(start, end - start + 1);
+}
+
+bool hasToken(const std::string& header, const std::string& token) {
+  return lower(header).find(token) != std::string::npos;
+}
+
+std::string frame(uint8_t opcode, std::string_view payload) {
+  std::string out;
+  out.push_back(char(0x80 | opcode));
+  if (payload.size() < 126) {
+    out.push_back(char(payload.size()));
+  } else if (payload.size() <= 0xffff) {
+    out.push_back(char(126));
+    out.push_back(char(payload.size() >> 8));
+    out.push_back(char(payload.size()));
+  } else {
+    out.push_back(char(127));
+    for (int i = 7; i >= 0; --i) {
+      out.push_back(char(uint64_t(payload.size()) >> (i * 8)));
+    }
+  }
+  out.append(payload);
+  return out;
+}
+
+std::string closeFrame(uint16_t code) {
+  char payload[2] = {char(code >> 8), char(code)};
+  return frame(Close, std::string_view(payload, 2));
+}
+
+// Waits for socket events or the timeout, with sub-millisecond precision where the platform has it.
+int waitFor(std::vector<pollfd>& fds, std::optional<Clock::duration> timeout) {
+#ifdef __linux__
+  if (timeout) {
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::max(*timeout, Clock::duration::zero()));
+    timespec ts{time_t(ns.count() / 1000000000), long(ns.count() % 1000000000)};
+    return ppoll(fds.data(), fds.size(), &ts, nullptr);
+  }
+  return ppoll(fds.data(), fds.size(), nullptr, nullptr);
+#else
+  int ms = -1;
+  if (timeout) {
+    ms = int(std::chrono::ceil<std::chrono::milliseconds>(std::max(*timeout, Clock::duration::zero())).count());
+  }
+  return poll(fds.data(), nfds_t(fds.size()), ms);
+#endif
+}
+
+void setNonBlocking(int fd) { fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK); }
+
+} // namespace
+
+class MockServer::Impl {
+public:
+  explicit Impl(const MockServerConfig& config)
+      : _config(config), _rng(config.seed),
+        _realtime(_rng, [this](uint64_t connection, const Envelope& envelope) { send(connection, envelope); }) {}
+
+  ~Impl() { stop(); }
+
+  bool start();
+  void stop();
+
+  uint16_t port() const { return _port; }
+
+  void setConfig(const MockServerConfig& config) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint16_t port = _config.port;
+    _config = config;
+    _config.port = port;
+  }
+
+  MockServerConfig getConfig() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _config;
+  }
+
+  void setHttpResponse(const std::string& method, const std::string& path, int status, std::string body) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cannedHttp[method + " " + path] = {status, std::move(body)};
+  }
+
+  bool setRtResponse(const std::string& request, const std::string& envelopeJson) {
+    Envelope envelope;
+    if (!fromJson(envelopeJson, envelope)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cannedRt[request] = std::move(envelope);
+    return true;
+  }
+
+  void clearCannedResponses() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _cannedHttp.clear();
+    _cannedRt.clear();
+  }
+
+  bool broadcast(const std::string& envelopeJson) {
+    auto envelope = std::make_shared<Envelope>();
+    if (!fromJson(envelopeJson, *envelope)) {
+      return false;
+    }
+    post([this, envelope]() {
+      for (auto& [id, connection] : _connections) {
+        if (connection->websocket) {
+          send(id, *envelope);
+        }
+      }
+    });
+    return true;
+  }
+
+  MockServerStats getStats() const {
+    MockServerStats stats;
+    stats.httpRequests = _httpRequests;
+    stats.httpErrors = _httpErrors;
+    stats.rtConnections = _rtConnections;
+    stats.rtMessagesIn = _rtMessagesIn;
+    stats.rtMessagesOut = _rtMessagesOut;
+    stats.rtErrors = _rtErrors;
+    stats.rtDisconnects = _rtDisconnects;
+    stats.bytesIn = _bytesIn;
+    stats.bytesOut = _bytesOut;
+    return stats;
+  }
+
+private:
+  void run();
+  void post(std::function<void()> task);
+  void accept(const MockServerConfig& config);
+  void read(Connection& connection, const MockServerConfig& config);
+  void flush(Connection& connection, Clock::time_point now, const MockServerConfig& config);
+  std::optional<Clock::time_point> nextWrite(const Connection& connection, const MockServerConfig& config) const;
+  // Refills the upload budget. Returns when reading may go on if it's used up.
+  std::optional<Clock::time_point> nextRead(
+      Connection& connection, Clock::time_point now, const MockServerConfig& config);
+  void close(Connection& connection);
+
+  void processHttp(Connection& connection);
+  void upgrade(Connection& connection, const MockHttpRequest& request);
+  MockHttpResponse handleHttp(const MockHttpRequest& request);
+  void respond(Connection& connection, int status, const std::string& body);
+
+  void processWebsocket(Connection& connection);
+  void onMessage(Connection& connection, uint8_t opcode, const std::string& payload);
+  void send(uint64_t connectionId, const Envelope& envelope);
+
+  // Queues bytes after the configured latency, keeping the order of the connection.
+  void queue(Connection& connection, std::string bytes);
+
+  bool chance(double probability) {
+    return probability > 0 && std::uniform_real_distribution<double>(0, 1)(_rng) < probability;
+  }
+
+  mutable std::mutex _mutex;
+  MockServerConfig _config;
+  std::map<std::string, MockHttpResponse> _cannedHttp;
+  std::map<std::string, Envelope> _cannedRt;
+  std::vector<std::function<void()>> _tasks;
+
+  // the rest is owned by the I/O thread
+  std::mt19937 _rng;
+  MockRest _rest;
+  MockRealtime _realtime;
+  std::unordered_map<uint64_t, std::unique_ptr<Connection>> _connections;
+  uint64_t _nextId = 1;
+
+  std::thread _thread;
+  std::atomic<bool> _running{false};
+  int _listenFd = -1;
+  int _wakeFds[2] = {-1, -1};
+  uint16_t _port = 0;
+
+  std::atomic<uint64_t> _httpRequests{0};
+  std::atomic<uint64_t> _httpErrors{0};
+  std::atomic<uint64_t> _rtConnections{0};
+  std::atomic<uint64_t> _rtMessagesIn{0};
+  std::atomic<uint64_t> _rtMessagesOut{0};
+  std::atomic<uint64_t> _rtErrors{0};
+  std::atomic<uint64_t> _rtDisconnects{0};
+  std::atomic<uint64_t> _bytesIn{0};
+  std::atomic<uint64_t> _bytesOut{0};
+};
+
+bool MockServer::Impl::start() {
+  if (_running) {
+    return true;
+  }
+
+  _listenFd = socket(AF_INET, SOCK_STREAM, 0);
+  if (_listenFd < 0) {
+    return false;
+  }
+
+  int one = 1;
+  setsockopt(_listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+  sockaddr_in addr{};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = htons(getConfig().port);
+
+  socklen_t len = sizeof(addr);
+  if (bind(_listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(_listenFd, SOMAXCONN) != 0 ||
+      getsockname(_listenFd, reinterpret_cast<sockaddr*>(&addr), &len) != 0 || pipe(_wakeFds) != 0) {
+    ::close(_listenFd);
+    _listenFd = -1;
+    return false;
+  }
+
+  setNonBlocking(_listenFd);
+  setNonBlocking(_wakeFds[0]);
+  setNonBlocking(_wakeFds[1]);
+  _port = ntohs(addr.sin_port);
+
+  _running = true;
+  _thread = std::thread([this]() { run(); });
+  return true;
+}
+
+void MockServer::Impl::stop() {
+  if (!_running) {
+    return;
+  }
+
+  _running = false;
+  post({});
+  _thread.join();
+
+  for (auto& [id, connection] : _connections) {
+    close(*connection);
+  }
+  _connections.clear();
+
+  ::close(_listenFd);
+  ::close(_wakeFds[0]);
+  ::close(_wakeFds[1]);
+  _listenFd = _wakeFds[0] = _wakeFds[1] = -1;
+}
+
+void MockServer::Impl::post(std::function<void()> task) {
+  if (task) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _tasks.push_back(std::move(task));
+  }
+  char c = 0;
+  // a full pipe already wakes the loop up
+  (void)::write(_wakeFds[1], &c, 1);
+}
+
+void MockServer::Impl::run() {
+  std::vector<pollfd> fds;
+  std::vector<Connection*> polled;
+
+  while (_running) {
+    MockServerConfig config = getConfig();
+    Clock::time_point now = Clock::now();
+
+    std::optional<Clock::time_point> wakeAt;
+    fds.clear();
+    polled.clear();
+    fds.push_back({_wakeFds[0], POLLIN, 0});
+    fds.push_back({_listenFd, POLLIN, 0});
+
+    for (auto& [id, connection] : _connections) {
+      flush(*connection, now, config);
+      if (connection->dead) {
+        continue;
+      }
+
+      if (auto next = nextWrite(*connection, config)) {
+        wakeAt = wakeAt ? std::min(*wakeAt, *next) : *next;
+      }
+
+      short events = connection->closing ? 0 : POLLIN;
+      if (auto next = nextRead(*connection, now, config)) {
+        events &= ~POLLIN;
+        wakeAt = wakeAt ? std::min(*wakeAt, *next) : *next;
+      }
+      events |= connection->wantWrite ? POLLOUT : 0;
+      fds.push_back({connection->fd, events, 0});
+      polled.push_back(connection.get());
+    }
+
+    std::optional<Clock::duration> timeout;
+    if (wakeAt) {
+      timeout = *wakeAt - now;
+    }
+
+    if (waitFor(fds, timeout) < 0 && errno != EINTR) {
+      break;
+    }
+
+    if (fds[0].revents & POLLIN) {
+      char buf[256];
+      while (::read(_wakeFds[0], buf, sizeof(buf)) > 0) {
+      }
+
+      std::vector<std::function<void()>> tasks;
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        tasks.swap(_tasks);
+      }
+      for (auto& task : tasks) {
+        task();
+      }
+    }
+
+    if (fds[1].revents & POLLIN) {
+      accept(config);
+    }
+
+    for (size_t i = 0; i < polled.size(); ++i) {
+      Connection& connection = *polled[i];
+      short revents = fds[i + 2].revents;
+
+      if (revents & POLLOUT) {
+        connection.wantWrite = false;
+      }
+      if (revents & (POLLIN | POLLHUP | POLLERR)) {
+        read(connection, config);
+      }
+    }
+
+    for (auto it = _connections.begin(); it != _connections.end();) {
+      if (it->second->dead) {
+        close(*it->second);
+        it = _connections.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+void MockServer::Impl::accept(const MockServerConfig& config) {
+  while (true) {
+    int fd = ::accept(_listenFd, nullptr, nullptr);
+    if (fd < 0) {
+      return;
+    }
+
+    setNonBlocking(fd);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    if (config.uploadBandwidth > 0) {
+      setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &kUploadReceiveBuffer, sizeof(kUploadReceiveBuffer));
+    }
+
+    auto connection = std::make_unique<Connection>();
+    connection->id = _nextId++;
+    connection->fd = fd;
+    connection->refilled = Clock::now();
+    connection->readRefilled = connection->refilled;
+    _connections.emplace(connection->id, std::move(connection));
+  }
+}
+
+void MockServer::Impl::read(Connection& connection, const MockServerConfig& config) {
+  char buf[kReadSize];
+  size_t total = 0;
+  size_t limit = kMaxReadPerIteration;
+  if (config.uploadBandwidth > 0) {
+    limit = std::min(limit, size_t(std::max(connection.readBudget, 0.0)));
+  }
+
+  while (!connection.dead && total < limit) {
+    ssize_t n = ::recv(connection.fd, buf, std::min(sizeof(buf), limit - total), 0);
+    if (n > 0) {
+      connection.in.append(buf, size_t(n));
+      total += size_t(n);
+    } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+      break;
+    } else {
+      connection.dead = true;
+    }
+  }
+
+  _bytesIn += total;
+  connection.readBudget -= double(total);
+
+  // what arrived before the peer closed is still handled, responses go nowhere
+  if (connection.websocket) {
+    processWebsocket(connection);
+  } else {
+    processHttp(connection);
+  }
+}
+
+void MockServer::Impl::flush(Connection& connection, Clock::time_point now, const MockServerConfig& config) {
+  if (config.bandwidth > 0) {
+    double burst = std::max<double>(double(config.bandwidth) / 100, kMinBurst);
+    double elapsed = std::chrono::duration<double>(now - connection.refilled).count();
+    connection.budget = std::min(burst, connection.budget + elapsed * double(config.bandwidth));
+  }
+  connection.refilled = now;
+
+  while (!connection.dead && !connection.wantWrite && !connection.out.empty() && connection.out.front().due <= now) {
+    const std::string& bytes = connection.out.front().bytes;
+    size_t size = bytes.size() - connection.outOffset;
+    if (config.bandwidth > 0) {
+      size = std::min(size, size_t(connection.budget));
+      if (size == 0) {
+        break;
+      }
+    }
+
+    ssize_t n = ::send(connection.fd, bytes.data() + connection.outOffset, size, kSendFlags);
+    if (n < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        connection.wantWrite = true;
+      } else if (errno != EINTR) {
+        connection.dead = true;
+      }
+      break;
+    }
+
+    _bytesOut += uint64_t(n);
+    connection.budget -= double(n);
+    connection.outOffset += size_t(n);
+    if (connection.outOffset == bytes.size()) {
+      connection.out.pop_front();
+      connection.outOffset = 0;
+    }
+  }
+
+  if (connection.closing && connection.out.empty()) {
+    connection.dead = true;
+  }
+}
+
+std::optional<Clock::time_point> MockServer::Impl::nextWrite(
+    const Connection& connection, const MockServerConfig& config) const {
+  // a blocked socket wakes the loop up through POLLOUT
+  if (connection.out.empty() || connection.wantWrite) {
+    return std::nullopt;
+  }
+
+  Clock::time_point due = connection.out.front().due;
+  if (config.bandwidth > 0 && connection.budget < 1) {
+    auto refill = std::chrono::duration<double>((1 - connection.budget) / double(config.bandwidth));
+    due = std::max(due, connection.refilled + std::chrono::duration_cast<Clock::duration>(refill));
+  }
+  return due;
+}
+
+std::optional<Clock::time_point> MockServer::Impl::nextRead(
+    Connection& connection, Clock::time_point now, const MockServerConfig& config) {
+  if (config.uploadBandwidth == 0) {
+    connection.readRefilled = now;
+    return std::nullopt;
+  }
+
+  double burst = std::max<double>(double(config.uploadBandwidth) / 100, kMinBurst);
+  double elapsed = std::chrono::duration<double>(now - connection.readRefilled).count();
+  connection.readBudget = std::min(burst, connection.readBudget + elapsed * double(config.uploadBandwidth));
+  connection.readRefilled = now;
+  if (connection.readBudget >= 1) {
+    return std::nullopt;
+  }
+
+  auto refill = std::chrono::duration<double>((1 - connection.readBudget) / double(config.uploadBandwidth));
+  return now + std::chrono::duration_cast<Clock::duration>(refill);
+}
+
+void MockServer::Impl::close(Connection& connection) {
+  if (connection.websocket) {
+    _realtime.disconnect(connection.id);
+  }
+  ::close(connection.fd);
+}
+
+void MockServer::Impl::queue(Connection& connection, std::string bytes) {
+  if (connection.dead || connection.closing) {
+    return;
+  }
+
+  MockServerConfig config = getConfig();
+  Clock::time_point due = Clock::now() + config.latency;
+  if (config.jitter.count() > 0) {
+    due += std::chrono::microseconds(std::uniform_int_distribution<int64_t>(0, config.jitter.count())(_rng));
+  }
+  due = std::max(due, connection.lastDue);
+  connection.lastDue = due;
+
+  // writes that are due together go out together
+  if (!connection.out.empty() && connection.out.back().due == due) {
+    connection.out.back().bytes.append(bytes);
+  } else {
+    connection.out.push_back({due, std::move(bytes)});
+  }
+}
+
+void MockServer::Impl::processHttp(Connection& connection) {
+  while (!connection.websocket && !connection.closing) {
+    size_t headerEnd = connection.in.find("\r\n\r\n");
+    if (headerEnd == std::string::npos) {
+      if (connection.in.size() > kMaxHeaderSize) {
+        respond(connection, 431, "");
+        connection.closing = true;
+      }
+      return;
+    }
+
+    MockHttpRequest request;
+    std::string version;
+    bool chunked = false;
+    size_t contentLength = 0;
+
+    size_t lineEnd = connection.in.find("\r\n");
+    {
+      std::string line = connection.in.substr(0, lineEnd);
+      size_t methodEnd = line.find(' ');
+      size_t targetEnd = methodEnd == std::string::npos ? methodEnd : line.find(' ', methodEnd + 1);
+      if (targetEnd == std::string::npos) {
+        respond(connection, 400, "");
+        connection.closing = true;
+        return;
+      }
+
+      request.method = line.substr(0, methodEnd);
+      std::string target = line.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+      version = line.substr(targetEnd + 1);
+
+      size_t query = target.find('?');
+      request.path = target.substr(0, query);
+      request.query = query == std::string::npos ? std::string() : target.substr(query + 1);
+    }
+
+    for (size_t pos = lineEnd + 2; pos < headerEnd;) {
+      size_t end = connection.in.find("\r\n", pos);
+      std::string header = connection.in.substr(pos, end - pos);
+      pos = end + 2;
+
+      size_t colon = header.find(':');
+      if (colon != std::string::npos) {
+        std::string name = lower(trim(header.substr(0, colon)));
+        std::string value = trim(header.substr(colon + 1));
+        if (name == "content-length") {
+          contentLength = size_t(std::strtoull(value.c_str(), nullptr, 10));
+        } else if (name == "transfer-encoding") {
+          chunked = hasToken(value, "chunked");
+        }
+        request.headers[name] = value;
+      }
+    }
+
+    // the SDK's HTTP transports always send a length
+    if (chunked || contentLength > kMaxBodySize) {
+      respond(connection, chunked ? 411 : 413, "");
+      connection.closing = true;
+      return;
+    }
+
+    if (connection.in.size() < headerEnd + 4 + contentLength) {
+      auto expect = request.headers.find("expect");
+      if (expect != request.headers.end() && hasToken(expect->second, "100-continue") && !connection.continueSent) {
+        queue(connection, "HTTP/1.1 100 Continue\r\n\r\n");
+        connection.continueSent = true;
+      }
+      return;
+    }
+
+    request.body = connection.in.substr(headerEnd + 4, contentLength);
+    connection.in.erase(0, headerEnd + 4 + contentLength);
+    connection.continueSent = false;
+
+    auto connectionHeader = request.headers.find("connection");
+    auto upgradeHeader = request.headers.find("upgrade");
+    if (upgradeHeader != request.headers.end() && hasToken(upgradeHeader->second, "websocket")) {
+      upgrade(connection, request);
+      continue;
+    }
+
+    _httpRequests++;
+    MockHttpResponse response = handleHttp(request);
+    if (response.status >= 400) {
+      _httpErrors++;
+    }
+    respond(connection, response.status, response.body);
+
+    if (version == "HTTP/1.0" ||
+        (connectionHeader != request.headers.end() && hasToken(connectionHeader->second, "close"))) {
+      connection.closing = true;
+    }
+  }
+
+  if (connection.websocket) {
+    processWebsocket(connection);
+  }
+}
+
+void MockServer::Impl::upgrade(Connection& connection, const MockHttpRequest& request) {
+  auto key = request.headers.find("sec-websocket-key");
+  std::string userId, username;
+
+  if (request.method != "GET" || request.path != "/ws" || key == request.headers.end()) {
+    respond(connection, 400, "");
+    connection.closing = true;
+    return;
+  }
+
+  if (!parseToken(queryParam(request.query, "token"), userId, username)) {
+    respond(connection, 401, mockHttpError(401, 16, "Auth token invalid").body);
+    connection.closing = true;
+    return;
+  }
+
+  // no extensions are negotiated
+  queue(
+      connection,
+      "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\nSec-WebSocket-Accept: " +
+          websocketAccept(key->second) + "\r\n\r\n");
+
+  connection.websocket = true;
+  connection.binary = queryParam(request.query, "format") == "protobuf";
+  _realtime.connect(connection.id, userId, username);
+  _rtConnections++;
+}
+
+MockHttpResponse MockServer::Impl::handleHttp(const MockHttpRequest& request) {
+  MockServerConfig config = getConfig();
+  if (chance(config.httpErrorRate)) {
+    return mockHttpError(config.httpErrorStatus, kInternal, "Injected error");
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _cannedHttp.find(request.method + " " + request.path);
+    if (it != _cannedHttp.end()) {
+      return it->second;
+    }
+  }
+
+  return _rest.handle(request);
+}
+
+void MockServer::Impl::respond(Connection& connection, int status, const std::string& body) {
+  queue(
+      connection, "HTTP/1.1 " + std::to_string(status) + " " + reason(status) +
+                      "\r\nContent-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) +
+                      "\r\n\r\n" + body);
+}
+
+void MockServer::Impl::processWebsocket(Connection& connection) {
+  std::string& in = connection.in;
+
+  while (!connection.closing && !connection.dead && in.size() >= 2) {
+    auto b0 = uint8_t(in[0]);
+    auto b1 = uint8_t(in[1]);
+    bool fin = b0 & 0x80;
+    uint8_t opcode = b0 & 0x0f;
+    uint64_t len = b1 & 0x7f;
+    size_t pos = 2;
+
+    if (len == 126) {
+      if (in.size() < 4) {
+        return;
+      }
+      len = uint64_t(uint8_t(in[2])) << 8 | uint8_t(in[3]);
+      pos = 4;
+    } else if (len == 127) {
+      if (in.size() < 10) {
+        return;
+      }
+      len = 0;
+      for (int i = 0; i < 8; ++i) {
+        len = len << 8 | uint8_t(in[2 + i]);
+      }
+      pos = 10;
+    }
+
+    // clients must mask, extensions were not negotiated
+    if (!(b1 & 0x80) || (b0 & 0x70)) {
+      queue(connection, closeFrame(1002));
+      connection.closing = true;
+      return;
+    }
+    if (len > kMaxBodySize || connection.fragments.size() + len > kMaxBodySize) {
+      queue(connection, closeFrame(1009));
+      connection.closing = true;
+      return;
+    }
+    if (in.size() < pos + 4 + len) {
+      return;
+    }
+
+    const char* mask = &in[pos];
+    std::string payload = in.substr(pos + 4, size_t(len));
+    for (size_t i = 0; i < payload.size(); ++i) {
+      payload[i] ^= mask[i % 4];
+    }
+    in.erase(0, pos + 4 + size_t(len));
+
+    switch (opcode) {
+    case Close:
+      queue(connection, closeFrame(1000));
+      connection.closing = true;
+      return;
+    case Ping:
+      queue(connection, frame(Pong, payload));
+      break;
+    case Pong:
+      break;
+    case Continuation:
+      connection.fragments.append(payload);
+      if (fin) {
+        onMessage(connection, connection.fragmentOpcode, connection.fragments);
+        connection.fragments.clear();
+      }
+      break;
+    case Text:
+    case Binary:
+      if (fin) {
+        onMessage(connection, opcode, payload);
+      } else {
+        connection.fragments = std::move(payload);
+        connection.fragmentOpcode = opcode;
+      }
+      break;
+    default:
+      queue(connection, closeFrame(1002));
+      connection.closing = true;
+      return;
+    }
+  }
+}
+
+void MockServer::Impl::onMessage(Connection& connection, uint8_t opcode, const std::string& payload) {
+  _rtMessagesIn++;
+
+  MockServerConfig config = getConfig();
+  if (chance(config.rtDisconnectRate)) {
+    // the socket goes away without a close frame, like a dropped connection
+    _rtDisconnects++;
+    connection.dead = true;
+    return;
+  }
+
+  Envelope request;
+  bool parsed = opcode == Binary ? request.ParseFromString(payload) : fromJson(payload, request);
+  if (!parsed) {
+    send(connection.id, MockRealtime::error({}, kUnrecognizedPayload, "Unrecognized message."));
+    return;
+  }
+
+  if (!request.cid().empty() && chance(config.rtErrorRate)) {
+    _rtErrors++;
+    send(connection.id, MockRealtime::error(request.cid(), MockRealtime::kRuntimeException, "Injected error"));
+    return;
+  }
+
+  const auto* oneof = Envelope::descriptor()->FindOneofByName("message");
+  const auto* field = request.GetReflection()->GetOneofFieldDescriptor(request, oneof);
+  if (field) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto it = _cannedRt.find(field->name());
+    if (it != _cannedRt.end()) {
+      Envelope response = it->second;
+      lock.unlock();
+      response.set_cid(request.cid());
+      send(connection.id, response);
+      return;
+    }
+  }
+
+  _realtime.setEchoMatchData(config.echoMatchData);
+  _realtime.handle(connection.id, request);
+}
+
+void MockServer::Impl::send(uint64_t connectionId, const Envelope& envelope) {
+  auto it = _connections.find(connectionId);
+  if (it == _connections.end() || !it->second->websocket) {
+    return;
+  }
+
+  Connection& connection = *it->second;
+  std::string payload = connection.binary ? envelope.SerializeAsString() : toJson(envelope);
+  queue(connection, frame(connection.binary ? Binary : Text, payload));
+  _rtMessagesOut++;
+}
+
+MockServer::MockServer(const MockServerConfig& config) : _impl(std::make_unique<Impl>(config)) {}
+
+MockServer::~MockServer() = default;
+
+bool MockServer::start() { return _impl->start(); }
+
+void MockServer::stop() { _impl->stop(); }
+
+uint16_t MockServer::port() const { return _impl->port(); }
+
+void MockServer::setConfig(const MockServerConfig& config) { _impl->setConfig(config); }
+
+MockServerConfig MockServer::getConfig() const { return _impl->getConfig(); }
+
+void MockServer::setHttpResponse(const std::string& method, const std::string& path, int status, std::string body) {
+  _impl->setHttpResponse(method, path, status, std::move(body));
+}
+
+bool MockServer::setRtResponse(const std::string& request, const std::string& envelopeJson) {
+  return _impl->setRtResponse(request, envelopeJson);
+}
+
+void MockServer::clearCannedResponses() { _impl->clearCannedResponses(); }
+
+bool MockServer::broadcast(const std::string& envelopeJson) { return _impl->broadcast(envelopeJson); }
+
+MockServerStats MockServer::getStats() const { return _impl->getStats(); }
+
+} // namespace Test
+} // namespace Nakama
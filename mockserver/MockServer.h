@@ -0,0 +1,119 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Nakama {
+namespace Test {
+
+struct MockServerConfig {
+  // Port to listen on, 0 picks a free one, see MockServer::port().
+  uint16_t port = 0;
+
+  // Delay of every response and server push, plus a uniform random jitter. Order on a connection is kept.
+  std::chrono::microseconds latency{0};
+  std::chrono::microseconds jitter{0};
+
+  // Server to client bytes per second of each connection, 0 for unlimited.
+  uint64_t bandwidth = 0;
+
+  // Client to server bytes per second of each connection, 0 for unlimited. Connections accepted while it is set
+  // get a small receive buffer, so the backlog of a slow uplink builds up in the client.
+  uint64_t uploadBandwidth = 0;
+
+  // Probability that an HTTP request fails with httpErrorStatus.
+  double httpErrorRate = 0.0;
+  int httpErrorStatus = 500;
+
+  // Probability that a realtime request is answered with an error envelope.
+  double rtErrorRate = 0.0;
+
+  // Probability that a realtime connection is dropped when a message arrives.
+  double rtDisconnectRate = 0.0;
+
+  // Send match data back to its sender as well, so a single client can measure round trips.
+  bool echoMatchData = false;
+
+  uint32_t seed = 1;
+};
+
+struct MockServerStats {
+  uint64_t httpRequests = 0;
+  uint64_t httpErrors = 0; ///< injected and canned error responses
+  uint64_t rtConnections = 0;
+  uint64_t rtMessagesIn = 0;
+  uint64_t rtMessagesOut = 0;
+  uint64_t rtErrors = 0; ///< injected error envelopes
+  uint64_t rtDisconnects = 0; ///< injected disconnects
+  uint64_t bytesIn = 0;
+  uint64_t bytesOut = 0;
+};
+
+/**
+ * A Nakama server stand-in on the loopback interface, for hermetic benchmarks and stress tests.
+ *
+ * It speaks HTTP/1.1 for the REST API and websockets for the realtime API, in both the JSON and the
+ * protobuf format. Authentication, account, storage, RPC, matches, chat, status and ping are answered by
+ * built-in handlers that keep just enough state to look real: RPCs echo their payload, relayed match
+ * data is forwarded to the other players of the match, chat messages to the channel. Anything else
+ * gets a not found error unless a canned response is set up for it.
+ *
+ * One I/O thread serves all connections, handlers run on it. POSIX only.
+ */
+class MockServer {
+public:
+  explicit MockServer(const MockServerConfig& config = {});
+  ~MockServer();
+
+  MockServer(const MockServer&) = delete;
+  MockServer& operator=(const MockServer&) = delete;
+
+  // Binds 127.0.0.1 and starts the I/O thread. Returns false if the port can't be bound.
+  bool start();
+  void stop();
+
+  uint16_t port() const;
+
+  // Takes effect for the following requests, the port can't be changed.
+  void setConfig(const MockServerConfig& config);
+  MockServerConfig getConfig() const;
+
+  // Answers METHOD path, without the query, with a canned JSON body instead of the built-in handler.
+  void setHttpResponse(const std::string& method, const std::string& path, int status, std::string body);
+
+  // Answers realtime requests of one type, e.g. "rpc" or "match_create", with a canned envelope given
+  // as JSON. Its cid is set to the request's. Returns false if the JSON is not an envelope.
+  bool setRtResponse(const std::string& request, const std::string& envelopeJson);
+
+  void clearCannedResponses();
+
+  // Pushes an envelope, given as JSON, to every realtime connection. Returns false if it doesn't parse.
+  bool broadcast(const std::string& envelopeJson);
+
+  MockServerStats getStats() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> _impl;
+};
+
+} // namespace Test
+} // namespace Nakama
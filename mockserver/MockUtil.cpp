@@ -0,0 +1,265 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MockUtil.h"
+
+#include <array>
+#include <cstring>
+
+#include <google/protobuf/struct.pb.h>
+#include <google/protobuf/util/json_util.h>
+
+namespace Nakama {
+namespace Test {
+
+namespace {
+
+constexpr char kBase64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+constexpr char kBase64Url[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+uint32_t rotl(uint32_t x, int n) { return (x << n) | (x >> (32 - n)); }
+
+// Only used for the websocket handshake and derived ids, speed doesn't matter.
+std::array<uint8_t, 20> sha1(std::string_view data) {
+  uint32_t h[5] = {0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0};
+
+  std::string msg(data);
+  uint64_t bits = uint64_t(data.size()) * 8;
+  msg.push_back(char(0x80));
+  while (msg.size() % 64 != 56) {
+    msg.push_back(0);
+  }
+  for (int i = 7; i >= 0; --i) {
+    msg.push_back(char(bits >> (i * 8)));
+  }
+
+  for (size_t chunk = 0; chunk < msg.size(); chunk += 64) {
+    uint32_t w[80];
+    for (int i = 0; i < 16; ++i) {
+      const auto* p = reinterpret_cast<const uint8_t*>(&msg[chunk + i * 4]);
+      w[i] = uint32_t(p[0]) << 24 | uint32_t(p[1]) << 16 | uint32_t(p[2]) << 8 | p[3];
+    }
+    for (int i = 16; i < 80; ++i) {
+      w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+    }
+
+    uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+    for (int i = 0; i < 80; ++i) {
+      uint32_t f, k;
+      if (i < 20) {
+        f = (b & c) | (~b & d);
+        k = 0x5A827999;
+      } else if (i < 40) {
+        f = b ^ c ^ d;
+        k = 0x6ED9EBA1;
+      } else if (i < 60) {
+        f = (b & c) | (b & d) | (c & d);
+        k = 0x8F1BBCDC;
+      } else {
+        f = b ^ c ^ d;
+        k = 0xCA62C1D6;
+      }
+      uint32_t t = rotl(a, 5) + f + e + k + w[i];
+      e = d;
+      d = c;
+      c = rotl(b, 30);
+      b = a;
+      a = t;
+    }
+
+    h[0] += a;
+    h[1] += b;
+    h[2] += c;
+    h[3] += d;
+    h[4] += e;
+  }
+
+  std::array<uint8_t, 20> digest;
+  for (int i = 0; i < 20; ++i) {
+    digest[i] = uint8_t(h[i / 4] >> (24 - (i % 4) * 8));
+  }
+  return digest;
+}
+
+std::string formatUuid(const uint8_t* bytes) {
+  static const char kHex[] = "0123456789abcdef";
+  std::string out;
+  for (int i = 0; i < 16; ++i) {
+    if (i == 4 || i == 6 || i == 8 || i == 10) {
+      out.push_back('-');
+    }
+    out.push_back(kHex[bytes[i] >> 4]);
+    out.push_back(kHex[bytes[i] & 15]);
+  }
+  return out;
+}
+
+} // namespace
+
+std::string newUuid(std::mt19937& rng) {
+  uint8_t bytes[16];
+  for (uint8_t& b : bytes) {
+    b = uint8_t(rng());
+  }
+  bytes[6] = (bytes[6] & 0x0f) | 0x40;
+  bytes[8] = (bytes[8] & 0x3f) | 0x80;
+  return formatUuid(bytes);
+}
+
+std::string uuidFrom(std::string_view seed) {
+  std::array<uint8_t, 20> digest = sha1(seed);
+  digest[6] = (digest[6] & 0x0f) | 0x50;
+  digest[8] = (digest[8] & 0x3f) | 0x80;
+  return formatUuid(digest.data());
+}
+
+std::string base64Encode(std::string_view data, bool url) {
+  const char* chars = url ? kBase64Url : kBase64;
+  std::string out;
+  for (size_t i = 0; i < data.size(); i += 3) {
+    uint32_t n = uint32_t(uint8_t(data[i])) << 16;
+    n |= i + 1 < data.size() ? uint32_t(uint8_t(data[i + 1])) << 8 : 0;
+    n |= i + 2 < data.size() ? uint32_t(uint8_t(data[i + 2])) : 0;
+    out.push_back(chars[(n >> 18) & 63]);
+    out.push_back(chars[(n >> 12) & 63]);
+    if (i + 1 < data.size()) {
+      out.push_back(chars[(n >> 6) & 63]);
+    } else if (!url) {
+      out.push_back('=');
+    }
+    if (i + 2 < data.size()) {
+      out.push_back(chars[n & 63]);
+    } else if (!url) {
+      out.push_back('=');
+    }
+  }
+  return out;
+}
+
+std::string base64DecodeUrl(std::string_view data) {
+  std::string out;
+  uint32_t n = 0;
+  int bits = 0;
+  for (char c : data) {
+    const char* p = c ? std::strchr(kBase64Url, c) : nullptr;
+    if (!p) {
+      break;
+    }
+    n = (n << 6) | uint32_t(p - kBase64Url);
+    bits += 6;
+    if (bits >= 8) {
+      bits -= 8;
+      out.push_back(char((n >> bits) & 0xff));
+    }
+  }
+  return out;
+}
+
+std::string websocketAccept(std::string_view key) {
+  std::array<uint8_t, 20> digest = sha1(std::string(key) + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11");
+  return base64Encode(std::string_view(reinterpret_cast<const char*>(digest.data()), digest.size()));
+}
+
+std::string percentDecode(std::string_view s) {
+  auto hex = [](char c) {
+    if (c >= '0' && c <= '9') {
+      return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+      return c - 'a' + 10;
+    }
+    return c >= 'A' && c <= 'F' ? c - 'A' + 10 : -1;
+  };
+
+  std::string out;
+  for (size_t i = 0; i < s.size(); ++i) {
+    if (s[i] == '%' && i + 2 < s.size() && hex(s[i + 1]) >= 0 && hex(s[i + 2]) >= 0) {
+      out.push_back(char(hex(s[i + 1]) * 16 + hex(s[i + 2])));
+      i += 2;
+    } else {
+      out.push_back(s[i] == '+' ? ' ' : s[i]);
+    }
+  }
+  return out;
+}
+
+std::string queryParam(std::string_view query, std::string_view name) {
+  while (!query.empty()) {
+    size_t end = query.find('&');
+    std::string_view param = query.substr(0, end);
+    query = end == std::string_view::npos ? std::string_view() : query.substr(end + 1);
+
+    size_t eq = param.find('=');
+    if (param.substr(0, eq) == name) {
+      return eq == std::string_view::npos ? std::string() : percentDecode(param.substr(eq + 1));
+    }
+  }
+  return {};
+}
+
+std::string toJson(const google::protobuf::Message& message) {
+  google::protobuf::util::JsonPrintOptions options;
+  options.preserve_proto_field_names = true;
+  options.always_print_enums_as_ints = true;
+
+  std::string json;
+  google::protobuf::util::MessageToJsonString(message, &json, options);
+  return json;
+}
+
+bool fromJson(std::string_view json, google::protobuf::Message& message) {
+  google::protobuf::util::JsonParseOptions options;
+  options.ignore_unknown_fields = true;
+  return google::protobuf::util::JsonStringToMessage(std::string(json), &message, options).ok();
+}
+
+std::string makeToken(const std::string& userId, const std::string& username, int64_t expiresAt) {
+  google::protobuf::Struct claims;
+  auto& fields = *claims.mutable_fields();
+  fields["uid"].set_string_value(userId);
+  fields["usn"].set_string_value(username);
+  fields["exp"].set_number_value(double(expiresAt));
+
+  return base64Encode(R"({"alg":"HS256","typ":"JWT"})", true) + "." + base64Encode(toJson(claims), true) + "." +
+         base64Encode("mock", true);
+}
+
+bool parseToken(std::string_view token, std::string& userId, std::string& username) {
+  size_t start = token.find('.');
+  size_t end = start == std::string_view::npos ? start : token.find('.', start + 1);
+  if (end == std::string_view::npos) {
+    return false;
+  }
+
+  google::protobuf::Struct claims;
+  if (!fromJson(base64DecodeUrl(token.substr(start + 1, end - start - 1)), claims)) {
+    return false;
+  }
+
+  const auto& fields = claims.fields();
+  auto uid = fields.find("uid");
+  auto usn = fields.find("usn");
+  if (uid == fields.end() || !uid->second.has_string_value()) {
+    return false;
+  }
+
+  userId = uid->second.string_value();
+  username = usn != fields.end() ? usn->second.string_value() : std::string();
+  return true;
+}
+
+} // namespace Test
+} // namespace Nakama
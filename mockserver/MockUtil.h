@@ -0,0 +1,60 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace google {
+namespace protobuf {
+class Message;
+}
+} // namespace google
+
+namespace Nakama {
+namespace Test {
+
+std::string newUuid(std::mt19937& rng);
+
+// A uuid derived from `seed`, so the same account always gets the same user id.
+std::string uuidFrom(std::string_view seed);
+
+std::string base64Encode(std::string_view data, bool url = false);
+std::string base64DecodeUrl(std::string_view data);
+
+// Sec-WebSocket-Accept for a Sec-WebSocket-Key.
+std::string websocketAccept(std::string_view key);
+
+std::string percentDecode(std::string_view s);
+
+// Returns the value of a query parameter, percent decoded, or an empty string.
+std::string queryParam(std::string_view query, std::string_view name);
+
+// Protobuf JSON the way Nakama writes it: proto field names and enums as numbers.
+std::string toJson(const google::protobuf::Message& message);
+bool fromJson(std::string_view json, google::protobuf::Message& message);
+
+// An unsigned JWT in the shape of Nakama's session tokens, which is all the client looks at.
+std::string makeToken(const std::string& userId, const std::string& username, int64_t expiresAt);
+
+// Reads user id and username of a token made by makeToken.
+bool parseToken(std::string_view token, std::string& userId, std::string& username);
+
+} // namespace Test
+} // namespace Nakama
@@ -0,0 +1,103 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Runs the mock server on its own, e.g. to point a game client or another process at it. Prints its
+// counters on SIGINT or SIGTERM.
+//
+// usage: nakama-mock-server [--port N] [--latency-us N] [--jitter-us N] [--bandwidth BYTES_PER_SECOND]
+//                           [--upload-bandwidth BYTES_PER_SECOND] [--http-error-rate P] [--rt-error-rate P]
+//                           [--rt-disconnect-rate P] [--echo-match-data 0|1]
+
+#include "MockServer.h"
+
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+namespace {
+
+std::atomic<bool> g_stop{false};
+
+void onSignal(int) { g_stop = true; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+  Nakama::Test::MockServerConfig config;
+  config.port = 7350;
+
+  for (int i = 1; i + 1 < argc; i += 2) {
+    const char* value = argv[i + 1];
+    if (!std::strcmp(argv[i], "--port")) {
+      config.port = uint16_t(std::atoi(value));
+    } else if (!std::strcmp(argv[i], "--latency-us")) {
+      config.latency = std::chrono::microseconds(std::atoll(value));
+    } else if (!std::strcmp(argv[i], "--jitter-us")) {
+      config.jitter = std::chrono::microseconds(std::atoll(value));
+    } else if (!std::strcmp(argv[i], "--bandwidth")) {
+      config.bandwidth = uint64_t(std::atoll(value));
+    } else if (!std::strcmp(argv[i], "--upload-bandwidth")) {
+      config.uploadBandwidth = uint64_t(std::atoll(value));
+    } else if (!std::strcmp(argv[i], "--http-error-rate")) {
+      config.httpErrorRate = std::atof(value);
+    } else if (!std::strcmp(argv[i], "--rt-error-rate")) {
+      config.rtErrorRate = std::atof(value);
+    } else if (!std::strcmp(argv[i], "--rt-disconnect-rate")) {
+      config.rtDisconnectRate = std::atof(value);
+    } else if (!std::strcmp(argv[i], "--echo-match-data")) {
+      config.echoMatchData = std::atoi(value) != 0;
+    } else {
+      std::fprintf(stderr, "unknown option %s\n", argv[i]);
+      return 1;
+    }
+  }
+
+  Nakama::Test::MockServer server(config);
+  if (!server.start()) {
+    std::fprintf(stderr, "unable to listen on port %d\n", int(config.port));
+    return 1;
+  }
+
+  std::signal(SIGINT, onSignal);
+  std::signal(SIGTERM, onSignal);
+  std::printf("listening on 127.0.0.1:%d\n", int(server.port()));
+  std::fflush(stdout);
+
+  while (!g_stop) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+
+  server.stop();
+
+  Nakama::Test::MockServerStats stats = server.getStats();
+  std::printf(
+      "http requests %llu (%llu errors), realtime connections %llu, messages in %llu, out %llu, "
+      "injected errors %llu, injected disconnects %llu, bytes in %llu, out %llu\n",
+      (unsigned long long)stats.httpRequests,
+      (unsigned long long)stats.httpErrors,
+      (unsigned long long)stats.rtConnections,
+      (unsigned long long)stats.rtMessagesIn,
+      (unsigned long long)stats.rtMessagesOut,
+      (unsigned long long)stats.rtErrors,
+      (unsigned long long)stats.rtDisconnects,
+      (unsigned long long)stats.bytesIn,
+      (unsigned long long)stats.bytesOut);
+  return 0;
+}
@@ -15,6 +15,7 @@
  */
 
 #include "InternalLowLevelSatoriAPI.h"
+#include "JsonPullParser.h"
 
 #include <iostream>
 #include <ostream>
@@ -27,27 +28,79 @@
 #include <rapidjson/error/en.h>
 
 namespace Satori {
-bool jsonValueToStringVector(const rapidjson::Value& input, std::vector<std::string>& output) {
-  output.reserve(input.Size());
+bool jsonValueToStringMap(const rapidjson::Value& input, std::unordered_map<std::string, std::string>& output) {
+  if (!input.IsObject()) {
+    return false;
+  }
+  output.reserve(input.MemberCount());
   for (rapidjson::Value::ConstMemberIterator iter = input.MemberBegin(); iter != input.MemberEnd(); ++iter) {
-    output.emplace_back(iter->value.GetString());
+    if (!iter->value.IsString()) {
+      return false;
+    }
+    output[iter->name.GetString()] = iter->value.GetString();
   }
   return true;
 }
 
-bool jsonValueToStringMap(const rapidjson::Value& input, std::unordered_map<std::string, std::string>& output) {
-  output.reserve(input.Size());
-  for (rapidjson::Value::ConstMemberIterator iter = input.MemberBegin(); iter != input.MemberEnd(); ++iter) {
-    output[iter->name.GetString()] = iter->value.GetString();
+void logDecodeError(const char* type, const JsonPullParser& parser, const std::string& jsonString) {
+  std::string reason = parser.failed() ? parser.error() : "unexpected value";
+  NLOG_ERROR(
+      Nakama::NError(
+          "Parse " + std::string(type) + " JSON failed, " + reason + ". HTTP body:<< " + jsonString + " >>.",
+          Nakama::ErrorCode::InternalError));
+}
+
+// Decodes a whole response body with `decode`, logging what went wrong
+template <typename T, typename Decode>
+bool decodeJson(const char* type, const std::string& jsonString, T& output, Decode decode) {
+  JsonPullParser parser(jsonString);
+  if (!decode(parser, output) || parser.failed()) {
+    logDecodeError(type, parser, jsonString);
+    return false;
   }
   return true;
 }
 
-bool SInternalAuthenticateLogoutRequest::fromJson(std::string jsonString) { return false; }
+// Calls `field` with each key of the next object, `field` consumes the value and returns false on error
+template <typename Field> bool decodeObject(JsonPullParser& parser, Field field) {
+  if (!parser.startObject()) {
+    return false;
+  }
+  while (parser.nextKey()) {
+    if (!field(parser.key())) {
+      return false;
+    }
+  }
+  return !parser.failed();
+}
 
-bool SInternalAuthenticateRefreshRequest::fromJson(std::string jsonString) { return false; }
+template <typename T, typename Decode> bool decodeArray(JsonPullParser& parser, std::vector<T>& output, Decode decode) {
+  if (!parser.startArray()) {
+    return false;
+  }
+  while (parser.nextElement()) {
+    output.emplace_back();
+    if (!decode(parser, output.back())) {
+      return false;
+    }
+  }
+  return !parser.failed();
+}
+
+template <typename Enum> bool readEnum(JsonPullParser& parser, Enum& output, Enum min, Enum max) {
+  int value = 0;
+  if (!parser.readInt(value) || value < static_cast<int>(min) || value > static_cast<int>(max)) {
+    return false;
+  }
+  output = static_cast<Enum>(value);
+  return true;
+}
+
+bool SInternalAuthenticateLogoutRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool SInternalAuthenticateRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalAuthenticateRefreshRequest::fromJson(const std::string& jsonString) { return false; }
+
+bool SInternalAuthenticateRequest::fromJson(const std::string& jsonString) { return false; }
 
 bool jsonValueToSEvent(const rapidjson::Value& input, SEvent& output) {
   if (input.HasMember("name")) {
@@ -104,9 +157,9 @@ bool jsonValueToSEvent(const rapidjson::Value& input, SEvent& output) {
   return true;
 }
 
-bool SInternalEvent::fromJson(std::string jsonString) {
+bool SInternalEvent::fromJson(const std::string& jsonString) {
   rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
+  if (d.Parse(jsonString.data(), jsonString.size()).HasParseError()) {
     NLOG_ERROR(
         Nakama::NError(
             "Parse SEvent JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
@@ -117,191 +170,90 @@ bool SInternalEvent::fromJson(std::string jsonString) {
   return jsonValueToSEvent(d, *this);
 }
 
-bool SInternalEventRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalEventRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool jsonValueToSExperiment(const rapidjson::Value& input, SExperiment& output) {
-  if (input.HasMember("name")) {
-    if (!input["name"].IsString()) {
-      return false;
+bool decodeExperiment(JsonPullParser& parser, SExperiment& output) {
+  return decodeObject(parser, [&](const std::string& key) {
+    if (key == "name") {
+      return parser.readString(output.name);
     }
-    output.name = input["name"].GetString();
-  }
-  if (input.HasMember("value")) {
-    if (!input["value"].IsString()) {
-      return false;
+    if (key == "value") {
+      return parser.readString(output.value);
     }
-    output.value = input["value"].GetString();
-  }
-  if (input.HasMember("labels")) {
-    if (!input["labels"].IsArray()) {
-      return false;
+    if (key == "labels") {
+      return parser.readStringArray(output.labels);
     }
-    output.labels.reserve(input["labels"].Size());
-    for (auto& jsonLabel : input["labels"].GetArray()) {
-      if (!jsonLabel.IsString()) {
-        return false;
-      }
-      output.labels.emplace_back(jsonLabel.GetString());
+    if (key == "phase_name") {
+      return parser.readString(output.phase_name);
     }
-  }
-  if (input.HasMember("phase_name")) {
-    if (!input["phase_name"].IsString()) {
-      return false;
+    if (key == "phase_variant_name") {
+      return parser.readString(output.phase_variant_name);
     }
-    output.phase_name = input["phase_name"].GetString();
-  }
-  if (input.HasMember("phase_variant_name")) {
-    if (!input["phase_variant_name"].IsString()) {
-      return false;
-    }
-    output.phase_variant_name = input["phase_variant_name"].GetString();
-  }
-  return true;
+    return parser.skipValue();
+  });
 }
 
-bool SInternalExperiment::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SExperiment JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-  return jsonValueToSExperiment(d, *this);
+bool SInternalExperiment::fromJson(const std::string& jsonString) {
+  return decodeJson("SExperiment", jsonString, *this, decodeExperiment);
 }
 
-bool SInternalExperimentList::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SExperimentList JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-
-  if (d.HasMember("experiments")) {
-    if (!d["experiments"].IsArray()) {
-      return false;
-    }
-    this->experiments.reserve(d["experiments"].Size());
-    for (auto& jsonExperiment : d["experiments"].GetArray()) {
-      SExperiment experiment;
-      if (!jsonValueToSExperiment(jsonExperiment, experiment)) {
-        return false;
+bool SInternalExperimentList::fromJson(const std::string& jsonString) {
+  return decodeJson("SExperimentList", jsonString, *this, [](JsonPullParser& parser, SExperimentList& output) {
+    return decodeObject(parser, [&](const std::string& key) {
+      if (key == "experiments") {
+        return decodeArray(parser, output.experiments, decodeExperiment);
       }
-      this->experiments.emplace_back(experiment);
-    }
-  }
-  return true;
+      return parser.skipValue();
+    });
+  });
 }
 
-bool jsonValueToSFlag(const rapidjson::Value& input, SFlag& output) {
-  if (input.HasMember("name")) {
-    if (!input["name"].IsString()) {
-      return false;
-    }
-    output.name = input["name"].GetString();
-  }
-  if (input.HasMember("value")) {
-    if (!input["value"].IsString()) {
-      return false;
-    }
-    output.value = input["value"].GetString();
-  }
-  if (input.HasMember("condition_changed")) {
-    if (!input["condition_changed"].IsBool()) {
-      return false;
-    }
-    output.condition_changed = input["condition_changed"].GetBool();
-  }
-  if (input.HasMember("change_reason")) {
-    if (!input["change_reason"].IsObject()) {
-      return false;
-    }
-    const auto change_object = input["change_reason"].GetObject();
-    SFlag::SValueChangeReason change_reason;
-    if (change_object.HasMember("name")) {
-      if (!change_object["name"].IsString()) {
-        return false;
-      }
-      change_reason.name = change_object["name"].GetString();
+bool decodeFlag(JsonPullParser& parser, SFlag& output) {
+  return decodeObject(parser, [&](const std::string& key) {
+    if (key == "name") {
+      return parser.readString(output.name);
     }
-    if (change_object.HasMember("variant_name")) {
-      if (!change_object["variant_name"].IsString()) {
-        return false;
-      }
-      change_reason.variant_name = change_object["variant_name"].GetString();
+    if (key == "value") {
+      return parser.readString(output.value);
     }
-    if (change_object.HasMember("type")) {
-      if (!change_object["type"].IsInt()) {
-        return false;
-      }
-      int type_int = change_object["type"].GetInt();
-      if (type_int < SFlag::SValueChangeReason::SType::UNKNOWN ||
-          type_int > SFlag::SValueChangeReason::SType::EXPERIMENT) {
-        return false;
-      }
-      change_reason.type = static_cast<SFlag::SValueChangeReason::SType>(type_int);
+    if (key == "condition_changed") {
+      return parser.readBool(output.condition_changed);
     }
-    output.change_reason = change_reason;
-  }
-  if (input.HasMember("labels")) {
-    if (!input["labels"].IsArray()) {
-      return false;
+    if (key == "change_reason") {
+      SFlag::SValueChangeReason& reason = output.change_reason;
+      return decodeObject(parser, [&](const std::string& reasonKey) {
+        if (reasonKey == "name") {
+          return parser.readString(reason.name);
+        }
+        if (reasonKey == "variant_name") {
+          return parser.readString(reason.variant_name);
+        }
+        if (reasonKey == "type") {
+          return readEnum(
+              parser, reason.type, SFlag::SValueChangeReason::SType::UNKNOWN,
+              SFlag::SValueChangeReason::SType::EXPERIMENT);
+        }
+        return parser.skipValue();
+      });
     }
-    output.labels.reserve(input["labels"].Size());
-    for (auto& jsonLabel : input["labels"].GetArray()) {
-      if (!jsonLabel.IsString()) {
-        return false;
-      }
-      output.labels.emplace_back(jsonLabel.GetString());
+    if (key == "labels") {
+      return parser.readStringArray(output.labels);
     }
-  }
-  return true;
+    return parser.skipValue();
+  });
 }
 
-bool SInternalFlag::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SFlag JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-  return jsonValueToSFlag(d, *this);
-}
+bool SInternalFlag::fromJson(const std::string& jsonString) { return decodeJson("SFlag", jsonString, *this, decodeFlag); }
 
-bool SInternalFlagList::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SFlagList JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-  if (d.HasMember("flags")) {
-    if (!d["flags"].IsArray()) {
-      return false;
-    }
-    this->flags.reserve(d["flags"].Size());
-    for (auto& jsonFlag : d["flags"].GetArray()) {
-      SFlag flag;
-      if (!jsonValueToSFlag(jsonFlag, flag)) {
-        return false;
+bool SInternalFlagList::fromJson(const std::string& jsonString) {
+  return decodeJson("SFlagList", jsonString, *this, [](JsonPullParser& parser, SFlagList& output) {
+    return decodeObject(parser, [&](const std::string& key) {
+      if (key == "flags") {
+        return decodeArray(parser, output.flags, decodeFlag);
       }
-      this->flags.emplace_back(flag);
-    }
-  }
-
-  return true;
+      return parser.skipValue();
+    });
+  });
 }
 
 bool jsonValueToSFlagOverride(const rapidjson::Value& input, SFlagOverride& output) {
@@ -364,9 +316,9 @@ bool jsonValueToSFlagOverride(const rapidjson::Value& input, SFlagOverride& outp
   return true;
 }
 
-bool SInternalFlagOverride::fromJson(std::string jsonString) {
+bool SInternalFlagOverride::fromJson(const std::string& jsonString) {
   rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
+  if (d.Parse(jsonString.data(), jsonString.size()).HasParseError()) {
     NLOG_ERROR(
         Nakama::NError(
             "Parse SFlagOverride JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
@@ -377,9 +329,9 @@ bool SInternalFlagOverride::fromJson(std::string jsonString) {
   return jsonValueToSFlagOverride(d, *this);
 }
 
-bool SInternalFlagOverrideList::fromJson(std::string jsonString) {
+bool SInternalFlagOverrideList::fromJson(const std::string& jsonString) {
   rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
+  if (d.Parse(jsonString.data(), jsonString.size()).HasParseError()) {
     NLOG_ERROR(
         Nakama::NError(
             "Parse SFlagOverrideList JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
@@ -404,355 +356,181 @@ bool SInternalFlagOverrideList::fromJson(std::string jsonString) {
   return true;
 }
 
-bool SInternalGetExperimentsRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalGetExperimentsRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool SInternalGetFlagsRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalGetFlagsRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool SInternalGetLiveEventsRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalGetLiveEventsRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool SInternalJoinLiveEventRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalJoinLiveEventRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool SInternalIdentifyRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalIdentifyRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool jsonValueToSLiveEvent(const rapidjson::Value& input, SLiveEvent& output) {
-  if (input.HasMember("name")) {
-    if (!input["name"].IsString()) {
-      return false;
+bool decodeLiveEvent(JsonPullParser& parser, SLiveEvent& output) {
+  return decodeObject(parser, [&](const std::string& key) {
+    if (key == "name") {
+      return parser.readString(output.name);
     }
-    output.name = input["name"].GetString();
-  }
-  if (input.HasMember("description")) {
-    if (!input["description"].IsString()) {
-      return false;
+    if (key == "description") {
+      return parser.readString(output.description);
     }
-    output.description = input["description"].GetString();
-  }
-  if (input.HasMember("value")) {
-    if (!input["value"].IsString()) {
-      return false;
+    if (key == "value") {
+      return parser.readString(output.value);
     }
-    output.value = input["value"].GetString();
-  }
-  if (input.HasMember("active_start_time_sec")) {
-    if (!input["active_start_time_sec"].IsInt64()) {
-      return false;
+    if (key == "active_start_time_sec") {
+      return parser.readInt64(output.active_start_time_sec);
     }
-    output.active_start_time_sec = input["active_start_time_sec"].GetInt64();
-  }
-  if (input.HasMember("active_end_time_sec")) {
-    if (!input["active_end_time_sec"].IsInt64()) {
-      return false;
+    if (key == "active_end_time_sec") {
+      return parser.readInt64(output.active_end_time_sec);
     }
-    output.active_end_time_sec = input["active_end_time_sec"].GetInt64();
-  }
-  if (input.HasMember("id")) {
-    if (!input["id"].IsString()) {
-      return false;
+    if (key == "id") {
+      return parser.readString(output.id);
     }
-    output.id = input["id"].GetString();
-  }
-  if (input.HasMember("start_time_sec")) {
-    if (!input["start_time_sec"].IsInt64()) {
-      return false;
-    }
-    output.start_time_sec = input["start_time_sec"].GetInt64();
-  }
-  if (input.HasMember("end_time_sec")) {
-    if (!input["end_time_sec"].IsInt64()) {
-      return false;
+    if (key == "start_time_sec") {
+      return parser.readInt64(output.start_time_sec);
     }
-    output.end_time_sec = input["end_time_sec"].GetInt64();
-  }
-  if (input.HasMember("duration_sec")) {
-    if (!input["duration_sec"].IsInt64()) {
-      return false;
-    }
-    output.duration_sec = input["duration_sec"].GetInt64();
-  }
-  if (input.HasMember("reset_cron")) {
-    if (!input["reset_cron"].IsString()) {
-      return false;
+    if (key == "end_time_sec") {
+      return parser.readInt64(output.end_time_sec);
     }
-    output.reset_cron = input["reset_cron"].GetString();
-  }
-  if (input.HasMember("status")) {
-    if (!input["status"].IsInt()) {
-      return false;
+    if (key == "duration_sec") {
+      return parser.readInt64(output.duration_sec);
     }
-    int type_int = input["status"].GetInt();
-    if (type_int < SLiveEvent::SStatus::UNKNOWN || type_int > SLiveEvent::SStatus::TERMINATED) {
-      return false;
+    if (key == "reset_cron") {
+      return parser.readString(output.reset_cron);
     }
-    output.status = static_cast<SLiveEvent::SStatus>(type_int);
-  }
-  if (input.HasMember("labels")) {
-    if (!input["labels"].IsArray()) {
-      return false;
+    if (key == "status") {
+      return readEnum(parser, output.status, SLiveEvent::SStatus::UNKNOWN, SLiveEvent::SStatus::TERMINATED);
     }
-    output.labels.reserve(input["labels"].Size());
-    for (auto& jsonLabel : input["labels"].GetArray()) {
-      if (!jsonLabel.IsString()) {
-        return false;
-      }
-      output.labels.emplace_back(jsonLabel.GetString());
+    if (key == "labels") {
+      return parser.readStringArray(output.labels);
     }
-  }
-  return true;
+    return parser.skipValue();
+  });
 }
 
-bool SInternalLiveEvent::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SLiveEvent JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-  return jsonValueToSLiveEvent(d, *this);
+bool SInternalLiveEvent::fromJson(const std::string& jsonString) {
+  return decodeJson("SLiveEvent", jsonString, *this, decodeLiveEvent);
 }
 
-bool SInternalLiveEventList::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SLiveEventList JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-
-  if (d.HasMember("live_events")) {
-    if (!d["live_events"].IsArray()) {
-      return false;
-    }
-    this->live_events.reserve(d["live_events"].Size());
-    for (auto& jsonLiveEvent : d["live_events"].GetArray()) {
-      SLiveEvent liveEvent;
-      if (!jsonValueToSLiveEvent(jsonLiveEvent, liveEvent)) {
-        return false;
+bool SInternalLiveEventList::fromJson(const std::string& jsonString) {
+  return decodeJson("SLiveEventList", jsonString, *this, [](JsonPullParser& parser, SLiveEventList& output) {
+    return decodeObject(parser, [&](const std::string& key) {
+      if (key == "live_events") {
+        return decodeArray(parser, output.live_events, decodeLiveEvent);
       }
-      this->live_events.emplace_back(liveEvent);
-    }
-  }
-  if (d.HasMember("explicit_join_live_events")) {
-    if (!d["explicit_join_live_events"].IsArray()) {
-      return false;
-    }
-    this->explicit_join_live_events.reserve(d["explicit_join_live_events"].Size());
-    for (auto& jsonExplicitLiveEvent : d["explicit_join_live_events"].GetArray()) {
-      SLiveEvent explicitLiveEvent;
-      if (!jsonValueToSLiveEvent(jsonExplicitLiveEvent, explicitLiveEvent)) {
-        return false;
+      if (key == "explicit_join_live_events") {
+        return decodeArray(parser, output.explicit_join_live_events, decodeLiveEvent);
       }
-      this->explicit_join_live_events.emplace_back(explicitLiveEvent);
-    }
-  }
-  return true;
+      return parser.skipValue();
+    });
+  });
 }
 
-bool jsonValueToSProperties(const rapidjson::Value& input, SProperties& output) {
-  if (input.HasMember("default") && !jsonValueToStringMap(input["default"], output.default_properties)) {
-    return false;
-  }
-  if (input.HasMember("computed") && !jsonValueToStringMap(input["computed"], output.computed_properties)) {
-    return false;
-  }
-  if (input.HasMember("custom") && !jsonValueToStringMap(input["custom"], output.custom_properties)) {
-    return false;
-  }
-  return true;
+bool decodeProperties(JsonPullParser& parser, SProperties& output) {
+  return decodeObject(parser, [&](const std::string& key) {
+    if (key == "default") {
+      return parser.readStringMap(output.default_properties);
+    }
+    if (key == "computed") {
+      return parser.readStringMap(output.computed_properties);
+    }
+    if (key == "custom") {
+      return parser.readStringMap(output.custom_properties);
+    }
+    return parser.skipValue();
+  });
 }
 
-bool SInternalProperties::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SProperties JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-  return jsonValueToSProperties(d, *this);
+bool SInternalProperties::fromJson(const std::string& jsonString) {
+  return decodeJson("SProperties", jsonString, *this, decodeProperties);
 }
 
-bool SInternalSession::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SSession JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-  if (d.HasMember("token")) {
-    if (!d["token"].IsString()) {
-      return false;
-    }
-    this->token = d["token"].GetString();
-  }
-  if (d.HasMember("refresh_token")) {
-    if (!d["refresh_token"].IsString()) {
-      return false;
-    }
-    this->refresh_token = d["refresh_token"].GetString();
-  }
-  return jsonValueToSProperties(d["properties"], this->properties);
+bool SInternalSession::fromJson(const std::string& jsonString) {
+  return decodeJson("SSession", jsonString, *this, [](JsonPullParser& parser, SSession& output) {
+    return decodeObject(parser, [&](const std::string& key) {
+      if (key == "token") {
+        return parser.readString(output.token);
+      }
+      if (key == "refresh_token") {
+        return parser.readString(output.refresh_token);
+      }
+      if (key == "properties") {
+        return decodeProperties(parser, output.properties);
+      }
+      return parser.skipValue();
+    });
+  });
 }
 
-bool SInternalUpdatePropertiesRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalUpdatePropertiesRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool SInternalGetMessageListRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalGetMessageListRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool jsonValueToSMessage(const rapidjson::Value& input, SMessage& output) {
-  if (input.HasMember("schedule_id")) {
-    if (!input["schedule_id"].IsString()) {
-      return false;
+bool decodeMessage(JsonPullParser& parser, SMessage& output) {
+  return decodeObject(parser, [&](const std::string& key) {
+    if (key == "schedule_id") {
+      return parser.readString(output.schedule_id);
     }
-    output.schedule_id = input["schedule_id"].GetString();
-  }
-  if (input.HasMember("send_time")) {
-    if (!input["send_time"].IsString()) {
-      return false;
+    if (key == "send_time") {
+      return parser.readUint64(output.send_time);
     }
-    std::string time_string = input["send_time"].GetString();
-    size_t string_length = input["send_time"].GetStringLength();
-    output.send_time = std::stoull(time_string, &string_length);
-  } else {
-    output.send_time = 0;
-  }
-  if (input.HasMember("metadata") && !jsonValueToStringMap(input["metadata"], output.metadata)) {
-    return false;
-  }
-  if (input.HasMember("create_time")) {
-    if (!input["create_time"].IsString()) {
-      return false;
+    if (key == "metadata") {
+      return parser.readStringMap(output.metadata);
     }
-    std::string time_string = input["create_time"].GetString();
-    size_t string_length = input["create_time"].GetStringLength();
-    output.create_time = std::stoull(time_string, &string_length);
-  } else {
-    output.create_time = 0;
-  }
-  if (input.HasMember("update_time")) {
-    if (!input["update_time"].IsString()) {
-      return false;
+    if (key == "create_time") {
+      return parser.readUint64(output.create_time);
     }
-    std::string time_string = input["update_time"].GetString();
-    size_t string_length = input["update_time"].GetStringLength();
-    output.update_time = std::stoull(time_string, &string_length);
-  } else {
-    output.update_time = 0;
-  }
-  if (input.HasMember("read_time")) {
-    if (!input["read_time"].IsString()) {
-      return false;
+    if (key == "update_time") {
+      return parser.readUint64(output.update_time);
     }
-    std::string time_string = input["read_time"].GetString();
-    size_t string_length = input["read_time"].GetStringLength();
-    output.read_time = std::stoull(time_string, &string_length);
-  } else {
-    output.read_time = 0;
-  }
-  if (input.HasMember("consume_time")) {
-    if (!input["consume_time"].IsString()) {
-      return false;
+    if (key == "read_time") {
+      return parser.readUint64(output.read_time);
     }
-    std::string time_string = input["consume_time"].GetString();
-    size_t string_length = input["consume_time"].GetStringLength();
-    output.consume_time = std::stoull(time_string, &string_length);
-  } else {
-    output.consume_time = 0;
-  }
-  if (input.HasMember("text")) {
-    if (!input["text"].IsString()) {
-      return false;
+    if (key == "consume_time") {
+      return parser.readUint64(output.consume_time);
     }
-    output.text = input["text"].GetString();
-  }
-  if (input.HasMember("id")) {
-    if (!input["id"].IsString()) {
-      return false;
+    if (key == "text") {
+      return parser.readString(output.text);
     }
-    output.id = input["id"].GetString();
-  }
-  if (input.HasMember("title")) {
-    if (!input["title"].IsString()) {
-      return false;
+    if (key == "id") {
+      return parser.readString(output.id);
     }
-    output.title = input["title"].GetString();
-  }
-  if (input.HasMember("image_url")) {
-    if (!input["image_url"].IsString()) {
-      return false;
+    if (key == "title") {
+      return parser.readString(output.title);
     }
-    output.image_url = input["image_url"].GetString();
-  }
-  return true;
+    if (key == "image_url") {
+      return parser.readString(output.image_url);
+    }
+    return parser.skipValue();
+  });
 }
 
-bool SInternalMessage::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SMessage JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-  return jsonValueToSMessage(d, *this);
+bool SInternalMessage::fromJson(const std::string& jsonString) {
+  return decodeJson("SMessage", jsonString, *this, decodeMessage);
 }
 
-bool SInternalGetMessageListResponse::fromJson(std::string jsonString) {
-  rapidjson::Document d;
-  if (d.ParseInsitu(jsonString.data()).HasParseError()) {
-    NLOG_ERROR(
-        Nakama::NError(
-            "Parse SGetMessageListResponse JSON failed. Error at " + std::to_string(d.GetErrorOffset()) + ": " +
-                std::string(GetParseError_En(d.GetParseError())) + " HTTP body:<< " + jsonString + " >>.",
-            Nakama::ErrorCode::InternalError));
-    return false;
-  }
-  if (d.HasMember("messages")) {
-    if (!d["messages"].IsArray()) {
-      return false;
-    }
-    this->messages.reserve(d["messages"].Size());
-    for (auto& jsonMessage : d["messages"].GetArray()) {
-      SMessage message;
-      if (!jsonValueToSMessage(jsonMessage, message)) {
-        return false;
-      }
-      this->messages.emplace_back(message);
-    }
-  }
-  if (d.HasMember("next_cursor")) {
-    if (!d["next_cursor"].IsString()) {
-      return false;
-    }
-    this->next_cursor = d["next_cursor"].GetString();
-  }
-  if (d.HasMember("prev_cursor")) {
-    if (!d["prev_cursor"].IsString()) {
-      return false;
-    }
-    this->prev_cursor = d["prev_cursor"].GetString();
-  }
-  if (d.HasMember("cacheable_cursor")) {
-    if (!d["cacheable_cursor"].IsString()) {
-      return false;
-    }
-    this->cacheable_cursor = d["cacheable_cursor"].GetString();
-  }
-  return true;
+bool SInternalGetMessageListResponse::fromJson(const std::string& jsonString) {
+  return decodeJson(
+      "SGetMessageListResponse", jsonString, *this, [](JsonPullParser& parser, SGetMessageListResponse& output) {
+        return decodeObject(parser, [&](const std::string& key) {
+          if (key == "messages") {
+            return decodeArray(parser, output.messages, decodeMessage);
+          }
+          if (key == "next_cursor") {
+            return parser.readString(output.next_cursor);
+          }
+          if (key == "prev_cursor") {
+            return parser.readString(output.prev_cursor);
+          }
+          if (key == "cacheable_cursor") {
+            return parser.readString(output.cacheable_cursor);
+          }
+          return parser.skipValue();
+        });
+      });
 }
 
-bool SInternalUpdateMessageRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalUpdateMessageRequest::fromJson(const std::string& jsonString) { return false; }
 
-bool SInternalDeleteMessageRequest::fromJson(std::string jsonString) { return false; }
+bool SInternalDeleteMessageRequest::fromJson(const std::string& jsonString) { return false; }
 } // namespace Satori
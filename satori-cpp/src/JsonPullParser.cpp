@@ -0,0 +1,283 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "JsonPullParser.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <limits>
+
+#include <rapidjson/error/en.h>
+#include <rapidjson/reader.h>
+
+namespace Satori {
+
+// Receives exactly one SAX event per IterativeParseNext call and stores it in the parser
+struct JsonPullParser::Handler {
+  JsonPullParser& p;
+
+  bool set(Token token) {
+    p._token = token;
+    return true;
+  }
+
+  bool setString(Token token, const char* str, rapidjson::SizeType length) {
+    // assign keeps the buffer capacity, so keys and short values don't allocate
+    p._string.assign(str, length);
+    return set(token);
+  }
+
+  bool setSigned(int64_t value) {
+    p._isInteger = true;
+    p._isUnsigned = false;
+    p._int = value;
+    return set(Token::Number);
+  }
+
+  bool Null() { return set(Token::Null); }
+  bool Bool(bool b) {
+    p._bool = b;
+    return set(Token::Bool);
+  }
+  bool Int(int i) { return setSigned(i); }
+  bool Uint(unsigned u) { return setSigned(u); }
+  bool Int64(int64_t i) { return setSigned(i); }
+  bool Uint64(uint64_t u) {
+    if (u <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max())) {
+      return setSigned(static_cast<int64_t>(u));
+    }
+    p._isInteger = true;
+    p._isUnsigned = true;
+    p._uint = u;
+    return set(Token::Number);
+  }
+  bool Double(double) {
+    p._isInteger = false;
+    return set(Token::Number);
+  }
+  bool RawNumber(const char*, rapidjson::SizeType, bool) { return set(Token::Number); }
+  bool String(const char* str, rapidjson::SizeType length, bool) { return setString(Token::String, str, length); }
+  bool StartObject() { return set(Token::StartObject); }
+  bool Key(const char* str, rapidjson::SizeType length, bool) { return setString(Token::Key, str, length); }
+  bool EndObject(rapidjson::SizeType) { return set(Token::EndObject); }
+  bool StartArray() { return set(Token::StartArray); }
+  bool EndArray(rapidjson::SizeType) { return set(Token::EndArray); }
+};
+
+struct JsonPullParser::State {
+  State(JsonPullParser& parser, const std::string& json) : stream(json.c_str()), handler{parser} {}
+
+  rapidjson::Reader reader;
+  rapidjson::StringStream stream;
+  Handler handler;
+};
+
+JsonPullParser::JsonPullParser(const std::string& json) : _state(new State(*this, json)) {
+  _state->reader.IterativeParseInit();
+}
+
+JsonPullParser::~JsonPullParser() = default;
+
+bool JsonPullParser::next() {
+  if (_pushedBack) {
+    _pushedBack = false;
+    return true;
+  }
+
+  if (failed() || _state->reader.IterativeParseComplete()) {
+    _token = Token::None;
+    return false;
+  }
+
+  _token = Token::None;
+  if (!_state->reader.IterativeParseNext<rapidjson::kParseDefaultFlags>(_state->stream, _state->handler)) {
+    if (_state->reader.HasParseError()) {
+      _error = std::string(rapidjson::GetParseError_En(_state->reader.GetParseErrorCode())) + " at offset " +
+               std::to_string(_state->reader.GetErrorOffset());
+    }
+    return false;
+  }
+
+  // last call only consumes trailing whitespace
+  return _token != Token::None;
+}
+
+bool JsonPullParser::startObject() { return next() && _token == Token::StartObject ? true : fail("object"); }
+
+bool JsonPullParser::nextKey() {
+  if (!next()) {
+    return false;
+  }
+  if (_token == Token::Key) {
+    return true;
+  }
+  if (_token != Token::EndObject) {
+    fail("key");
+  }
+  return false;
+}
+
+bool JsonPullParser::startArray() { return next() && _token == Token::StartArray ? true : fail("array"); }
+
+bool JsonPullParser::nextElement() {
+  if (!next() || _token == Token::EndArray) {
+    return false;
+  }
+  _pushedBack = true;
+  return true;
+}
+
+bool JsonPullParser::readString(std::string& out) {
+  if (!next() || _token != Token::String) {
+    return _token == Token::Null ? true : fail("string");
+  }
+  out.assign(_string);
+  return true;
+}
+
+bool JsonPullParser::readBool(bool& out) {
+  if (!next() || _token != Token::Bool) {
+    return _token == Token::Null ? true : fail("bool");
+  }
+  out = _bool;
+  return true;
+}
+
+bool JsonPullParser::readInt(int& out) {
+  int64_t value = 0;
+  if (!integerValue(value)) {
+    return false;
+  }
+  if (value < std::numeric_limits<int>::min() || value > std::numeric_limits<int>::max()) {
+    return fail("int");
+  }
+  out = static_cast<int>(value);
+  return true;
+}
+
+bool JsonPullParser::readInt64(int64_t& out) { return integerValue(out); }
+
+bool JsonPullParser::readUint64(uint64_t& out) {
+  if (!next()) {
+    return fail("integer");
+  }
+  if (_token == Token::Number && _isInteger) {
+    if (!_isUnsigned && _int < 0) {
+      return fail("unsigned integer");
+    }
+    out = _isUnsigned ? _uint : static_cast<uint64_t>(_int);
+    return true;
+  }
+  if (_token == Token::String && !_string.empty() && _string[0] != '-') {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long value = std::strtoull(_string.c_str(), &end, 10);
+    if (errno == 0 && *end == '\0') {
+      out = value;
+      return true;
+    }
+  }
+  return _token == Token::Null ? true : fail("unsigned integer");
+}
+
+bool JsonPullParser::readStringArray(std::vector<std::string>& out) {
+  if (!next()) {
+    return fail("array");
+  }
+  if (_token == Token::Null) {
+    return true;
+  }
+  if (_token != Token::StartArray) {
+    return fail("array");
+  }
+  while (nextElement()) {
+    out.emplace_back();
+    if (!readString(out.back())) {
+      return false;
+    }
+  }
+  return !failed();
+}
+
+bool JsonPullParser::readStringMap(std::unordered_map<std::string, std::string>& out) {
+  if (!next()) {
+    return fail("object");
+  }
+  if (_token == Token::Null) {
+    return true;
+  }
+  if (_token != Token::StartObject) {
+    return fail("object");
+  }
+  while (nextKey()) {
+    std::string& value = out[_string];
+    if (!readString(value)) {
+      return false;
+    }
+  }
+  return !failed();
+}
+
+bool JsonPullParser::skipValue() {
+  if (!next()) {
+    return fail("value");
+  }
+  int depth = 0;
+  do {
+    switch (_token) {
+      case Token::StartObject:
+      case Token::StartArray:
+        ++depth;
+        break;
+      case Token::EndObject:
+      case Token::EndArray:
+        --depth;
+        break;
+      default:
+        break;
+    }
+  } while (depth > 0 && next());
+  return depth == 0 && !failed();
+}
+
+bool JsonPullParser::fail(const char* what) {
+  if (_error.empty()) {
+    _error = std::string("expected ") + what + " at offset " + std::to_string(_state->stream.Tell());
+  }
+  return false;
+}
+
+bool JsonPullParser::integerValue(int64_t& out) {
+  if (!next()) {
+    return fail("integer");
+  }
+  if (_token == Token::Number && _isInteger && !_isUnsigned) {
+    out = _int;
+    return true;
+  }
+  if (_token == Token::String && !_string.empty()) {
+    char* end = nullptr;
+    errno = 0;
+    long long value = std::strtoll(_string.c_str(), &end, 10);
+    if (errno == 0 && *end == '\0') {
+      out = value;
+      return true;
+    }
+  }
+  return _token == Token::Null ? true : fail("integer");
+}
+
+} // namespace Satori
@@ -0,0 +1,92 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Satori {
+
+// Streaming JSON reader on top of rapidjson's iterative SAX parser.
+//
+// Tokens are pulled one at a time, so decoders read like the data they decode and nothing but the
+// fields they keep is materialized. Read functions consume the next value and fail on a type mismatch.
+// Integers are also accepted as strings, as the gateway encodes 64 bit values that way.
+class JsonPullParser {
+public:
+  enum class Token { None, Null, Bool, Number, String, StartObject, Key, EndObject, StartArray, EndArray };
+
+  explicit JsonPullParser(const std::string& json);
+  ~JsonPullParser();
+
+  // Advances to the next token, false at the end of input or on a syntax error.
+  bool next();
+  Token token() const { return _token; }
+
+  // Consumes `{`.
+  bool startObject();
+  // Reads the next key of the current object, false once the object ends.
+  bool nextKey();
+  // Key read by nextKey, valid until the next read.
+  const std::string& key() const { return _string; }
+
+  // Consumes `[`.
+  bool startArray();
+  // True if the current array has another element, false once it ends.
+  bool nextElement();
+
+  bool readString(std::string& out);
+  bool readBool(bool& out);
+  bool readInt(int& out);
+  bool readInt64(int64_t& out);
+  bool readUint64(uint64_t& out);
+  bool readStringArray(std::vector<std::string>& out);
+  bool readStringMap(std::unordered_map<std::string, std::string>& out);
+
+  // Skips the next value including nested objects and arrays.
+  bool skipValue();
+
+  // Syntax or type error, with input offset.
+  bool failed() const { return !_error.empty(); }
+  const std::string& error() const { return _error; }
+
+private:
+  struct Handler;
+  struct State;
+
+  bool fail(const char* what);
+  bool integerValue(int64_t& out);
+
+  std::unique_ptr<State> _state;
+  Token _token = Token::None;
+  // one token of look-ahead, used by nextElement
+  bool _pushedBack = false;
+  std::string _string;
+  bool _bool = false;
+  bool _isInteger = false;
+  bool _isUnsigned = false;
+  int64_t _int = 0;
+  uint64_t _uint = 0;
+  std::string _error;
+
+  friend struct Handler;
+};
+
+} // namespace Satori
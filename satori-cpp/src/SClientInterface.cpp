@@ -20,4 +20,6 @@ namespace Satori {
 
 SClientInterface::~SClientInterface() = default;
 
+SConfigCacheInterface::~SConfigCacheInterface() = default;
+
 } // namespace Satori
@@ -18,6 +18,18 @@
 #include "nakama-cpp/NException.h"
 
 namespace Satori {
+void SatoriBaseClient::tick() { tick(std::chrono::microseconds::max()); }
+
+void SatoriBaseClient::tick(std::chrono::microseconds budget) {
+  _ioWorker.tick([this]() { pumpTransport(); }, budget);
+}
+
+void SatoriBaseClient::startIoThread(Nakama::NExecutorPtr callbackExecutor, std::chrono::milliseconds interval) {
+  _ioWorker.start([this]() { pumpTransport(); }, std::move(callbackExecutor), interval);
+}
+
+void SatoriBaseClient::stopIoThread() { _ioWorker.stop(); }
+
 std::future<SSessionPtr> SatoriBaseClient::authenticateAsync(
     const std::string& id,
     const std::unordered_map<std::string, std::string>& defaultProperties,
@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "IoWorker.h"
 #include "nakama-cpp/satori/HardcodedLowLevelSatoriAPI.h"
 #include "nakama-cpp/satori/SClientInterface.h"
 #include "nakama-cpp/satori/SatoriClientFactory.h"
@@ -25,6 +26,13 @@
 namespace Satori {
 class SatoriBaseClient : public SClientInterface {
 public:
+  void tick() override;
+  void tick(std::chrono::microseconds budget) override;
+  Nakama::NTickStats getTickStats() const override { return _ioWorker.getTickStats(); }
+
+  void startIoThread(Nakama::NExecutorPtr callbackExecutor, std::chrono::milliseconds interval) override;
+  void stopIoThread() override;
+
   std::future<SSessionPtr> authenticateAsync(
       const std::string& id,
       const std::unordered_map<std::string, std::string>& defaultProperties,
@@ -80,6 +88,12 @@ public:
 
   std::future<void> deleteMessageAsync(SSessionPtr session, const std::string& messageId) override;
 
+protected:
+  // Pumps the transport. Called from tick() or from the I/O thread when it is running.
+  virtual void pumpTransport() = 0;
+
+  void dispatch(std::function<void()> callback) { _ioWorker.dispatch(std::move(callback)); }
+
 protected:
   int _port = 0;
   std::string _host;
@@ -88,5 +102,6 @@ protected:
   Nakama::ErrorCallback _defaultErrorCallback;
   void* _userData = nullptr;
   Nakama::NPlatformParameters _platformParams;
+  Nakama::IoWorker _ioWorker;
 };
 } // namespace Satori
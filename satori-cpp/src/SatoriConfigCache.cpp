@@ -0,0 +1,380 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SatoriConfigCache.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "InternalLowLevelSatoriAPI.h"
+#include "nakama-cpp/log/NLogger.h"
+
+#undef NMODULE_NAME
+#define NMODULE_NAME "Satori::SatoriConfigCache"
+
+namespace Satori {
+
+namespace {
+
+constexpr int kSnapshotVersion = 1;
+
+bool sameFlag(const SFlag& a, const SFlag& b) {
+  return a.value == b.value && a.condition_changed == b.condition_changed && a.labels == b.labels &&
+         a.change_reason.type == b.change_reason.type && a.change_reason.name == b.change_reason.name &&
+         a.change_reason.variant_name == b.change_reason.variant_name;
+}
+
+bool sameLiveEvent(const SLiveEvent& a, const SLiveEvent& b) {
+  return a.id == b.id && a.value == b.value && a.description == b.description && a.status == b.status &&
+         a.active_start_time_sec == b.active_start_time_sec && a.active_end_time_sec == b.active_end_time_sec &&
+         a.start_time_sec == b.start_time_sec && a.end_time_sec == b.end_time_sec &&
+         a.duration_sec == b.duration_sec && a.reset_cron == b.reset_cron && a.labels == b.labels;
+}
+
+// Names of entries added, removed or changed between two maps
+template <typename T, typename Equal>
+void diff(
+    const std::unordered_map<std::string, T>& before,
+    const std::unordered_map<std::string, T>& after,
+    Equal equal,
+    std::vector<std::string>& names) {
+  for (const auto& p : after) {
+    auto it = before.find(p.first);
+    if (it == before.end() || !equal(it->second, p.second)) {
+      names.push_back(p.first);
+    }
+  }
+  for (const auto& p : before) {
+    if (after.find(p.first) == after.end()) {
+      names.push_back(p.first);
+    }
+  }
+}
+
+std::string getHeader(const Nakama::NHttpResponse& response, const char* name) {
+  auto it = response.headers.find(name);
+  return it != response.headers.end() ? it->second : std::string();
+}
+
+} // namespace
+
+bool SatoriConfigCache::isReady() const {
+  std::lock_guard<std::mutex> lock(_dataMutex);
+  return _ready;
+}
+
+bool SatoriConfigCache::getFlag(const std::string& name, SFlag& flag) const {
+  DataPtr snapshot = data();
+  const SFlag* found = findFlag(*snapshot, name);
+  if (!found) {
+    return false;
+  }
+  flag = *found;
+  return true;
+}
+
+std::string SatoriConfigCache::getString(const std::string& name, const std::string& defaultValue) const {
+  DataPtr snapshot = data();
+  const SFlag* found = findFlag(*snapshot, name);
+  return found ? found->value : defaultValue;
+}
+
+bool SatoriConfigCache::getBool(const std::string& name, bool defaultValue) const {
+  DataPtr snapshot = data();
+  const SFlag* found = findFlag(*snapshot, name);
+  if (!found) {
+    return defaultValue;
+  }
+  const std::string& value = found->value;
+  if (value == "true" || value == "1") {
+    return true;
+  }
+  if (value == "false" || value == "0") {
+    return false;
+  }
+  return defaultValue;
+}
+
+int64_t SatoriConfigCache::getInt(const std::string& name, int64_t defaultValue) const {
+  DataPtr snapshot = data();
+  const SFlag* found = findFlag(*snapshot, name);
+  if (!found || found->value.empty()) {
+    return defaultValue;
+  }
+  char* end = nullptr;
+  errno = 0;
+  long long value = std::strtoll(found->value.c_str(), &end, 10);
+  return errno == 0 && *end == '\0' ? static_cast<int64_t>(value) : defaultValue;
+}
+
+double SatoriConfigCache::getDouble(const std::string& name, double defaultValue) const {
+  DataPtr snapshot = data();
+  const SFlag* found = findFlag(*snapshot, name);
+  if (!found || found->value.empty()) {
+    return defaultValue;
+  }
+  char* end = nullptr;
+  errno = 0;
+  double value = std::strtod(found->value.c_str(), &end);
+  return errno == 0 && *end == '\0' ? value : defaultValue;
+}
+
+bool SatoriConfigCache::getLiveEvent(const std::string& name, SLiveEvent& liveEvent) const {
+  DataPtr snapshot = data();
+  auto it = snapshot->liveEvents.find(name);
+  if (it == snapshot->liveEvents.end()) {
+    return false;
+  }
+  liveEvent = it->second;
+  return true;
+}
+
+SLiveEventList SatoriConfigCache::getLiveEvents() const { return data()->liveEventList; }
+
+void SatoriConfigCache::configure(const SConfigCacheConfig& config) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  bool filtersChanged = config.flagsRequest.names != _config.flagsRequest.names ||
+                        config.flagsRequest.labels != _config.flagsRequest.labels ||
+                        config.liveEvents != _config.liveEvents;
+  _config = config;
+  _nextRefreshAt = Clock::time_point();
+  if (filtersChanged) {
+    // cached data doesn't match the new filter, refetch in full
+    _flagsEtag.clear();
+    _flagsBody.clear();
+    _liveEventsEtag.clear();
+    _liveEventsBody.clear();
+  }
+
+  if (!isReady() && !_config.snapshotFilePath.empty()) {
+    loadSnapshot();
+  }
+}
+
+SConfigCacheConfig SatoriConfigCache::getConfig() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _config;
+}
+
+bool SatoriConfigCache::beginRefresh(bool force, int requests) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_pendingRequests > 0) {
+    return false;
+  }
+
+  Clock::time_point now = Clock::now();
+  if (!force && now < _nextRefreshAt) {
+    return false;
+  }
+
+  _nextRefreshAt = now + _config.refreshInterval;
+  _pendingRequests = requests;
+  _changed = false;
+  _changes = SConfigChanges();
+  return true;
+}
+
+std::string SatoriConfigCache::getEtag(Resource resource) const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return resource == Resource::Flags ? _flagsEtag : _liveEventsEtag;
+}
+
+bool SatoriConfigCache::onResponse(Resource resource, const Nakama::NHttpResponse& response, SConfigChanges& changes) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  std::string& etag = resource == Resource::Flags ? _flagsEtag : _liveEventsEtag;
+  std::string& lastBody = resource == Resource::Flags ? _flagsBody : _liveEventsBody;
+
+  // 304 or same body as last time: nothing to parse
+  if (response.statusCode == 200) {
+    if (response.body == lastBody) {
+      etag = getHeader(response, "etag");
+    } else if (resource == Resource::Flags ? applyFlags(response.body) : applyLiveEvents(response.body)) {
+      lastBody = response.body;
+      etag = getHeader(response, "etag");
+      _changed = true;
+    }
+  }
+
+  return endRequest(changes);
+}
+
+bool SatoriConfigCache::onRequestFailed(SConfigChanges& changes) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  return endRequest(changes);
+}
+
+SatoriConfigCache::DataPtr SatoriConfigCache::data() const {
+  std::lock_guard<std::mutex> lock(_dataMutex);
+  return _data;
+}
+
+const SFlag* SatoriConfigCache::findFlag(const Data& data, const std::string& name) const {
+  auto it = data.flags.find(name);
+  return it != data.flags.end() ? &it->second : nullptr;
+}
+
+bool SatoriConfigCache::applyFlags(const std::string& body) {
+  SInternalFlagList list;
+  if (!list.fromJson(body)) {
+    return false;
+  }
+
+  DataPtr before = data();
+  auto after = std::make_shared<Data>();
+  after->flags.reserve(list.flags.size());
+  for (SFlag& flag : list.flags) {
+    std::string name = flag.name;
+    after->flags[std::move(name)] = std::move(flag);
+  }
+  after->liveEvents = before->liveEvents;
+  after->liveEventList = before->liveEventList;
+
+  diff(before->flags, after->flags, sameFlag, _changes.flags);
+
+  std::lock_guard<std::mutex> lock(_dataMutex);
+  _data = std::move(after);
+  _ready = true;
+  return true;
+}
+
+bool SatoriConfigCache::applyLiveEvents(const std::string& body) {
+  SInternalLiveEventList list;
+  if (!list.fromJson(body)) {
+    return false;
+  }
+
+  DataPtr before = data();
+  auto after = std::make_shared<Data>();
+  after->flags = before->flags;
+  for (const SLiveEvent& liveEvent : list.live_events) {
+    after->liveEvents[liveEvent.name] = liveEvent;
+  }
+  for (const SLiveEvent& liveEvent : list.explicit_join_live_events) {
+    after->liveEvents[liveEvent.name] = liveEvent;
+  }
+  after->liveEventList = static_cast<SLiveEventList>(std::move(list));
+
+  diff(before->liveEvents, after->liveEvents, sameLiveEvent, _changes.liveEvents);
+
+  std::lock_guard<std::mutex> lock(_dataMutex);
+  _data = std::move(after);
+  _ready = true;
+  return true;
+}
+
+bool SatoriConfigCache::endRequest(SConfigChanges& changes) {
+  if (_pendingRequests > 0 && --_pendingRequests > 0) {
+    return false;
+  }
+
+  if (!_changed) {
+    return false;
+  }
+
+  if (!_config.snapshotFilePath.empty()) {
+    saveSnapshot();
+  }
+
+  _changed = false;
+  changes = std::move(_changes);
+  _changes = SConfigChanges();
+  return !changes.flags.empty() || !changes.liveEvents.empty();
+}
+
+bool SatoriConfigCache::loadSnapshot() {
+  std::ifstream file(_config.snapshotFilePath, std::ios::binary);
+  if (!file) {
+    return false;
+  }
+
+  std::stringstream content;
+  content << file.rdbuf();
+  std::string json = content.str();
+
+  rapidjson::Document document;
+  if (document.Parse(json.data(), json.size()).HasParseError() || !document.IsObject()) {
+    NLOG(Nakama::NLogLevel::Warn, "Ignoring unreadable config snapshot %s", _config.snapshotFilePath.c_str());
+    return false;
+  }
+
+  auto version = document.FindMember("version");
+  if (version == document.MemberEnd() || !version->value.IsInt() || version->value.GetInt() != kSnapshotVersion) {
+    return false;
+  }
+
+  auto read = [&document](const char* name) {
+    auto it = document.FindMember(name);
+    return it != document.MemberEnd() && it->value.IsString()
+               ? std::string(it->value.GetString(), it->value.GetStringLength())
+               : std::string();
+  };
+
+  // snapshot keeps response bodies, ETags are not restored so the first refresh fetches in full
+  std::string flagsBody = read("flags");
+  std::string liveEventsBody = read("live_events");
+  bool loaded = false;
+  if (!flagsBody.empty() && applyFlags(flagsBody)) {
+    _flagsBody = std::move(flagsBody);
+    loaded = true;
+  }
+  if (!liveEventsBody.empty() && applyLiveEvents(liveEventsBody)) {
+    _liveEventsBody = std::move(liveEventsBody);
+    loaded = true;
+  }
+  // nothing was "changed" by loading, callbacks are for refreshes
+  _changes = SConfigChanges();
+
+  if (loaded) {
+    NLOG(Nakama::NLogLevel::Info, "Loaded config snapshot %s", _config.snapshotFilePath.c_str());
+  }
+  return loaded;
+}
+
+void SatoriConfigCache::saveSnapshot() {
+  rapidjson::StringBuffer buffer;
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("version");
+  writer.Int(kSnapshotVersion);
+  writer.Key("flags");
+  writer.String(_flagsBody.data(), static_cast<rapidjson::SizeType>(_flagsBody.size()));
+  writer.Key("live_events");
+  writer.String(_liveEventsBody.data(), static_cast<rapidjson::SizeType>(_liveEventsBody.size()));
+  writer.EndObject();
+
+  // write aside and swap, so a crash never leaves a truncated snapshot behind
+  std::string tmpPath = _config.snapshotFilePath + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!file.write(buffer.GetString(), static_cast<std::streamsize>(buffer.GetSize()))) {
+      NLOG(Nakama::NLogLevel::Warn, "Can't write config snapshot %s", tmpPath.c_str());
+      return;
+    }
+  }
+  std::remove(_config.snapshotFilePath.c_str());
+  if (std::rename(tmpPath.c_str(), _config.snapshotFilePath.c_str()) != 0) {
+    NLOG(Nakama::NLogLevel::Warn, "Can't replace config snapshot %s", _config.snapshotFilePath.c_str());
+  }
+}
+
+} // namespace Satori
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "nakama-cpp/NHttpTransportInterface.h"
+#include "nakama-cpp/satori/SConfigCache.h"
+
+namespace Satori {
+
+// Flags and live events kept by SatoriRestClient.
+//
+// Readers take a reference to an immutable snapshot and do a hash lookup, a refresh builds a new
+// snapshot and swaps it in. Refresh state (ETags, last bodies) is only touched by the client.
+class SatoriConfigCache : public SConfigCacheInterface {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  enum class Resource { Flags, LiveEvents };
+
+  bool isReady() const override;
+  bool getFlag(const std::string& name, SFlag& flag) const override;
+  std::string getString(const std::string& name, const std::string& defaultValue) const override;
+  bool getBool(const std::string& name, bool defaultValue) const override;
+  int64_t getInt(const std::string& name, int64_t defaultValue) const override;
+  double getDouble(const std::string& name, double defaultValue) const override;
+  bool getLiveEvent(const std::string& name, SLiveEvent& liveEvent) const override;
+  SLiveEventList getLiveEvents() const override;
+
+  // Loads the snapshot file if the cache is empty and schedules an immediate refresh.
+  void configure(const SConfigCacheConfig& config);
+  SConfigCacheConfig getConfig() const;
+
+  // Starts a refresh round of `requests` requests if it is due, or `force` is set and none is in flight.
+  bool beginRefresh(bool force, int requests);
+  std::string getEtag(Resource resource) const;
+
+  // Both return true when the refresh round is complete and changed something, `changes` lists what.
+  bool onResponse(Resource resource, const Nakama::NHttpResponse& response, SConfigChanges& changes);
+  bool onRequestFailed(SConfigChanges& changes);
+
+private:
+  struct Data {
+    std::unordered_map<std::string, SFlag> flags;
+    std::unordered_map<std::string, SLiveEvent> liveEvents;
+    SLiveEventList liveEventList;
+  };
+  using DataPtr = std::shared_ptr<const Data>;
+
+  DataPtr data() const;
+  const SFlag* findFlag(const Data& data, const std::string& name) const;
+
+  bool applyFlags(const std::string& body);
+  bool applyLiveEvents(const std::string& body);
+  bool endRequest(SConfigChanges& changes);
+
+  bool loadSnapshot();
+  void saveSnapshot();
+
+  mutable std::mutex _dataMutex;
+  DataPtr _data = std::make_shared<Data>();
+  bool _ready = false;
+
+  mutable std::mutex _mutex;
+  SConfigCacheConfig _config;
+  Clock::time_point _nextRefreshAt;
+  int _pendingRequests = 0;
+  bool _changed = false;
+  SConfigChanges _changes;
+  std::string _flagsEtag;
+  std::string _flagsBody;
+  std::string _liveEventsEtag;
+  std::string _liveEventsBody;
+};
+
+} // namespace Satori
@@ -0,0 +1,442 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SatoriEventQueue.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <random>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "nakama-cpp/log/NLogger.h"
+
+#undef NMODULE_NAME
+#define NMODULE_NAME "Satori::SatoriEventQueue"
+
+namespace Satori {
+
+namespace {
+
+// Serialized size estimate, good enough for the byte limit of a batch
+size_t estimateJsonBytes(const SEvent& event) {
+  size_t bytes = 96 + event.name.size() + event.id.size() + event.value.size();
+  for (const auto& p : event.metadata) {
+    bytes += p.first.size() + p.second.size() + 6;
+  }
+  return bytes;
+}
+
+template <typename Writer>
+void writeString(Writer& writer, const std::string& str) {
+  writer.String(str.data(), static_cast<rapidjson::SizeType>(str.size()));
+}
+
+// Request bodies carry RFC 3339 timestamps, spill file keeps milliseconds to avoid parsing them back
+template <typename Writer> void writeEvent(Writer& writer, const SEvent& event, bool serverEvent, bool forSpill) {
+  writer.StartObject();
+  writer.Key("name");
+  writeString(writer, event.name);
+  writer.Key("id");
+  writeString(writer, event.id);
+  writer.Key("value");
+  writeString(writer, event.value);
+  if (serverEvent) {
+    writer.Key("identity_id");
+    writeString(writer, event.identity_id);
+    writer.Key("session_id");
+    writeString(writer, event.session_id);
+    writer.Key("session_issued_at");
+    writer.Int64(event.session_issued_at);
+    writer.Key("session_expires_at");
+    writer.Int64(event.session_expires_at);
+  }
+  writer.Key("timestamp");
+  if (forSpill) {
+    writer.Uint64(event.timestamp);
+  } else {
+    writeString(writer, formatEventTimestamp(event.timestamp));
+  }
+  writer.Key("metadata");
+  writer.StartObject();
+  for (const auto& p : event.metadata) {
+    writer.Key(p.first.data(), static_cast<rapidjson::SizeType>(p.first.size()));
+    writeString(writer, p.second);
+  }
+  writer.EndObject();
+  writer.EndObject();
+}
+
+std::string getString(const rapidjson::Value& obj, const char* name) {
+  auto it = obj.FindMember(name);
+  return it != obj.MemberEnd() && it->value.IsString() ? std::string(it->value.GetString(), it->value.GetStringLength())
+                                                        : std::string();
+}
+
+bool parseSpilledEvent(const std::string& line, SEvent& event) {
+  rapidjson::Document document;
+  if (document.Parse(line.data(), line.size()).HasParseError() || !document.IsObject()) {
+    return false;
+  }
+
+  event.name = getString(document, "name");
+  event.id = getString(document, "id");
+  event.value = getString(document, "value");
+  event.identity_id = getString(document, "identity_id");
+  event.session_id = getString(document, "session_id");
+  event.timestamp = 0;
+  event.session_issued_at = 0;
+  event.session_expires_at = 0;
+
+  auto it = document.FindMember("timestamp");
+  if (it != document.MemberEnd() && it->value.IsUint64()) {
+    event.timestamp = it->value.GetUint64();
+  }
+  it = document.FindMember("session_issued_at");
+  if (it != document.MemberEnd() && it->value.IsInt64()) {
+    event.session_issued_at = it->value.GetInt64();
+  }
+  it = document.FindMember("session_expires_at");
+  if (it != document.MemberEnd() && it->value.IsInt64()) {
+    event.session_expires_at = it->value.GetInt64();
+  }
+  it = document.FindMember("metadata");
+  if (it != document.MemberEnd() && it->value.IsObject()) {
+    for (auto& m : it->value.GetObject()) {
+      if (m.value.IsString()) {
+        event.metadata.emplace(m.name.GetString(), m.value.GetString());
+      }
+    }
+  }
+
+  return !event.name.empty();
+}
+
+} // namespace
+
+std::string generateEventId() {
+  thread_local std::mt19937_64 rng(std::random_device{}());
+
+  uint64_t hi = rng();
+  uint64_t lo = rng();
+  hi = (hi & 0xFFFFFFFFFFFF0FFFULL) | 0x0000000000004000ULL; // version 4
+  lo = (lo & 0x3FFFFFFFFFFFFFFFULL) | 0x8000000000000000ULL; // RFC 4122 variant
+
+  char buf[37];
+  std::snprintf(
+      buf, sizeof(buf), "%08x-%04x-%04x-%04x-%012llx", static_cast<unsigned>(hi >> 32),
+      static_cast<unsigned>((hi >> 16) & 0xFFFF), static_cast<unsigned>(hi & 0xFFFF),
+      static_cast<unsigned>(lo >> 48), static_cast<unsigned long long>(lo & 0xFFFFFFFFFFFFULL));
+  return buf;
+}
+
+std::string formatEventTimestamp(Nakama::NTimestamp timestampMs) {
+  int64_t seconds = static_cast<int64_t>(timestampMs / 1000);
+  unsigned millis = static_cast<unsigned>(timestampMs % 1000);
+  int64_t days = seconds / 86400;
+  unsigned secondOfDay = static_cast<unsigned>(seconds % 86400);
+
+  // civil date from days since epoch, see http://howardhinnant.github.io/date_algorithms.html
+  int64_t z = days + 719468;
+  int64_t era = z / 146097;
+  unsigned doe = static_cast<unsigned>(z - era * 146097);
+  unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  unsigned mp = (5 * doy + 2) / 153;
+  unsigned day = doy - (153 * mp + 2) / 5 + 1;
+  unsigned month = mp < 10 ? mp + 3 : mp - 9;
+  int64_t year = static_cast<int64_t>(yoe) + era * 400 + (month <= 2 ? 1 : 0);
+
+  char buf[32];
+  int len = std::snprintf(
+      buf, sizeof(buf), "%04lld-%02u-%02uT%02u:%02u:%02u", static_cast<long long>(year), month, day,
+      secondOfDay / 3600, secondOfDay / 60 % 60, secondOfDay % 60);
+  if (millis != 0) {
+    len += std::snprintf(buf + len, sizeof(buf) - len, ".%03u", millis);
+  }
+  buf[len++] = 'Z';
+  return std::string(buf, len);
+}
+
+void writeEventsJson(const std::vector<SEvent>& events, bool serverEvents, std::string& out) {
+  rapidjson::StringBuffer buffer;
+  size_t estimate = 16;
+  for (const SEvent& event : events) {
+    estimate += estimateJsonBytes(event);
+  }
+  buffer.Reserve(estimate);
+
+  rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+  writer.StartObject();
+  writer.Key("events");
+  writer.StartArray();
+  for (const SEvent& event : events) {
+    writeEvent(writer, event, serverEvents, false);
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  out.assign(buffer.GetString(), buffer.GetSize());
+}
+
+void SatoriEventQueue::configure(const SEventQueueConfig& config) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _config = config;
+  _config.maxBatchEvents = std::max<size_t>(_config.maxBatchEvents, 1);
+}
+
+void SatoriEventQueue::push(SEvent event) {
+  if (event.id.empty()) {
+    event.id = generateEventId();
+  }
+  size_t bytes = estimateJsonBytes(event);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_config.maxQueuedEvents > 0 && _events.size() >= _config.maxQueuedEvents) {
+    evictOldest(_config.spillFilePath.empty() ? 1 : _config.maxBatchEvents);
+  }
+  _queuedBytes += bytes;
+  _events.push_back({std::move(event), Clock::now(), bytes});
+}
+
+bool SatoriEventQueue::takeBatch(bool force, std::vector<SEvent>& batch) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_inFlight > 0 || (_events.empty() && !_spillPending)) {
+    return false;
+  }
+
+  Clock::time_point now = Clock::now();
+  if (!force) {
+    if (now < _retryAt) {
+      return false;
+    }
+
+    // spilled events are overdue
+    bool due = _attempt > 0 || _spillPending || _events.size() >= _config.maxBatchEvents ||
+               _queuedBytes >= _config.maxBatchBytes || now - _events.front().queuedAt >= _config.maxBatchAge;
+    if (!due) {
+      return false;
+    }
+  }
+
+  // spilled events are older than queued ones, they go first
+  if (_spillPending) {
+    loadSpill();
+    if (_events.empty()) {
+      return false;
+    }
+  }
+
+  size_t count = 0;
+  size_t bytes = 0;
+  batch.clear();
+  while (!_events.empty() && count < _config.maxBatchEvents &&
+         (count == 0 || bytes + _events.front().bytes <= _config.maxBatchBytes)) {
+    bytes += _events.front().bytes;
+    batch.push_back(std::move(_events.front().event));
+    _events.pop_front();
+    ++count;
+  }
+  _queuedBytes -= bytes;
+  _inFlight = count;
+  if (_attempt > 0) {
+    ++_stats.retries;
+  }
+  return true;
+}
+
+void SatoriEventQueue::onBatchSent() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _stats.sent += _inFlight;
+  ++_stats.batchesSent;
+  _inFlight = 0;
+  _attempt = 0;
+  _serverFailures = 0;
+  _retryAt = {};
+}
+
+void SatoriEventQueue::onBatchFailed(std::vector<SEvent> batch, Nakama::ErrorCode code) {
+  std::lock_guard<std::mutex> lock(_mutex);
+  Clock::time_point now = Clock::now();
+  _inFlight = 0;
+
+  switch (code) {
+  case Nakama::ErrorCode::CancelledByUser:
+    // client is disconnecting, keep events for the next attempt or spillAll
+    requeueFront(batch, now);
+    break;
+
+  case Nakama::ErrorCode::ConnectionError:
+  case Nakama::ErrorCode::Unauthenticated:
+    // can't be delivered now, wait for network or a new session. The next batch starts with the spilled one.
+    scheduleRetry(now);
+    if (_config.spillFilePath.empty() || !appendToSpill(batch)) {
+      requeueFront(batch, now);
+    }
+    break;
+
+  case Nakama::ErrorCode::Unknown:
+  case Nakama::ErrorCode::InternalError:
+    if (++_serverFailures <= _config.maxRetries) {
+      scheduleRetry(now);
+      requeueFront(batch, now);
+      break;
+    }
+    NLOG(Nakama::NLogLevel::Warn, "Dropping %u event(s) after %d failed attempt(s).", batch.size(), _serverFailures);
+    _stats.dropped += batch.size();
+    _serverFailures = 0;
+    _attempt = 0;
+    _retryAt = {};
+    break;
+
+  default:
+    NLOG(Nakama::NLogLevel::Warn, "Dropping %u event(s) rejected by server.", batch.size());
+    _stats.dropped += batch.size();
+    _serverFailures = 0;
+    _attempt = 0;
+    _retryAt = {};
+    break;
+  }
+}
+
+void SatoriEventQueue::replaySpill() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  _attempt = 0;
+  _retryAt = {};
+  loadSpill();
+}
+
+void SatoriEventQueue::spillAll() {
+  std::lock_guard<std::mutex> lock(_mutex);
+  if (_config.spillFilePath.empty() || _events.empty()) {
+    return;
+  }
+
+  std::vector<SEvent> events;
+  events.reserve(_events.size());
+  for (QueuedEvent& queued : _events) {
+    events.push_back(std::move(queued.event));
+  }
+  _events.clear();
+  _queuedBytes = 0;
+
+  if (!appendToSpill(events)) {
+    _stats.dropped += events.size();
+  }
+}
+
+SEventQueueStats SatoriEventQueue::getStats() const {
+  std::lock_guard<std::mutex> lock(_mutex);
+  SEventQueueStats stats = _stats;
+  stats.queued = _events.size();
+  stats.inFlight = _inFlight;
+  return stats;
+}
+
+void SatoriEventQueue::requeueFront(std::vector<SEvent>& batch, Clock::time_point now) {
+  for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+    size_t bytes = estimateJsonBytes(*it);
+    _queuedBytes += bytes;
+    _events.push_front({std::move(*it), now, bytes});
+  }
+}
+
+void SatoriEventQueue::scheduleRetry(Clock::time_point now) {
+  std::chrono::milliseconds backoff = _config.retryBackoff * (1LL << std::min(_attempt, 16));
+  _retryAt = now + std::min(backoff, _config.maxRetryBackoff);
+  ++_attempt;
+}
+
+void SatoriEventQueue::evictOldest(size_t count) {
+  std::vector<SEvent> evicted;
+  while (!_events.empty() && evicted.size() < count) {
+    _queuedBytes -= _events.front().bytes;
+    evicted.push_back(std::move(_events.front().event));
+    _events.pop_front();
+  }
+
+  if (_config.spillFilePath.empty() || !appendToSpill(evicted)) {
+    NLOG(Nakama::NLogLevel::Warn, "Event queue is full, dropping %u event(s).", evicted.size());
+    _stats.dropped += evicted.size();
+  }
+}
+
+bool SatoriEventQueue::appendToSpill(const std::vector<SEvent>& events) {
+  std::ofstream file(_config.spillFilePath, std::ios::binary | std::ios::app | std::ios::ate);
+  if (!file) {
+    NLOG(Nakama::NLogLevel::Error, "Can't open event spill file %s", _config.spillFilePath.c_str());
+    return false;
+  }
+
+  rapidjson::StringBuffer buffer;
+  for (const SEvent& event : events) {
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    writeEvent(writer, event, true, true);
+    buffer.Put('\n');
+  }
+
+  std::streamoff size = file.tellp();
+  if (size >= 0 && static_cast<size_t>(size) + buffer.GetSize() > _config.maxSpillBytes) {
+    NLOG(Nakama::NLogLevel::Warn, "Event spill file is full, %u event(s) not written.", events.size());
+    return false;
+  }
+
+  file.write(buffer.GetString(), static_cast<std::streamsize>(buffer.GetSize()));
+  if (!file) {
+    return false;
+  }
+  _stats.spilled += events.size();
+  _spillPending = true;
+  return true;
+}
+
+void SatoriEventQueue::loadSpill() {
+  if (_config.spillFilePath.empty()) {
+    return;
+  }
+
+  std::vector<SEvent> events;
+  {
+    std::ifstream file(_config.spillFilePath, std::ios::binary);
+    if (!file) {
+      return;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+      SEvent event;
+      if (!line.empty() && parseSpilledEvent(line, event)) {
+        events.push_back(std::move(event));
+      }
+    }
+  }
+
+  // truncate, events live in memory now and are spilled again if needed
+  std::ofstream(_config.spillFilePath, std::ios::binary | std::ios::trunc);
+  _spillPending = false;
+
+  if (!events.empty()) {
+    NLOG(Nakama::NLogLevel::Info, "Replaying %u spilled event(s).", events.size());
+    _stats.replayed += events.size();
+    // spilled events are overdue already
+    requeueFront(events, Clock::time_point());
+  }
+}
+
+} // namespace Satori
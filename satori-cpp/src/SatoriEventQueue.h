@@ -0,0 +1,96 @@
+/*
+ * Copyright 2025 The Nakama Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "nakama-cpp/NError.h"
+#include "nakama-cpp/satori/HardcodedLowLevelSatoriAPI.h"
+#include "nakama-cpp/satori/SEventQueue.h"
+
+namespace Satori {
+
+// Random UUID v4 used as event id for de-duplication of retransmitted events.
+std::string generateEventId();
+
+// RFC 3339 UTC timestamp with millisecond precision, e.g. "2025-01-02T03:04:05.678Z".
+std::string formatEventTimestamp(Nakama::NTimestamp timestampMs);
+
+// Streams `{"events":[...]}` request body into `out` without building a DOM.
+// Server events also carry identity and session fields.
+void writeEventsJson(const std::vector<SEvent>& events, bool serverEvents, std::string& out);
+
+// Events waiting to be published in batches. Thread safe.
+//
+// At most one batch is in flight. A failed batch goes back to the front of the queue, so events are
+// delivered in order. While the server is unreachable batches are retried with backoff and, if a spill
+// file is configured, appended to it as JSON lines to survive a restart. Events spilled while the client
+// runs are moved back to the front of the queue before the next batch is taken.
+class SatoriEventQueue {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  void configure(const SEventQueueConfig& config);
+  void push(SEvent event);
+
+  // Moves the next batch into `batch` if the flush policy says so, or `force` is set.
+  bool takeBatch(bool force, std::vector<SEvent>& batch);
+
+  void onBatchSent();
+  void onBatchFailed(std::vector<SEvent> batch, Nakama::ErrorCode code);
+
+  // Moves events from the spill file to the front of the queue.
+  void replaySpill();
+  // Writes all queued events to the spill file, e.g. on shutdown.
+  void spillAll();
+
+  SEventQueueStats getStats() const;
+
+private:
+  struct QueuedEvent {
+    SEvent event;
+    Clock::time_point queuedAt;
+    size_t bytes;
+  };
+
+  void requeueFront(std::vector<SEvent>& batch, Clock::time_point now);
+  void scheduleRetry(Clock::time_point now);
+  // Spill or drop oldest events to make room, mutex must be held.
+  void evictOldest(size_t count);
+  bool appendToSpill(const std::vector<SEvent>& events);
+  void loadSpill();
+
+  mutable std::mutex _mutex;
+  SEventQueueConfig _config;
+  std::deque<QueuedEvent> _events;
+  size_t _queuedBytes = 0;
+  size_t _inFlight = 0;
+  // backoff exponent, grows while offline as well
+  int _attempt = 0;
+  // consecutive server side failures, limited by maxRetries
+  int _serverFailures = 0;
+  // events were spilled since the file was last loaded
+  bool _spillPending = false;
+  Clock::time_point _retryAt;
+  SEventQueueStats _stats;
+};
+
+} // namespace Satori
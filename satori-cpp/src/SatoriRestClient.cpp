@@ -24,11 +24,11 @@
 #include "StrUtil.h"
 #include "nakama-cpp/NakamaVersion.h"
 
-#include <google/protobuf/util/time_util.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
 #include "DefaultSession.h"
+#include "RestResponse.h"
 
 namespace Satori {
 
@@ -80,7 +80,10 @@ SatoriRestClient::SatoriRestClient(const Nakama::NClientParameters& parameters,
 }
 
 SatoriRestClient::~SatoriRestClient() {
+  stopIoThread();
   SatoriRestClient::disconnect();
+  // cancelled batch is back in the queue by now
+  _eventQueue.spillAll();
 
   if (_reqContexts.size() > 0) {
     NLOG(Nakama::NLogLevel::Warn, "Not handled %u request(s) detected.", _reqContexts.size());
@@ -95,7 +98,11 @@ SatoriRestClient::~SatoriRestClient() {
 
 void SatoriRestClient::disconnect() { _httpClient->cancelAllRequests(); }
 
-void SatoriRestClient::tick() { _httpClient->tick(); }
+void SatoriRestClient::pumpTransport() {
+  flushEventQueue(false);
+  refreshConfigCacheIfDue(false);
+  _httpClient->tick();
+}
 
 void SatoriRestClient::authenticate(
     const std::string& id,
@@ -210,34 +217,8 @@ void SatoriRestClient::postEvent(
     ctx->successCallback = std::move(successCallback);
     ctx->errorCallback = std::move(errorCallback);
 
-    rapidjson::Document document;
-    document.SetObject();
-    rapidjson::Value jsonEvents;
-    jsonEvents.SetArray();
-    for (const SEvent& event : events) {
-      rapidjson::Value jsonEvent;
-      jsonEvent.SetObject();
-
-      jsonEvent.AddMember("name", event.name, document.GetAllocator());
-      jsonEvent.AddMember("id", event.id, document.GetAllocator());
-      jsonEvent.AddMember("value", event.value, document.GetAllocator());
-      google::protobuf::Timestamp timeProto =
-          google::protobuf::util::TimeUtil::MillisecondsToTimestamp(static_cast<int64_t>(event.timestamp));
-      std::string timeString = google::protobuf::util::TimeUtil::ToString(timeProto);
-      jsonEvent.AddMember("timestamp", std::move(timeString), document.GetAllocator());
-      rapidjson::Value jsonMetadata;
-      jsonMetadata.SetObject();
-      for (auto& p : event.metadata) {
-        jsonMetadata.AddMember(
-            rapidjson::Value::StringRefType(p.first.c_str()), p.second, document.GetAllocator());
-      }
-      jsonEvent.AddMember("metadata", std::move(jsonMetadata), document.GetAllocator());
-
-      jsonEvents.PushBack(std::move(jsonEvent), document.GetAllocator());
-    }
-    document.AddMember("events", std::move(jsonEvents), document.GetAllocator());
-
-    std::string body = jsonDocToStr(document);
+    std::string body;
+    writeEventsJson(events, false, body);
 
     sendReq(ctx, Nakama::NHttpReqMethod::POST, "/v1/event", std::move(body));
   } catch (std::exception& e) {
@@ -256,42 +237,64 @@ void SatoriRestClient::serverEvent(
     ctx->successCallback = std::move(successCallback);
     ctx->errorCallback = std::move(errorCallback);
 
-    rapidjson::Document document;
-    document.SetObject();
-    rapidjson::Value jsonEvents;
-    jsonEvents.SetArray();
-    for (const SEvent& event : events) {
-      rapidjson::Value jsonEvent;
-      jsonEvent.SetObject();
-
-      jsonEvent.AddMember("name", event.name, document.GetAllocator());
-      jsonEvent.AddMember("id", event.id, document.GetAllocator());
-      jsonEvent.AddMember("value", event.value, document.GetAllocator());
-      jsonEvent.AddMember("identity_id", event.identity_id, document.GetAllocator());
-      jsonEvent.AddMember("session_id", event.session_id, document.GetAllocator());
-      jsonEvent.AddMember("session_issued_at", event.session_issued_at, document.GetAllocator());
-      jsonEvent.AddMember("session_expires_at", event.session_expires_at, document.GetAllocator());
-      google::protobuf::Timestamp timeProto =
-          google::protobuf::util::TimeUtil::MillisecondsToTimestamp(static_cast<int64_t>(event.timestamp));
-      std::string timeString = google::protobuf::util::TimeUtil::ToString(timeProto);
-      jsonEvent.AddMember("timestamp", std::move(timeString), document.GetAllocator());
-      rapidjson::Value jsonMetadata;
-      jsonMetadata.SetObject();
-      for (auto& p : event.metadata) {
-        jsonMetadata.AddMember(
-            rapidjson::Value::StringRefType(p.first.c_str()), p.second, document.GetAllocator());
-      }
-      jsonEvent.AddMember("metadata", std::move(jsonMetadata), document.GetAllocator());
+    std::string body;
+    writeEventsJson(events, true, body);
 
-      jsonEvents.PushBack(std::move(jsonEvent), document.GetAllocator());
-    }
-    document.AddMember("events", std::move(jsonEvents), document.GetAllocator());
+    sendReq(ctx, Nakama::NHttpReqMethod::POST, "/v1/server-event", std::move(body));
+  } catch (std::exception& e) {
+    NLOG_ERROR("exception: " + std::string(e.what()));
+  }
+}
 
-    std::string body = jsonDocToStr(document);
+void SatoriRestClient::configureEventQueue(const SEventQueueConfig& config) { _eventQueue.configure(config); }
 
-    sendReq(ctx, Nakama::NHttpReqMethod::POST, "/v1/server-event", std::move(body));
+void SatoriRestClient::setEventQueueSession(SSessionPtr session) {
+  {
+    std::lock_guard<std::mutex> lock(_eventSessionLock);
+    _eventSession = session;
+  }
+  if (session) {
+    _eventQueue.replaySpill();
+  }
+}
+
+void SatoriRestClient::queueEvent(SEvent event) { _eventQueue.push(std::move(event)); }
+
+void SatoriRestClient::flushEvents() { flushEventQueue(true); }
+
+SEventQueueStats SatoriRestClient::getEventQueueStats() const { return _eventQueue.getStats(); }
+
+void SatoriRestClient::flushEventQueue(bool force) {
+  SSessionPtr session;
+  {
+    std::lock_guard<std::mutex> lock(_eventSessionLock);
+    session = _eventSession;
+  }
+  if (!session) {
+    return;
+  }
+
+  auto batch = std::make_shared<std::vector<SEvent>>();
+  if (!_eventQueue.takeBatch(force, *batch)) {
+    return;
+  }
+
+  try {
+    RestReqContext* ctx = createReqContext(nullptr);
+    setSessionAuth(ctx, session);
+    ctx->internal = true;
+    ctx->successCallback = [this]() { _eventQueue.onBatchSent(); };
+    ctx->errorCallback = [this, batch](const Nakama::NError& error) {
+      _eventQueue.onBatchFailed(std::move(*batch), error.code);
+    };
+
+    std::string body;
+    writeEventsJson(*batch, false, body);
+
+    sendReq(ctx, Nakama::NHttpReqMethod::POST, "/v1/event", std::move(body));
   } catch (std::exception& e) {
     NLOG_ERROR("exception: " + std::string(e.what()));
+    _eventQueue.onBatchFailed(std::move(*batch), Nakama::ErrorCode::InternalError);
   }
 }
 
@@ -438,6 +441,31 @@ void SatoriRestClient::getFlagOverrides(
   }
 }
 
+void setLiveEventsArgs(Nakama::NHttpQueryArgs& args, const SGetLiveEventsRequest& request) {
+  for (auto& name : request.names) {
+    if (!name.empty()) {
+      args.emplace("names", Nakama::encodeURIComponent(name));
+    }
+  }
+  for (auto& labels : request.labels) {
+    if (!labels.empty()) {
+      args.emplace("labels", Nakama::encodeURIComponent(labels));
+    }
+  }
+  if (request.past_run_count != 0) {
+    args.emplace("past_run_count", std::to_string(request.past_run_count));
+  }
+  if (request.future_run_count != 0) {
+    args.emplace("future_run_count", std::to_string(request.future_run_count));
+  }
+  if (request.start_time_sec != 0) {
+    args.emplace("start_time_sec", std::to_string(request.start_time_sec));
+  }
+  if (request.end_time_sec != 0) {
+    args.emplace("end_time_sec", std::to_string(request.end_time_sec));
+  }
+}
+
 void SatoriRestClient::getLiveEvents(
     SSessionPtr session,
     const SGetLiveEventsRequest& request,
@@ -447,29 +475,7 @@ void SatoriRestClient::getLiveEvents(
     NLOG_INFO("...");
 
     Nakama::NHttpQueryArgs args;
-
-    for (auto& name : request.names) {
-      if (!name.empty()) {
-        args.emplace("names", Nakama::encodeURIComponent(name));
-      }
-    }
-    for (auto& labels : request.labels) {
-      if (!labels.empty()) {
-        args.emplace("labels", Nakama::encodeURIComponent(labels));
-      }
-    }
-    if (request.past_run_count != 0) {
-      args.emplace("past_run_count", std::to_string(request.past_run_count));
-    }
-    if (request.future_run_count != 0) {
-      args.emplace("future_run_count", std::to_string(request.future_run_count));
-    }
-    if (request.start_time_sec != 0) {
-      args.emplace("start_time_sec", std::to_string(request.start_time_sec));
-    }
-    if (request.end_time_sec != 0) {
-      args.emplace("end_time_sec", std::to_string(request.end_time_sec));
-    }
+    setLiveEventsArgs(args, request);
 
     std::shared_ptr<SInternalLiveEventList> liveEventsData(std::make_shared<SInternalLiveEventList>());
     RestReqContext* ctx(createReqContext(liveEventsData));
@@ -702,9 +708,106 @@ void SatoriRestClient::deleteMessage(
   }
 }
 
+void SatoriRestClient::startConfigCache(SSessionPtr session, const SConfigCacheConfig& config) {
+  _configCache.configure(config);
+  {
+    std::lock_guard<std::mutex> lock(_configLock);
+    _configSession = session;
+  }
+  if (_ioWorker.isRunning()) {
+    _ioWorker.wakeUp();
+  }
+}
+
+void SatoriRestClient::stopConfigCache() {
+  std::lock_guard<std::mutex> lock(_configLock);
+  _configSession = nullptr;
+}
+
+void SatoriRestClient::refreshConfigCache() { refreshConfigCacheIfDue(true); }
+
+void SatoriRestClient::setConfigChangedCallback(std::function<void(const SConfigChanges&)> callback) {
+  std::lock_guard<std::mutex> lock(_configLock);
+  _configChangedCallback = std::move(callback);
+}
+
+void SatoriRestClient::refreshConfigCacheIfDue(bool force) {
+  SSessionPtr session;
+  {
+    std::lock_guard<std::mutex> lock(_configLock);
+    session = _configSession;
+  }
+  if (!session) {
+    return;
+  }
+
+  SConfigCacheConfig config = _configCache.getConfig();
+  if (!_configCache.beginRefresh(force, config.liveEvents ? 2 : 1)) {
+    return;
+  }
+
+  sendConfigCacheRequest(session, SatoriConfigCache::Resource::Flags, config);
+  if (config.liveEvents) {
+    sendConfigCacheRequest(session, SatoriConfigCache::Resource::LiveEvents, config);
+  }
+}
+
+void SatoriRestClient::sendConfigCacheRequest(
+    SSessionPtr session, SatoriConfigCache::Resource resource, const SConfigCacheConfig& config) {
+  try {
+    Nakama::NHttpQueryArgs args;
+    if (resource == SatoriConfigCache::Resource::Flags) {
+      setFlagsArgs(args, config.flagsRequest);
+    } else {
+      setLiveEventsArgs(args, config.liveEventsRequest);
+    }
+
+    RestReqContext* ctx = createReqContext(nullptr);
+    setSessionAuth(ctx, session);
+    ctx->internal = true;
+    std::string etag = _configCache.getEtag(resource);
+    if (!etag.empty()) {
+      ctx->headers.emplace("If-None-Match", std::move(etag));
+    }
+    ctx->responseCallback = [this, resource](const Nakama::NHttpResponse& response) {
+      SConfigChanges changes;
+      if (_configCache.onResponse(resource, response, changes)) {
+        notifyConfigChanged(std::move(changes));
+      }
+    };
+    ctx->errorCallback = [this](const Nakama::NError&) {
+      SConfigChanges changes;
+      if (_configCache.onRequestFailed(changes)) {
+        notifyConfigChanged(std::move(changes));
+      }
+    };
+
+    std::string path = resource == SatoriConfigCache::Resource::Flags ? "/v1/flag" : "/v1/live-event";
+    sendReq(ctx, Nakama::NHttpReqMethod::GET, std::move(path), "", std::move(args));
+  } catch (std::exception& e) {
+    NLOG_ERROR("exception: " + std::string(e.what()));
+    SConfigChanges changes;
+    if (_configCache.onRequestFailed(changes)) {
+      notifyConfigChanged(std::move(changes));
+    }
+  }
+}
+
+void SatoriRestClient::notifyConfigChanged(SConfigChanges changes) {
+  std::function<void(const SConfigChanges&)> callback;
+  {
+    std::lock_guard<std::mutex> lock(_configLock);
+    callback = _configChangedCallback;
+  }
+  if (callback) {
+    dispatch([callback, changes]() { callback(changes); });
+  }
+}
+
 RestReqContext* SatoriRestClient::createReqContext(std::shared_ptr<SFromJsonInterface> data) {
   RestReqContext* ctx = new RestReqContext();
   ctx->data = data;
+  std::lock_guard<std::mutex> lock(_reqContextsLock);
   _reqContexts.emplace(ctx);
   return ctx;
 }
@@ -737,112 +840,76 @@ void SatoriRestClient::sendReq(
   if (!ctx->auth.empty()) {
     req.headers.emplace("Authorization", std::move(ctx->auth));
   }
+  for (auto& header : ctx->headers) {
+    req.headers.emplace(header.first, std::move(header.second));
+  }
 
   _httpClient->request(req, [this, ctx](Nakama::NHttpResponsePtr response) {
-    // TODO: Convert this boilerplate lambda back into a function that can be used from within Satori cpp. Boilerplate
-    // begins here	============
-    [&]() // void RestClient::onResponse(RestReqContext* reqContext, NHttpResponsePtr response)
-    {
-      auto it = _reqContexts.find(ctx);
-      if (it != _reqContexts.end()) {
-        if (response->statusCode == 200) { // OK
-          if (ctx && ctx->successCallback) {
-            bool ok = true;
-            if (ctx->data) {
-              ok = ctx->data->fromJson(response->body);
-              if (!ok) {
-                reqError(
-                    ctx, Nakama::NError(
-                             "Parse JSON failed for Satori. HTTP body: <<" + response->body + ">>",
-                             Nakama::ErrorCode::InternalError));
-              }
-            }
-
-            if (ok) {
-              ctx->successCallback();
-            }
-          }
-        } else {
-          std::string errMessage;
-          Nakama::ErrorCode code = Nakama::ErrorCode::Unknown;
-
-          if (response->statusCode == Nakama::InternalStatusCodes::CONNECTION_ERROR) {
-            code = Nakama::ErrorCode::ConnectionError;
-            errMessage.append("message: ").append(response->errorMessage);
-          } else if (response->statusCode == Nakama::InternalStatusCodes::CANCELLED_BY_USER) {
-            code = Nakama::ErrorCode::CancelledByUser;
-            errMessage.append("message: ").append(response->errorMessage);
-          } else if (response->statusCode == Nakama::InternalStatusCodes::INTERNAL_TRANSPORT_ERROR) {
-            code = Nakama::ErrorCode::InternalError;
-            errMessage.append("message: ").append(response->errorMessage);
-          } else if (!response->body.empty() && response->body[0] == '{') { // have to be JSON
-                                                                            /*
-                                                                             try {
-                                                                                    rapidjson::Document document;
-
-                                                                                    if (document.Parse(response->body).HasParseError()) {
-                                                                                            errMessage = "Parse JSON failed: " + response->body;
-                                                                                            code = Nakama::ErrorCode::InternalError;
-                                                                                    } else {
-                                                                                            auto& jsonMessage = document["message"];
-                                                                                            auto& jsonCode    = document["code"];
-
-                                                                                            if (jsonMessage.IsString()) {
-                                                                                                    errMessage.append("message: ").append(jsonMessage.GetString());
-                                                                                            }
-
-                                                                                            if (jsonCode.IsNumber()) {
-                                                                                                    int serverErrCode = jsonCode.GetInt();
-
-                                                                                                    switch (serverErrCode) {
-                                                                                                    case grpc::StatusCode::UNAVAILABLE      : code = ErrorCode::ConnectionError; break;
-                                                                                                    case grpc::StatusCode::INTERNAL         : code = ErrorCode::InternalError; break;
-                                                                                                    case grpc::StatusCode::NOT_FOUND        : code = ErrorCode::NotFound; break;
-                                                                                                    case grpc::StatusCode::ALREADY_EXISTS   : code = ErrorCode::AlreadyExists; break;
-                                                                                                    case grpc::StatusCode::INVALID_ARGUMENT : code = ErrorCode::InvalidArgument; break;
-                                                                                                    case grpc::StatusCode::UNAUTHENTICATED  : code = ErrorCode::Unauthenticated; break;
-                                                                                                    case grpc::StatusCode::PERMISSION_DENIED: code = ErrorCode::PermissionDenied; break;
-
-                                                                                                    default:
-                                                                                                            errMessage.append("\ncode: ").append(std::to_string(serverErrCode));
-                                                                                                            break;
-                                                                                                    }
-                                                                                            }
-                                                                                    }
-                                                                            } catch (std::exception& e) {
-                                                                                    NLOG_ERROR("exception: " + std::string(e.what()));
-                                                                            }
-                                                                            */
-          }
+    Nakama::TickPriority priority =
+        Nakama::isResponseOk(*response) ? Nakama::TickPriority::Normal : Nakama::TickPriority::High;
+    _ioWorker.runOrDefer(priority, [this, ctx, response]() { onResponse(ctx, response); });
+  });
 
-          if (errMessage.empty()) {
-            errMessage.append("message: ").append(response->errorMessage);
-            errMessage.append("\nHTTP status: ").append(std::to_string(response->statusCode));
-            errMessage.append("\nbody: ").append(response->body);
-          }
+  if (_ioWorker.isRunning()) {
+    _ioWorker.wakeUp();
+  }
+}
 
-          reqError(ctx, Nakama::NError(std::move(errMessage), code));
+void SatoriRestClient::onResponse(RestReqContext* ctx, Nakama::NHttpResponsePtr response) {
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(_reqContextsLock);
+    found = _reqContexts.erase(ctx) > 0;
+  }
+  if (found) {
+    if (ctx->responseCallback && (response->statusCode == 200 || response->statusCode == 304)) {
+      ctx->responseCallback(*response);
+    } else if (Nakama::isResponseOk(*response)) {
+      if (ctx && ctx->successCallback) {
+        bool ok = true;
+        if (ctx->data) {
+          ok = ctx->data->fromJson(response->body);
+          if (!ok) {
+            reqError(
+                ctx, Nakama::NError(
+                         "Parse JSON failed for Satori. HTTP body: <<" + response->body + ">>",
+                         Nakama::ErrorCode::InternalError));
+          }
         }
 
-        delete ctx;
-        _reqContexts.erase(it);
-      } else {
-        reqError(nullptr, Nakama::NError("Not found satori request context.", Nakama::ErrorCode::InternalError));
-        delete ctx;
+        if (ok) {
+          if (ctx->internal) {
+            ctx->successCallback();
+          } else {
+            dispatch(std::move(ctx->successCallback));
+          }
+        }
       }
-    }();
-    // TODO: Convert this boilerplate lambda back into a function that can be used from within Satori cpp. Boilerplate
-    // ends here	============
-  });
+    } else {
+      reqError(ctx, Nakama::responseToError(*response));
+    }
+
+    delete ctx;
+  } else {
+    reqError(nullptr, Nakama::NError("Not found satori request context.", Nakama::ErrorCode::InternalError));
+    delete ctx;
+  }
 }
 
-void SatoriRestClient::reqError(RestReqContext* ctx, const Nakama::NError& error) const {
+void SatoriRestClient::reqError(RestReqContext* ctx, const Nakama::NError& error) {
   NLOG_ERROR(error);
 
-  if (ctx && ctx->errorCallback) {
-    ctx->errorCallback(error);
-  } else if (_defaultErrorCallback) {
-    _defaultErrorCallback(error);
+  if (ctx && ctx->internal) {
+    if (ctx->errorCallback) {
+      ctx->errorCallback(error);
+    }
+    return;
+  }
+
+  Nakama::ErrorCallback errorCallback = ctx && ctx->errorCallback ? ctx->errorCallback : _defaultErrorCallback;
+
+  if (errorCallback) {
+    dispatch([errorCallback, error]() { errorCallback(error); });
   } else {
     NLOG_WARN("^ error not handled");
   }
@@ -16,10 +16,13 @@
 
 #pragma once
 
+#include <mutex>
 #include <set>
 
 #include "InternalLowLevelSatoriAPI.h"
 #include "SatoriBaseClient.h"
+#include "SatoriConfigCache.h"
+#include "SatoriEventQueue.h"
 #include "nakama-cpp/log/NLogger.h"
 
 namespace Satori {
@@ -28,6 +31,11 @@ struct RestReqContext {
   std::function<void()> successCallback;
   Nakama::ErrorCallback errorCallback;
   std::shared_ptr<SFromJsonInterface> data = nullptr;
+  Nakama::NHttpHeaders headers;
+  // Takes 200 and 304 responses as they are, instead of data and successCallback
+  std::function<void(const Nakama::NHttpResponse&)> responseCallback;
+  // Callbacks are client internals, run them on the I/O side instead of the callback executor
+  bool internal = false;
 };
 
 class SatoriRestClient : public SatoriBaseClient {
@@ -35,7 +43,6 @@ public:
   explicit SatoriRestClient(const Nakama::NClientParameters& parameters, Nakama::NHttpTransportPtr httpClient);
   ~SatoriRestClient() override;
   void disconnect() override;
-  void tick() override;
 
   void authenticate(
       const std::string& id,
@@ -68,6 +75,18 @@ public:
       std::function<void()> successCallback,
       Nakama::ErrorCallback errorCallback) override;
 
+  void configureEventQueue(const SEventQueueConfig& config) override;
+  void setEventQueueSession(SSessionPtr session) override;
+  void queueEvent(SEvent event) override;
+  void flushEvents() override;
+  SEventQueueStats getEventQueueStats() const override;
+
+  void startConfigCache(SSessionPtr session, const SConfigCacheConfig& config) override;
+  void stopConfigCache() override;
+  void refreshConfigCache() override;
+  void setConfigChangedCallback(std::function<void(const SConfigChanges&)> callback) override;
+  const SConfigCacheInterface& getConfigCache() const override { return _configCache; }
+
   void getExperiments(
       SSessionPtr session,
       const SGetExperimentsRequest& request,
@@ -153,6 +172,9 @@ public:
       std::function<void()> successCallback,
       Nakama::ErrorCallback errorCallback) override;
 
+protected:
+  void pumpTransport() override;
+
 private:
   RestReqContext* createReqContext(std::shared_ptr<SFromJsonInterface> data);
   void setBasicAuth(RestReqContext* ctx);
@@ -165,11 +187,31 @@ private:
       std::string&& body,
       Nakama::NHttpQueryArgs&& args = Nakama::NHttpQueryArgs());
 
+  // Takes ownership of ctx pointer
+  void onResponse(RestReqContext* ctx, Nakama::NHttpResponsePtr response);
+
   // Does not take ownership of ctx pointer
-  void reqError(RestReqContext* ctx, const Nakama::NError& error) const;
+  void reqError(RestReqContext* ctx, const Nakama::NError& error);
+
+  // Sends next batch of queued events if it is due
+  void flushEventQueue(bool force);
+
+  // Fetches flags and live events into the config cache if a refresh is due
+  void refreshConfigCacheIfDue(bool force);
+  void sendConfigCacheRequest(
+      SSessionPtr session, SatoriConfigCache::Resource resource, const SConfigCacheConfig& config);
+  void notifyConfigChanged(SConfigChanges changes);
 
 private:
   std::set<RestReqContext*> _reqContexts;
+  std::mutex _reqContextsLock;
   Nakama::NHttpTransportPtr _httpClient;
+  SatoriEventQueue _eventQueue;
+  SSessionPtr _eventSession;
+  mutable std::mutex _eventSessionLock;
+  SatoriConfigCache _configCache;
+  SSessionPtr _configSession;
+  std::function<void(const SConfigChanges&)> _configChangedCallback;
+  std::mutex _configLock;
 };
 } // namespace Satori
@@ -15,6 +15,7 @@
  */
 
 #include <iostream>
+#include <string>
 #include <thread>
 
 #include "nakama-cpp/satori/SatoriClientFactory.h"
@@ -70,8 +71,41 @@ int main(int argc, char** argv) {
     bool testResult3 = getFromFuture(client->postEventAsync(session3, testEvents), client);
     Satori::SLiveEventList testResult4 = getFromFuture(client->getLiveEventsAsync(session3), client);
 
+    Satori::SEventQueueConfig queueConfig;
+    queueConfig.maxBatchEvents = 10;
+    client->configureEventQueue(queueConfig);
+    client->setEventQueueSession(session3);
+    for (int i = 0; i < 25; i++) {
+      Satori::SEvent queuedEvent;
+      queuedEvent.name = "testQueuedEvent";
+      queuedEvent.value = std::to_string(i);
+      queuedEvent.timestamp = 1337 + i;
+      client->queueEvent(queuedEvent);
+    }
+    client->flushEvents();
+    for (int i = 0; i < 100 && client->getEventQueueStats().sent < 25; i++) {
+      client->tick();
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    std::cout << "Queued events sent:" << client->getEventQueueStats().sent << std::endl;
+
     Satori::SLiveEventList liveEvents = getFromFuture(client->getLiveEventsAsync(session3), client);
     std::cout << "Live events num:" << liveEvents.live_events.size() << std::endl;
+
+    Satori::SConfigCacheConfig cacheConfig;
+    cacheConfig.refreshInterval = std::chrono::seconds(1);
+    client->setConfigChangedCallback([](const Satori::SConfigChanges& changes) {
+      std::cout << "Config changed, flags:" << changes.flags.size() << " live events:" << changes.liveEvents.size()
+                << std::endl;
+    });
+    client->startConfigCache(session3, cacheConfig);
+    for (int i = 0; i < 100 && !client->getConfigCache().isReady(); i++) {
+      client->tick();
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+    std::cout << "Cached flag Hiro-Inventory:" << client->getConfigCache().getString("Hiro-Inventory", "<none>")
+              << std::endl;
+    client->stopConfigCache();
     Satori::SGetMessageListResponse messages =
         getFromFuture(client->getMessagesAsync(session3, 10, false, std::string()), client);
     std::cout << "Messages size:" << messages.messages.size() << std::endl;